@@ -45,6 +45,12 @@ class ProgressHandle(tuttle.IProgressHandle):
         """
         pass
 
+    def endSetupAtTime(self, duration):
+        """
+        Called after setting up an image, with the setup duration in seconds
+        """
+        print "---> setup took %f s" % duration
+
     def processAtTime(self):
         """
         Called before processing an image
@@ -1546,6 +1546,13 @@ bool ImageEffect::getTimeDomain(OfxRangeD& range)
     return false;
 }
 
+/** @brief give the output image buffer to the host, without render (tuttle extension) */
+bool ImageEffect::getOutputImageBuffer(const OutputImageBufferArguments& args, OutputImageBuffer& buffer)
+{
+    // by default, the host allocates the output image
+    return false;
+}
+
 /// Start doing progress.
 void ImageEffect::progressStart(const std::string& message)
 {
@@ -2365,6 +2372,38 @@ bool getTimeDomainAction(OfxImageEffectHandle handle, OFX::PropertySet& outArgs)
     return v;
 }
 
+/** @brief Library side get output image buffer function (tuttle extension) */
+bool outputImageBufferAction(OfxImageEffectHandle handle, OFX::PropertySet inArgs, OFX::PropertySet& outArgs)
+{
+    ImageEffect* effectInstance = retrieveImageEffectPointer(handle);
+    OutputImageBufferArguments args;
+
+    args.time = inArgs.propGetDouble(kOfxPropTime);
+    args.renderScale.x = inArgs.propGetDouble(kOfxImageEffectPropRenderScale, 0);
+    args.renderScale.y = inArgs.propGetDouble(kOfxImageEffectPropRenderScale, 1);
+
+    OutputImageBuffer buffer;
+    buffer.data = NULL;
+    buffer.rowBytes = 0;
+    buffer.bounds.x1 = buffer.bounds.y1 = buffer.bounds.x2 = buffer.bounds.y2 = 0;
+    buffer.release = NULL;
+    buffer.releaseCustomData = NULL;
+
+    // and call the plugin client code
+    if(!effectInstance->getOutputImageBuffer(args, buffer))
+        return false;
+
+    outArgs.propSetPointer(kOfxImagePropData, buffer.data);
+    outArgs.propSetInt(kOfxImagePropRowBytes, buffer.rowBytes);
+    outArgs.propSetInt(kOfxImagePropBounds, buffer.bounds.x1, 0);
+    outArgs.propSetInt(kOfxImagePropBounds, buffer.bounds.y1, 1);
+    outArgs.propSetInt(kOfxImagePropBounds, buffer.bounds.x2, 2);
+    outArgs.propSetInt(kOfxImagePropBounds, buffer.bounds.y2, 3);
+    outArgs.propSetPointer(kTuttleOfxImagePropBufferRelease, reinterpret_cast<void*>(buffer.release));
+    outArgs.propSetPointer(kTuttleOfxImagePropBufferReleaseCustomData, buffer.releaseCustomData);
+    return true;
+}
+
 /** @brief Library side get regions of interest function */
 bool clipPreferencesAction(OfxImageEffectHandle handle, OFX::PropertySet& outArgs, const char* plugname)
 {
@@ -2665,6 +2704,14 @@ OfxStatus mainEntryStr(const char* actionRaw, const void* handleRaw, OfxProperty
             if(getTimeDomainAction(handle, outArgs))
                 stat = kOfxStatOK;
         }
+        else if(action == kTuttleOfxImageEffectActionGetOutputImageBuffer)
+        {
+            checkMainHandles(actionRaw, handleRaw, inArgsRaw, outArgsRaw, false, false, false);
+
+            // call the output image buffer action, return OK if the plugin gives its buffer
+            if(outputImageBufferAction(handle, inArgs, outArgs))
+                stat = kOfxStatOK;
+        }
         else if(action == kOfxActionBeginInstanceChanged)
         {
             checkMainHandles(actionRaw, handleRaw, inArgsRaw, outArgsRaw, false, false, true);
@@ -798,6 +798,23 @@ struct RegionOfDefinitionArguments
     OfxPointD renderScale;
 };
 
+/** @brief POD struct to pass arguments into @ref OFX::ImageEffect::getOutputImageBuffer */
+struct OutputImageBufferArguments
+{
+    double time;
+    OfxPointD renderScale;
+};
+
+/** @brief POD struct to give an image buffer to the host in @ref OFX::ImageEffect::getOutputImageBuffer */
+struct OutputImageBuffer
+{
+    void* data;                              ///< bottom left corner of the image
+    int rowBytes;                            ///< negative if the rows are from top to bottom in memory
+    OfxRectI bounds;                         ///< bounds of the image in pixels
+    TuttleOfxImageBufferReleaseFunc release; ///< called by the host when the buffer is no longer used (or NULL)
+    void* releaseCustomData;
+};
+
 /** @brief POD struct to pass arguments into @ref OFX::ImageEffect::getRegionsOfInterest */
 struct RegionsOfInterestArguments
 {
@@ -1120,6 +1137,12 @@ public:
      */
     virtual bool getTimeDomain( OfxRangeD& range );
 
+    /** @brief give the output image buffer to the host, without render (tuttle extension)
+     *
+     * return true if the buffer was set, otherwise the host allocates the output image and calls render
+     */
+    virtual bool getOutputImageBuffer( const OutputImageBufferArguments& args, OutputImageBuffer& buffer );
+
     /// Start doing progress.
     void progressStart( const std::string& message );
 
@@ -0,0 +1,56 @@
+#ifndef _ofxImageBuffer_h_
+#define _ofxImageBuffer_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Function called by the host to release an image buffer given by a plugin. */
+typedef void (*TuttleOfxImageBufferReleaseFunc)(void* customData);
+
+/** @brief Action called by the host before the render action, to get the output image buffer from the plugin.
+ *
+ * It allows a plugin which already has the image in memory (like an input buffer) to give it to the host without copy.
+ * The host uses the buffer as the output image and doesn't call the render action for this frame.
+ *
+ * - handle - handle to the image effect instance
+ * - inArgs - has the following properties
+ *   - ::kOfxPropTime - the time of the output image
+ *   - ::kOfxImageEffectPropRenderScale - the render scale
+ * - outArgs - has the following properties which the plugin sets
+ *   - ::kOfxImagePropData - pointer to the bottom left corner of the image (as for an OFX image)
+ *   - ::kOfxImagePropRowBytes - distance in bytes between rows, negative if the rows are from top to bottom in memory
+ *   - ::kOfxImagePropBounds - bounds of the image in pixels, it needs to match the region of definition
+ *   - ::kTuttleOfxImagePropBufferRelease - function called by the host when the buffer is no longer used (or NULL)
+ *   - ::kTuttleOfxImagePropBufferReleaseCustomData - argument of the release function
+ *
+ * @returns
+ *   - ::kOfxStatOK - the plugin gives the buffer, the host calls the release function when the image is destroyed
+ *   - ::kOfxStatReplyDefault - the plugin has no buffer, the host allocates the image and calls the render action
+ *
+ * If the host can't use the buffer (other bounds or a tiled render), it doesn't call the release function
+ * and calls the render action as usual.
+ */
+#define kTuttleOfxImageEffectActionGetOutputImageBuffer "TuttleOfxImageEffectActionGetOutputImageBuffer"
+
+/** @brief Function to release the image buffer given by the plugin.
+ *
+ * - Type - pointer X 1 (a ::TuttleOfxImageBufferReleaseFunc)
+ * - Property Set - out args of ::kTuttleOfxImageEffectActionGetOutputImageBuffer
+ * - Default - NULL, the buffer is owned by the plugin
+ */
+#define kTuttleOfxImagePropBufferRelease "TuttleOfxImagePropBufferRelease"
+
+/** @brief Argument of the release function of the image buffer.
+ *
+ * - Type - pointer X 1
+ * - Property Set - out args of ::kTuttleOfxImageEffectActionGetOutputImageBuffer
+ * - Default - NULL
+ */
+#define kTuttleOfxImagePropBufferReleaseCustomData "TuttleOfxImagePropBufferReleaseCustomData"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "correlate.hpp"
 #include "detail/kernel.hpp"
+#include "detail/correlate_simd.hpp"
 
 #include <terry/numeric/scalar.hpp>
 #include <terry/numeric/init.hpp>
@@ -290,6 +291,254 @@ public:
     }
 };
 
+/// @brief Position in the source line of the position @p i of the line extended with the boundary option.
+/// @return false if the value is zero
+inline bool extended_index(const std::ptrdiff_t i, const std::ptrdiff_t size, const convolve_boundary_option option,
+                           std::ptrdiff_t& index)
+{
+    index = i;
+    if(i >= 0 && i < size)
+        return true;
+    switch(option)
+    {
+        case convolve_option_extend_padded:
+            return true;
+        case convolve_option_extend_constant:
+            index = (i < 0) ? 0 : size - 1;
+            return true;
+        case convolve_option_extend_mirror:
+        {
+            const std::ptrdiff_t period = 2 * size;
+            std::ptrdiff_t m = i % period;
+            if(m < 0)
+                m += period;
+            index = (m < size) ? m : period - 1 - m;
+            return true;
+        }
+        case convolve_option_extend_zero:
+        case convolve_option_output_ignore:
+        case convolve_option_output_zero:
+            break;
+    }
+    return false;
+}
+
+/// @brief Raw channels of a row of an interleaved view, starting at pixel @p x (which may be in the padding).
+template <typename View>
+GIL_FORCEINLINE typename simd_channel<typename channel_type<View>::type>::raw_type*
+simd_row(const View& view, const std::ptrdiff_t x, const std::ptrdiff_t y)
+{
+    typedef typename simd_channel<typename channel_type<View>::type>::raw_type raw_type;
+    return reinterpret_cast<raw_type*>(&(*view.row_begin(y))) + 4 * x;
+}
+
+/// @brief correlate a 1D kernel along the rows of an interleaved RGBA view (see correlate_rows_imp)
+template <std::size_t Size, typename SrcView, typename Kernel, typename DstView>
+void correlate_rows_simd(const SrcView& src, const Kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                         const convolve_boundary_option option)
+{
+    typedef typename simd_channel<typename channel_type<DstView>::type>::raw_type dst_raw_t;
+
+    assert(dst_tl <= src.dimensions());
+    assert(ker.size() != 0);
+
+    const std::ptrdiff_t width = dst.dimensions().x;
+    if(width == 0 || dst.dimensions().y == 0)
+        return;
+
+    const std::size_t ker_size = ker.size();
+    const std::ptrdiff_t left = ker.left_size();
+    const std::ptrdiff_t right = ker.right_size();
+    const std::ptrdiff_t src_width = src.dimensions().x;
+    const bool output_only = (option == convolve_option_output_ignore || option == convolve_option_output_zero);
+
+    if(output_only && width < static_cast<std::ptrdiff_t>(ker_size))
+    {
+        if(option == convolve_option_output_zero)
+        {
+            for(std::ptrdiff_t y = 0; y < dst.dimensions().y; ++y)
+                std::fill_n(simd_row(dst, 0, y), 4 * width, dst_raw_t(0));
+        }
+        return;
+    }
+    // outside of [x_begin, x_end[ the kernel goes out of the source,
+    // the range is empty if dst goes beyond the source (x_end may be lower than x_begin)
+    const std::ptrdiff_t x_begin = std::min(std::max(left - dst_tl.x, std::ptrdiff_t(0)), width);
+    const std::ptrdiff_t x_end = std::max(std::min(src_width - right - dst_tl.x, width), x_begin);
+
+    const std::vector<float> kernel(ker.begin(), ker.end());
+    const std::ptrdiff_t line_size = width + ker_size - 1;
+    const std::ptrdiff_t line_begin = dst_tl.x - left; // source position of the line
+    const std::ptrdiff_t in_begin = std::max(line_begin, std::ptrdiff_t(0));
+    const std::ptrdiff_t in_end = std::min(line_begin + line_size, src_width);
+    std::vector<float> line(4 * line_size);
+    std::vector<float> result(4 * width);
+
+    for(std::ptrdiff_t y = 0; y < dst.dimensions().y; ++y)
+    {
+        const std::ptrdiff_t y_src = y + dst_tl.y;
+        // fill the line from the source row depending on the boundary option
+        if(option == convolve_option_extend_padded)
+        {
+            load_floats(simd_row(src, line_begin, y_src), &line.front(), 4 * line_size);
+        }
+        else
+        {
+            if(in_end > in_begin)
+                load_floats(simd_row(src, in_begin, y_src), &line[4 * (in_begin - line_begin)], 4 * (in_end - in_begin));
+            for(std::ptrdiff_t i = 0; i < line_size; ++i)
+            {
+                const std::ptrdiff_t x_src = line_begin + i;
+                if(x_src >= in_begin && x_src < in_end)
+                {
+                    i = in_end - line_begin - 1;
+                    continue;
+                }
+                std::ptrdiff_t index;
+                if(extended_index(x_src, src_width, option, index))
+                    load_floats(simd_row(src, index, y_src), &line[4 * i], 4);
+                else
+                    std::fill_n(&line[4 * i], 4, 0.f);
+            }
+        }
+
+        dst_raw_t* it_dst = simd_row(dst, 0, y);
+        if(output_only)
+        {
+            if(option == convolve_option_output_zero)
+            {
+                std::fill_n(it_dst, 4 * x_begin, dst_raw_t(0));
+                std::fill(it_dst + 4 * x_end, it_dst + 4 * width, dst_raw_t(0));
+            }
+            correlate_floats<Size>(&line[4 * x_begin], 4, &kernel.front(), ker_size, &result.front(),
+                                   4 * (x_end - x_begin));
+            store_floats(&result.front(), it_dst + 4 * x_begin, 4 * (x_end - x_begin));
+        }
+        else
+        {
+            correlate_floats<Size>(&line.front(), 4, &kernel.front(), ker_size, &result.front(), 4 * width);
+            store_floats(&result.front(), it_dst, 4 * width);
+        }
+    }
+}
+
+/// @brief Number of columns processed together by correlate_cols_simd.
+/// A row of a block is 256 bytes of floats, so the rows needed by the kernel stay in the cache.
+static const std::ptrdiff_t simd_cols_block_width = 16;
+
+/// @brief correlate a 1D kernel along the columns of an interleaved RGBA view
+///
+/// Instead of a strided access to each column, the view is processed by blocks of columns:
+/// the rows of a block are copied (with the boundary option) and the kernel is applied on full rows of the block.
+/// The source is entirely read before writing, so @p src and @p dst may be the same view.
+template <std::size_t Size, typename SrcView, typename Kernel, typename DstView>
+void correlate_cols_simd(const SrcView& src, const Kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                         const convolve_boundary_option option)
+{
+    typedef typename simd_channel<typename channel_type<DstView>::type>::raw_type dst_raw_t;
+
+    assert(dst_tl <= src.dimensions());
+    assert(ker.size() != 0);
+
+    const std::ptrdiff_t width = dst.dimensions().x;
+    const std::ptrdiff_t height = dst.dimensions().y;
+    if(width == 0 || height == 0)
+        return;
+
+    const std::size_t ker_size = ker.size();
+    const std::ptrdiff_t top = ker.left_size();
+    const std::ptrdiff_t bottom = ker.right_size();
+    const std::ptrdiff_t src_height = src.dimensions().y;
+    const bool output_only = (option == convolve_option_output_ignore || option == convolve_option_output_zero);
+
+    if(output_only && height < static_cast<std::ptrdiff_t>(ker_size))
+    {
+        if(option == convolve_option_output_zero)
+        {
+            for(std::ptrdiff_t y = 0; y < height; ++y)
+                std::fill_n(simd_row(dst, 0, y), 4 * width, dst_raw_t(0));
+        }
+        return;
+    }
+    // outside of [y_begin, y_end[ the kernel goes out of the source
+    const std::ptrdiff_t y_begin = output_only ? std::max(top - dst_tl.y, std::ptrdiff_t(0)) : 0;
+    const std::ptrdiff_t y_end = output_only ? std::min(src_height - bottom - dst_tl.y, height) : height;
+
+    const std::vector<float> kernel(ker.begin(), ker.end());
+    const std::ptrdiff_t block_stride = 4 * simd_cols_block_width;
+    const std::ptrdiff_t nb_lines = height + ker_size - 1;
+    const std::ptrdiff_t line_begin = dst_tl.y - top; // source row of the first line of a block
+    std::vector<float> block(block_stride * nb_lines);
+    std::vector<float> result(block_stride);
+
+    for(std::ptrdiff_t x = 0; x < width; x += simd_cols_block_width)
+    {
+        const std::ptrdiff_t block_width = std::min(simd_cols_block_width, width - x);
+        const std::ptrdiff_t x_src = x + dst_tl.x;
+
+        for(std::ptrdiff_t l = 0; l < nb_lines; ++l)
+        {
+            float* line = &block[l * block_stride];
+            std::ptrdiff_t y_src;
+            if(extended_index(line_begin + l, src_height, option, y_src))
+                load_floats(simd_row(src, x_src, y_src), line, 4 * block_width);
+            else
+                std::fill_n(line, 4 * block_width, 0.f);
+        }
+
+        for(std::ptrdiff_t y = 0; y < height; ++y)
+        {
+            dst_raw_t* it_dst = simd_row(dst, x, y);
+            if(y < y_begin || y >= y_end)
+            {
+                if(option == convolve_option_output_zero)
+                    std::fill_n(it_dst, 4 * block_width, dst_raw_t(0));
+                continue;
+            }
+            correlate_floats<Size>(&block[y * block_stride], block_stride, &kernel.front(), ker_size, &result.front(),
+                                   4 * block_width);
+            store_floats(&result.front(), it_dst, 4 * block_width);
+        }
+    }
+}
+
+/// @brief correlate a 1D kernel along the rows or the columns of an interleaved RGBA view
+template <bool rows, std::size_t Size, typename SrcView, typename Kernel, typename DstView>
+GIL_FORCEINLINE void correlate_1d_simd_k(const SrcView& src, const Kernel& ker, const DstView& dst,
+                                         const typename SrcView::point_t& dst_tl, const convolve_boundary_option option)
+{
+    if(rows)
+        correlate_rows_simd<Size>(src, ker, dst, dst_tl, option);
+    else
+        correlate_cols_simd<Size>(src, ker, dst, dst_tl, option);
+}
+
+/// @brief correlate a 1D kernel with the vectorized implementation,
+/// small kernels are specialized at compile time
+template <bool rows, typename SrcView, typename Kernel, typename DstView>
+void correlate_1d_simd(const SrcView& src, const Kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                       const convolve_boundary_option option)
+{
+    switch(ker.size())
+    {
+        case 3:
+            correlate_1d_simd_k<rows, 3>(src, ker, dst, dst_tl, option);
+            break;
+        case 5:
+            correlate_1d_simd_k<rows, 5>(src, ker, dst, dst_tl, option);
+            break;
+        case 7:
+            correlate_1d_simd_k<rows, 7>(src, ker, dst, dst_tl, option);
+            break;
+        case 9:
+            correlate_1d_simd_k<rows, 9>(src, ker, dst, dst_tl, option);
+            break;
+        default:
+            correlate_1d_simd_k<rows, 0>(src, ker, dst, dst_tl, option);
+            break;
+    }
+}
+
 /// @ingroup ImageAlgorithms
 /// correlate a 1D variable-size kernel along the rows of an image
 template <typename PixelAccum, typename SrcView, typename Kernel, typename DstView>
@@ -409,6 +658,28 @@ GIL_FORCEINLINE void correlate_1d_auto(const SrcView& src, const Kernel& ker, co
     correlate_1d_imp<PixelAccum, SrcView, Kernel, DstView>(src, ker, dst, dst_tl, option, Rows(), Fixed());
 }
 
+/// @ingroup ImageAlgorithms
+/// correlate a 1D kernel with the generic implementation
+template <bool autoEnabled, bool rows, typename PixelAccum, typename SrcView, typename Kernel, typename DstView>
+GIL_FORCEINLINE void correlate_1d_dispatch(const SrcView& src, const Kernel& ker, const DstView& dst,
+                                           const typename SrcView::point_t& dst_tl,
+                                           const convolve_boundary_option option, const boost::mpl::false_ /*simd*/)
+{
+    correlate_1d_auto<rows, PixelAccum, SrcView, Kernel, DstView>(src, ker, dst, dst_tl, option,
+                                                                  boost::mpl::bool_<autoEnabled>());
+}
+
+/// @ingroup ImageAlgorithms
+/// correlate a 1D kernel with the vectorized implementation (interleaved RGBA views, see is_simd_correlable)
+/// The pixels are accumulated in float, whatever the PixelAccum channel type.
+template <bool autoEnabled, bool rows, typename PixelAccum, typename SrcView, typename Kernel, typename DstView>
+GIL_FORCEINLINE void correlate_1d_dispatch(const SrcView& src, const Kernel& ker, const DstView& dst,
+                                           const typename SrcView::point_t& dst_tl,
+                                           const convolve_boundary_option option, const boost::mpl::true_ /*simd*/)
+{
+    correlate_1d_simd<rows>(src, ker, dst, dst_tl, option);
+}
+
 } // namespace detail //
 
 /// @ingroup ImageAlgorithms
@@ -418,8 +689,9 @@ GIL_FORCEINLINE void correlate_1d_imp(const SrcView& src, const Kernel& ker, con
                                       const typename SrcView::point_t& dst_tl,
                                       const convolve_boundary_option option = convolve_option_extend_zero)
 {
-    detail::correlate_1d_auto<rows, PixelAccum, SrcView, Kernel, DstView>(src, ker, dst, dst_tl, option,
-                                                                          boost::mpl::bool_<autoEnabled>());
+    typedef typename detail::is_simd_correlable<PixelAccum, SrcView, DstView>::type Simd;
+    detail::correlate_1d_dispatch<autoEnabled, rows, PixelAccum, SrcView, Kernel, DstView>(src, ker, dst, dst_tl, option,
+                                                                                           Simd());
 }
 
 /// @ingroup ImageAlgorithms
@@ -0,0 +1,198 @@
+#ifndef _TERRY_FILTER_DETAIL_CORRELATE_SIMD_HPP_
+#define _TERRY_FILTER_DETAIL_CORRELATE_SIMD_HPP_
+
+/*!
+/// \file
+/// \brief Vectorized kernels of the separable correlation on interleaved RGBA views
+///        (float32, uint8 and uint16 channels).
+///
+/// The pixels are always accumulated in float32.
+/// SSE2 and AVX are used when enabled at compile time, with a scalar fallback.
+*/
+
+#include <boost/gil/gil_config.hpp>
+#include <boost/gil/typedefs.hpp>
+#include <boost/gil/metafunctions.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <cstddef>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TERRY_FILTER_CORRELATE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__SSE4_1__)
+#define TERRY_FILTER_CORRELATE_SSE41
+#include <smmintrin.h>
+#endif
+#if defined(__AVX__)
+#define TERRY_FILTER_CORRELATE_AVX
+#include <immintrin.h>
+#endif
+
+namespace terry
+{
+namespace filter
+{
+
+using namespace boost::gil;
+
+namespace detail
+{
+
+/// @brief Channel types supported by the vectorized correlation, and their raw memory type.
+template <typename Channel>
+struct simd_channel : public boost::mpl::false_
+{
+};
+template <>
+struct simd_channel<bits8> : public boost::mpl::true_
+{
+    typedef boost::uint8_t raw_type;
+};
+template <>
+struct simd_channel<bits16> : public boost::mpl::true_
+{
+    typedef boost::uint16_t raw_type;
+};
+template <>
+struct simd_channel<bits32f> : public boost::mpl::true_
+{
+    typedef float raw_type;
+};
+
+/// @brief Is this pixel a 4 channels pixel with a supported channel type?
+template <typename Pixel>
+struct is_simd_pixel
+    : public boost::mpl::and_<boost::mpl::bool_<num_channels<Pixel>::value == 4>,
+                              simd_channel<typename channel_type<Pixel>::type> >
+{
+};
+
+/// @brief Is this view an interleaved view (contiguous pixels in a row) of supported pixels?
+template <typename View>
+struct is_simd_view
+    : public boost::mpl::and_<boost::is_pointer<typename View::x_iterator>, is_simd_pixel<typename View::value_type> >
+{
+};
+
+/// @brief Can the correlation from @p SrcView to @p DstView with the @p PixelAccum accumulator be vectorized?
+/// All pixels must share the same channels layout (the channels are processed in memory order).
+template <typename PixelAccum, typename SrcView, typename DstView>
+struct is_simd_correlable
+    : public boost::mpl::and_<
+          is_simd_pixel<PixelAccum>, is_simd_view<SrcView>, is_simd_view<DstView>,
+          boost::is_same<typename SrcView::value_type::layout_t, typename PixelAccum::layout_t>,
+          boost::is_same<typename DstView::value_type::layout_t, typename PixelAccum::layout_t> >
+{
+};
+
+/**
+ * @brief dst[i] = sum_k( ker[k] * src[i + k * stride] ) for i in [0, n[
+ *
+ * Along a row of interleaved pixels the stride is one pixel,
+ * along the columns of a block of rows it is the width of the block.
+ * @tparam Size kernel size known at compile time, 0 for a variable-size kernel.
+ */
+template <std::size_t Size>
+inline void correlate_floats(const float* src, const std::ptrdiff_t stride, const float* ker, const std::size_t ker_size,
+                             float* dst, const std::size_t n)
+{
+    const std::size_t size = Size ? Size : ker_size;
+    std::size_t i = 0;
+#ifdef TERRY_FILTER_CORRELATE_AVX
+    for(; i + 8 <= n; i += 8)
+    {
+        const float* s = src + i;
+        __m256 acc = _mm256_setzero_ps();
+        for(std::size_t k = 0; k < size; ++k, s += stride)
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(s), _mm256_set1_ps(ker[k])));
+        _mm256_storeu_ps(dst + i, acc);
+    }
+#endif
+#ifdef TERRY_FILTER_CORRELATE_SSE2
+    for(; i + 4 <= n; i += 4)
+    {
+        const float* s = src + i;
+        __m128 acc = _mm_setzero_ps();
+        for(std::size_t k = 0; k < size; ++k, s += stride)
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(s), _mm_set1_ps(ker[k])));
+        _mm_storeu_ps(dst + i, acc);
+    }
+#endif
+    for(; i < n; ++i)
+    {
+        const float* s = src + i;
+        float acc = 0.f;
+        for(std::size_t k = 0; k < size; ++k, s += stride)
+            acc += *s * ker[k];
+        dst[i] = acc;
+    }
+}
+
+/// @brief Convert @p n channels to float.
+/// @{
+inline void load_floats(const float* src, float* dst, const std::size_t n) { std::copy(src, src + n, dst); }
+
+inline void load_floats(const boost::uint8_t* src, float* dst, const std::size_t n)
+{
+    for(std::size_t i = 0; i < n; ++i)
+        dst[i] = static_cast<float>(src[i]);
+}
+
+inline void load_floats(const boost::uint16_t* src, float* dst, const std::size_t n)
+{
+    for(std::size_t i = 0; i < n; ++i)
+        dst[i] = static_cast<float>(src[i]);
+}
+/// @}
+
+/// @brief Convert @p n floats to channels (truncated like a channel assignment, and saturated).
+/// @{
+inline void store_floats(const float* src, float* dst, const std::size_t n) { std::copy(src, src + n, dst); }
+
+inline void store_floats(const float* src, boost::uint8_t* dst, const std::size_t n)
+{
+    std::size_t i = 0;
+#ifdef TERRY_FILTER_CORRELATE_SSE2
+    for(; i + 16 <= n; i += 16)
+    {
+        const __m128i a = _mm_cvttps_epi32(_mm_loadu_ps(src + i));
+        const __m128i b = _mm_cvttps_epi32(_mm_loadu_ps(src + i + 4));
+        const __m128i c = _mm_cvttps_epi32(_mm_loadu_ps(src + i + 8));
+        const __m128i d = _mm_cvttps_epi32(_mm_loadu_ps(src + i + 12));
+        const __m128i ab = _mm_packs_epi32(a, b);
+        const __m128i cd = _mm_packs_epi32(c, d);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(ab, cd));
+    }
+#endif
+    for(; i < n; ++i)
+        dst[i] = src[i] <= 0.f ? 0 : (src[i] >= 255.f ? 255 : static_cast<boost::uint8_t>(src[i]));
+}
+
+inline void store_floats(const float* src, boost::uint16_t* dst, const std::size_t n)
+{
+    std::size_t i = 0;
+#ifdef TERRY_FILTER_CORRELATE_SSE41
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m128i a = _mm_cvttps_epi32(_mm_loadu_ps(src + i));
+        const __m128i b = _mm_cvttps_epi32(_mm_loadu_ps(src + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi32(a, b));
+    }
+#endif
+    for(; i < n; ++i)
+        dst[i] = src[i] <= 0.f ? 0 : (src[i] >= 65535.f ? 65535 : static_cast<boost::uint16_t>(src[i]));
+}
+/// @}
+}
+}
+}
+
+#endif
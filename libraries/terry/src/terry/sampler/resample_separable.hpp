@@ -0,0 +1,266 @@
+#ifndef _TERRY_SAMPLER_RESAMPLE_SEPARABLE_HPP_
+#define _TERRY_SAMPLER_RESAMPLE_SEPARABLE_HPP_
+
+#include <terry/math/Rect.hpp>
+#include <terry/geometry/affine.hpp>
+
+#include <terry/sampler/details.hpp>
+#include <terry/sampler/sampler.hpp>
+
+#include <boost/static_assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define TERRY_SAMPLER_SEPARABLE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace terry
+{
+using namespace boost::gil;
+namespace sampler
+{
+
+namespace details
+{
+
+/**
+ * @brief Weights of a windowed sampler along one axis, computed once for each destination coordinate.
+ */
+struct separable_weights
+{
+    std::size_t _windowSize;
+    std::vector<std::ptrdiff_t> _first; ///< source coordinate of the first tap (can be outside of the source image)
+    std::vector<float> _weights;        ///< _windowSize weights for each destination coordinate
+
+    std::ptrdiff_t min_tap() const { return _first.empty() ? 0 : *std::min_element(_first.begin(), _first.end()); }
+    std::ptrdiff_t max_tap() const
+    {
+        return _first.empty() ? 0 : *std::max_element(_first.begin(), _first.end()) + _windowSize - 1;
+    }
+};
+
+/**
+ * @brief Weights of the destination coordinates [begin, end[ mapped to the source by: scale * x + translate.
+ * The taps and the weights are the ones of sample().
+ */
+template <typename Sampler>
+void compute_separable_weights(Sampler& sampler, const double scale, const double translate, const std::ptrdiff_t begin,
+                               const std::ptrdiff_t end, separable_weights& weights)
+{
+    const std::size_t windowSize = sampler._windowSize;
+    const std::size_t middlePosition = std::floor((windowSize - 1.0) * 0.5);
+
+    weights._windowSize = windowSize;
+    weights._first.resize(end - begin);
+    weights._weights.resize((end - begin) * windowSize);
+
+    for(std::ptrdiff_t d = begin; d < end; ++d)
+    {
+        const double p = scale * d + translate;
+        const std::ptrdiff_t pTL = ifloor(p);
+        const RESAMPLING_CORE_TYPE frac = p - pTL;
+
+        weights._first[d - begin] = pTL - middlePosition;
+        float* w = &weights._weights[(d - begin) * windowSize];
+        for(std::size_t i = 0; i < windowSize; ++i)
+        {
+            const RESAMPLING_CORE_TYPE distance = -frac - middlePosition + i;
+            bits64f weight = 0;
+            sampler(distance, weight);
+            w[i] = static_cast<float>(weight);
+        }
+    }
+}
+
+/**
+ * @brief Horizontal pass: dst[x] = sum_i( weights[x][i] * src[first[x] + i] ).
+ * @param src interleaved float pixels of the row, starting at the source coordinate @p srcBegin
+ */
+inline void resample_row_separable(const float* src, const std::ptrdiff_t srcBegin, const std::size_t nbChannels,
+                                   const separable_weights& weights, float* dst)
+{
+    const std::size_t windowSize = weights._windowSize;
+    const std::size_t width = weights._first.size();
+    const float* w = &weights._weights[0];
+
+#ifdef TERRY_SAMPLER_SEPARABLE_SSE
+    if(nbChannels == 4)
+    {
+        for(std::size_t x = 0; x < width; ++x, w += windowSize, dst += 4)
+        {
+            const float* s = src + (weights._first[x] - srcBegin) * 4;
+            __m128 acc = _mm_setzero_ps();
+            for(std::size_t i = 0; i < windowSize; ++i, s += 4)
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(s), _mm_set1_ps(w[i])));
+            _mm_storeu_ps(dst, acc);
+        }
+        return;
+    }
+#endif
+    for(std::size_t x = 0; x < width; ++x, w += windowSize, dst += nbChannels)
+    {
+        const float* s = src + (weights._first[x] - srcBegin) * nbChannels;
+        std::fill(dst, dst + nbChannels, 0.f);
+        for(std::size_t i = 0; i < windowSize; ++i, s += nbChannels)
+        {
+            for(std::size_t c = 0; c < nbChannels; ++c)
+                dst[c] += w[i] * s[c];
+        }
+    }
+}
+
+/**
+ * @brief Vertical pass: dst[j] = sum_i( weights[i] * rows[i][j] ) for j in [0, n[
+ */
+inline void resample_column_separable(const float* const* rows, const float* weights, const std::size_t windowSize,
+                                      float* dst, const std::size_t n)
+{
+    std::size_t j = 0;
+#ifdef TERRY_SAMPLER_SEPARABLE_SSE
+    for(; j + 4 <= n; j += 4)
+    {
+        __m128 acc = _mm_setzero_ps();
+        for(std::size_t i = 0; i < windowSize; ++i)
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(rows[i] + j), _mm_set1_ps(weights[i])));
+        _mm_storeu_ps(dst + j, acc);
+    }
+#endif
+    for(; j < n; ++j)
+    {
+        float acc = 0.f;
+        for(std::size_t i = 0; i < windowSize; ++i)
+            acc += weights[i] * rows[i][j];
+        dst[j] = acc;
+    }
+}
+
+/**
+ * @brief Filter horizontally the source row @p y (outside of the image, the row is handled as sample() does).
+ * @param srcRow buffer for the source pixels from min_tap() to max_tap()
+ */
+template <typename SrcView, typename SrcC>
+void filter_row_separable(const SrcView& src_view, std::ptrdiff_t y, const separable_weights& xWeights,
+                          const EParamFilterOutOfImage outOfImageProcess, const SrcC& outside,
+                          std::vector<SrcC>& srcRow, SrcC* dst)
+{
+    const std::ptrdiff_t width = src_view.width();
+    const std::ptrdiff_t height = src_view.height();
+    const std::size_t nbChannels = num_channels<SrcC>::value;
+
+    if(y < 0 || y >= height)
+    {
+        if(outOfImageProcess != eParamFilterOutCopy)
+        {
+            std::fill(dst, dst + xWeights._first.size(), outside);
+            return;
+        }
+        y = y < 0 ? 0 : height - 1;
+    }
+
+    const std::ptrdiff_t xMin = xWeights.min_tap();
+    typename SrcView::x_iterator sit = src_view.row_begin(y);
+    for(std::ptrdiff_t i = 0, x = xMin; i < static_cast<std::ptrdiff_t>(srcRow.size()); ++i, ++x)
+    {
+        if(x >= 0 && x < width)
+            color_convert(sit[x], srcRow[i]);
+        else if(outOfImageProcess == eParamFilterOutCopy)
+            color_convert(sit[x < 0 ? 0 : width - 1], srcRow[i]);
+        else
+            srcRow[i] = outside;
+    }
+    resample_row_separable(reinterpret_cast<const float*>(&srcRow[0]), xMin, nbChannels, xWeights,
+                           reinterpret_cast<float*>(dst));
+}
+}
+
+/**
+ * @brief Can the resampling with @p dst_to_src be done by resample_pixels_separable_progress?
+ * Only a scale and a translation are separable, and the mirror mode is not supported.
+ */
+template <typename F>
+inline bool is_separable(const matrix3x2<F>& dst_to_src, const EParamFilterOutOfImage outOfImageProcess)
+{
+    return dst_to_src.b == 0 && dst_to_src.c == 0 && outOfImageProcess != eParamFilterOutMirror;
+}
+
+/**
+ * @brief Same as resample_pixels_progress for the windowed samplers (bc, gaussian, lanczos), when is_separable().
+ * @ingroup ImageAlgorithms
+ *
+ * The weights are computed once for each destination column and row.
+ * The needed source rows are filtered horizontally into a cache of _windowSize rows,
+ * then each destination row is the weighted sum of the cached rows.
+ */
+template <typename Sampler, // Models SamplerConcept
+          typename SrcView, // Models RandomAccess2DImageViewConcept
+          typename DstView, // Models MutableRandomAccess2DImageViewConcept
+          typename F, typename Progress>
+void resample_pixels_separable_progress(const SrcView& src_view, const DstView& dst_view,
+                                        const matrix3x2<F>& dst_to_src, const terry::Rect<std::ssize_t>& procWindow,
+                                        const EParamFilterOutOfImage& outOfImageProcess, Progress& p,
+                                        Sampler sampler = Sampler())
+{
+    typedef typename SrcView::value_type SrcP;
+    typedef typename floating_pixel_from_view<SrcView>::type SrcC;
+    // the pixels are processed as arrays of floats
+    BOOST_STATIC_ASSERT(sizeof(SrcC) == num_channels<SrcC>::value * sizeof(float));
+
+    const terry::point2<std::ssize_t> procWindowSize = procWindow.size();
+    if(procWindowSize.x <= 0 || procWindowSize.y <= 0 || src_view.width() == 0 || src_view.height() == 0)
+        return;
+
+    details::separable_weights xWeights, yWeights;
+    details::compute_separable_weights(sampler, dst_to_src.a, dst_to_src.e, procWindow.x1, procWindow.x2, xWeights);
+    details::compute_separable_weights(sampler, dst_to_src.d, dst_to_src.f, procWindow.y1, procWindow.y2, yWeights);
+    const std::size_t windowSize = yWeights._windowSize;
+    const std::size_t rowSize = procWindowSize.x;
+
+    // value of the pixels outside of the source image (except for the copy mode)
+    SrcC outside(0);
+    if(outOfImageProcess == eParamFilterOutBlack)
+        color_convert(get_black<SrcP>(), outside);
+
+    std::vector<SrcC> srcRow(xWeights.max_tap() - xWeights.min_tap() + 1);
+    // source rows filtered horizontally, the row y is in the slot (y modulo windowSize)
+    std::vector<SrcC> rows(windowSize * rowSize);
+    std::vector<std::ptrdiff_t> rowsY(windowSize, std::numeric_limits<std::ptrdiff_t>::min());
+    std::vector<const float*> rowPtrs(windowSize);
+    std::vector<SrcC> dstRow(rowSize);
+
+    for(std::ptrdiff_t y = procWindow.y1; y < procWindow.y2; ++y)
+    {
+        const std::ptrdiff_t first = yWeights._first[y - procWindow.y1];
+        for(std::size_t i = 0; i < windowSize; ++i)
+        {
+            const std::ptrdiff_t srcY = first + i;
+            const std::size_t slot = ((srcY % std::ptrdiff_t(windowSize)) + windowSize) % windowSize;
+            if(rowsY[slot] != srcY)
+            {
+                details::filter_row_separable(src_view, srcY, xWeights, outOfImageProcess, outside, srcRow,
+                                              &rows[slot * rowSize]);
+                rowsY[slot] = srcY;
+            }
+            rowPtrs[i] = reinterpret_cast<const float*>(&rows[slot * rowSize]);
+        }
+        details::resample_column_separable(&rowPtrs[0], &yWeights._weights[(y - procWindow.y1) * windowSize],
+                                           windowSize, reinterpret_cast<float*>(&dstRow[0]),
+                                           rowSize * num_channels<SrcC>::value);
+
+        typename DstView::x_iterator xit = dst_view.row_begin(y) + procWindow.x1;
+        for(std::size_t x = 0; x < rowSize; ++x)
+            color_convert(dstRow[x], xit[x]);
+
+        if(p.progressForward(procWindowSize.x))
+            return;
+    }
+}
+}
+}
+
+#endif
@@ -0,0 +1,117 @@
+#include <terry/globals.hpp>
+#include <terry/filter/convolve.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define BOOST_TEST_MODULE terry_filter_convolve_benchmark
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(terry_filter_convolve_benchmark)
+
+namespace
+{
+
+typedef terry::rgba32f_pixel_t Pixel;
+typedef terry::rgba32f_image_t Image;
+typedef terry::rgba32f_view_t View;
+typedef terry::filter::kernel_1d<float> Kernel;
+
+static const int kNbRuns = 5;
+
+double seconds(const boost::posix_time::ptime& begin)
+{
+    return (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() / 1000000.0;
+}
+
+void fillRandom(const View& v)
+{
+    std::srand(42);
+    for(View::iterator it = v.begin(), itEnd = v.end(); it != itEnd; ++it)
+    {
+        for(int c = 0; c < 4; ++c)
+            (*it)[c] = static_cast<float>(std::rand() / double(RAND_MAX));
+    }
+}
+
+/// @brief The generic implementation of correlate_rows/correlate_cols (without the vectorized dispatch).
+void correlateGeneric(const bool rows, const View& src, const Kernel& ker, const View& dst)
+{
+    const View::point_t dst_tl(0, 0);
+    if(rows)
+        terry::filter::detail::correlate_1d_auto<true, Pixel>(src, ker, dst, dst_tl,
+                                                              terry::filter::convolve_option_extend_mirror,
+                                                              boost::mpl::false_());
+    else
+        terry::filter::detail::correlate_1d_auto<false, Pixel>(src, ker, dst, dst_tl,
+                                                               terry::filter::convolve_option_extend_mirror,
+                                                               boost::mpl::false_());
+}
+
+/// @brief correlate_rows_simd/correlate_cols_simd (with the small kernels specialized at compile time).
+void correlateSimd(const bool rows, const View& src, const Kernel& ker, const View& dst)
+{
+    const View::point_t dst_tl(0, 0);
+    if(rows)
+        terry::filter::detail::correlate_1d_simd<true>(src, ker, dst, dst_tl,
+                                                       terry::filter::convolve_option_extend_mirror);
+    else
+        terry::filter::detail::correlate_1d_simd<false>(src, ker, dst, dst_tl,
+                                                        terry::filter::convolve_option_extend_mirror);
+}
+
+/// @return the best time of kNbRuns runs
+template <class Correlate>
+double bestTime(Correlate correlate, const bool rows, const View& src, const Kernel& ker, const View& dst)
+{
+    double best = 0;
+    for(int i = 0; i < kNbRuns; ++i)
+    {
+        const boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+        correlate(rows, src, ker, dst);
+        const double time = seconds(begin);
+        best = (i == 0) ? time : std::min(best, time);
+    }
+    return best;
+}
+}
+
+BOOST_AUTO_TEST_CASE(convolve_simd_benchmark)
+{
+    // a full HD RGBA float image
+    Image srcImage(1920, 1080);
+    fillRandom(view(srcImage));
+    Image generic(srcImage.dimensions());
+    Image simd(srcImage.dimensions());
+    const double nbMPixels = srcImage.width() * srcImage.height() / 1e6;
+
+    // the sizes specialized at compile time, and larger ones
+    const std::size_t sizes[] = {3, 5, 9, 15, 31};
+    BOOST_FOREACH(const std::size_t size, sizes)
+    {
+        const std::vector<float> values(size, 1.f / size);
+        const Kernel ker(values.begin(), values.size(), values.size() / 2);
+        for(int rows = 1; rows >= 0; --rows)
+        {
+            const double genericTime = bestTime(correlateGeneric, rows, view(srcImage), ker, view(generic));
+            const double simdTime = bestTime(correlateSimd, rows, view(srcImage), ker, view(simd));
+
+            std::cout << "[convolve] " << (rows ? "rows" : "cols") << ", kernel of " << ker.size()
+                      << ": correlate_" << (rows ? "rows" : "cols") << " " << nbMPixels / genericTime
+                      << " Mpixels/s, correlate_" << (rows ? "rows" : "cols") << "_simd " << nbMPixels / simdTime
+                      << " Mpixels/s (x" << genericTime / simdTime << ")" << std::endl;
+
+            // the timed results are used
+            BOOST_CHECK_SMALL(view(generic)(960, 540)[0] - view(simd)(960, 540)[0], 1e-5f);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,170 @@
+#include <terry/globals.hpp>
+#include <terry/filter/convolve.hpp>
+#include <terry/filter/gaussianKernel.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/foreach.hpp>
+
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(terry_filter_convolve)
+
+namespace
+{
+
+typedef terry::rgba32f_pixel_t Pixel;
+typedef terry::rgba32f_image_t Image;
+typedef terry::rgba32f_view_t View;
+typedef terry::filter::kernel_1d<float> Kernel;
+
+template <class V>
+void fillRandom(const V& v)
+{
+    typedef typename boost::gil::channel_type<V>::type Channel;
+    const double maxValue = boost::gil::channel_traits<Channel>::max_value();
+    std::srand(42);
+    for(typename V::iterator it = v.begin(), itEnd = v.end(); it != itEnd; ++it)
+    {
+        for(int c = 0; c < 4; ++c)
+            (*it)[c] = Channel(static_cast<float>(std::rand() / double(RAND_MAX) * maxValue));
+    }
+}
+
+template <class V>
+void fillHalf(const V& v)
+{
+    typedef typename boost::gil::channel_type<V>::type Channel;
+    const double maxValue = boost::gil::channel_traits<Channel>::max_value();
+    typename V::value_type half;
+    for(int c = 0; c < 4; ++c)
+        half[c] = Channel(static_cast<float>(maxValue * 0.5));
+    terry::fill_pixels(v, half);
+}
+
+template <class V>
+double maxDifference(const V& a, const V& b)
+{
+    double diff = 0;
+    for(typename V::iterator itA = a.begin(), itB = b.begin(), itEnd = a.end(); itA != itEnd; ++itA, ++itB)
+    {
+        for(int c = 0; c < 4; ++c)
+            diff = std::max(diff, std::abs(double((*itA)[c]) - double((*itB)[c])));
+    }
+    return diff;
+}
+
+/// @brief The generic implementation (used for views which can't be vectorized).
+/// The pixels are accumulated in float, like the vectorized implementation.
+template <class V>
+void correlateGeneric(const bool rows, const V& src, const Kernel& ker, const V& dst, const typename V::point_t& dst_tl,
+                      const terry::filter::convolve_boundary_option option)
+{
+    if(rows)
+        terry::filter::detail::correlate_1d_auto<true, Pixel>(src, ker, dst, dst_tl, option, boost::mpl::true_());
+    else
+        terry::filter::detail::correlate_1d_auto<false, Pixel>(src, ker, dst, dst_tl, option, boost::mpl::true_());
+}
+
+template <class V>
+void correlateSimd(const bool rows, const V& src, const Kernel& ker, const V& dst, const typename V::point_t& dst_tl,
+                   const terry::filter::convolve_boundary_option option)
+{
+    if(rows)
+        terry::filter::correlate_rows_auto<Pixel>(src, ker, dst, dst_tl, option);
+    else
+        terry::filter::correlate_cols_auto<Pixel>(src, ker, dst, dst_tl, option);
+}
+
+/// @brief Compare the vectorized and the generic implementations on all the boundary options.
+/// @param tolerance maximum difference of a channel (the integer channels are truncated from the float accumulation)
+template <class Img>
+void checkSimdEquivalence(const double tolerance)
+{
+    typedef typename Img::view_t V;
+    typedef typename V::point_t Point;
+    BOOST_STATIC_ASSERT((terry::filter::detail::is_simd_correlable<Pixel, V, V>::value));
+
+    Img srcImage(67, 45);
+    fillRandom(view(srcImage));
+
+    const terry::filter::convolve_boundary_option options[] = {
+        terry::filter::convolve_option_output_ignore, terry::filter::convolve_option_output_zero,
+        terry::filter::convolve_option_extend_zero, terry::filter::convolve_option_extend_constant,
+        terry::filter::convolve_option_extend_mirror};
+    const float sizes[] = {1.f, 2.f, 9.f};
+
+    // the whole image, and a window of it (like a tile of a plugin)
+    const Point windowTl(5, 3);
+    const Point windowSize(50, 30);
+
+    BOOST_FOREACH(const terry::filter::convolve_boundary_option option, options)
+    {
+        BOOST_FOREACH(const float size, sizes)
+        {
+            const Kernel ker = terry::filter::buildGaussian1DKernel<float>(size);
+            for(int rows = 0; rows < 2; ++rows)
+            {
+                for(int window = 0; window < 2; ++window)
+                {
+                    const Point dst_tl = window ? windowTl : Point(0, 0);
+                    const Point dstSize = window ? windowSize : view(srcImage).dimensions();
+                    Img generic(dstSize);
+                    Img simd(dstSize);
+                    fillHalf(view(generic));
+                    fillHalf(view(simd));
+
+                    correlateGeneric(rows, view(srcImage), ker, view(generic), dst_tl, option);
+                    correlateSimd(rows, view(srcImage), ker, view(simd), dst_tl, option);
+
+                    BOOST_CHECK_SMALL(maxDifference(view(generic), view(simd)), tolerance);
+                }
+            }
+        }
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(convolve_simd_equivalence)
+{
+    BOOST_STATIC_ASSERT((!terry::filter::detail::is_simd_correlable<terry::rgb32f_pixel_t, terry::rgb32f_view_t,
+                                                                    terry::rgb32f_view_t>::value));
+    checkSimdEquivalence<Image>(1e-5);
+}
+
+BOOST_AUTO_TEST_CASE(convolve_simd_equivalence_integer_channels)
+{
+    BOOST_STATIC_ASSERT((terry::filter::detail::is_simd_correlable<terry::rgba8_pixel_t, terry::rgba8_view_t,
+                                                                   terry::rgba8_view_t>::value));
+    checkSimdEquivalence<terry::rgba8_image_t>(1.0);
+    checkSimdEquivalence<terry::rgba16_image_t>(1.0);
+}
+
+BOOST_AUTO_TEST_CASE(convolve_simd_window_out_of_source)
+{
+    // the window goes beyond the right side of the source, so no output pixel has the whole kernel inside the source
+    Image srcImage(10, 4);
+    fillRandom(view(srcImage));
+    const std::vector<float> values(9, 1.f / 9.f);
+    const Kernel ker(values.begin(), values.size(), values.size() / 2);
+
+    Image ignored(9, 4);
+    fillHalf(view(ignored));
+    correlateSimd(true, view(srcImage), ker, view(ignored), View::point_t(8, 0),
+                  terry::filter::convolve_option_output_ignore);
+    Image half(9, 4);
+    fillHalf(view(half));
+    BOOST_CHECK_EQUAL(0.0, maxDifference(view(ignored), view(half)));
+
+    Image zero(9, 4);
+    fillHalf(view(zero));
+    correlateSimd(true, view(srcImage), ker, view(zero), View::point_t(8, 0), terry::filter::convolve_option_output_zero);
+    terry::fill_pixels(view(half), Pixel(0.f, 0.f, 0.f, 0.f));
+    BOOST_CHECK_EQUAL(0.0, maxDifference(view(zero), view(half)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,112 @@
+#include <terry/globals.hpp>
+#include <terry/sampler/resample_progress.hpp>
+#include <terry/sampler/resample_separable.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#define BOOST_TEST_MODULE terry_sampler_resample_benchmark
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(terry_sampler_resample_benchmark)
+
+namespace
+{
+
+typedef terry::rgba32f_image_t Image;
+typedef terry::rgba32f_view_t View;
+
+struct NoProgress
+{
+    bool progressForward(const std::ptrdiff_t) { return false; }
+};
+
+double seconds(const boost::posix_time::ptime& begin)
+{
+    return (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() / 1000000.0;
+}
+
+void fillRandom(const View& v)
+{
+    std::srand(42);
+    for(View::iterator it = v.begin(), itEnd = v.end(); it != itEnd; ++it)
+    {
+        for(int c = 0; c < 4; ++c)
+            (*it)[c] = static_cast<float>(std::rand()) / RAND_MAX;
+    }
+}
+
+/// @brief Same matrix as the Resize plugin.
+terry::matrix3x2<double> resizeMatrix(const View& src, const View& dst)
+{
+    const double src_width = std::max<double>(src.width() - 1, 1);
+    const double src_height = std::max<double>(src.height() - 1, 1);
+    const double dst_width = std::max<double>(dst.width() - 1, 1);
+    const double dst_height = std::max<double>(dst.height() - 1, 1);
+    return terry::matrix3x2<double>::get_translate(-dst_width * 0.5, -dst_height * 0.5) *
+           terry::matrix3x2<double>::get_scale((src_width + 1) / (dst_width + 1), (src_height + 1) / (dst_height + 1)) *
+           terry::matrix3x2<double>::get_translate(src_width * 0.5, src_height * 0.5);
+}
+
+template <typename Sampler>
+void benchmarkSeparable(const View& src, const View& dst, const char* name, Sampler sampler = Sampler())
+{
+    using namespace terry::sampler;
+    Image genericImage(dst.dimensions());
+    Image separableImage(dst.dimensions());
+    const terry::matrix3x2<double> mat = resizeMatrix(src, dst);
+    const terry::Rect<std::ssize_t> procWindow(0, 0, dst.width(), dst.height());
+    NoProgress progress;
+
+    BOOST_REQUIRE(is_separable(mat, eParamFilterOutCopy));
+
+    boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    resample_pixels_progress(src, view(genericImage), mat, procWindow, eParamFilterOutCopy, progress, sampler);
+    const double genericTime = seconds(begin);
+
+    begin = boost::posix_time::microsec_clock::universal_time();
+    resample_pixels_separable_progress(src, view(separableImage), mat, procWindow, eParamFilterOutCopy, progress,
+                                       sampler);
+    const double separableTime = seconds(begin);
+
+    std::cout << "[resample] " << name << " " << src.width() << "x" << src.height() << " -> " << dst.width() << "x"
+              << dst.height() << ": generic " << genericTime * 1000.0 << " ms, separable " << separableTime * 1000.0
+              << " ms (x" << genericTime / separableTime << ")" << std::endl;
+
+    // the timed results are used
+    BOOST_CHECK_SMALL(view(genericImage)(dst.width() / 2, dst.height() / 2)[0] -
+                          view(separableImage)(dst.width() / 2, dst.height() / 2)[0],
+                      1e-4f);
+}
+}
+
+BOOST_AUTO_TEST_CASE(resample_upscale_benchmark)
+{
+    using namespace terry::sampler;
+    Image srcImage(960, 540);
+    Image dstImage(1920, 1080);
+    fillRandom(view(srcImage));
+
+    benchmarkSeparable<catrom_sampler>(view(srcImage), view(dstImage), "catrom");
+    benchmarkSeparable<lanczos3_sampler>(view(srcImage), view(dstImage), "lanczos3");
+    benchmarkSeparable<gaussian_sampler>(view(srcImage), view(dstImage), "gaussian");
+}
+
+BOOST_AUTO_TEST_CASE(resample_downscale_benchmark)
+{
+    using namespace terry::sampler;
+    Image srcImage(1920, 1080);
+    Image dstImage(640, 360);
+    fillRandom(view(srcImage));
+
+    benchmarkSeparable<catrom_sampler>(view(srcImage), view(dstImage), "catrom");
+    benchmarkSeparable(view(srcImage), view(dstImage), "lanczos(6)", lanczos_sampler(6, 1.0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
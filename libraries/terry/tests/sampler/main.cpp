@@ -0,0 +1,115 @@
+#include <terry/globals.hpp>
+#include <terry/sampler/resample_progress.hpp>
+#include <terry/sampler/resample_separable.hpp>
+
+#include <boost/gil/image.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#define BOOST_TEST_MODULE terry_sampler_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(terry_sampler_separable)
+
+namespace
+{
+
+typedef terry::rgba32f_image_t Image;
+typedef terry::rgba32f_view_t View;
+
+struct NoProgress
+{
+    bool progressForward(const std::ptrdiff_t) { return false; }
+};
+
+void fillRandom(const View& v)
+{
+    std::srand(42);
+    for(View::iterator it = v.begin(), itEnd = v.end(); it != itEnd; ++it)
+    {
+        for(int c = 0; c < 4; ++c)
+            (*it)[c] = static_cast<float>(std::rand()) / RAND_MAX;
+    }
+}
+
+float maxDifference(const View& a, const View& b)
+{
+    float diff = 0;
+    for(View::iterator itA = a.begin(), itB = b.begin(), itEnd = a.end(); itA != itEnd; ++itA, ++itB)
+    {
+        for(int c = 0; c < 4; ++c)
+            diff = std::max(diff, std::abs((*itA)[c] - (*itB)[c]));
+    }
+    return diff;
+}
+
+/// @brief Same matrix as the Resize plugin.
+terry::matrix3x2<double> resizeMatrix(const View& src, const View& dst, const double shiftX)
+{
+    const double src_width = std::max<double>(src.width() - 1, 1);
+    const double src_height = std::max<double>(src.height() - 1, 1);
+    const double dst_width = std::max<double>(dst.width() - 1, 1);
+    const double dst_height = std::max<double>(dst.height() - 1, 1);
+    return terry::matrix3x2<double>::get_translate(-dst_width * 0.5 + shiftX, -dst_height * 0.5) *
+           terry::matrix3x2<double>::get_scale((src_width + 1) / (dst_width + 1), (src_height + 1) / (dst_height + 1)) *
+           terry::matrix3x2<double>::get_translate(src_width * 0.5, src_height * 0.5);
+}
+
+template <typename Sampler>
+void checkSeparable(const View& src, const View& dst, const terry::sampler::EParamFilterOutOfImage outOfImage,
+                    const double shiftX = 0, Sampler sampler = Sampler())
+{
+    using namespace terry::sampler;
+    Image genericImage(dst.dimensions());
+    Image separableImage(dst.dimensions());
+    const terry::matrix3x2<double> mat = resizeMatrix(src, dst, shiftX);
+    const terry::Rect<std::ssize_t> procWindow(0, 0, dst.width(), dst.height());
+    NoProgress progress;
+
+    BOOST_REQUIRE(is_separable(mat, outOfImage));
+
+    resample_pixels_progress(src, view(genericImage), mat, procWindow, outOfImage, progress, sampler);
+    resample_pixels_separable_progress(src, view(separableImage), mat, procWindow, outOfImage, progress, sampler);
+
+    BOOST_CHECK_SMALL(maxDifference(view(genericImage), view(separableImage)), 1e-4f);
+}
+}
+
+BOOST_AUTO_TEST_CASE(upscale)
+{
+    using namespace terry::sampler;
+    Image srcImage(480, 270);
+    Image dstImage(960, 540);
+    fillRandom(view(srcImage));
+
+    checkSeparable<lanczos3_sampler>(view(srcImage), view(dstImage), eParamFilterOutCopy);
+    checkSeparable<catrom_sampler>(view(srcImage), view(dstImage), eParamFilterOutBlack);
+    checkSeparable<gaussian_sampler>(view(srcImage), view(dstImage), eParamFilterOutTransparency);
+}
+
+BOOST_AUTO_TEST_CASE(downscale)
+{
+    using namespace terry::sampler;
+    Image srcImage(640, 360);
+    Image dstImage(213, 120);
+    fillRandom(view(srcImage));
+
+    checkSeparable(view(srcImage), view(dstImage), eParamFilterOutCopy, 0, lanczos_sampler(6, 1.0));
+    checkSeparable<mitchell_sampler>(view(srcImage), view(dstImage), eParamFilterOutBlack, -40.5);
+}
+
+BOOST_AUTO_TEST_CASE(not_separable)
+{
+    using namespace terry::sampler;
+    const terry::matrix3x2<double> rotation = terry::matrix3x2<double>::get_rotate(0.1);
+    const terry::matrix3x2<double> scale = terry::matrix3x2<double>::get_scale(2.0, 0.5);
+
+    BOOST_CHECK(!is_separable(rotation, eParamFilterOutCopy));
+    BOOST_CHECK(!is_separable(scale, eParamFilterOutMirror));
+    BOOST_CHECK(is_separable(scale, eParamFilterOutCopy));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,50 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+class SetupTimeHandle(tuttle.IProgressHandle):
+	def __init__(self):
+		super(SetupTimeHandle, self).__init__()
+		self.durations = []
+
+	def endSetupAtTime(self, duration):
+		self.durations.append(duration)
+
+
+def computeSequence(options):
+	g = tuttle.Graph()
+	checkerboard = g.createNode("tuttle.checkerboard", format="PAL", explicitConversion="32f")
+	blur = g.createNode("tuttle.blur", size=[4, 4])
+	invert = g.createNode("tuttle.invert")
+	g.connect([checkerboard, blur, invert])
+
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, invert, options)
+	return [outputCache.get(invert.getName(), t).getNumpyArray() for t in range(0, 5)]
+
+
+def testIncrementalSetup():
+	"""
+	Reusing the graph at time of the previous frame gives the same result,
+	and the setup time of each frame is reported to the progress handle.
+	"""
+	fullSetupOptions = tuttle.ComputeOptions(0, 4)
+	fullSetupOptions.setIncrementalSetup(False)
+	fullSetup = computeSequence(fullSetupOptions)
+
+	handle = SetupTimeHandle()
+	incrementalOptions = tuttle.ComputeOptions(0, 4)
+	incrementalOptions.setProgressHandle(handle)
+	incremental = computeSequence(incrementalOptions)
+
+	assert_equal(5, len(handle.durations))
+	for duration in handle.durations:
+		assert duration >= 0
+	for a, b in zip(fullSetup, incremental):
+		assert numpy.array_equal(a, b)
@@ -0,0 +1,51 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+class OutputImagesHandle(tuttle.IOutputHandle):
+	def __init__(self):
+		super(OutputImagesHandle, self).__init__()
+		self.images = []
+
+	def outputImage(self, nodeName, time, image):
+		# keep the image (and its buffer) after the compute
+		self.images.append((nodeName, time, image))
+
+
+def createGraph():
+	g = tuttle.Graph()
+	checkerboard = g.createNode("tuttle.checkerboard", format="PAL", explicitConversion="32f")
+	invert = g.createNode("tuttle.invert")
+	g.connect([checkerboard, invert])
+	return g, invert
+
+
+def testOutputHandle():
+	"""
+	The images of the final node are given to the output handle, in order,
+	without keeping them in the output memory cache.
+	"""
+	g, invert = createGraph()
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, invert, tuttle.ComputeOptions(0, 2))
+	expected = [outputCache.get(invert.getName(), t).getNumpyArray() for t in range(0, 3)]
+
+	g, invert = createGraph()
+	handle = OutputImagesHandle()
+	options = tuttle.ComputeOptions(0, 2)
+	options.setReturnBuffers(False)
+	options.setOutputHandle(handle)
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, invert, options)
+
+	assert_equal(0, outputCache.size())
+	assert_equal([0, 1, 2], [time for (nodeName, time, image) in handle.images])
+	for (nodeName, time, image), e in zip(handle.images, expected):
+		assert_equal(invert.getName(), nodeName)
+		assert numpy.array_equal(e, image.getNumpyArray())
@@ -0,0 +1,74 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+class OutputImagesHandle(tuttle.IOutputHandle):
+	"""
+	Record the images of the final node, in the order they are delivered.
+	"""
+	def __init__(self):
+		super(OutputImagesHandle, self).__init__()
+		self.images = []
+
+	def outputImage(self, nodeName, time, image):
+		self.images.append((time, numpy.array(image.getNumpyArray())))
+
+
+def computeAnimatedBlur(options):
+	"""
+	A different image at each frame, only with fully thread safe nodes (so the frames can be rendered in parallel).
+	"""
+	g = tuttle.Graph()
+	constant = g.createNode("tuttle.constant", format="PAL", explicitConversion="32f")
+	color = constant.getParam("color")
+	color.setValueAtTime(0., [0., 0.2, 1., 1.])
+	color.setValueAtTime(9., [1., 0.8, 0., 1.])
+	blur = g.createNode("tuttle.blur", size=[6, 3])
+	g.connect([constant, blur])
+
+	handle = OutputImagesHandle()
+	options.setOutputHandle(handle)
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, blur, options)
+	return handle.images
+
+
+def testParallelFrames():
+	"""
+	Rendering several frames in parallel gives the same images as the sequential rendering,
+	and the final node receives them in the same order.
+	"""
+	sequential = computeAnimatedBlur(tuttle.ComputeOptions(0, 9))
+
+	parallelOptions = tuttle.ComputeOptions(0, 9)
+	parallelOptions.setNbParallelFrames(4)
+	parallel = computeAnimatedBlur(parallelOptions)
+
+	assert_equal(list(range(0, 10)), [time for (time, image) in sequential])
+	assert_equal([time for (time, image) in sequential], [time for (time, image) in parallel])
+	for (timeA, a), (timeB, b) in zip(sequential, parallel):
+		assert numpy.array_equal(a, b)
+	# the frames are not all the same
+	assert not numpy.array_equal(sequential[0][1], sequential[9][1])
+
+
+def testParallelFramesMemoryBudget():
+	"""
+	With a memory budget smaller than a frame, the frames are rendered one at a time, in order.
+	"""
+	sequential = computeAnimatedBlur(tuttle.ComputeOptions(0, 9))
+
+	budgetOptions = tuttle.ComputeOptions(0, 9)
+	budgetOptions.setNbParallelFrames(4)
+	budgetOptions.setParallelFramesMemoryBudget(1)
+	budget = computeAnimatedBlur(budgetOptions)
+
+	assert_equal([time for (time, image) in sequential], [time for (time, image) in budget])
+	for (timeA, a), (timeB, b) in zip(sequential, budget):
+		assert numpy.array_equal(a, b)
@@ -0,0 +1,94 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+class RenderedNodesHandle(tuttle.IOutputHandle):
+	"""
+	Record the beginning and the end of the process of the final nodes.
+	"""
+	def __init__(self):
+		super(RenderedNodesHandle, self).__init__()
+		self.events = []
+
+	def allocateBuffer(self, nodeName, time, image):
+		self.events.append(("begin", nodeName, time))
+		return None
+
+	def outputImage(self, nodeName, time, image):
+		self.events.append(("end", nodeName, time))
+
+
+def computeMergedBranches(options):
+	g = tuttle.Graph()
+	checkerboard = g.createNode("tuttle.checkerboard", format="PAL", explicitConversion="32f")
+	blurA = g.createNode("tuttle.blur", size=[8, 8])
+	invertA = g.createNode("tuttle.invert")
+	blurB = g.createNode("tuttle.blur", size=[2, 12])
+	constant = g.createNode("tuttle.constant", format="PAL", explicitConversion="32f", color=[0.2, 0.4, 0.6, 1])
+	invertB = g.createNode("tuttle.invert")
+	merge = g.createNode("tuttle.merge", mergingFunction="average").asImageEffectNode()
+	g.connect([checkerboard, blurA, invertA])
+	g.connect([checkerboard, blurB])
+	g.connect([constant, invertB])
+	g.connect(invertA, merge.getClip("A"))
+	g.connect(blurB, merge.getClip("B"))
+	final = g.createNode("tuttle.merge", mergingFunction="multiply").asImageEffectNode()
+	g.connect(merge, final.getClip("A"))
+	g.connect(invertB, final.getClip("B"))
+
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, final, options)
+	return [outputCache.get(final.getName(), t).getNumpyArray() for t in range(0, 3)]
+
+
+def testParallelNodes():
+	"""
+	Rendering the independent branches of a frame in parallel gives the same result
+	as the depth first rendering, with or without a memory budget.
+	"""
+	serial = computeMergedBranches(tuttle.ComputeOptions(0, 2))
+
+	parallelOptions = tuttle.ComputeOptions(0, 2)
+	parallelOptions.setNbParallelNodes(4)
+	parallel = computeMergedBranches(parallelOptions)
+
+	budgetOptions = tuttle.ComputeOptions(0, 2)
+	budgetOptions.setNbParallelNodes(4)
+	budgetOptions.setParallelNodesMemoryBudget(1)
+	budget = computeMergedBranches(budgetOptions)
+
+	for a, b, c in zip(serial, parallel, budget):
+		assert numpy.array_equal(a, b)
+		assert numpy.array_equal(a, c)
+
+
+def testParallelNodesMemoryBudget():
+	"""
+	The independent nodes are rendered one at a time if their output images don't fit in the memory budget.
+	"""
+	g = tuttle.Graph()
+	checkerboard = g.createNode("tuttle.checkerboard", format="PAL", explicitConversion="32f")
+	blurA = g.createNode("tuttle.blur", size=[20, 20])
+	blurB = g.createNode("tuttle.blur", size=[30, 10])
+	g.connect([checkerboard, blurA])
+	g.connect([checkerboard, blurB])
+
+	handle = RenderedNodesHandle()
+	options = tuttle.ComputeOptions(0, 2)
+	options.setNbParallelNodes(4)
+	options.setParallelNodesMemoryBudget(1)
+	options.setOutputHandle(handle)
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, [blurA, blurB], options)
+
+	assert_equal(12, len(handle.events))
+	for begin, end in zip(handle.events[0::2], handle.events[1::2]):
+		assert_equal("begin", begin[0])
+		assert_equal("end", end[0])
+		assert_equal(begin[1:], end[1:])
@@ -0,0 +1,59 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+# not divisible by the number of threads, by the 8 rows chunks of lensdistort,
+# nor by the automatic chunk size of invert (301 / (3 * 8) = 12 rows)
+height = 301
+nbThreadsMulti = 3
+
+
+def computeWithThreads(plugin, nbThreads, **params):
+	g = tuttle.Graph()
+	checkerboard = g.createNode("tuttle.checkerboard", size=[320, height], explicitConversion="32f")
+	node = g.createNode(plugin, **params)
+	g.connect(checkerboard, node)
+
+	options = tuttle.ComputeOptions(0)
+	options.setNbThreads(nbThreads)
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, node, options)
+	return outputCache.get(node.getName(), 0).getNumpyArray()
+
+
+def checkSameAsOneThread(plugin, **params):
+	"""
+	With one thread, the whole render window is processed in one band.
+	"""
+	reference = computeWithThreads(plugin, 1, **params)
+	multiThreaded = computeWithThreads(plugin, nbThreadsMulti, **params)
+
+	assert_equal(reference.shape, multiThreaded.shape)
+	assert numpy.array_equal(reference, multiThreaded)
+
+
+def testDynamicSchedulingAutoChunks():
+	"""
+	Invert uses dynamic scheduling with the automatic chunk size.
+	"""
+	checkSameAsOneThread("tuttle.invert")
+
+
+def testDynamicSchedulingFixedChunks():
+	"""
+	LensDistort uses dynamic scheduling with chunks of 8 rows.
+	"""
+	checkSameAsOneThread("tuttle.lensdistort", coef1=0.2)
+
+
+def testStaticScheduling():
+	"""
+	Blur uses static scheduling, one band of rows per thread.
+	"""
+	checkSameAsOneThread("tuttle.blur", size=[4, 4])
@@ -0,0 +1,34 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def computeBlurredCheckerboard(options):
+	g = tuttle.Graph()
+	checkerboard = g.createNode("tuttle.checkerboard", format="PAL", explicitConversion="32f")
+	blur = g.createNode("tuttle.blur", size=[10, 10])
+	invert = g.createNode("tuttle.invert")
+	g.connect([checkerboard, blur, invert])
+
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, invert, options)
+	return outputCache.get(invert.getName(), 0).getNumpyArray()
+
+
+def testTiledRendering():
+	"""
+	The tiled rendering gives the same result as the full frame rendering.
+	"""
+	fullFrame = computeBlurredCheckerboard(tuttle.ComputeOptions(0))
+
+	tiledOptions = tuttle.ComputeOptions(0)
+	tiledOptions.setTileSize(128, 64)
+	tiled = computeBlurredCheckerboard(tiledOptions)
+
+	assert_equal(fullFrame.shape, tiled.shape)
+	assert numpy.allclose(fullFrame, tiled)
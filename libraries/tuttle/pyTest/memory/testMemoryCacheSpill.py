@@ -0,0 +1,46 @@
+from pyTuttle import tuttle
+import numpy
+import os
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def computeWithInternCache(internCache):
+	g = tuttle.Graph()
+	checkerboard = g.createNode("tuttle.checkerboard", format="PAL", explicitConversion="32f")
+	blur = g.createNode("tuttle.blur", size=[4, 4])
+	constant = g.createNode("tuttle.constant", format="PAL", explicitConversion="32f")
+	invert = g.createNode("tuttle.invert")
+	merge = g.createNode("tuttle.merge").asImageEffectNode()
+	g.connect(checkerboard, blur)
+	g.connect(constant, invert)
+	# the output of a branch waits in the cache during the computation of the other one
+	g.connect(blur, merge.getClip("A"))
+	g.connect(invert, merge.getClip("B"))
+
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, merge, tuttle.ComputeOptions(0), internCache)
+	return outputCache.get(merge.getName(), 0).getNumpyArray()
+
+
+def testMemoryCacheSpill():
+	"""
+	With a too small memory budget, the images waiting for their next usage
+	are spilled to disk and reloaded without changing the result.
+	"""
+	reference = computeWithInternCache(tuttle.MemoryCache())
+
+	internCache = tuttle.MemoryCache()
+	internCache.setMaxMemorySize(1)
+	internCache.setSpillDirectory(os.path.join(".tests", "memoryCacheSpill"))
+	spilled = computeWithInternCache(internCache)
+
+	assert numpy.array_equal(reference, spilled)
+	# the images were really moved to disk and back
+	assert_greater(internCache.getNbSpillWrites(), 0)
+	assert_greater(internCache.getNbReloads(), 0)
+	assert_equal(0, internCache.getNbSpilled())
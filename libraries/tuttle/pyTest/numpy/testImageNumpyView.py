@@ -0,0 +1,59 @@
+from pyTuttle import tuttle
+import gc
+
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def computeImage():
+	g = tuttle.Graph()
+	checkerboard = g.createNode("tuttle.checkerboard", format="PAL", explicitConversion="32f")
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, checkerboard)
+	return outputCache.get(checkerboard.getName(), 0)
+
+
+def testNumpyView():
+	"""
+	The numpy view shares the image buffer, with the same content as the numpy copy.
+	"""
+	image = computeImage()
+	view = image.getNumpyView()
+	bounds = image.getBounds()
+
+	assert_equal((bounds.y2 - bounds.y1, bounds.x2 - bounds.x1, image.getNbComponents()), view.shape)
+	assert_equal(numpy.float32, view.dtype)
+	assert numpy.array_equal(image.getNumpyArray(), view)
+	assert numpy.array_equal(view, numpy.asarray(image))
+
+
+def testNumpyViewWritable():
+	"""
+	The numpy view is read-only, unless it is requested as writable.
+	"""
+	image = computeImage()
+	view = image.getNumpyView()
+	assert_false(view.flags.writeable)
+	assert_raises(ValueError, view.fill, 0)
+
+	writableView = image.getNumpyView(True)
+	writableView[0, 0, :] = 0.5
+	assert numpy.array_equal([0.5] * image.getNbComponents(), view[0, 0, :])
+	assert numpy.array_equal(view, image.getNumpyArray())
+
+
+def testNumpyViewKeepsBuffer():
+	"""
+	The numpy view keeps the image buffer alive.
+	"""
+	image = computeImage()
+	expected = image.getNumpyArray()
+	view = image.getNumpyView()
+	del image
+	gc.collect()
+	assert numpy.array_equal(expected, view)
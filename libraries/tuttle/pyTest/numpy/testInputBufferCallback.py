@@ -1,5 +1,6 @@
 from pyTuttle import tuttle
 import tempfile
+import gc
 
 import numpy
 from PIL import Image
@@ -37,3 +38,47 @@ def testInputBufferCallback():
 	
 	g.compute(w)
 
+
+# A different image per frame, created on each call of the callback
+def getFrameImage(time):
+	img = numpy.zeros((16, 24, 4), numpy.uint8)
+	img[:, :, 0] = int(time)
+	img[:, :, 1] = numpy.arange(24, dtype=numpy.uint8)
+	img[:, :, 2] = numpy.arange(16, dtype=numpy.uint8).reshape(16, 1)
+	img[:, :, 3] = 255
+	return img
+
+
+def getFrame(time):
+	img = getFrameImage(time)
+	return (img.tobytes(), img.shape[1], img.shape[0], img.strides[0])
+
+
+def testInputBufferCallback_zeroCopy():
+	"""
+	The images returned by the callback are used without copy by the output
+	images, and stay valid after the following calls of the callback.
+	"""
+	g = tuttle.Graph()
+
+	ib = g.createInputBuffer()
+	ib.setComponents(tuttle.InputBufferWrapper.ePixelComponentRGBA)
+	ib.setBitDepth(tuttle.InputBufferWrapper.eBitDepthUByte)
+	ib.setOrientation(tuttle.InputBufferWrapper.eImageOrientationFromTopToBottom)
+	ib.setPyCallback(getFrame)
+	ib.setZeroCopy(True)
+
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, ib.getNode(), tuttle.ComputeOptions(0, 3))
+
+	images = [outputCache.get(ib.getNode().getName(), t) for t in range(0, 4)]
+	for t, image in enumerate(images):
+		assert_true(numpy.array_equal(image.getNumpyArray(), getFrameImage(t)))
+
+	# the custom data of the callback is destroyed with the graph,
+	# the images of the cache keep their own buffers
+	del ib
+	del g
+	gc.collect()
+	for t, image in enumerate(images):
+		assert_true(numpy.array_equal(image.getNumpyArray(), getFrameImage(t)))
@@ -47,6 +47,28 @@ def testInputBuffer_generateImageBufferWithNumpy():
 	g.compute( w )
 
 
+def testInputBuffer_zeroCopy():
+	"""
+	Use the numpy buffer as the output image of the InputBuffer node, without copy.
+	"""
+	g = tuttle.Graph()
+
+	ib = g.createInputBuffer()
+	img = numpy.asarray(Image.open('TuttleOFX-data/image/jpeg/MatrixLarge.jpg'))
+	ib.set3DArrayBuffer( img )
+	ib.setOrientation( tuttle.InputBufferWrapper.eImageOrientationFromTopToBottom )
+	ib.setZeroCopy( True )
+
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, ib.getNode() )
+
+	outImg = outputCache.get( ib.getNode().getName(), 0 )
+	outBuffer = outImg.getNumpyArray()
+	# the output image has the same content as the input buffer
+	assert_equal( outBuffer.shape, img.shape )
+	assert_true( numpy.array_equal( outBuffer, img ) )
+
+
 def testInputBuffer_MergeInputBufferNodes():
 	"""
 	Merge an image file (loaded with PIL) with a generated image buffer (created with numpy).
@@ -0,0 +1,49 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+ctlCode = """
+void main(
+		input varying float rIn,
+		input varying float gIn,
+		input varying float bIn,
+		input varying float aIn,
+		output varying float rOut,
+		output varying float gOut,
+		output varying float bOut,
+		output varying float aOut
+	)
+{
+	rOut = 0.6 * rIn + 0.3 * gIn + 0.1 * bIn;
+	gOut = 0.2 * rIn + 0.7 * gIn + 0.1 * bIn;
+	bOut = 0.1 * rIn + 0.1 * gIn + 0.8 * bIn;
+	aOut = aIn;
+}
+"""
+
+
+def ctl(**ctlParams):
+	g = tuttle.Graph()
+	constant = g.createNode("tuttle.constant", format="PAL", explicitConversion="32f", color=[0.2, 0.4, 0.6, 1])
+	c = g.createNode("tuttle.ctl", code=ctlCode, **ctlParams)
+	g.connect([constant, c])
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, c, tuttle.ComputeOptions(0, 1))
+	return [outputCache.get(c.getName(), t).getNumpyArray() for t in range(0, 2)]
+
+
+def testLutMode():
+	"""
+	The transform baked into a LUT gives the same image as the interpreter.
+	"""
+	interpreted = ctl(mode="interpreter")
+	baked = ctl(mode="lut", lutSize=17, lutShaper="linear", lutRangeMin=0.0, lutRangeMax=1.0)
+	for i, b in zip(interpreted, baked):
+		assert_equal(i.shape, b.shape)
+		assert numpy.allclose(i, b, atol=1e-5)
@@ -0,0 +1,36 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+	g = tuttle.Graph()
+	checkerboard = g.createNode( "tuttle.checkerboard", size=[16, 16], format="PAL", explicitConversion="32f" )
+	write = g.createNode( "tuttle.exrwriter", filename=".tests/exrReader/input.exr" )
+	g.connect( [checkerboard, write] )
+	g.compute( write )
+
+
+def readImage(options):
+	g = tuttle.Graph()
+	read = g.createNode( "tuttle.exrreader", filename=".tests/exrReader/input.exr", explicitConversion="32f" )
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, read, options )
+	return outputCache.get(read.getName(), 0).getNumpyArray()
+
+
+def testTiledRead():
+	"""
+	Reading the file by tiles (only the scanlines of each tile) gives the full image.
+	"""
+	fullFrame = readImage( tuttle.ComputeOptions(0) )
+
+	tiledOptions = tuttle.ComputeOptions(0)
+	tiledOptions.setTileSize(128, 64)
+	tiled = readImage( tiledOptions )
+
+	assert_equal( fullFrame.shape, tiled.shape )
+	assert numpy.array_equal( fullFrame, tiled )
@@ -0,0 +1,42 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def writeAndRead(filename, **writerParams):
+	g = tuttle.Graph()
+	checkerboard = g.createNode( "tuttle.checkerboard", size=[16, 16], format="PAL", explicitConversion="32f" )
+	write = g.createNode( "tuttle.exrwriter", filename=filename, **writerParams )
+	g.connect( [checkerboard, write] )
+	g.compute( write )
+
+	g = tuttle.Graph()
+	read = g.createNode( "tuttle.exrreader", filename=filename, explicitConversion="32f" )
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, read )
+	return outputCache.get(read.getName(), 0).getNumpyArray()
+
+
+def testTiledWrite():
+	"""
+	The full resolution level of a tiled file is the same image as a scanline file.
+	"""
+	scanLine = writeAndRead( ".tests/exrWriter/scanLine.exr" )
+
+	for levels in ["oneLevel", "mipmap", "ripmap"]:
+		tiled = writeAndRead( ".tests/exrWriter/tiles-%s.exr" % levels, storage="tiles", tileSize=[32, 16], tileLevels=levels )
+		assert_equal( scanLine.shape, tiled.shape )
+		assert numpy.array_equal( scanLine, tiled )
+
+
+def testHalfWrite():
+	"""
+	The images converted to half float are written.
+	"""
+	image = writeAndRead( ".tests/exrWriter/half.exr", fileBitDepth="16f" )
+	assert_equal( len(image.shape), 3 )
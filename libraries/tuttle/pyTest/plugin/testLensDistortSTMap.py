@@ -0,0 +1,33 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def lensDistort(**lensParams):
+	g = tuttle.Graph()
+	checkerboard = g.createNode("tuttle.checkerboard", format="PAL", explicitConversion="32f")
+	lens = g.createNode("tuttle.lensdistort", **lensParams)
+	g.connect([checkerboard, lens])
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, lens, tuttle.ComputeOptions(0, 1))
+	return [outputCache.get(lens.getName(), t).getNumpyArray() for t in range(0, 2)]
+
+
+def testSTMapWriteAndRead():
+	"""
+	The ST-map written in an EXR file gives the same image as the lens model.
+	"""
+	filename = ".tests/lensDistort/stmap.exr"
+	model = lensDistort(coef1=0.1, stmap="write", stmapFile=filename)
+	# the ST-map baked for the first frame is used for the second one
+	assert numpy.array_equal(model[0], model[1])
+
+	read = lensDistort(stmap="read", stmapFile=filename)
+	for m, r in zip(model, read):
+		assert_equal(m.shape, r.shape)
+		assert numpy.allclose(m, r, atol=1e-4)
@@ -0,0 +1,45 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def noisyImage():
+	numpy.random.seed(0)
+	y, x = numpy.mgrid[0:96, 0:128]
+	img = numpy.empty((96, 128, 4), numpy.float32)
+	for c in range(3):
+		img[:, :, c] = 0.5 + 0.3 * numpy.sin(x * 0.3 + c) * numpy.cos(y * 0.2)
+	img[:, :, 3] = 1.0
+	img[:, :, :3] += numpy.random.normal(0.0, 0.05, (96, 128, 3))
+	return numpy.clip(img, 0.0, 1.0).astype(numpy.float32)
+
+
+def denoise(img, **nlmParams):
+	g = tuttle.Graph()
+	ib = g.createInputBuffer()
+	ib.set3DArrayBuffer(img)
+	nlm = g.createNode("tuttle.nlmdenoiser", **nlmParams)
+	g.connect(ib.getNode(), nlm)
+	outputCache = tuttle.MemoryCache()
+	g.compute(outputCache, nlm)
+	return outputCache.get(nlm.getName(), 0).getNumpyArray()
+
+
+def testIntegralEngine():
+	"""
+	The integral image engine gives the same result as the classic one.
+	"""
+	img = noisyImage()
+	params = dict(redGrainSize=300, greenGrainSize=450, blueGrainSize=600, patchRadius=2, regionRadius=4)
+	classic = denoise(img, engine="classic", **params)
+	integral = denoise(img, engine="integral", **params)
+
+	assert_equal(classic.shape, integral.shape)
+	# the image is denoised
+	assert_false(numpy.array_equal(classic, img))
+	assert numpy.allclose(classic, integral, atol=1e-5)
@@ -0,0 +1,39 @@
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+	# a sequence with a different image at each frame
+	for time in range(0, 6):
+		g = tuttle.Graph()
+		checkerboard = g.createNode( "tuttle.checkerboard", size=[2 + time, 2 + time], format="PAL" )
+		write = g.createNode( "tuttle.pngwriter", filename=".tests/readAhead/input-####.png" )
+		g.connect( [checkerboard, write] )
+		g.compute( write, tuttle.ComputeOptions(time) )
+
+
+def readFrames(options, times):
+	g = tuttle.Graph()
+	read = g.createNode( "tuttle.pngreader", filename=".tests/readAhead/input-####.png", explicitConversion="32f" )
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, read, options )
+	frames = [outputCache.get(read.getName(), time).getNumpyArray() for time in times]
+	return frames, read.getParam("readAheadHits").getIntValue()
+
+
+def testReadAhead():
+	"""
+	The frames read in advance are the same as the frames read one by one.
+	"""
+	sequence, readAheadHits = readFrames( tuttle.ComputeOptions(0, 5), range(0, 6) )
+	# some frames were read in advance by the background threads
+	assert_greater( readAheadHits, 0 )
+
+	for time in range(0, 6):
+		frame = readFrames( tuttle.ComputeOptions(time), [time] )[0][0]
+		assert_equal( frame.shape, sequence[time].shape )
+		assert numpy.array_equal( frame, sequence[time] )
@@ -0,0 +1,30 @@
+from pyTuttle import tuttle
+import os
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def testWriteBehindSequence():
+	"""
+	The images are written in background during a sequence render,
+	but all the files must exist when compute returns.
+	"""
+	outputs = [".tests/writeBehind/output-%04d.%s" % (i, ext) for ext in ("png", "exr") for i in range(0, 8)]
+	for f in outputs:
+		if os.path.exists( f ):
+			os.remove( f )
+
+	g = tuttle.Graph()
+	checker = g.createNode( "tuttle.checkerboard", size=[320,240] )
+	blur = g.createNode( "tuttle.blur", size=[0.03, 0.05] )
+	pngWrite = g.createNode( "tuttle.pngwriter", filename=".tests/writeBehind/output-####.png" )
+	exrWrite = g.createNode( "tuttle.exrwriter", filename=".tests/writeBehind/output-####.exr" )
+
+	g.connect( [checker, blur, pngWrite] )
+	g.connect( blur, exrWrite )
+	assert g.compute( tuttle.ComputeOptions(0, 7) )
+
+	for f in outputs:
+		assert os.path.getsize( f ) > 0
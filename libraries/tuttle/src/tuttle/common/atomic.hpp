@@ -39,6 +39,22 @@ public:
         return _value;
     }
 
+    value_type fetch_add(const T v, const memory_order unused = memory_order_seq_cst)
+    {
+        boost::mutex::scoped_lock locker(_mutex);
+        const T old = _value;
+        _value += v;
+        return old;
+    }
+
+    value_type fetch_sub(const T v, const memory_order unused = memory_order_seq_cst)
+    {
+        boost::mutex::scoped_lock locker(_mutex);
+        const T old = _value;
+        _value -= v;
+        return old;
+    }
+
 private:
     T _value;
     mutable boost::mutex _mutex;
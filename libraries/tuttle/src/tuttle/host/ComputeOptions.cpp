@@ -11,6 +11,10 @@ IProgressHandle::~IProgressHandle()
 {
 }
 
+IOutputHandle::~IOutputHandle()
+{
+}
+
 TimeRange::TimeRange(const OfxRangeD& range, const int step)
     : _begin(static_cast<int>(range.min))
     , _end(static_cast<int>(range.max))
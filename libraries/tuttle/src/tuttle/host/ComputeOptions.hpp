@@ -12,6 +12,7 @@
 
 #include <limits>
 #include <list>
+#include <string>
 
 namespace tuttle
 {
@@ -26,11 +27,52 @@ public:
     virtual void beginSequence() {}
     virtual void beginFrame() {}
     virtual void setupAtTime() {}
+    /// @param duration time spent to setup the frame, in seconds
+    virtual void endSetupAtTime(const double duration) {}
     virtual void processAtTime() {}
     virtual void endFrame() {}
     virtual void endSequence() {}
 };
 
+namespace attribute
+{
+class Image;
+}
+
+/**
+ * @brief Delivery of the images of the final nodes to the application (see ComputeOptions::setOutputHandle).
+ *
+ * It can be called from the process threads.
+ */
+class IOutputHandle
+{
+public:
+    virtual ~IOutputHandle() = 0;
+
+    /**
+     * @brief Memory where the final node @p nodeName renders its image at @p time, instead of the memory pool.
+     * @param image image to allocate (bounds, components, bit depth and getMemorySize()), the rows are contiguous
+     *              and from bottom to top.
+     * @return NULL to let the host allocate the image, otherwise the memory needs to stay valid until releaseBuffer().
+     */
+    virtual void* allocateBuffer(const std::string& nodeName, const OfxTime time, const attribute::Image& image)
+    {
+        return NULL;
+    }
+    /// @brief The host doesn't use anymore the memory returned by allocateBuffer().
+    virtual void releaseBuffer(void* buffer) {}
+
+    /**
+     * @brief The image of the final node @p nodeName at @p time is rendered (in the buffer of allocateBuffer(),
+     * except if the image was reused from the content cache).
+     * The application can keep the image as long as it needs, its buffer is released with the last reference.
+     */
+    virtual void outputImage(const std::string& nodeName, const OfxTime time,
+                             const boost::shared_ptr<attribute::Image>& image)
+    {
+    }
+};
+
 struct TimeRange
 {
     TimeRange()
@@ -109,6 +151,14 @@ public:
         _forceIdentityNodesProcess = other._forceIdentityNodesProcess;
         _returnBuffers = other._returnBuffers;
         _isInteractive = other._isInteractive;
+        _nbParallelFrames = other._nbParallelFrames;
+        _parallelFramesMemoryBudget = other._parallelFramesMemoryBudget;
+        _nbParallelNodes = other._nbParallelNodes;
+        _parallelNodesMemoryBudget = other._parallelNodesMemoryBudget;
+        _nbThreads = other._nbThreads;
+        _tileSize = other._tileSize;
+        _incrementalSetup = other._incrementalSetup;
+        _outputHandle = other._outputHandle;
 
         // don't modify the abort status?
         //_abort.store( false, boost::memory_order_relaxed );
@@ -126,6 +176,13 @@ private:
         setColorEnable(false);
         setIsInteractive(false);
         setForceIdentityNodesProcess(false);
+        setNbParallelFrames(1);
+        setParallelFramesMemoryBudget(0);
+        setNbParallelNodes(1);
+        setParallelNodesMemoryBudget(0);
+        setNbThreads(0);
+        setTileSize(0, 0);
+        setIncrementalSetup(true);
     }
 
 public:
@@ -242,6 +299,99 @@ public:
     }
     bool getForceIdentityNodesProcess() const { return _forceIdentityNodesProcess; }
 
+    /**
+     * @brief Number of frames rendered concurrently.
+     * Each frame in flight has its own graph at time and is processed in a separate thread.
+     * Final nodes (like writers) still receive the frames in order.
+     * It is only used if all nodes of the graph declare a fully safe render,
+     * otherwise frames are rendered one by one.
+     * By default, 1 frame at a time.
+     */
+    This& setNbParallelFrames(const std::size_t v = 1)
+    {
+        _nbParallelFrames = v;
+        return *this;
+    }
+    std::size_t getNbParallelFrames() const { return _nbParallelFrames; }
+
+    /**
+     * @brief Memory budget (in bytes) shared by the frames in flight.
+     * A new frame is started only if its estimated memory usage fits into the budget
+     * (at least one frame is always in flight).
+     * 0 means no limit other than the number of parallel frames.
+     */
+    This& setParallelFramesMemoryBudget(const std::size_t v)
+    {
+        _parallelFramesMemoryBudget = v;
+        return *this;
+    }
+    std::size_t getParallelFramesMemoryBudget() const { return _parallelFramesMemoryBudget; }
+
+    /**
+     * @brief Number of nodes of the same frame processed in parallel.
+     * Independent branches of the graph are dispatched as soon as all their inputs are rendered.
+     * Only used if all the nodes are thread safe and without tiled rendering.
+     * By default, 1 node at a time (depth first order).
+     */
+    This& setNbParallelNodes(const std::size_t v = 1)
+    {
+        _nbParallelNodes = v;
+        return *this;
+    }
+    std::size_t getNbParallelNodes() const { return _nbParallelNodes; }
+
+    /**
+     * @brief Memory budget (in bytes) shared by the output images of the nodes in flight
+     * and the rendered images still waiting for their consumers.
+     * A node is started only if its output image fits into the budget
+     * (at least one node is always in flight).
+     * 0 means no limit other than the number of parallel nodes.
+     */
+    This& setParallelNodesMemoryBudget(const std::size_t v)
+    {
+        _parallelNodesMemoryBudget = v;
+        return *this;
+    }
+    std::size_t getParallelNodesMemoryBudget() const { return _parallelNodesMemoryBudget; }
+
+    /**
+     * @brief Number of threads used to process each node (size of the host thread pool).
+     * 0 means the value of the host Preferences.
+     */
+    This& setNbThreads(const std::size_t v = 0)
+    {
+        _nbThreads = v;
+        return *this;
+    }
+    std::size_t getNbThreads() const { return _nbThreads; }
+
+    /**
+     * @brief Render the nodes supporting tiles tile by tile (size in pixels).
+     * The region of interest of each tile is propagated to the input nodes,
+     * so the memory used by intermediate images depends on the tile size instead of the frame size.
+     * Nodes without tiles support and final nodes are still rendered at once.
+     * A null size disables the tiled rendering (default).
+     */
+    This& setTileSize(const int width, const int height)
+    {
+        _tileSize.x = width;
+        _tileSize.y = height;
+        return *this;
+    }
+    const OfxPointI& getTileSize() const { return _tileSize; }
+
+    /**
+     * @brief Reuse the graph at time of the previous frame when the nodes deployed over time
+     * are the same, shifted in time. Only the per-time informations (RoD, RoI, identity) are computed again.
+     * Enabled by default.
+     */
+    This& setIncrementalSetup(const bool v = true)
+    {
+        _incrementalSetup = v;
+        return *this;
+    }
+    bool getIncrementalSetup() const { return _incrementalSetup; }
+
     /**
      * @brief The application would like to abort the process (from another thread).
      */
@@ -271,6 +421,11 @@ public:
         if(isProgressHandleSet())
             _progressHandle->setupAtTime();
     }
+    void endSetupAtTimeHandle(const double duration) const
+    {
+        if(isProgressHandleSet())
+            _progressHandle->endSetupAtTime(duration);
+    }
     void processAtTimeHandle() const
     {
         if(isProgressHandleSet())
@@ -287,6 +442,13 @@ public:
             _progressHandle->endSequence();
     }
 
+    /**
+     * @brief A handle to receive the images of the final nodes, and to give the memory where they are rendered.
+     * Use it with setReturnBuffers(false) to not keep all the images in the output memory cache.
+     */
+    void setOutputHandle(boost::shared_ptr<IOutputHandle> outputHandle) { _outputHandle = outputHandle; }
+    const boost::shared_ptr<IOutputHandle>& getOutputHandle() const { return _outputHandle; }
+
 private:
     std::list<TimeRange> _timeRanges;
 
@@ -301,9 +463,18 @@ private:
     bool _returnBuffers;
     bool _isInteractive;
 
+    std::size_t _nbParallelFrames;
+    std::size_t _parallelFramesMemoryBudget;
+    std::size_t _nbParallelNodes;
+    std::size_t _parallelNodesMemoryBudget;
+    std::size_t _nbThreads;
+    OfxPointI _tileSize;
+    bool _incrementalSetup;
+
     boost::atomic_bool _abort;
 
     boost::shared_ptr<IProgressHandle> _progressHandle;
+    boost::shared_ptr<IOutputHandle> _outputHandle;
 };
 }
 }
@@ -3,6 +3,7 @@
 %include <boost_shared_ptr.i>
 %include <std_list.i>
 %include <std_string.i>
+%include <tuttle/host/attribute/Image.i>
 
 
 %{
@@ -10,6 +11,7 @@
 %}
 
 %shared_ptr(tuttle::host::IProgressHandle)
+%shared_ptr(tuttle::host::IOutputHandle)
 
 namespace std {
 %template(TimeRangeList) list<tuttle::host::TimeRange>;
@@ -22,6 +24,7 @@ namespace host {
 // if we use ThreadEnv to compute the graph.
 // So we need to use the Python GIL.
 %threadblock IProgressHandle;
+%threadblock IOutputHandle;
 
 // If we throw an exception from the director overload (in Python),
 // we need to convert this Python exception into a C++ exception.
@@ -31,6 +34,7 @@ namespace host {
     }
 }
 %feature("director") IProgressHandle;
+%feature("director") IOutputHandle;
 
 }
 }
@@ -1,4 +1,5 @@
 #include "Core.hpp"
+#include "PluginCacheFile.hpp"
 
 #include <tuttle/host/ofx/OfxhImageEffectPlugin.hpp>
 #include <tuttle/host/memory/MemoryPool.hpp>
@@ -6,23 +7,6 @@
 
 #include <tuttle/common/system/system.hpp>
 
-#include <boost/archive/xml_oarchive.hpp>
-#include <boost/archive/binary_oarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
-#include <boost/archive/xml_iarchive.hpp>
-#include <boost/archive/binary_iarchive.hpp>
-#include <boost/archive/text_iarchive.hpp>
-
-#include <boost/serialization/serialization.hpp>
-#include <boost/serialization/nvp.hpp>
-
-#include <boost/uuid/uuid.hpp>
-#include <boost/uuid/uuid_io.hpp>
-#include <boost/uuid/uuid_generators.hpp>
-
-#include <boost/filesystem/operations.hpp>
-#include <boost/filesystem/convenience.hpp>
-
 #ifdef TUTTLE_HOST_WITH_PYTHON_EXPRESSION
 #include <boost/python.hpp>
 #endif
@@ -50,6 +34,8 @@ Core::Core()
     , _memoryCache(cache)
     , _isPreloaded(false)
     , _formatter(tuttle::common::Formatter::get())
+    , _threadPool(_preferences.getNbThreads())
+    , _contentCache(_preferences.getContentCacheSize())
 {
 #ifdef TUTTLE_HOST_WITH_PYTHON_EXPRESSION
     Py_Initialize();
@@ -59,6 +45,9 @@ Core::Core()
     // register the image effect cache with the global plugin cache
     _pluginCache.registerAPICache(_imageEffectPluginCache);
 
+    pool.setUseHugePages(_preferences.getUseHugePages());
+    cache.setMaxMemorySize(_preferences.getMemoryCacheSize());
+    cache.setSpillDirectory(_preferences.getMemoryCacheSpillPath());
     _memoryPool.updateMemoryAuthorizedWithRAM();
     //	preload();
 }
@@ -71,81 +60,38 @@ void Core::preload(const bool useCache)
 {
     _isPreloaded = true;
 
-    //	typedef boost::archive::binary_oarchive OArchive;
-    //	typedef boost::archive::binary_iarchive IArchive;
-    //	typedef boost::archive::text_oarchive OArchive;
-    //	typedef boost::archive::text_iarchive IArchive;
-    typedef boost::archive::xml_oarchive OArchive;
-    typedef boost::archive::xml_iarchive IArchive;
-
     std::string cacheFile;
     if(useCache)
     {
-        cacheFile = (getPreferences().getTuttleHomePath() / "tuttlePluginCacheSerialize.xml").string();
+        cacheFile = (getPreferences().getTuttleHomePath() / "tuttlePluginCache.bin").string();
 
         TUTTLE_LOG_DEBUG("plugin cache file = " << cacheFile);
 
-        if(boost::filesystem::exists(cacheFile))
+        try
         {
-            try
-            {
-                std::ifstream ifsb(cacheFile.c_str(), std::ios::in);
-                {
-                    TUTTLE_LOG_DEBUG("Read plugins cache.");
-                    IArchive iArchive(ifsb);
-                    iArchive >> BOOST_SERIALIZATION_NVP(_pluginCache);
-                    // Destructor for an archive should be called before the stream is closed. It restores any altered stream
-                    // facets to thier state before the the archive was opened.
-                }
-            }
-            catch(std::exception& e)
-            {
-                TUTTLE_LOG_WARNING("Error when reading plugins cache file (" << e.what() << ").");
-                // Clear the plugins cache to be sure that we don't stay in an unknown state.
-                _pluginCache.clearPluginFiles();
-
-                // As the plugins cache will be declared dirty, the cache file will be recreated.
-            }
+            TUTTLE_LOG_DEBUG("Read plugins cache.");
+            // if the file is missing or from another version, all binaries are new so the cache file will be recreated
+            pluginCacheFile::read(cacheFile, _pluginCache);
+        }
+        catch(std::exception& e)
+        {
+            TUTTLE_LOG_WARNING("Error when reading plugins cache file (" << e.what() << ").");
+            // Clear the plugins cache to be sure that we don't stay in an unknown state.
+            _pluginCache.clearPluginFiles();
+
+            // As the plugins cache will be declared dirty, the cache file will be recreated.
         }
     }
     _pluginCache.scanPluginFiles();
     if(useCache && _pluginCache.isDirty())
     {
-        // generate unique name for writing
-        boost::uuids::random_generator gen;
-        boost::uuids::uuid u = gen();
-        const std::string tmpCacheFile(cacheFile + ".writing." + boost::uuids::to_string(u) + ".xml");
-
-        TUTTLE_LOG_DEBUG("Write plugins cache " << tmpCacheFile);
         try
         {
-            // Serialize into a temporary file
-            {
-                std::ofstream ofsb(tmpCacheFile.c_str(), std::ios::out);
-                {
-                    OArchive oArchive(ofsb);
-                    oArchive << BOOST_SERIALIZATION_NVP(_pluginCache);
-                    // Destructor for an archive should be called before the stream is closed. It restores any altered stream
-                    // facets to thier state before the the archive was opened.
-                }
-            }
-            // Replace the cache file
-            boost::filesystem::rename(tmpCacheFile, cacheFile);
+            pluginCacheFile::write(cacheFile, _pluginCache);
         }
         catch(std::exception& e)
         {
             TUTTLE_LOG_WARNING("Error when writing plugins cache file (" << e.what() << ").");
-            try
-            {
-                // Try to remove the bad temporary cache file.
-                if(boost::filesystem::exists(tmpCacheFile))
-                {
-                    boost::filesystem::remove(tmpCacheFile);
-                }
-            }
-            catch(std::exception& e)
-            {
-            }
         }
     }
 }
@@ -5,9 +5,11 @@
 #include "Preferences.hpp"
 
 #include <tuttle/host/memory/IMemoryCache.hpp>
+#include <tuttle/host/memory/ContentCache.hpp>
 #include <tuttle/host/HostDescriptor.hpp>
 #include <tuttle/host/ofx/OfxhPluginCache.hpp>
 #include <tuttle/host/ofx/OfxhImageEffectPluginCache.hpp>
+#include <tuttle/host/ofx/OfxhThreadPool.hpp>
 
 #include <tuttle/common/patterns/Singleton.hpp>
 #include <tuttle/common/utils/Formatter.hpp>
@@ -40,6 +42,8 @@ private:
     boost::shared_ptr<tuttle::common::Formatter> _formatter;
 
     Preferences _preferences;
+    ofx::OfxhThreadPool _threadPool;
+    memory::ContentCache _contentCache;
 
 public:
     ofx::OfxhPluginCache& getPluginCache() { return _pluginCache; }
@@ -54,13 +58,21 @@ public:
     Preferences& getPreferences() { return _preferences; }
     const Preferences& getPreferences() const { return _preferences; }
 
+    /// @brief Threads used by the OFX MultiThread suite.
+    ofx::OfxhThreadPool& getThreadPool() { return _threadPool; }
+    const ofx::OfxhThreadPool& getThreadPool() const { return _threadPool; }
+
 public:
+    ofx::imageEffect::OfxhImageEffectPluginCache& getImageEffectPluginCache() { return _imageEffectPluginCache; }
     const ofx::imageEffect::OfxhImageEffectPluginCache& getImageEffectPluginCache() const { return _imageEffectPluginCache; }
 
     memory::IMemoryPool& getMemoryPool() { return _memoryPool; }
     const memory::IMemoryPool& getMemoryPool() const { return _memoryPool; }
     memory::IMemoryCache& getMemoryCache() { return _memoryCache; }
     const memory::IMemoryCache& getMemoryCache() const { return _memoryCache; }
+    /// @brief Rendered images shared across frames and computations, addressed by their content hash.
+    memory::ContentCache& getContentCache() { return _contentCache; }
+    const memory::ContentCache& getContentCache() const { return _contentCache; }
 
 public:
     ofx::imageEffect::OfxhImageEffectPlugin* getImageEffectPluginById(const std::string& id, int vermaj = -1,
@@ -23,6 +23,9 @@
 %factory(tuttle::host::Graph::Node& tuttle::host::Graph::createNode, tuttle::host::ImageEffectNode);
 %factory(tuttle::host::Graph::Node& tuttle::host::Graph::addNode, tuttle::host::ImageEffectNode);
 
+// Release the GIL for the whole computation, so other python threads can run meanwhile.
+// The python callbacks (input/output buffers, progress and output handles) take it back themselves.
+%thread tuttle::host::Graph::compute;
 
 %include <tuttle/host/Graph.hpp>
 
@@ -47,14 +47,22 @@ void INode::setProcessData(Data* data)
 void INode::setProcessDataAtTime(DataAtTime* dataAtTime)
 {
     TUTTLE_LOG_TRACE("setProcessDataAtTime \"" << getName() << "\" at " << dataAtTime->_time);
+    boost::mutex::scoped_lock lock(_mutexDataAtTime);
     _dataAtTime[dataAtTime->_time] = dataAtTime;
 }
 
 void INode::clearProcessDataAtTime()
 {
+    boost::mutex::scoped_lock lock(_mutexDataAtTime);
     _dataAtTime.clear();
 }
 
+void INode::clearProcessDataAtTime(const OfxTime time)
+{
+    boost::mutex::scoped_lock lock(_mutexDataAtTime);
+    _dataAtTime.erase(time);
+}
+
 void INode::setBeforeRenderCallback(Callback* cb)
 {
     _beforeRenderCallback = cb;
@@ -88,6 +96,7 @@ const INode::Data& INode::getData() const
 
 bool INode::hasData(const OfxTime time) const
 {
+    boost::mutex::scoped_lock lock(_mutexDataAtTime);
     DataAtTimeMap::const_iterator it = _dataAtTime.find(time);
     return it != _dataAtTime.end();
 }
@@ -95,6 +104,7 @@ bool INode::hasData(const OfxTime time) const
 const INode::DataAtTime& INode::getData(const OfxTime time) const
 {
     // TUTTLE_LOG_TRACE( "- INode::getData(" << time << ") of " << getName() );
+    boost::mutex::scoped_lock lock(_mutexDataAtTime);
     DataAtTimeMap::const_iterator it = _dataAtTime.find(time);
     if(it == _dataAtTime.end())
     {
@@ -119,6 +129,7 @@ INode::DataAtTime& INode::getData(const OfxTime time)
 
 const INode::DataAtTime& INode::getFirstData() const
 {
+    boost::mutex::scoped_lock lock(_mutexDataAtTime);
     DataAtTimeMap::const_iterator it = _dataAtTime.begin();
     if(it == _dataAtTime.end())
     {
@@ -135,6 +146,7 @@ INode::DataAtTime& INode::getFirstData()
 
 const INode::DataAtTime& INode::getLastData() const
 {
+    boost::mutex::scoped_lock lock(_mutexDataAtTime);
     DataAtTimeMap::const_reverse_iterator it = _dataAtTime.rbegin();
     if(it == _dataAtTime.rend())
     {
@@ -8,6 +8,7 @@
 #include <tuttle/host/Callback.hpp>
 
 #include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <iostream>
 #include <string>
@@ -241,11 +242,13 @@ public:
 protected:
     Data* _data;               ///< link to external datas
     DataAtTimeMap _dataAtTime; ///< link to external datas at each time
+    mutable boost::mutex _mutexDataAtTime; ///< multiple frames could be processed concurrently
 
 public:
     void setProcessData(Data* data);
     void setProcessDataAtTime(DataAtTime* dataAtTime);
     void clearProcessDataAtTime();
+    void clearProcessDataAtTime(const OfxTime time);
 
     Data& getData();
     const Data& getData() const;
@@ -8,6 +8,7 @@
 #include <tuttle/host/graph/ProcessEdgeAtTime.hpp>
 #include <tuttle/host/graph/ProcessVertexData.hpp>
 #include <tuttle/host/graph/ProcessVertexAtTimeData.hpp>
+#include <tuttle/host/memory/LinkData.hpp>
 
 #include <tuttle/host/ofx/OfxhUtilities.hpp>
 #include <tuttle/host/ofx/OfxhBinary.hpp>
@@ -25,8 +26,11 @@
 #include <ofxCore.h>
 #include <ofxImageEffect.h>
 
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/foreach.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include <iomanip>
@@ -147,9 +151,40 @@ int ImageEffectNode::abort()
     return 0;
 }
 
+namespace
+{
+/**
+ * @brief Memory of the OFX image memory suite, allocated in the memory pool of the host
+ * (so the plugin buffers are reused and counted with the images).
+ */
+class PoolMemory : public ofx::OfxhMemory
+{
+public:
+    ~PoolMemory() { _ptr = NULL; }
+
+    bool alloc(size_t nBytes)
+    {
+        if(_locked)
+            return false;
+        _data = core().getMemoryPool().allocate(nBytes);
+        _ptr = _data->data();
+        return true;
+    }
+
+    void freeMem()
+    {
+        _data.reset();
+        _ptr = NULL;
+    }
+
+private:
+    memory::IPoolDataPtr _data;
+};
+}
+
 ofx::OfxhMemory* ImageEffectNode::newMemoryInstance(size_t nBytes)
 {
-    ofx::OfxhMemory* instance = new ofx::OfxhMemory();
+    ofx::OfxhMemory* instance = new PoolMemory();
 
     instance->alloc(nBytes);
     return instance;
@@ -819,6 +854,20 @@ void ImageEffectNode::preProcess_infos(const graph::ProcessVertexAtTimeData& vDa
     nodeInfos._memory = std::ceil((rod.x2 - rod.x1) * (rod.y2 - rod.y1) * nbComponents * bitDepth);
 }
 
+namespace
+{
+/**
+ * @brief Memory given by the application for the output image of a final node (see IOutputHandle), or NULL.
+ */
+void* allocateOutputHandleBuffer(const graph::ProcessVertexAtTimeData& vData, const std::string& nodeName,
+                                 const attribute::Image& image)
+{
+    if(!vData._isFinalNode || !vData._nodeData->_outputHandle)
+        return NULL;
+    return vData._nodeData->_outputHandle->allocateBuffer(nodeName, vData._time, image);
+}
+}
+
 void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
 {
     try
@@ -830,10 +879,13 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
         double par = this->getOutputClip().getPixelAspectRatio();
         if(par == 0.0)
             par = 1.0;
-        const OfxRectI renderWindow = {boost::numeric_cast<int>(std::floor(vData._apiImageEffect._renderRoI.x1 / par)),
-                                       boost::numeric_cast<int>(std::floor(vData._apiImageEffect._renderRoI.y1)),
-                                       boost::numeric_cast<int>(std::ceil(vData._apiImageEffect._renderRoI.x2 / par)),
-                                       boost::numeric_cast<int>(std::ceil(vData._apiImageEffect._renderRoI.y2))};
+        // a partial process (tiled rendering) only renders a part of the output image
+        const OfxRectD& renderRoI =
+            vData._tile._isPartial ? vData._tile._renderWindowRoI : vData._apiImageEffect._renderRoI;
+        const OfxRectI renderWindow = {boost::numeric_cast<int>(std::floor(renderRoI.x1 / par)),
+                                       boost::numeric_cast<int>(std::floor(renderRoI.y1)),
+                                       boost::numeric_cast<int>(std::ceil(renderRoI.x2 / par)),
+                                       boost::numeric_cast<int>(std::ceil(renderRoI.y2))};
         //		TUTTLE_LOG_VAR( TUTTLE_INFO, roi );
 
         //		INode::ClipTimesSetMap timesSetMap = this->getFramesNeeded( vData._time );
@@ -879,30 +931,112 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
             allNeededDatas.push_back(imageCache);
         }
 
+        // the plugin may already have the output image in memory (tuttle extension)
+        ofx::imageEffect::OfxhOutputImageBuffer outputBuffer;
+        bool useOutputBuffer = false;
+        bool externalOutput = false; ///< the output image is not in the memory pool
+        if(!vData._contentCacheData && !vData._tile._isPartial &&
+           getOutputImageBufferAction(vData._time, vData._nodeData->_renderScale, outputBuffer))
+        {
+            const OfxRectI& b = outputBuffer._bounds;
+            useOutputBuffer = b.x1 == renderWindow.x1 && b.y1 == renderWindow.y1 && b.x2 == renderWindow.x2 &&
+                              b.y2 == renderWindow.y2;
+            if(!useOutputBuffer)
+                TUTTLE_LOG_DEBUG("[Node Process] The output image buffer of " << quotes(getName())
+                                                                              << " doesn't match the render window.");
+        }
+
         TUTTLE_LOG_INFO("[Node Process] Acquire needed output clip images");
         BOOST_FOREACH(ClipImageMap::value_type& i, _clipImages)
         {
             attribute::ClipImage& clip = dynamic_cast<attribute::ClipImage&>(*(i.second));
-            if(clip.isOutput())
+            if(clip.isOutput() && !vData._tile._isFirst)
+            {
+                // the output image has been allocated by the first partial process
+                memory::CACHE_ELEMENT imageCache(memoryCache.get(clip.getClipIdentifier(), vData._time));
+                if(imageCache.get() == NULL)
+                {
+                    BOOST_THROW_EXCEPTION(exception::Memory() << exception::dev() + "Output attribute " +
+                                                                     quotes(clip.getFullName()) + " at time " +
+                                                                     vData._time + " not in memory cache.");
+                }
+                allNeededDatas.push_back(imageCache);
+            }
+            else if(clip.isOutput())
             {
                 TUTTLE_LOG_INFO("[Node Process] " << vData._apiImageEffect._renderRoI);
+                if(useOutputBuffer)
+                {
+                    // wrap the buffer of the plugin, the rows keep their orientation and their padding
+                    const bool topToBottom = outputBuffer._rowBytes < 0;
+                    const int rowAbsBytes = std::abs(outputBuffer._rowBytes);
+                    const int height = renderWindow.y2 - renderWindow.y1;
+                    char* bufferBegin = static_cast<char*>(outputBuffer._data);
+                    if(topToBottom)
+                        bufferBegin -= static_cast<std::ptrdiff_t>(rowAbsBytes) * (height - 1);
+
+                    memory::CACHE_ELEMENT imageCache(new attribute::Image(
+                        clip, vData._time, vData._apiImageEffect._renderRoI,
+                        topToBottom ? attribute::Image::eImageOrientationFromTopToBottom
+                                    : attribute::Image::eImageOrientationFromBottomToTop,
+                        rowAbsBytes));
+                    boost::function<void()> release;
+                    if(outputBuffer._release != NULL)
+                        release = boost::bind(outputBuffer._release, outputBuffer._releaseCustomData);
+                    imageCache->setPoolData(
+                        new memory::LinkData(bufferBegin, std::size_t(rowAbsBytes) * height, release));
+                    imageCache->addReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost);
+                    memoryCache.put(clip.getClipIdentifier(), vData._time, imageCache);
+
+                    externalOutput = true;
+                    allNeededDatas.push_back(imageCache);
+                    continue;
+                }
                 memory::CACHE_ELEMENT imageCache(new attribute::Image(clip, vData._time, vData._apiImageEffect._renderRoI,
                                                                       attribute::Image::eImageOrientationFromBottomToTop,
                                                                       0));
-                imageCache->setPoolData(core().getMemoryPool().allocate(imageCache->getMemorySize()));
+                if(vData._contentCacheData)
+                {
+                    // the image is already rendered, reuse the buffer of the content cache
+                    imageCache->setPoolData(vData._contentCacheData);
+                }
+                else if(void* buffer = allocateOutputHandleBuffer(vData, getName(), *imageCache))
+                {
+                    // the final node renders directly in the memory of the application
+                    imageCache->setPoolData(new memory::LinkData(
+                        static_cast<char*>(buffer), imageCache->getMemorySize(),
+                        boost::bind(&IOutputHandle::releaseBuffer, vData._nodeData->_outputHandle, buffer)));
+                    externalOutput = true;
+                }
+                else
+                {
+                    imageCache->setPoolData(core().getMemoryPool().allocate(imageCache->getMemorySize()));
+                }
+                // The host keeps a reference during the render, so the image can't be considered
+                // as unused by the memory cache (other frames may be processed concurrently).
+                imageCache->addReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost);
                 memoryCache.put(clip.getClipIdentifier(), vData._time, imageCache);
 
                 allNeededDatas.push_back(imageCache);
             }
         }
 
-        TUTTLE_LOG_TRACE("[Node Process] Plugin Render Action");
+        if(!vData._contentCacheData && !useOutputBuffer)
+        {
+            TUTTLE_LOG_TRACE("[Node Process] Plugin Render Action");
 
-        renderAction(vData._time, vData._apiImageEffect._field, renderWindow, vData._nodeData->_renderScale);
+            const boost::posix_time::ptime renderBegin(boost::posix_time::microsec_clock::local_time());
+            renderAction(vData._time, vData._apiImageEffect._field, renderWindow, vData._nodeData->_renderScale);
+            const boost::posix_time::time_duration renderDuration =
+                boost::posix_time::microsec_clock::local_time() - renderBegin;
+            // used by the memory cache to select the images to evict
+            memoryCache.setRecomputeCost(getOutputClip().getClipIdentifier(), vData._time,
+                                         renderDuration.total_microseconds() * 0.000001);
 
-        TUTTLE_LOG_TRACE("[Node Process] Plugin Render Action - End");
+            TUTTLE_LOG_TRACE("[Node Process] Plugin Render Action - End");
 
-        debugOutputImage(vData._time);
+            debugOutputImage(vData._time);
+        }
 
         // release input images
         BOOST_FOREACH(const graph::ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdgePair,
@@ -929,6 +1063,10 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
             imageCache->releaseReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost);
         }
 
+        // other parts of the output will be rendered by the next partial process
+        if(!vData._tile._isLast)
+            return;
+
         // declare future usages of the output
         BOOST_FOREACH(ClipImageMap::value_type& item, _clipImages)
         {
@@ -945,6 +1083,13 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
                                                                      " not in memory cache (identifier:" +
                                                                      quotes(clip.getClipIdentifier()) + ").");
                 }
+                // an external buffer is not owned by the memory pool, it can't be shared
+                if(vData._hasContentHash && !vData._contentCacheData && !externalOutput)
+                {
+                    // share the rendered image with the next frames and computations
+                    core().getContentCache().put(vData._contentHash, imageCache->getPoolData(),
+                                                 vData._apiImageEffect._renderRoI);
+                }
                 const std::size_t realOutDegree =
                     vData._outDegree - vData._isFinalNode; // final nodes have a connection to the fake output node.
                 TUTTLE_LOG_INFO("[Node Process] Declare future usages: " << clip.getClipIdentifier()
@@ -959,6 +1104,12 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
                     // Add a reference on this node for each future usages
                     imageCache->addReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost, realOutDegree);
                 }
+                // Final nodes keep the render reference for the fake output node,
+                // it is released by the Process visitor once the output is delivered.
+                if(!vData._isFinalNode)
+                {
+                    imageCache->releaseReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost);
+                }
             }
         }
     }
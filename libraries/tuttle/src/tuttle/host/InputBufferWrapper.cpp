@@ -97,6 +97,11 @@ void InputBufferWrapper::setOrientation(const EImageOrientation orientation)
     getNode().getParam("orientation").setValue(toString.find(orientation)->second);
 }
 
+void InputBufferWrapper::setZeroCopy(const bool zeroCopy)
+{
+    getNode().getParam("zeroCopy").setValue(zeroCopy);
+}
+
 void InputBufferWrapper::setRawImageBuffer(void* rawBuffer, const int width, const int height,
                                            const EPixelComponent components, const EBitDepth bitDepth,
                                            const int rowDistanceBytes, const EImageOrientation orientation)
@@ -132,7 +137,7 @@ void InputBufferWrapper::setRawImageBuffer(void* rawBuffer, const int width, con
 //}
 
 void InputBufferWrapper::setCallback(CallbackInputImagePtr callback, CustomDataPtr customData,
-                                     CallbackDestroyCustomDataPtr destroyCustomData)
+                                     CallbackDestroyCustomDataPtr destroyCustomData, CallbackRetainImagePtr retainImage)
 {
     getNode()
         .getParam("callbackPointer")
@@ -143,6 +148,9 @@ void InputBufferWrapper::setCallback(CallbackInputImagePtr callback, CustomDataP
     getNode()
         .getParam("callbackDestroyCustomData")
         .setValue(boost::lexical_cast<std::string>(reinterpret_cast<std::ptrdiff_t>(destroyCustomData)));
+    getNode()
+        .getParam("callbackRetainImage")
+        .setValue(boost::lexical_cast<std::string>(reinterpret_cast<std::ptrdiff_t>(retainImage)));
 }
 }
 }
@@ -50,6 +50,9 @@ public:
     typedef void (*CallbackInputImagePtr)(OfxTime time, CustomDataPtr outputCustomData, void** rawdata, int* width,
                                           int* height, int* rowSizeBytes);
     typedef void (*CallbackDestroyCustomDataPtr)(CustomDataPtr outputCustomData);
+    typedef void (*CallbackReleaseImagePtr)(void* image);
+    /// Keep the image returned by the last call of the input callback, until the returned image is given to outRelease.
+    typedef void* (*CallbackRetainImagePtr)(CustomDataPtr outputCustomData, CallbackReleaseImagePtr* outRelease);
 
 private:
     INode* _node;
@@ -113,6 +116,12 @@ public:
     void setBitDepth(const EBitDepth bitDepth);
     void setRowDistanceSize(const int rowDistanceBytes);
     void setOrientation(const EImageOrientation orientation);
+    /**
+     * @brief Use the image buffer as the output image of the node, without copy.
+     * In buffer mode, the buffer needs to stay valid as long as the output image is used.
+     * In callback mode, the destroy callback is called when the output image is released.
+     */
+    void setZeroCopy(const bool zeroCopy);
 
     void setRawImageBuffer(void* rawBuffer, const int width, const int height, const EPixelComponent components,
                            const EBitDepth bitDepth, const int rowDistanceBytes = 0,
@@ -142,8 +151,13 @@ public:
                           orientation);
     }
 
+    /**
+     * @brief The image of each frame is given by @p callback.
+     * @param destroyCustomData called when the customData is replaced or when the node is destroyed
+     * @param retainImage needed to use the images of the callback without copy (see setZeroCopy)
+     */
     void setCallback(CallbackInputImagePtr callback, CustomDataPtr customData = NULL,
-                     CallbackDestroyCustomDataPtr destroyCustomData = NULL);
+                     CallbackDestroyCustomDataPtr destroyCustomData = NULL, CallbackRetainImagePtr retainImage = NULL);
 };
 }
 }
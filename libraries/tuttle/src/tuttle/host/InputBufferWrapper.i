@@ -70,6 +70,7 @@ import_array();
 		if( ! PyTuple_Check(ret) || PyTuple_Size(ret) != 4 )
 		{
 			TUTTLE_LOG_TRACE( "The python callback doesn't return a tuple with 4 values as expected. Aborting..." );
+			Py_DECREF( ret );
 			*rawdata = NULL;
 			*width = 0;
 			*height = 0;
@@ -89,7 +90,9 @@ import_array();
 		*rowSizeBytes = static_cast<int>( PyInt_AsLong( PyTuple_GetItem(ret, 3) ) );
 //		TUTTLE_LOG_VAR( TUTTLE_TRACE, *rowSizeBytes );
 		
+		// keep the image until the next call
 		customData.setImgObject( ret );
+		Py_DECREF( ret );
 		SWIG_PYTHON_THREAD_END_BLOCK;
 	}
 	
@@ -99,6 +102,24 @@ import_array();
 		delete (Inputbuffer_python_customData*)object;
 	}
 	
+	void inputbuffer_release_image( void* image )
+	{
+		SWIG_PYTHON_THREAD_BEGIN_BLOCK;
+		Py_DECREF( (PyObject*)image );
+		SWIG_PYTHON_THREAD_END_BLOCK;
+	}
+	
+	// The image returned by the last call of the callback is kept by the output image (zero copy).
+	void* inputbuffer_retain_image( void* object, tuttle::host::InputBufferWrapper::CallbackReleaseImagePtr* outRelease )
+	{
+		SWIG_PYTHON_THREAD_BEGIN_BLOCK;
+		Inputbuffer_python_customData& customData = *(Inputbuffer_python_customData*)object;
+		Py_XINCREF( customData._imgObject );
+		*outRelease = customData._imgObject != NULL ? inputbuffer_release_image : NULL;
+		SWIG_PYTHON_THREAD_END_BLOCK;
+		return customData._imgObject;
+	}
+	
 	typedef void *PyFunc;
 %}
 
@@ -118,7 +139,7 @@ import_array();
 			Py_INCREF( (PyObject *)object );
 			Inputbuffer_python_customData* customData = new Inputbuffer_python_customData();
 			customData->_funcObject = (PyObject *)object;
-			$self->setCallback( inputbuffer_python_callback, customData, inputbuffer_destroy_callback );
+			$self->setCallback( inputbuffer_python_callback, customData, inputbuffer_destroy_callback, inputbuffer_retain_image );
 		}
 		else
 		{
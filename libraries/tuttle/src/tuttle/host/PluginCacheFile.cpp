@@ -0,0 +1,139 @@
+#include "PluginCacheFile.hpp"
+
+#include <tuttle/common/utils/global.hpp>
+#include <tuttle/common/exceptions.hpp>
+#include <tuttle/host/serialization.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/version.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <streambuf>
+
+namespace tuttle
+{
+namespace host
+{
+namespace pluginCacheFile
+{
+
+namespace
+{
+
+static const char kMagic[8] = {'T', 'U', 'T', 'T', 'L', 'E', 'P', 'C'};
+
+struct Header
+{
+    char _magic[8];
+    boost::uint32_t _formatVersion;
+    boost::uint32_t _boostVersion; ///< the binary archives are not portable between boost versions
+    boost::uint32_t _pointerSize;
+    boost::uint32_t _cacheVersionSize; ///< the header is followed by the cache version string
+};
+
+/// @brief Read-only stream buffer on a memory area (the mapped file), without copy.
+class MemoryStreamBuf : public std::streambuf
+{
+public:
+    MemoryStreamBuf(const char* data, const std::size_t size)
+    {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+}
+
+bool read(const std::string& filename, ofx::OfxhPluginCache& pluginCache)
+{
+    if(!boost::filesystem::exists(filename) || boost::filesystem::file_size(filename) < sizeof(Header))
+        return false;
+
+    using namespace boost::interprocess;
+    const file_mapping file(filename.c_str(), read_only);
+    const mapped_region region(file, read_only);
+    const char* data = static_cast<const char*>(region.get_address());
+    const std::size_t size = region.get_size();
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    const std::string& cacheVersion = pluginCache.getCacheVersion();
+    const std::size_t offset = sizeof(Header) + header._cacheVersionSize;
+
+    if(std::memcmp(header._magic, kMagic, sizeof(kMagic)) != 0 || header._formatVersion != kFormatVersion ||
+       header._boostVersion != BOOST_VERSION || header._pointerSize != sizeof(void*) ||
+       header._cacheVersionSize != cacheVersion.size() || size < offset ||
+       cacheVersion.compare(0, cacheVersion.size(), data + sizeof(Header), header._cacheVersionSize) != 0)
+    {
+        TUTTLE_LOG_DEBUG("Plugin cache file " << quotes(filename) << " was written by another version.");
+        return false;
+    }
+
+    MemoryStreamBuf buffer(data + offset, size - offset);
+    std::istream is(&buffer);
+    boost::archive::binary_iarchive iArchive(is);
+    iArchive >> pluginCache;
+    return true;
+}
+
+void write(const std::string& filename, const ofx::OfxhPluginCache& pluginCache)
+{
+    // generate unique name for writing
+    boost::uuids::random_generator gen;
+    const boost::uuids::uuid u = gen();
+    const std::string tmpFilename(filename + ".writing." + boost::uuids::to_string(u));
+
+    TUTTLE_LOG_DEBUG("Write plugins cache " << tmpFilename);
+    try
+    {
+        {
+            std::ofstream ofsb(tmpFilename.c_str(), std::ios::out | std::ios::binary);
+
+            const std::string& cacheVersion = pluginCache.getCacheVersion();
+            Header header;
+            std::memcpy(header._magic, kMagic, sizeof(kMagic));
+            header._formatVersion = kFormatVersion;
+            header._boostVersion = BOOST_VERSION;
+            header._pointerSize = sizeof(void*);
+            header._cacheVersionSize = cacheVersion.size();
+            ofsb.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            ofsb.write(cacheVersion.c_str(), cacheVersion.size());
+            {
+                boost::archive::binary_oarchive oArchive(ofsb);
+                oArchive << pluginCache;
+                // Destructor for an archive should be called before the stream is closed. It restores any altered stream
+                // facets to thier state before the the archive was opened.
+            }
+            if(!ofsb)
+            {
+                BOOST_THROW_EXCEPTION(exception::File() << exception::user("Unable to write the plugins cache.")
+                                                        << exception::filename(tmpFilename));
+            }
+        }
+        // Replace the cache file
+        boost::filesystem::rename(tmpFilename, filename);
+    }
+    catch(...)
+    {
+        try
+        {
+            // Try to remove the bad temporary cache file.
+            if(boost::filesystem::exists(tmpFilename))
+                boost::filesystem::remove(tmpFilename);
+        }
+        catch(...)
+        {
+        }
+        throw;
+    }
+}
+}
+}
+}
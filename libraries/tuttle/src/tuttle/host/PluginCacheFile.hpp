@@ -0,0 +1,42 @@
+#ifndef _TUTTLE_HOST_PLUGINCACHEFILE_HPP_
+#define _TUTTLE_HOST_PLUGINCACHEFILE_HPP_
+
+#include <tuttle/host/ofx/OfxhPluginCache.hpp>
+
+#include <string>
+
+namespace tuttle
+{
+namespace host
+{
+
+/**
+ * @brief Binary file of the plugin cache: the descriptors and the parameter definitions of the plugins,
+ *        so the plugin binaries are only loaded when a node is created.
+ *
+ * The file begins with a header (magic, format version, boost version, pointer size and cache version of the
+ * OfxhPluginCache), followed by a boost binary archive of the OfxhPluginCache. The file is memory-mapped to be read.
+ */
+namespace pluginCacheFile
+{
+
+/// @brief Version of the file format, to increment when the header or the serialized classes change.
+static const unsigned int kFormatVersion = 1;
+
+/**
+ * @brief Read the plugin cache from @p filename.
+ * @return false if the file doesn't exist or was written by another version (the cache needs to be rewritten).
+ * @exception std::exception if the archive is corrupted
+ */
+bool read(const std::string& filename, ofx::OfxhPluginCache& pluginCache);
+
+/**
+ * @brief Write the plugin cache into @p filename (through a temporary file, so a concurrent reader never gets a partial
+ * file).
+ */
+void write(const std::string& filename, const ofx::OfxhPluginCache& pluginCache);
+}
+}
+}
+
+#endif
@@ -6,6 +6,8 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
 
+#include <cstdlib>
+
 #ifdef __WINDOWS__
 #include <windows.h>
 #include <shlobj.h>
@@ -22,6 +24,11 @@ namespace host
 Preferences::Preferences()
     : _home(buildTuttleHome())
     , _temp(buildTuttleTemp())
+    , _nbThreads(buildNbThreads())
+    , _contentCacheSize(buildContentCacheSize())
+    , _useHugePages(buildUseHugePages())
+    , _memoryCacheSize(buildMemoryCacheSize())
+    , _memoryCacheSpillPath(buildMemoryCacheSpillPath())
 {
 }
 
@@ -104,6 +111,51 @@ boost::filesystem::path Preferences::buildTuttleTemp() const
     return tuttleTmp;
 }
 
+std::size_t Preferences::buildNbThreads() const
+{
+    const char* env_nb_threads = std::getenv("TUTTLE_NB_THREADS");
+    if(env_nb_threads == NULL)
+        return 0;
+    const int nbThreads = std::atoi(env_nb_threads);
+    return nbThreads > 0 ? nbThreads : 0;
+}
+
+std::size_t Preferences::buildContentCacheSize() const
+{
+    // size in megabytes
+    const char* env_cache_size = std::getenv("TUTTLE_CONTENT_CACHE_SIZE");
+    if(env_cache_size == NULL)
+        return 0;
+    const int cacheSize = std::atoi(env_cache_size);
+    return cacheSize > 0 ? std::size_t(cacheSize) * 1024 * 1024 : 0;
+}
+
+bool Preferences::buildUseHugePages() const
+{
+    const char* env_huge_pages = std::getenv("TUTTLE_HUGE_PAGES");
+    if(env_huge_pages == NULL)
+        return false;
+    return std::atoi(env_huge_pages) != 0;
+}
+
+std::size_t Preferences::buildMemoryCacheSize() const
+{
+    // size in megabytes
+    const char* env_cache_size = std::getenv("TUTTLE_MEMORY_CACHE_SIZE");
+    if(env_cache_size == NULL)
+        return 0;
+    const int cacheSize = std::atoi(env_cache_size);
+    return cacheSize > 0 ? std::size_t(cacheSize) * 1024 * 1024 : 0;
+}
+
+boost::filesystem::path Preferences::buildMemoryCacheSpillPath() const
+{
+    const char* env_spill_path = std::getenv("TUTTLE_MEMORY_CACHE_SPILL_PATH");
+    if(env_spill_path == NULL)
+        return boost::filesystem::path();
+    return boost::filesystem::path(env_spill_path);
+}
+
 boost::filesystem::path Preferences::buildTuttleTestPath() const
 {
     const boost::filesystem::path tuttleTest = boost::filesystem::current_path() / ".tests";
@@ -15,6 +15,11 @@ class Preferences
 private:
     boost::filesystem::path _home;
     boost::filesystem::path _temp;
+    std::size_t _nbThreads;
+    std::size_t _contentCacheSize;
+    bool _useHugePages;
+    std::size_t _memoryCacheSize;
+    boost::filesystem::path _memoryCacheSpillPath;
 
 public:
     Preferences();
@@ -27,9 +32,46 @@ public:
 
     boost::filesystem::path buildTuttleTestPath() const;
 
+    /**
+     * @brief Number of threads used to process each node, 0 means one per CPU.
+     * Defined by the TUTTLE_NB_THREADS environment variable if it exists.
+     */
+    void setNbThreads(const std::size_t nbThreads) { _nbThreads = nbThreads; }
+    std::size_t getNbThreads() const { return _nbThreads; }
+
+    /// @brief Memory budget of the content cache in bytes, 0 disables it (see memory::ContentCache).
+    void setContentCacheSize(const std::size_t size) { _contentCacheSize = size; }
+    std::size_t getContentCacheSize() const { return _contentCacheSize; }
+
+    /**
+     * @brief Back the big image buffers with huge pages (see memory::MemoryPool::setUseHugePages).
+     * Defined by the TUTTLE_HUGE_PAGES environment variable if it exists.
+     */
+    void setUseHugePages(const bool useHugePages) { _useHugePages = useHugePages; }
+    bool getUseHugePages() const { return _useHugePages; }
+
+    /**
+     * @brief Memory budget of the intern memory cache in bytes, 0 means no budget (see memory::MemoryCache).
+     * Defined by the TUTTLE_MEMORY_CACHE_SIZE environment variable (in megabytes) if it exists.
+     */
+    void setMemoryCacheSize(const std::size_t size) { _memoryCacheSize = size; }
+    std::size_t getMemoryCacheSize() const { return _memoryCacheSize; }
+
+    /**
+     * @brief Scratch directory where the intern memory cache spills the evicted images, empty to disable the spill.
+     * Defined by the TUTTLE_MEMORY_CACHE_SPILL_PATH environment variable if it exists.
+     */
+    void setMemoryCacheSpillPath(const boost::filesystem::path& spillPath) { _memoryCacheSpillPath = spillPath; }
+    boost::filesystem::path getMemoryCacheSpillPath() const { return _memoryCacheSpillPath; }
+
 private:
     boost::filesystem::path buildTuttleHome() const;
     boost::filesystem::path buildTuttleTemp() const;
+    std::size_t buildNbThreads() const;
+    std::size_t buildContentCacheSize() const;
+    bool buildUseHugePages() const;
+    std::size_t buildMemoryCacheSize() const;
+    boost::filesystem::path buildMemoryCacheSpillPath() const;
 };
 }
 }
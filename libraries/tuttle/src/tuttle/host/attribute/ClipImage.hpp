@@ -65,6 +65,10 @@ public:
         // TUTTLE_LOG_VAR( TUTTLE_TRACE, getFullName() );
         // TUTTLE_LOG_VAR( TUTTLE_TRACE, other.getFullName() );
 
+        // already connected: don't modify anything, other frames may use this clip concurrently
+        if(_connectedClip == &other && isConnected())
+            return;
+
         _connectedClip = &other;
         setConnected();
 
@@ -12,6 +12,27 @@
 #include <tuttle/host/attribute/Image.hpp>
 %}
 
+#ifndef WITHOUT_NUMPY
+
+%{
+#define SWIG_FILE_WITH_INIT
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+// The numpy views keep a reference on the image buffer.
+static void imagePoolDataCapsuleDestructor( PyObject* capsule )
+{
+	delete static_cast<tuttle::host::memory::IPoolDataPtr*>( PyCapsule_GetPointer( capsule, NULL ) );
+}
+%}
+
+%init
+%{
+import_array();
+%}
+
+#endif
+
 namespace tuttle {
 namespace host {
 namespace attribute {
@@ -28,6 +49,55 @@ namespace attribute {
 
 %extend Image
 {
+#ifndef WITHOUT_NUMPY
+	/**
+	 * @brief Numpy array (height, width, components) on the image buffer, without copy.
+	 * The rows are from top to bottom whatever the buffer orientation, and the row padding is in the strides.
+	 * The array keeps the image buffer alive.
+	 * @param writable the array can modify the image buffer
+	 */
+	PyObject* getNumpyView( const bool writable = false )
+	{
+		SWIG_PYTHON_THREAD_BEGIN_BLOCK;
+		int typenum;
+		switch( self->getBitDepth() )
+		{
+			case tuttle::ofx::imageEffect::eBitDepthUByte:
+				typenum = NPY_UINT8;
+				break;
+			case tuttle::ofx::imageEffect::eBitDepthUShort:
+				typenum = NPY_UINT16;
+				break;
+			case tuttle::ofx::imageEffect::eBitDepthFloat:
+				typenum = NPY_FLOAT32;
+				break;
+			default:
+				PyErr_SetString( PyExc_TypeError, "Unrecognized bit depth" );
+				return NULL;
+		}
+
+		const tuttle::host::attribute::Image::EImageOrientation orientation = tuttle::host::attribute::Image::eImageOrientationFromTopToBottom;
+		const OfxRectI bounds = self->getBounds();
+		const npy_intp pixelBytes = self->getNbComponents() * self->getBitDepthMemorySize();
+		npy_intp dims[3] = { bounds.y2 - bounds.y1, bounds.x2 - bounds.x1, static_cast<npy_intp>( self->getNbComponents() ) };
+		npy_intp strides[3] = { self->getOrientedRowDistanceBytes( orientation ), pixelBytes, static_cast<npy_intp>( self->getBitDepthMemorySize() ) };
+
+		PyObject* array = PyArray_New( &PyArray_Type, 3, dims, typenum, strides, self->getOrientedPixelData( orientation ),
+		                               0, writable ? NPY_ARRAY_WRITEABLE : 0, NULL );
+		if( array == NULL )
+			return NULL;
+
+		PyObject* owner = PyCapsule_New( new tuttle::host::memory::IPoolDataPtr( self->getPoolData() ), NULL, imagePoolDataCapsuleDestructor );
+		if( owner == NULL || PyArray_SetBaseObject( reinterpret_cast<PyArrayObject*>( array ), owner ) < 0 )
+		{
+			Py_DECREF( array );
+			return NULL;
+		}
+		SWIG_PYTHON_THREAD_END_BLOCK;
+		return array;
+	}
+#endif
+
 	%pythoncode
 	{
 		def getImage(self):
@@ -36,7 +106,7 @@ namespace attribute {
 					self.getVoidPixelData(),
 					bounds.x2 - bounds.x1,
 					bounds.y2 - bounds.y1,
-					self.getRowBytes(),
+					self.getRowAbsDistanceBytes(),
 					self.getBitDepth(),
 					self.getComponentsType()
 				)
@@ -44,33 +114,17 @@ namespace attribute {
 #ifndef WITHOUT_NUMPY
 
 		def getNumpyArray(self):
+			"""
+			Copy of the image buffer, in a numpy array (height, width, components).
+			"""
 			import numpy
-			(data, width, height, rowSizeBytes, bitDepth, components) = self.getImage()
-			
-			numpyBitDepth = None
-			if bitDepth == eBitDepthUByte:
-				numpyBitDepth = numpy.uint8
-			elif bitDepth == eBitDepthUShort:
-				numpyBitDepth = numpy.uint16
-			elif bitDepth == eBitDepthFloat:
-				numpyBitDepth = numpy.float32
-			else:
-				raise TypeError('Unrecognized bit depth')
-			
-			bufferSize = rowSizeBytes * height
-			d = cbytearray(data, bufferSize)
-			arraySize = width * height * self.getNbComponents()
-			if rowSizeBytes != (width * self.getNbComponents() * self.getBitDepthMemorySize()):
-				print('rowSizeBytes:', rowSizeBytes)
-				print('width:', width)
-				print('self.getNbComponents():', self.getNbComponents())
-				print('self.getBitDepthMemorySize():', self.getBitDepthMemorySize())
-				raise NotImplementedError('The image padding is unsupported in the pyTuttle binding.')
-
-			flatarray = numpy.frombuffer( d, numpyBitDepth, arraySize )
-
-			nArray = numpy.array( numpy.flipud( numpy.reshape( flatarray, ( height, width, self.getNbComponents() ) ) ) )
-			return nArray
+			return numpy.array( self.getNumpyView() )
+
+		def __array__(self, dtype=None):
+			view = self.getNumpyView()
+			if dtype is None:
+				return view
+			return view.astype( dtype )
 
 		def getNumpyImage(self):
 			from PIL import Image
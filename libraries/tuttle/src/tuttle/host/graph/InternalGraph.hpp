@@ -438,6 +438,11 @@ public:
      */
     std::vector<vertex_descriptor> leafVertices();
 
+    /**
+     * @brief Update the map from vertex keys to descriptors, after a modification of the keys.
+     */
+    void rebuildVertexDescriptorMap();
+
     /**
      * @brief Remove all vertices without connection with vroot.
      */
@@ -446,9 +451,6 @@ public:
     template <typename Vertex, typename Edge>
     friend std::ostream& operator<<(std::ostream& os, const This& g);
 
-private:
-    void rebuildVertexDescriptorMap();
-
 protected:
     GraphContainer _graph;
     boost::unordered_map<VertexKey, vertex_descriptor> _vertexDescriptorMap;
@@ -3,7 +3,23 @@
 #include <tuttle/common/utils/color.hpp>
 #include <tuttle/host/graph/GraphExporter.hpp>
 
+#include <tuttle/host/ImageEffectNode.hpp>
+#include <tuttle/host/Core.hpp>
+
+#include <tuttle/common/ofx/utilities.hpp>
+
 #include <boost/foreach.hpp>
+#include <boost/bind.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <deque>
+#include <map>
+#include <set>
 
 #if(TUTTLE_EXPORT_WITH_TIMER)
 #include <boost/timer/timer.hpp>
@@ -28,6 +44,7 @@ ProcessGraph::ProcessGraph(const ComputeOptions& options, Graph& userGraph, cons
     _procOptions._interactive = _options.getIsInteractive();
     // imageEffect specific...
     _procOptions._renderScale = _options.getRenderScale();
+    _procOptions._outputHandle = _options.getOutputHandle();
 
     updateGraph(userGraph, outputNodes);
 }
@@ -43,7 +60,13 @@ ProcessGraph::VertexAtTime::Key ProcessGraph::getOutputKeyAtTime(const OfxTime t
 
 ProcessGraph::InternalGraphAtTimeImpl::vertex_descriptor ProcessGraph::getOutputVertexAtTime(const OfxTime time)
 {
-    return _renderGraphAtTime.getVertexDescriptor(getOutputKeyAtTime(time));
+    return getOutputVertexAtTime(_renderGraphAtTime, time);
+}
+
+ProcessGraph::InternalGraphAtTimeImpl::vertex_descriptor
+ProcessGraph::getOutputVertexAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time)
+{
+    return renderGraphAtTime.getVertexDescriptor(getOutputKeyAtTime(time));
 }
 
 /**
@@ -236,6 +259,8 @@ void ProcessGraph::updateGraph(Graph& userGraph, const std::list<std::string>& o
     }
 
     relink();
+    _renderGraphAtTime.clear();
+    _setupAtTimeCache = SetupAtTimeCache();
 }
 
 void ProcessGraph::setup()
@@ -294,6 +319,9 @@ void ProcessGraph::setup()
         graph::visitor::Setup3<InternalGraphImpl> setup3Visitor(_renderGraph);
         _renderGraph.depthFirstVisit(setup3Visitor, _renderGraph.getVertexDescriptor(_outputId));
     }
+
+    // the nodes informations have changed
+    _setupAtTimeCache = SetupAtTimeCache();
 }
 
 std::list<TimeRange> ProcessGraph::computeTimeRange()
@@ -341,17 +369,122 @@ void ProcessGraph::setupAtTime(const OfxTime time)
 #if(TUTTLE_EXPORT_WITH_TIMER)
     boost::timer::cpu_timer timer;
 #endif
+    const boost::posix_time::ptime begin(boost::posix_time::microsec_clock::local_time());
+
+    deployTime(time);
+    if(!_options.getIncrementalSetup() || !shiftGraphAtTime(time))
+    {
+        createGraphAtTime(_renderGraphAtTime, time);
+    }
+    const bool identityNodesRemoved = setupGraphAtTime(_renderGraphAtTime, time);
+
+    // Identity nodes removal modifies the graph at time, so the next frame can't reuse it.
+    _setupAtTimeCache._isValid = _options.getIncrementalSetup() && !identityNodesRemoved;
+    _setupAtTimeCache._time = time;
+    _setupAtTimeCache._nbVertices = _renderGraphAtTime.getVertexCount();
+    _setupAtTimeCache._nbEdges = _renderGraphAtTime.getEdgeCount();
+
+    const boost::posix_time::time_duration duration = boost::posix_time::microsec_clock::local_time() - begin;
+    TUTTLE_LOG_TRACE("[Setup at time " << time << "] took: " << duration);
+    _options.endSetupAtTimeHandle(duration.total_microseconds() * 1e-6);
+}
+
+/**
+ * @brief Deploy the nodes over time and create the graph at time (vertices and edges).
+ * No data is linked to the nodes at this step.
+ */
+void ProcessGraph::buildGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time)
+{
+    deployTime(time);
+    createGraphAtTime(renderGraphAtTime, time);
+}
 
+/**
+ * @brief Compute the times needed for each node and each connection to render the output at @p time.
+ */
+void ProcessGraph::deployTime(const OfxTime time)
+{
     TUTTLE_LOG_TRACE("[Setup at time " << time << "] start");
     graph::visitor::DeployTime<InternalGraphImpl> deployTimeVisitor(_renderGraph, time);
     _renderGraph.depthFirstVisit(deployTimeVisitor, _renderGraph.getVertexDescriptor(_outputId));
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
     graph::exportDebugAsDOT("graphProcess_c.dot", _renderGraph);
 #endif
+}
 
+/**
+ * @brief Serialize the times deployed on the nodes and connections, relatively to @p time.
+ * Two times with the same relative topology have the same graph at time, shifted in time.
+ */
+void ProcessGraph::buildRelativeTopology(std::vector<OfxTime>& topology, const OfxTime time) const
+{
+    topology.clear();
+    BOOST_FOREACH(const InternalGraphImpl::vertex_descriptor vd, _renderGraph.getVertices())
+    {
+        const Vertex& v = _renderGraph.instance(vd);
+        topology.push_back(v._data._times.size());
+        BOOST_FOREACH(const OfxTime t, v._data._times)
+        {
+            topology.push_back(t - time);
+        }
+    }
+    BOOST_FOREACH(const InternalGraphImpl::edge_descriptor ed, _renderGraph.getEdges())
+    {
+        const Edge& e = _renderGraph.instance(ed);
+        topology.push_back(e._timesNeeded.size());
+        BOOST_FOREACH(const Edge::TimeMap::value_type& tm, e._timesNeeded)
+        {
+            topology.push_back(tm.first - time);
+            topology.push_back(tm.second.size());
+            BOOST_FOREACH(const OfxTime t, tm.second)
+            {
+                topology.push_back(t - time);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reuse the graph at time of the previous setup if the deployed times are the same, shifted in time.
+ * The vertices and edges are moved to the new time and their per-time datas are reset,
+ * so only the per-time informations need to be computed again.
+ * @return false if the graph at time needs to be created
+ */
+bool ProcessGraph::shiftGraphAtTime(const OfxTime time)
+{
+    std::vector<OfxTime> topology;
+    buildRelativeTopology(topology, time);
+
+    // the graph at time may have been modified by the last process (nodes reused from the content cache)
+    const bool sameTopology = _setupAtTimeCache._isValid && topology == _setupAtTimeCache._topology &&
+                              _renderGraphAtTime.getVertexCount() == _setupAtTimeCache._nbVertices &&
+                              _renderGraphAtTime.getEdgeCount() == _setupAtTimeCache._nbEdges;
+    _setupAtTimeCache._topology.swap(topology);
+    if(!sameTopology)
+        return false;
+
+    TUTTLE_LOG_TRACE("[Setup at time " << time << "] reuse the graph at time " << _setupAtTimeCache._time);
+    const OfxTime offset = time - _setupAtTimeCache._time;
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
+    {
+        _renderGraphAtTime.instance(vd).shiftTime(offset);
+    }
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraphAtTime.getEdges())
+    {
+        _renderGraphAtTime.instance(ed).shiftTime(offset);
+    }
+    _renderGraphAtTime.rebuildVertexDescriptorMap();
+    return true;
+}
+
+/**
+ * @brief Create the graph at time (vertices and edges) from the times deployed on the nodes (see deployTime).
+ */
+void ProcessGraph::createGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time)
+{
     TUTTLE_LOG_TRACE("[Setup at time " << time << "] build render graph");
     // create a new graph with time information
-    _renderGraphAtTime.clear();
+    renderGraphAtTime.clear();
 
     {
         BOOST_FOREACH(InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraph.getVertices())
@@ -360,7 +493,7 @@ void ProcessGraph::setupAtTime(const OfxTime time)
             BOOST_FOREACH(const OfxTime t, v._data._times)
             {
                 TUTTLE_LOG_INFO("[Setup at time " << time << "] add connection from node: " << v << " for time: " << t);
-                _renderGraphAtTime.addVertex(ProcessVertexAtTime(v, t));
+                renderGraphAtTime.addVertex(ProcessVertexAtTime(v, t));
             }
         }
         BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraph.getEdges())
@@ -387,29 +520,39 @@ void ProcessGraph::setupAtTime(const OfxTime time)
 
                     const EdgeAtTime eAtTime(outKey, inKey, e.getInAttrName());
 
-                    _renderGraphAtTime.addEdge(_renderGraphAtTime.getVertexDescriptor(inKey),
-                                               _renderGraphAtTime.getVertexDescriptor(outKey), eAtTime);
+                    renderGraphAtTime.addEdge(renderGraphAtTime.getVertexDescriptor(inKey),
+                                              renderGraphAtTime.getVertexDescriptor(outKey), eAtTime);
                 }
             }
         }
     }
+}
 
-    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime(time);
+/**
+ * @brief Link the graph at time to the nodes and compute the per-time informations (RoD, RoI, identity).
+ * @param beforeIdentityNodesRemoval called before modifying the clips connections to remove identity nodes
+ * @return true if some identity nodes have been removed, so the clips connections are specific to this time
+ */
+bool ProcessGraph::setupGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time,
+                                    const boost::function<void()>& beforeIdentityNodesRemoval)
+{
+    bool identityNodesRemoved = false;
+    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime(renderGraphAtTime, time);
 
     // declare final nodes
     BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed,
-                  boost::out_edges(outputAtTime, _renderGraphAtTime.getGraph()))
+                  boost::out_edges(outputAtTime, renderGraphAtTime.getGraph()))
     {
-        VertexAtTime& v = _renderGraphAtTime.targetInstance(ed);
+        VertexAtTime& v = renderGraphAtTime.targetInstance(ed);
         v.getProcessDataAtTime()._isFinalNode =
             true; /// @todo: this is maybe better to move this into the ProcessData? Doesn't depend on time?
     }
 
     TUTTLE_LOG_INFO("[Setup at time " << time << "] set data at time");
     // give a link to the node on its attached process data
-    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, renderGraphAtTime.getVertices())
     {
-        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        VertexAtTime& v = renderGraphAtTime.instance(vd);
         if(!v.isFake())
         {
             // TUTTLE_LOG_INFO( "setProcessDataAtTime: " << v._name << " id: " << v._id << " at time: " << v._data._time );
@@ -417,10 +560,10 @@ void ProcessGraph::setupAtTime(const OfxTime time)
         }
     }
 
-    bakeGraphInformationToNodes(_renderGraphAtTime);
+    bakeGraphInformationToNodes(renderGraphAtTime);
 
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
-    graph::exportDebugAsDOT("graphProcessAtTime_a.dot", _renderGraphAtTime);
+    graph::exportDebugAsDOT("graphProcessAtTime_a.dot", renderGraphAtTime);
 #endif
 
     if(!_options.getForceIdentityNodesProcess())
@@ -429,45 +572,48 @@ void ProcessGraph::setupAtTime(const OfxTime time)
         // The "Remove identity nodes" step need to be done after preprocess steps, because the RoI need to be computed.
         std::vector<graph::visitor::IdentityNodeConnection<InternalGraphAtTimeImpl> > toRemove;
 
-        graph::visitor::RemoveIdentityNodes<InternalGraphAtTimeImpl> vis(_renderGraphAtTime, toRemove);
-        _renderGraphAtTime.depthFirstVisit(vis, outputAtTime);
+        graph::visitor::RemoveIdentityNodes<InternalGraphAtTimeImpl> vis(renderGraphAtTime, toRemove);
+        renderGraphAtTime.depthFirstVisit(vis, outputAtTime);
         TUTTLE_LOG_TRACE("[Setup at time " << time << "] removing " << toRemove.size() << " nodes");
         if(toRemove.size())
         {
-            graph::visitor::removeIdentityNodes(_renderGraphAtTime, toRemove);
+            if(beforeIdentityNodesRemoval)
+                beforeIdentityNodesRemoval();
+            identityNodesRemoved = true;
+            graph::visitor::removeIdentityNodes(renderGraphAtTime, toRemove);
 
             // Bake graph information again as the connections have changed.
-            bakeGraphInformationToNodes(_renderGraphAtTime);
+            bakeGraphInformationToNodes(renderGraphAtTime);
         }
     }
 
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
-    graph::exportDebugAsDOT("graphProcessAtTime_b.dot", _renderGraphAtTime);
+    graph::exportDebugAsDOT("graphProcessAtTime_b.dot", renderGraphAtTime);
 #endif
 
     {
         TUTTLE_LOG_TRACE("[Setup at time " << time << "] preprocess 1");
-        graph::visitor::PreProcess1<InternalGraphAtTimeImpl> preProcess1Visitor(_renderGraphAtTime);
-        _renderGraphAtTime.depthFirstVisit(preProcess1Visitor, outputAtTime);
+        graph::visitor::PreProcess1<InternalGraphAtTimeImpl> preProcess1Visitor(renderGraphAtTime);
+        renderGraphAtTime.depthFirstVisit(preProcess1Visitor, outputAtTime);
     }
 
     {
         TUTTLE_LOG_TRACE("[Setup at time " << time << "] preprocess 2");
-        graph::visitor::PreProcess2<InternalGraphAtTimeImpl> preProcess2Visitor(_renderGraphAtTime);
-        _renderGraphAtTime.depthFirstVisit(preProcess2Visitor, outputAtTime);
+        graph::visitor::PreProcess2<InternalGraphAtTimeImpl> preProcess2Visitor(renderGraphAtTime);
+        renderGraphAtTime.depthFirstVisit(preProcess2Visitor, outputAtTime);
     }
 
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
-    graph::exportDebugAsDOT("graphProcessAtTime_c.dot", _renderGraphAtTime);
+    graph::exportDebugAsDOT("graphProcessAtTime_c.dot", renderGraphAtTime);
 #endif
 
 /*
 TUTTLE_LOG_INFO( "---------------------------------------- optimize graph" );
-graph::visitor::OptimizeGraph<InternalGraphAtTimeImpl> optimizeGraphVisitor( _renderGraphAtTime );
-_renderGraphAtTime.depthFirstVisit( optimizeGraphVisitor, outputAtTime );
+graph::visitor::OptimizeGraph<InternalGraphAtTimeImpl> optimizeGraphVisitor( renderGraphAtTime );
+renderGraphAtTime.depthFirstVisit( optimizeGraphVisitor, outputAtTime );
 */
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
-    graph::exportDebugAsDOT("graphProcessAtTime_d.dot", _renderGraphAtTime);
+    graph::exportDebugAsDOT("graphProcessAtTime_d.dot", renderGraphAtTime);
 #endif
     /*
     InternalGraphImpl tmpGraph;
@@ -517,6 +663,7 @@ _renderGraph.targetInstance(*oe_it).getProcessDataAtTime()._globalInfos._memory
     graph::exportDebugAsDOT( "graphprocess_e.dot", tmpGraph );
 #endif
     */
+    return identityNodesRemoved;
 }
 
 void ProcessGraph::computeHashAtTime(NodeHashContainer& outNodesHash, const OfxTime time)
@@ -540,45 +687,1158 @@ void ProcessGraph::processAtTime(memory::IMemoryCache& outCache, const OfxTime t
     boost::timer::cpu_timer timer;
 #endif
 
+    processGraphAtTime(_renderGraphAtTime, outCache, time, boost::function<void()>());
+
+    ///@todo clean datas...
+    TUTTLE_LOG_TRACE("[Process at time " << time << "] Clear data at time");
+    // give a link to the node on its attached process data
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
+    {
+        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        if(!v.isFake())
+        {
+            v.getProcessNode().clearProcessDataAtTime();
+        }
+    }
+
+    // clear cache at each frame
+    // @todo: remove
+    _internMemoryCache.clearUnused();
+
+    TUTTLE_LOG_TRACE("[Process at time " << time << "] Memory cache size: " << _internMemoryCache.size());
+    TUTTLE_LOG_TRACE("[Process at time " << time << "] Out cache size: " << outCache.size());
+}
+
+namespace
+{
+
+typedef ProcessGraph::InternalGraphAtTimeImpl InternalGraphAtTimeImpl;
+typedef InternalGraphAtTimeImpl::vertex_descriptor VertexDescriptor;
+typedef InternalGraphAtTimeImpl::edge_descriptor EdgeDescriptor;
+
+/**
+ * @brief Collect the vertices in the order of the process (inputs before outputs).
+ */
+struct ProcessOrder : public boost::default_dfs_visitor
+{
+    ProcessOrder(std::vector<VertexDescriptor>& order)
+        : _order(order)
+    {
+    }
+
+    template <class Graph>
+    void finish_vertex(VertexDescriptor v, Graph& g)
+    {
+        _order.push_back(v);
+    }
+
+    std::vector<VertexDescriptor>& _order;
+};
+
+/**
+ * @brief Can this node be rendered tile by tile?
+ * Final nodes are rendered at once, so writers receive complete images.
+ */
+bool isTiledVertex(const ProcessGraph::VertexAtTime& v)
+{
+    if(v.isFake() || v.getProcessDataAtTime()._isFinalNode)
+        return false;
+    // the output image is reused from the content cache
+    if(v.getProcessDataAtTime()._contentCacheData)
+        return false;
+    const INode& node = v.getProcessNode();
+    if(node.getNodeType() != INode::eNodeTypeImageEffect)
+        return false;
+    return node.asImageEffectNode().supportsTiles();
+}
+
+/**
+ * @brief Split the region of interest of a node into tiles (aligned on pixels).
+ */
+std::vector<OfxRectD> splitIntoTiles(const OfxRectD& roi, const OfxPointI& tileSize, const double par)
+{
+    std::vector<OfxRectD> tiles;
+    const int x1 = boost::numeric_cast<int>(std::floor(roi.x1 / par));
+    const int y1 = boost::numeric_cast<int>(std::floor(roi.y1));
+    const int x2 = boost::numeric_cast<int>(std::ceil(roi.x2 / par));
+    const int y2 = boost::numeric_cast<int>(std::ceil(roi.y2));
+    for(int y = y1; y < y2; y += tileSize.y)
+    {
+        for(int x = x1; x < x2; x += tileSize.x)
+        {
+            OfxRectD tile;
+            tile.x1 = x * par;
+            tile.y1 = y;
+            tile.x2 = std::min(x + tileSize.x, x2) * par;
+            tile.y2 = std::min(y + tileSize.y, y2);
+            tiles.push_back(tuttle::ofx::clamp(tile, roi));
+        }
+    }
+    return tiles;
+}
+
+/**
+ * @brief Render the output of @p boundary tile by tile.
+ *
+ * The output image of @p boundary is allocated once (it is used at once by other nodes),
+ * but the tiled nodes only used by tiled nodes (@p innerTiledVertices) are rendered again for each tile,
+ * with the region of interest needed by this tile.
+ */
+void processTiles(InternalGraphAtTimeImpl& renderGraphAtTime, const VertexDescriptor boundary,
+                  const std::set<VertexDescriptor>& innerTiledVertices,
+                  graph::visitor::Process<InternalGraphAtTimeImpl>& processVisitor, memory::IMemoryCache& internCache,
+                  const OfxPointI& tileSize)
+{
+    // tiled nodes needed by this output, inputs first
+    std::vector<VertexDescriptor> subGraph;
+    {
+        std::set<VertexDescriptor> visited;
+        std::vector<std::pair<VertexDescriptor, bool> > stack;
+        stack.push_back(std::make_pair(boundary, false));
+        while(!stack.empty())
+        {
+            const std::pair<VertexDescriptor, bool> current = stack.back();
+            stack.pop_back();
+            if(current.second)
+            {
+                subGraph.push_back(current.first);
+                continue;
+            }
+            if(!visited.insert(current.first).second)
+                continue;
+            stack.push_back(std::make_pair(current.first, true));
+            BOOST_FOREACH(const EdgeDescriptor ed, renderGraphAtTime.getOutEdges(current.first))
+            {
+                const VertexDescriptor input = renderGraphAtTime.target(ed);
+                if(innerTiledVertices.count(input) && !visited.count(input))
+                    stack.push_back(std::make_pair(input, false));
+            }
+        }
+    }
+    const std::set<VertexDescriptor> subGraphSet(subGraph.begin(), subGraph.end());
+
+    // Images computed outside of the tiles are released by each tile,
+    // so they need a reference per tile instead of a single one.
+    std::vector<std::pair<std::string, OfxTime> > externalInputs;
+    BOOST_FOREACH(const VertexDescriptor vd, subGraph)
+    {
+        BOOST_FOREACH(const EdgeDescriptor ed, renderGraphAtTime.getOutEdges(vd))
+        {
+            const ProcessGraph::VertexAtTime& input = renderGraphAtTime.targetInstance(ed);
+            if(!subGraphSet.count(renderGraphAtTime.target(ed)))
+                externalInputs.push_back(
+                    std::make_pair(input._clipName + "." kOfxOutputAttributeName, input.getProcessDataAtTime()._time));
+        }
+    }
+
+    // backup the informations modified for each tile
+    std::map<VertexDescriptor, ProcessVertexAtTimeData> backup;
+    std::map<VertexDescriptor, std::size_t> nbUsages;
+    BOOST_FOREACH(const VertexDescriptor vd, subGraph)
+    {
+        backup[vd] = renderGraphAtTime.instance(vd).getProcessDataAtTime();
+        // usages of the output inside this tile
+        std::size_t& n = nbUsages[vd];
+        n = 0;
+        BOOST_FOREACH(const EdgeDescriptor ed, renderGraphAtTime.getInEdges(vd))
+        {
+            if(subGraphSet.count(renderGraphAtTime.source(ed)))
+                ++n;
+        }
+    }
+
+    ProcessVertexAtTimeData& boundaryData = renderGraphAtTime.instance(boundary).getProcessDataAtTime();
+    double par = renderGraphAtTime.instance(boundary).getProcessNode().asImageEffectNode().getOutputClip().getPixelAspectRatio();
+    if(par == 0.0)
+        par = 1.0;
+    const std::vector<OfxRectD> tiles = splitIntoTiles(boundaryData._apiImageEffect._renderRoI, tileSize, par);
+    TUTTLE_LOG_TRACE("[Process tiles] " << renderGraphAtTime.instance(boundary).getName() << ": " << tiles.size()
+                                        << " tiles, " << subGraph.size() << " nodes");
+
+    for(std::size_t t = 0; t < tiles.size(); ++t)
+    {
+        // propagate the regions of interest from the output to the inputs
+        std::map<VertexDescriptor, OfxRectD> requestedRoI;
+        requestedRoI[boundary] = tiles[t];
+        BOOST_REVERSE_FOREACH(const VertexDescriptor vd, subGraph)
+        {
+            ProcessGraph::VertexAtTime& v = renderGraphAtTime.instance(vd);
+            ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+            const ProcessVertexAtTimeData& original = backup[vd];
+
+            OfxRectD roi = tuttle::ofx::clamp(requestedRoI[vd], original._apiImageEffect._renderRoD);
+            if(tuttle::ofx::isEmpty(roi))
+                roi = original._apiImageEffect._renderRoI;
+            vData._apiImageEffect._renderRoI = roi;
+            v.getProcessNode().preProcess2_reverse(vData);
+
+            BOOST_FOREACH(const EdgeDescriptor ed, renderGraphAtTime.getOutEdges(vd))
+            {
+                const VertexDescriptor input = renderGraphAtTime.target(ed);
+                if(!subGraphSet.count(input))
+                    continue;
+                const std::string& clipName = renderGraphAtTime.instance(ed).getInAttrName();
+                BOOST_FOREACH(const ProcessVertexAtTimeData::ImageEffect::MapClipImageRod::value_type& inputRoI,
+                              vData._apiImageEffect._inputsRoI)
+                {
+                    if(inputRoI.first->getName() != clipName)
+                        continue;
+                    std::map<VertexDescriptor, OfxRectD>::iterator it = requestedRoI.find(input);
+                    if(it == requestedRoI.end())
+                        requestedRoI[input] = inputRoI.second;
+                    else
+                        it->second = tuttle::ofx::rectUnion(it->second, inputRoI.second);
+                }
+            }
+
+            if(vd == boundary)
+            {
+                // render a part of the complete output image
+                vData._apiImageEffect._renderRoI = original._apiImageEffect._renderRoI;
+                vData._tile._isPartial = true;
+                vData._tile._isFirst = (t == 0);
+                vData._tile._isLast = (t == tiles.size() - 1);
+                vData._tile._renderWindowRoI = roi;
+            }
+            else
+            {
+                // the output image only contains this tile and is only used inside this tile
+                vData._outDegree = nbUsages[vd];
+            }
+        }
+
+        if(t != tiles.size() - 1)
+        {
+            typedef std::pair<std::string, OfxTime> ImageKey;
+            BOOST_FOREACH(const ImageKey& k, externalInputs)
+            {
+                memory::CACHE_ELEMENT img = internCache.get(k.first, k.second);
+                if(img.get())
+                    img->addReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost);
+            }
+        }
+        BOOST_FOREACH(const VertexDescriptor vd, subGraph)
+        {
+            processVisitor.finish_vertex(vd, renderGraphAtTime.getGraph());
+        }
+        // release the images of this tile
+        internCache.clearUnused();
+    }
+
+    BOOST_FOREACH(const VertexDescriptor vd, subGraph)
+    {
+        renderGraphAtTime.instance(vd).getProcessDataAtTime() = backup[vd];
+    }
+}
+}
+
+/**
+ * @brief Process the graph at time with the tiled rendering (see ComputeOptions::setTileSize).
+ * @return false if there is no node to render by tiles.
+ */
+bool ProcessGraph::processGraphAtTimeByTiles(InternalGraphAtTimeImpl& renderGraphAtTime,
+                                             graph::visitor::Process<InternalGraphAtTimeImpl>& processVisitor,
+                                             const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime)
+{
+    std::vector<VertexDescriptor> order;
+    ProcessOrder processOrder(order);
+    renderGraphAtTime.depthFirstVisit(processOrder, outputAtTime);
+
+    std::set<VertexDescriptor> tiledVertices;
+    BOOST_FOREACH(const VertexDescriptor vd, order)
+    {
+        if(isTiledVertex(renderGraphAtTime.instance(vd)))
+            tiledVertices.insert(vd);
+    }
+    if(tiledVertices.empty())
+        return false;
+
+    // Nodes only used by tiled nodes are rendered inside the tiles of their outputs.
+    // The others are rendered tile by tile into a complete image.
+    std::set<VertexDescriptor> innerTiledVertices;
+    BOOST_FOREACH(const VertexDescriptor vd, tiledVertices)
+    {
+        bool isBoundary = false;
+        BOOST_FOREACH(const EdgeDescriptor ed, renderGraphAtTime.getInEdges(vd))
+        {
+            if(!tiledVertices.count(renderGraphAtTime.source(ed)))
+                isBoundary = true;
+        }
+        if(!isBoundary)
+            innerTiledVertices.insert(vd);
+    }
+
+    BOOST_FOREACH(const VertexDescriptor vd, order)
+    {
+        if(!tiledVertices.count(vd))
+            processVisitor.finish_vertex(vd, renderGraphAtTime.getGraph());
+        else if(!innerTiledVertices.count(vd))
+            processTiles(renderGraphAtTime, vd, innerTiledVertices, processVisitor, _internMemoryCache,
+                         _options.getTileSize());
+    }
+    return true;
+}
+
+/**
+ * @brief State shared by the threads rendering the nodes of a graph at time.
+ */
+struct ProcessGraph::ParallelNodes
+{
+    ParallelNodes()
+        : _nbNodesToProcess(0)
+        , _nbNodesInFlight(0)
+        , _memoryInFlight(0)
+        , _hasError(false)
+    {
+    }
+
+    /// @brief Memory used by the output image of a node.
+    static std::size_t getMemory(VertexAtTime& v)
+    {
+        if(v.isFake())
+            return 0;
+        // the local infos are not filled by the preprocess visitors
+        ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+        v.getProcessNode().preProcess_infos(vData, vData._time, vData._localInfos);
+        return vData._localInfos._memory;
+    }
+
+    /// @brief Node of a vertex (NULL for the fake output vertex).
+    static const INode* getNode(const VertexAtTime& v) { return v.isFake() ? NULL : &v.getProcessNode(); }
+
+    /// @brief Can this node render multiple times of the same instance concurrently?
+    static bool isFullySafe(const VertexAtTime& v)
+    {
+        return v.isFake() || v.getProcessNode().asImageEffectNode().getRenderThreadSafety() ==
+                                 kOfxImageEffectRenderFullySafe;
+    }
+
+    /**
+     * @brief Can the process of @p v start now?
+     * The output image must fit into the memory budget (at least one node is always in flight),
+     * and a node which is not fully safe is not rendered twice at the same time.
+     */
+    bool canStart(const VertexDescriptor vd, const VertexAtTime& v, const std::size_t memoryBudget) const
+    {
+        if(_nbNodesInFlight == 0)
+            return true;
+        if(memoryBudget && _memoryInFlight + _memory.find(vd)->second > memoryBudget)
+            return false;
+        if(_nodesInFlight.count(getNode(v)) && !isFullySafe(v))
+            return false;
+        return true;
+    }
+
+    boost::mutex _mutex;
+    boost::condition_variable _cond;
+
+    typedef std::map<VertexDescriptor, std::set<VertexDescriptor> > VertexLinks;
+    VertexLinks _inputs;                                          ///< distinct input nodes of each node
+    VertexLinks _consumers;                                       ///< distinct nodes using the output of each node
+    std::map<VertexDescriptor, std::size_t> _nbPendingInputs;    ///< inputs not rendered yet
+    std::map<VertexDescriptor, std::size_t> _nbPendingConsumers; ///< consumers not rendered yet
+    std::deque<VertexDescriptor> _ready;                          ///< nodes with all their inputs rendered
+    std::map<VertexDescriptor, std::size_t> _memory;             ///< output image size of each node
+    std::map<VertexDescriptor, const INode*> _nodes;
+    std::multiset<const INode*> _nodesInFlight;
+
+    std::size_t _nbNodesToProcess;
+    std::size_t _nbNodesInFlight;
+    std::size_t _memoryInFlight; ///< output images of the nodes in flight and of the nodes waiting for consumers
+
+    bool _hasError;
+    boost::exception_ptr _error;
+};
+
+/**
+ * @brief Nodes which are not thread safe prevent the parallel rendering of the nodes.
+ */
+bool ProcessGraph::canProcessParallelNodes() const
+{
+    BOOST_FOREACH(const NodeMap::value_type& p, _nodes)
+    {
+        const INode& node = *p.second;
+        if(node.getNodeType() != INode::eNodeTypeImageEffect)
+        {
+            TUTTLE_LOG_TRACE("[Process render] Parallel nodes disabled by the node " << quotes(node.getName()) << ".");
+            return false;
+        }
+        const ImageEffectNode& effect = node.asImageEffectNode();
+        if(effect.getRenderThreadSafety() == kOfxImageEffectRenderUnsafe ||
+           effect.getProperties().getIntProperty(kOfxImageEffectInstancePropSequentialRender) != 0)
+        {
+            TUTTLE_LOG_TRACE("[Process render] Parallel nodes disabled by the node "
+                             << quotes(node.getName()) << " (render thread safety: " << effect.getRenderThreadSafety()
+                             << ").");
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Process the graph at time with independent nodes rendered concurrently.
+ *
+ * A node is ready when all its inputs are rendered, and the ready nodes are dispatched
+ * to ComputeOptions::getNbParallelNodes worker threads in the order they become ready.
+ * The output image of a node is counted in ComputeOptions::getParallelNodesMemoryBudget
+ * from the beginning of its process until all its consumers are rendered,
+ * like its host references (see ImageEffectNode::process).
+ * @return false if the nodes can't be processed in parallel.
+ */
+bool ProcessGraph::processGraphAtTimeByParallelNodes(InternalGraphAtTimeImpl& renderGraphAtTime,
+                                                     visitor::Process<InternalGraphAtTimeImpl>& processVisitor,
+                                                     const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime)
+{
+    const std::size_t nbParallelNodes = _options.getNbParallelNodes();
+    if(nbParallelNodes < 2 || !canProcessParallelNodes())
+        return false;
+
+    ParallelNodes state;
+
+    // Only the nodes reachable from the output are processed
+    // (the inputs of the nodes reused from the content cache are disconnected).
+    std::vector<VertexDescriptor> toVisit(1, outputAtTime);
+    while(!toVisit.empty())
+    {
+        const VertexDescriptor vd = toVisit.back();
+        toVisit.pop_back();
+        if(state._inputs.count(vd))
+            continue;
+
+        std::set<VertexDescriptor>& inputs = state._inputs[vd];
+        BOOST_FOREACH(const EdgeDescriptor ed, renderGraphAtTime.getOutEdges(vd))
+        {
+            const VertexDescriptor input = renderGraphAtTime.target(ed);
+            inputs.insert(input);
+            state._consumers[input].insert(vd);
+            toVisit.push_back(input);
+        }
+    }
+    BOOST_FOREACH(const ParallelNodes::VertexLinks::value_type& p, state._inputs)
+    {
+        VertexAtTime& v = renderGraphAtTime.instance(p.first);
+        state._memory[p.first] = ParallelNodes::getMemory(v);
+        state._nodes[p.first] = ParallelNodes::getNode(v);
+        state._nbPendingInputs[p.first] = p.second.size();
+        state._nbPendingConsumers[p.first] = state._consumers[p.first].size();
+        if(p.second.empty())
+            state._ready.push_back(p.first);
+    }
+    state._nbNodesToProcess = state._inputs.size();
+    TUTTLE_LOG_TRACE("[Process render] Render " << state._nbNodesToProcess << " nodes with " << nbParallelNodes
+                                                << " threads.");
+
+    boost::thread_group workers;
+    for(std::size_t i = 0; i < nbParallelNodes; ++i)
+    {
+        workers.create_thread(boost::bind(&ProcessGraph::parallelNodesWorker, this, boost::ref(state),
+                                          boost::ref(renderGraphAtTime), boost::ref(processVisitor)));
+    }
+    workers.join_all();
+
+    if(state._hasError)
+        boost::rethrow_exception(state._error);
+    return true;
+}
+
+void ProcessGraph::parallelNodesWorker(ParallelNodes& state, InternalGraphAtTimeImpl& renderGraphAtTime,
+                                       visitor::Process<InternalGraphAtTimeImpl>& processVisitor)
+{
+    const std::size_t memoryBudget = _options.getParallelNodesMemoryBudget();
+    for(;;)
+    {
+        VertexDescriptor vd;
+        {
+            boost::mutex::scoped_lock lock(state._mutex);
+            std::deque<VertexDescriptor>::iterator itReady = state._ready.end();
+            for(;;)
+            {
+                if(state._hasError || state._nbNodesToProcess == 0)
+                    return;
+                for(itReady = state._ready.begin(); itReady != state._ready.end(); ++itReady)
+                {
+                    if(state.canStart(*itReady, renderGraphAtTime.instance(*itReady), memoryBudget))
+                        break;
+                }
+                if(itReady != state._ready.end())
+                    break;
+                state._cond.wait(lock);
+            }
+            vd = *itReady;
+            state._ready.erase(itReady);
+
+            ++state._nbNodesInFlight;
+            state._memoryInFlight += state._memory[vd];
+            state._nodesInFlight.insert(state._nodes[vd]);
+        }
+
+        try
+        {
+            processVisitor.finish_vertex(vd, renderGraphAtTime.getGraph());
+        }
+        catch(...)
+        {
+            {
+                boost::mutex::scoped_lock lock(state._mutex);
+                if(!state._hasError)
+                    state._error = boost::current_exception();
+                state._hasError = true;
+            }
+            state._cond.notify_all();
+            return;
+        }
+        endNodeInFlight(state, vd);
+    }
+}
+
+/**
+ * @brief Declare the consumers of a rendered node ready if all their inputs are rendered,
+ * and release the memory of the images which are not needed anymore.
+ */
+void ProcessGraph::endNodeInFlight(ParallelNodes& state, const InternalGraphAtTimeImpl::vertex_descriptor vd)
+{
+    {
+        boost::mutex::scoped_lock lock(state._mutex);
+        --state._nbNodesInFlight;
+        --state._nbNodesToProcess;
+        state._nodesInFlight.erase(state._nodesInFlight.find(state._nodes[vd]));
+
+        if(state._nbPendingConsumers[vd] == 0)
+            state._memoryInFlight -= state._memory[vd];
+        BOOST_FOREACH(const VertexDescriptor input, state._inputs[vd])
+        {
+            if(--state._nbPendingConsumers[input] == 0)
+                state._memoryInFlight -= state._memory[input];
+        }
+        BOOST_FOREACH(const VertexDescriptor consumer, state._consumers[vd])
+        {
+            if(--state._nbPendingInputs[consumer] == 0)
+                state._ready.push_back(consumer);
+        }
+    }
+    state._cond.notify_all();
+}
+
+namespace
+{
+
+/**
+ * @brief Can the output image of this node be stored in the content cache?
+ * Final nodes are always processed (writers, buffers returned to the user).
+ */
+bool isContentCachedVertex(const ProcessGraph::VertexAtTime& v)
+{
+    if(v.isFake() || v.getProcessDataAtTime()._isFinalNode)
+        return false;
+    return v.getProcessNode().getNodeType() == INode::eNodeTypeImageEffect;
+}
+
+/**
+ * @brief Add to the global hash of a node the parameters of the output image which are not part of it.
+ */
+std::size_t buildContentHash(const std::size_t globalHash, const ProcessGraph::VertexAtTime& v)
+{
+    const attribute::ClipImage& outputClip = v.getProcessNode().getOutputClip();
+    const OfxPointD& renderScale = v.getProcessDataAtTime()._nodeData->_renderScale;
+
+    std::size_t seed = globalHash;
+    boost::hash_combine(seed, outputClip.getComponentsString());
+    boost::hash_combine(seed, outputClip.getBitDepthString());
+    boost::hash_combine(seed, outputClip.getPixelAspectRatio());
+    boost::hash_combine(seed, renderScale.x);
+    boost::hash_combine(seed, renderScale.y);
+    return seed;
+}
+}
+
+/**
+ * @brief Reuse the output images available in the content cache (see memory::ContentCache).
+ * The nodes found in the cache are not rendered, and their inputs are disconnected,
+ * so the nodes only used by them are not rendered either.
+ */
+void ProcessGraph::fetchFromContentCache(InternalGraphAtTimeImpl& renderGraphAtTime,
+                                         const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime,
+                                         const OfxTime time)
+{
+    typedef InternalGraphAtTimeImpl::vertex_descriptor VertexDescriptor;
+    typedef InternalGraphAtTimeImpl::edge_descriptor EdgeDescriptor;
+
+    memory::ContentCache& contentCache = core().getContentCache();
+
+    NodeHashContainer nodesHash;
+    graph::visitor::ComputeHashAtTime<InternalGraphAtTimeImpl> computeHashVisitor(renderGraphAtTime, nodesHash, time);
+    renderGraphAtTime.depthFirstVisit(computeHashVisitor, outputAtTime);
+
+    // Visit the graph from the output, without going through the nodes found in the cache.
+    std::set<VertexDescriptor> visited;
+    std::vector<VertexDescriptor> toVisit(1, outputAtTime);
+    std::size_t nbReused = 0;
+    while(!toVisit.empty())
+    {
+        const VertexDescriptor vd = toVisit.back();
+        toVisit.pop_back();
+        if(!visited.insert(vd).second)
+            continue;
+
+        VertexAtTime& v = renderGraphAtTime.instance(vd);
+        if(isContentCachedVertex(v))
+        {
+            ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+            vData._hasContentHash = true;
+            vData._contentHash = buildContentHash(nodesHash.getHash(v.getKey()), v);
+
+            memory::ContentCache::Entry entry;
+            if(contentCache.get(vData._contentHash, vData._apiImageEffect._renderRoI, entry))
+            {
+                TUTTLE_LOG_TRACE("[Content cache] reuse " << v.getKey());
+                vData._contentCacheData = entry._data;
+                vData._apiImageEffect._renderRoI = entry._roi;
+
+                // the inputs are not needed anymore by this node
+                BOOST_FOREACH(const EdgeDescriptor ed, renderGraphAtTime.getOutEdges(vd))
+                {
+                    --renderGraphAtTime.targetInstance(ed).getProcessDataAtTime()._outDegree;
+                }
+                vData._inEdges.clear();
+                renderGraphAtTime.clearVertexOutputs(vd);
+                ++nbReused;
+                continue;
+            }
+        }
+        BOOST_FOREACH(const EdgeDescriptor ed, renderGraphAtTime.getOutEdges(vd))
+        {
+            toVisit.push_back(renderGraphAtTime.target(ed));
+        }
+    }
+    TUTTLE_LOG_DEBUG("[Process at time " << time << "] " << nbReused << " node(s) reused from the content cache");
+}
+
+void ProcessGraph::processGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, memory::IMemoryCache& outCache,
+                                      const OfxTime time, const boost::function<void()>& finalNodeGate)
+{
     TUTTLE_LOG_TRACE("[Process at time " << time << "] Output node : " << _renderGraph.getVertex(_outputId).getName());
-    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime(time);
+    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime(renderGraphAtTime, time);
+
+    if(core().getContentCache().isEnabled())
+        fetchFromContentCache(renderGraphAtTime, outputAtTime, time);
 
     // Launch a pass of callbacks on the nodes
-    graph::visitor::BeforeRenderCallbackVisitor<InternalGraphAtTimeImpl> callbackRun(_renderGraphAtTime);
-    _renderGraphAtTime.depthFirstVisit(callbackRun, outputAtTime);
+    graph::visitor::BeforeRenderCallbackVisitor<InternalGraphAtTimeImpl> callbackRun(renderGraphAtTime);
+    renderGraphAtTime.depthFirstVisit(callbackRun, outputAtTime);
 
     // do the process
-    graph::visitor::Process<InternalGraphAtTimeImpl> processVisitor(_renderGraphAtTime, _internMemoryCache);
+    graph::visitor::Process<InternalGraphAtTimeImpl> processVisitor(renderGraphAtTime, _internMemoryCache);
     if(_options.getReturnBuffers())
     {
         // accumulate output nodes buffers into the @p outCache MemoryCache
         processVisitor.setOutputMemoryCache(outCache);
     }
+    processVisitor.setFinalNodeGate(finalNodeGate);
 
-    _renderGraphAtTime.depthFirstVisit(processVisitor, outputAtTime);
+    const OfxPointI& tileSize = _options.getTileSize();
+    const bool tiled = tileSize.x > 0 && tileSize.y > 0 &&
+                       processGraphAtTimeByTiles(renderGraphAtTime, processVisitor, outputAtTime);
+    if(!tiled && !processGraphAtTimeByParallelNodes(renderGraphAtTime, processVisitor, outputAtTime))
+    {
+        renderGraphAtTime.depthFirstVisit(processVisitor, outputAtTime);
+    }
 
     TUTTLE_LOG_TRACE("[Process at time " << time << "] Post process");
-    graph::visitor::PostProcess<InternalGraphAtTimeImpl> postProcessVisitor(_renderGraphAtTime);
-    _renderGraphAtTime.depthFirstVisit(postProcessVisitor, outputAtTime);
+    graph::visitor::PostProcess<InternalGraphAtTimeImpl> postProcessVisitor(renderGraphAtTime);
+    renderGraphAtTime.depthFirstVisit(postProcessVisitor, outputAtTime);
+}
 
-    ///@todo clean datas...
-    TUTTLE_LOG_TRACE("[Process at time " << time << "] Clear data at time");
-    // give a link to the node on its attached process data
-    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
+/**
+ * @brief Remove the links between the nodes and the datas of this graph at time.
+ * Only the times of this graph are removed, other frames may still be in flight.
+ */
+void ProcessGraph::clearGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime)
+{
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, renderGraphAtTime.getVertices())
     {
-        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        VertexAtTime& v = renderGraphAtTime.instance(vd);
         if(!v.isFake())
         {
-            v.getProcessNode().clearProcessDataAtTime();
+            v.getProcessNode().clearProcessDataAtTime(v.getProcessDataAtTime()._time);
         }
     }
+}
 
-    // clear cache at each frame
-    // @todo: remove
-    _internMemoryCache.clearUnused();
+/**
+ * @brief A frame prepared by the main thread and rendered by a worker thread.
+ */
+struct ProcessGraph::FrameInFlight
+{
+    FrameInFlight(const std::size_t index, const OfxTime time)
+        : _index(index)
+        , _time(time)
+        , _memory(0)
+        , _identityNodesRemoved(false)
+    {
+    }
 
-    TUTTLE_LOG_TRACE("[Process at time " << time << "] Memory cache size: " << _internMemoryCache.size());
-    TUTTLE_LOG_TRACE("[Process at time " << time << "] Out cache size: " << outCache.size());
+    std::size_t _index; ///< position of the frame in the sequence
+    OfxTime _time;
+    InternalGraphAtTimeImpl _graph;
+    std::set<VertexAtTime::Key> _keys; ///< all nodes at time used by this frame
+    std::size_t _memory;               ///< estimated memory needed by this frame
+    bool _identityNodesRemoved;        ///< the clips connections are specific to this frame
+};
+
+/**
+ * @brief State shared between the main thread and the threads rendering frames.
+ */
+struct ProcessGraph::ParallelFrames
+{
+    ParallelFrames()
+        : _nextFrameToDeliver(0)
+        , _nbFramesInFlight(0)
+        , _memoryInFlight(0)
+        , _identityNodesRemovedInFlight(false)
+        , _noMoreFrames(false)
+        , _abort(false)
+        , _hasError(false)
+        , _errorFrameIndex(0)
+    {
+    }
+
+    /// @brief Has an error occured on a frame before @p frameIndex?
+    bool errorBefore(const std::size_t frameIndex) const { return _hasError && _errorFrameIndex < frameIndex; }
+
+    boost::mutex _mutex;
+    boost::condition_variable _cond;
+
+    std::deque<boost::shared_ptr<FrameInFlight> > _queue; ///< frames ready to be rendered
+    std::set<std::size_t> _finishedFrames;                 ///< finished frames after _nextFrameToDeliver
+    std::size_t _nextFrameToDeliver;                       ///< all frames before this index are finished
+    std::size_t _nbFramesInFlight;
+    std::size_t _memoryInFlight;
+    std::set<VertexAtTime::Key> _keysInFlight;
+    bool _identityNodesRemovedInFlight;
+    bool _noMoreFrames;
+    bool _abort;
+
+    bool _hasError;
+    std::size_t _errorFrameIndex;
+    boost::exception_ptr _error;
+};
+
+namespace
+{
+/// @brief Thrown inside a frame when it can't be delivered anymore (abort or error on a previous frame).
+struct FrameCancelled
+{
+};
+}
+
+bool ProcessGraph::canProcessParallelFrames() const
+{
+    if(_options.getNbParallelFrames() < 2)
+        return false;
+
+    BOOST_FOREACH(const NodeMap::value_type& p, _nodes)
+    {
+        const INode& node = *p.second;
+        if(node.getNodeType() != INode::eNodeTypeImageEffect)
+        {
+            TUTTLE_LOG_INFO("[Process render] Parallel frames disabled by the node " << quotes(node.getName()) << ".");
+            return false;
+        }
+        const ImageEffectNode& effect = node.asImageEffectNode();
+        if(effect.getRenderThreadSafety() != kOfxImageEffectRenderFullySafe ||
+           effect.getProperties().getIntProperty(kOfxImageEffectInstancePropSequentialRender) != 0)
+        {
+            TUTTLE_LOG_INFO("[Process render] Parallel frames disabled by the node "
+                            << quotes(node.getName()) << " (render thread safety: " << effect.getRenderThreadSafety()
+                            << ").");
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Render multiple frames concurrently.
+ *
+ * The main thread deploys the graph at each time (setup is not thread safe and calls plugin actions),
+ * and a fixed number of worker threads process the frames.
+ * A frame is only started if:
+ *  - the number of frames in flight is lower than ComputeOptions::getNbParallelFrames,
+ *  - none of its nodes at time is already used by a frame in flight (temporal effects),
+ *  - its estimated memory usage fits into ComputeOptions::getParallelFramesMemoryBudget.
+ * Final nodes of a frame are processed only when all previous frames are finished,
+ * so writers receive the frames in order.
+ */
+bool ProcessGraph::processParallelFrames(memory::IMemoryCache& outCache, const std::list<TimeRange>& timeRanges)
+{
+    const std::size_t nbParallelFrames = _options.getNbParallelFrames();
+    const std::size_t memoryBudget = _options.getParallelFramesMemoryBudget();
+    TUTTLE_LOG_INFO("[Process render] Render " << nbParallelFrames << " frames in parallel.");
+
+    ParallelFrames state;
+    boost::thread_group workers;
+    for(std::size_t i = 0; i < nbParallelFrames; ++i)
+    {
+        workers.create_thread(
+            boost::bind(&ProcessGraph::parallelFramesWorker, this, boost::ref(state), boost::ref(outCache)));
+    }
+
+    std::size_t frameIndex = 0;
+    bool stop = false;
+    for(std::list<TimeRange>::const_iterator itRange = timeRanges.begin(); !stop && itRange != timeRanges.end();
+        ++itRange)
+    {
+        const TimeRange& timeRange = *itRange;
+        TUTTLE_LOG_TRACE("[Process render] process timeRange: [" << timeRange._begin << ", " << timeRange._end << ", "
+                                                                 << timeRange._step << "]");
+
+        for(int time = timeRange._begin; !stop && time <= timeRange._end; time += timeRange._step)
+        {
+            boost::shared_ptr<FrameInFlight> frame(new FrameInFlight(frameIndex++, time));
+            {
+                boost::mutex::scoped_lock lock(state._mutex);
+                // Clips connections are shared by all frames,
+                // so a frame without identity nodes can't be setup while they are modified.
+                while((state._nbFramesInFlight >= nbParallelFrames || state._identityNodesRemovedInFlight) &&
+                      !state._hasError && !_options.getAbort())
+                    state._cond.wait(lock);
+                if(state._hasError || _options.getAbort())
+                {
+                    stop = true;
+                    break;
+                }
+            }
+
+            _options.beginFrameHandle();
+            // the process data at time of the nodes is only modified once we know they are not used by another frame
+            bool dataAtTimeOwned = false;
+            try
+            {
+                _options.setupAtTimeHandle();
+#if(TUTTLE_EXPORT_WITH_TIMER)
+                boost::timer::cpu_timer setup_timer;
+#endif
+                // the time waiting for the other frames is not part of the setup duration
+                boost::posix_time::ptime setupBegin(boost::posix_time::microsec_clock::local_time());
+                buildGraphAtTime(frame->_graph, time);
+                boost::posix_time::time_duration setupDuration =
+                    boost::posix_time::microsec_clock::local_time() - setupBegin;
+                BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, frame->_graph.getVertices())
+                {
+                    const VertexAtTime& v = frame->_graph.instance(vd);
+                    if(!v.isFake())
+                        frame->_keys.insert(v.getKey());
+                }
+                bool cancelled = false;
+                {
+                    // The nodes keep a link to the data at each time,
+                    // so the same node at the same time can't be used by 2 frames in flight.
+                    boost::mutex::scoped_lock lock(state._mutex);
+                    for(;;)
+                    {
+                        bool conflict = false;
+                        BOOST_FOREACH(const VertexAtTime::Key& k, frame->_keys)
+                        {
+                            if(state._keysInFlight.count(k))
+                            {
+                                conflict = true;
+                                break;
+                            }
+                        }
+                        cancelled = state._hasError || _options.getAbort();
+                        if(!conflict || cancelled)
+                            break;
+                        state._cond.wait(lock);
+                    }
+                }
+                if(cancelled)
+                {
+                    _options.endFrameHandle();
+                    stop = true;
+                    break;
+                }
+                dataAtTimeOwned = true;
+                setupBegin = boost::posix_time::microsec_clock::local_time();
+                frame->_identityNodesRemoved = setupGraphAtTime(
+                    frame->_graph, time, boost::bind(&ProcessGraph::waitAllFramesInFlight, this, boost::ref(state)));
+                setupDuration += boost::posix_time::microsec_clock::local_time() - setupBegin;
+                _options.endSetupAtTimeHandle(setupDuration.total_microseconds() * 1e-6);
+#if(TUTTLE_EXPORT_WITH_TIMER)
+                TUTTLE_LOG_INFO("[process timer] setup " << boost::timer::format(setup_timer.elapsed()));
+#endif
+
+                BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, frame->_graph.getVertices())
+                {
+                    VertexAtTime& v = frame->_graph.instance(vd);
+                    // skip the fake output node and the nodes unconnected by the identity nodes removal
+                    if(v.isFake() || v.getProcessDataAtTime()._outDegree == 0)
+                        continue;
+                    ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+                    v.getProcessNode().preProcess_infos(vData, vData._time, vData._localInfos);
+                    frame->_memory += vData._localInfos._memory;
+                }
+            }
+            catch(tuttle::exception::FileInSequenceNotExist& e)
+            {
+                e << tuttle::exception::time(time);
+                if(dataAtTimeOwned)
+                    clearGraphAtTime(frame->_graph);
+                if(_options.getContinueOnError() || _options.getContinueOnMissingFile())
+                {
+                    TUTTLE_LOG_WARNING("[Process render] Missing input file at frame " << time << "." << std::endl);
+                    TUTTLE_LOG_DEBUG(tuttle::exception::format_exception_message(e)
+                                     << std::endl
+                                     << tuttle::exception::format_exception_info(e));
+                    frame->_keys.clear();
+                    endFrameInFlight(state, *frame);
+                    continue;
+                }
+                TUTTLE_LOG_ERROR("[Process render] Missing input file at frame " << time << "." << std::endl);
+                setFrameError(state, frame->_index);
+                _options.endFrameHandle();
+                stop = true;
+                break;
+            }
+            catch(::boost::exception& e)
+            {
+                e << tuttle::exception::time(time);
+                if(dataAtTimeOwned)
+                    clearGraphAtTime(frame->_graph);
+                if(_options.getContinueOnError())
+                {
+                    TUTTLE_LOG_ERROR("[Process render] Skip frame " << time << "." << std::endl);
+                    TUTTLE_LOG_DEBUG(tuttle::exception::format_exception_message(e)
+                                     << std::endl
+                                     << tuttle::exception::format_exception_info(e));
+                    frame->_keys.clear();
+                    endFrameInFlight(state, *frame);
+                    continue;
+                }
+                TUTTLE_LOG_ERROR("[Process render] Stopped at frame " << time << "." << std::endl);
+                setFrameError(state, frame->_index);
+                _options.endFrameHandle();
+                stop = true;
+                break;
+            }
+            catch(...)
+            {
+                if(dataAtTimeOwned)
+                    clearGraphAtTime(frame->_graph);
+                if(_options.getContinueOnError())
+                {
+                    TUTTLE_LOG_ERROR("[Process render] Skip frame " << time << "." << std::endl
+                                                                    << tuttle::exception::format_current_exception());
+                    frame->_keys.clear();
+                    endFrameInFlight(state, *frame);
+                    continue;
+                }
+                TUTTLE_LOG_ERROR("[Process render] Error at frame " << time << "." << std::endl);
+                setFrameError(state, frame->_index);
+                _options.endFrameHandle();
+                stop = true;
+                break;
+            }
+
+            {
+                boost::mutex::scoped_lock lock(state._mutex);
+                // at least one frame is always in flight, even if it doesn't fit into the memory budget
+                while(memoryBudget && state._nbFramesInFlight &&
+                      state._memoryInFlight + frame->_memory > memoryBudget && !state._hasError &&
+                      !_options.getAbort())
+                    state._cond.wait(lock);
+
+                state._keysInFlight.insert(frame->_keys.begin(), frame->_keys.end());
+                state._memoryInFlight += frame->_memory;
+                state._identityNodesRemovedInFlight = state._identityNodesRemovedInFlight || frame->_identityNodesRemoved;
+                ++state._nbFramesInFlight;
+                state._queue.push_back(frame);
+            }
+            state._cond.notify_all();
+        }
+    }
+
+    const bool aborted = _options.getAbort();
+    {
+        boost::mutex::scoped_lock lock(state._mutex);
+        state._noMoreFrames = true;
+        state._abort = aborted;
+    }
+    state._cond.notify_all();
+    workers.join_all();
+
+    if(state._hasError)
+    {
+        endSequence();
+        _internMemoryCache.clearUnused();
+        boost::rethrow_exception(state._error);
+    }
+    if(aborted)
+    {
+        TUTTLE_LOG_ERROR("[Process render] PROCESS ABORTED.");
+        endSequence();
+        _internMemoryCache.clearUnused();
+        return false;
+    }
+
+    // End range of frames
+    endSequence();
+    TUTTLE_LOG_DEBUG("[Process render] thread pool: " << core().getThreadPool().getStatistics());
+    TUTTLE_LOG_DEBUG("[Process render] content cache: " << core().getContentCache().getStatistics());
+    return true;
+}
+
+void ProcessGraph::parallelFramesWorker(ParallelFrames& state, memory::IMemoryCache& outCache)
+{
+    for(;;)
+    {
+        boost::shared_ptr<FrameInFlight> frame;
+        {
+            boost::mutex::scoped_lock lock(state._mutex);
+            while(state._queue.empty() && !state._noMoreFrames)
+                state._cond.wait(lock);
+            if(state._queue.empty())
+                return;
+            frame = state._queue.front();
+            state._queue.pop_front();
+        }
+        processFrameInFlight(state, *frame, outCache);
+        clearGraphAtTime(frame->_graph);
+        endFrameInFlight(state, *frame);
+    }
+}
+
+void ProcessGraph::processFrameInFlight(ParallelFrames& state, FrameInFlight& frame, memory::IMemoryCache& outCache)
+{
+    const OfxTime time = frame._time;
+    try
+    {
+        _options.processAtTimeHandle();
+#if(TUTTLE_EXPORT_WITH_TIMER)
+        boost::timer::cpu_timer processAtTime_timer;
+#endif
+        processGraphAtTime(frame._graph, outCache, time,
+                           boost::bind(&ProcessGraph::waitFrameDelivery, this, boost::ref(state), frame._index));
+#if(TUTTLE_EXPORT_WITH_TIMER)
+        TUTTLE_LOG_INFO("[process timer] took " << boost::timer::format(processAtTime_timer.elapsed()));
+#endif
+    }
+    catch(FrameCancelled&)
+    {
+        TUTTLE_LOG_TRACE("[Process render] Frame " << time << " cancelled.");
+    }
+    catch(tuttle::exception::FileInSequenceNotExist& e)
+    {
+        e << tuttle::exception::time(time);
+        if(_options.getContinueOnError() || _options.getContinueOnMissingFile())
+        {
+            TUTTLE_LOG_WARNING("[Process render] Missing input file at frame " << time << "." << std::endl);
+            TUTTLE_LOG_DEBUG(tuttle::exception::format_exception_message(e)
+                             << std::endl
+                             << tuttle::exception::format_exception_info(e));
+        }
+        else
+        {
+            TUTTLE_LOG_ERROR("[Process render] Missing input file at frame " << time << "." << std::endl);
+            setFrameError(state, frame._index);
+        }
+    }
+    catch(::boost::exception& e)
+    {
+        e << tuttle::exception::time(time);
+        if(_options.getContinueOnError())
+        {
+            TUTTLE_LOG_ERROR("[Process render] Skip frame " << time << "." << std::endl);
+            TUTTLE_LOG_DEBUG(tuttle::exception::format_exception_message(e)
+                             << std::endl
+                             << tuttle::exception::format_exception_info(e));
+        }
+        else
+        {
+            TUTTLE_LOG_ERROR("[Process render] Stopped at frame " << time << "." << std::endl);
+            setFrameError(state, frame._index);
+        }
+    }
+    catch(...)
+    {
+        if(_options.getContinueOnError())
+        {
+            TUTTLE_LOG_ERROR("[Process render] Skip frame " << time << "." << std::endl
+                                                            << tuttle::exception::format_current_exception());
+        }
+        else
+        {
+            TUTTLE_LOG_ERROR("[Process render] Error at frame " << time << "." << std::endl);
+            setFrameError(state, frame._index);
+        }
+    }
+}
+
+/**
+ * @brief Called before the process of final nodes, wait until all previous frames are finished.
+ */
+void ProcessGraph::waitFrameDelivery(ParallelFrames& state, const std::size_t frameIndex)
+{
+    boost::mutex::scoped_lock lock(state._mutex);
+    while(state._nextFrameToDeliver < frameIndex && !state._abort && !state.errorBefore(frameIndex) &&
+          !_options.getAbort())
+        state._cond.wait(lock);
+    if(state._abort || state.errorBefore(frameIndex) || _options.getAbort())
+        throw FrameCancelled();
+}
+
+/**
+ * @brief Wait until no frame is in flight (before modifying the clips connections).
+ */
+void ProcessGraph::waitAllFramesInFlight(ParallelFrames& state)
+{
+    boost::mutex::scoped_lock lock(state._mutex);
+    while(state._nbFramesInFlight)
+        state._cond.wait(lock);
+}
+
+/**
+ * @brief Keep the first error in the frames order. Must be called inside a catch block.
+ */
+void ProcessGraph::setFrameError(ParallelFrames& state, const std::size_t frameIndex)
+{
+    {
+        boost::mutex::scoped_lock lock(state._mutex);
+        if(!state._hasError || frameIndex < state._errorFrameIndex)
+        {
+            state._error = boost::current_exception();
+            state._errorFrameIndex = frameIndex;
+        }
+        state._hasError = true;
+    }
+    state._cond.notify_all();
+}
+
+void ProcessGraph::endFrameInFlight(ParallelFrames& state, FrameInFlight& frame)
+{
+    _internMemoryCache.clearUnused();
+    {
+        boost::mutex::scoped_lock lock(state._mutex);
+        if(!frame._keys.empty())
+        {
+            BOOST_FOREACH(const VertexAtTime::Key& k, frame._keys)
+            {
+                state._keysInFlight.erase(k);
+            }
+            state._memoryInFlight -= frame._memory;
+            if(frame._identityNodesRemoved)
+                state._identityNodesRemovedInFlight = false;
+            --state._nbFramesInFlight;
+        }
+        state._finishedFrames.insert(frame._index);
+        while(!state._finishedFrames.empty() && *state._finishedFrames.begin() == state._nextFrameToDeliver)
+        {
+            state._finishedFrames.erase(state._finishedFrames.begin());
+            ++state._nextFrameToDeliver;
+        }
+    }
+    state._cond.notify_all();
+    _options.endFrameHandle();
 }
 
 bool ProcessGraph::process(memory::IMemoryCache& outCache)
@@ -602,6 +1862,10 @@ bool ProcessGraph::process(memory::IMemoryCache& outCache)
     /// @todo Bug: need to use a map 'OutputNode': 'timeRanges'
     /// And check if all Output nodes share a common timeRange
 
+    // threads used by the plugins to process each node
+    const std::size_t nbThreads = _options.getNbThreads();
+    core().getThreadPool().setNbThreads(nbThreads ? nbThreads : core().getPreferences().getNbThreads());
+
     TUTTLE_LOG_INFO("[Process render] start");
 
     // Begin range of frames
@@ -616,6 +1880,9 @@ bool ProcessGraph::process(memory::IMemoryCache& outCache)
     TUTTLE_LOG_TRACE("[Process render] begin timeRange: [" << globalTimeRange._begin << ", " << globalTimeRange._end << "]");
     beginSequence(globalTimeRange);
 
+    if(canProcessParallelFrames())
+        return processParallelFrames(outCache, timeRanges);
+
     // RENDER (at each frame)
     BOOST_FOREACH(const TimeRange& timeRange, timeRanges)
     {
@@ -726,6 +1993,8 @@ bool ProcessGraph::process(memory::IMemoryCache& outCache)
 
     // End range of frames
     endSequence();
+    TUTTLE_LOG_DEBUG("[Process render] thread pool: " << core().getThreadPool().getStatistics());
+    TUTTLE_LOG_DEBUG("[Process render] content cache: " << core().getContentCache().getStatistics());
 
 #if(TUTTLE_EXPORT_WITH_TIMER)
     TUTTLE_LOG_INFO("[all process timer] " << boost::timer::format(all_process_timer.elapsed()));
@@ -11,7 +11,10 @@
 #include <tuttle/host/Graph.hpp>
 #include <tuttle/host/NodeHashContainer.hpp>
 
+#include <boost/function.hpp>
+
 #include <string>
+#include <vector>
 
 /**
  * @brief If there is a define PROCESSGRAPH_USE_LINK, we don't create a copy of all nodes and
@@ -25,6 +28,11 @@ namespace host
 {
 namespace graph
 {
+namespace visitor
+{
+template <class TGraph>
+class Process;
+}
 
 /**
  * @brief Created from a user Graph, this class allows you to launch the process.
@@ -59,10 +67,65 @@ public:
 private:
     VertexAtTime::Key getOutputKeyAtTime(const OfxTime time);
     InternalGraphAtTimeImpl::vertex_descriptor getOutputVertexAtTime(const OfxTime time);
+    InternalGraphAtTimeImpl::vertex_descriptor getOutputVertexAtTime(InternalGraphAtTimeImpl& renderGraphAtTime,
+                                                                     const OfxTime time);
 
     void relink();
     void bakeGraphInformationToNodes(InternalGraphAtTimeImpl& renderGraphAtTime);
 
+    /// @brief Steps of setupAtTime/processAtTime on a specific graph at time.
+    /// @{
+    void buildGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time);
+    void deployTime(const OfxTime time);
+    void createGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time);
+    bool setupGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time,
+                          const boost::function<void()>& beforeIdentityNodesRemoval = boost::function<void()>());
+    void processGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, memory::IMemoryCache& outCache,
+                            const OfxTime time, const boost::function<void()>& finalNodeGate);
+    void clearGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime);
+    /// @}
+
+    void fetchFromContentCache(InternalGraphAtTimeImpl& renderGraphAtTime,
+                               const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime, const OfxTime time);
+
+    /// @brief Incremental setup (see ComputeOptions::setIncrementalSetup)
+    /// @{
+    void buildRelativeTopology(std::vector<OfxTime>& topology, const OfxTime time) const;
+    bool shiftGraphAtTime(const OfxTime time);
+    /// @}
+
+    bool processGraphAtTimeByTiles(InternalGraphAtTimeImpl& renderGraphAtTime,
+                                   visitor::Process<InternalGraphAtTimeImpl>& processVisitor,
+                                   const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime);
+
+    /// @brief Parallel rendering of independent nodes inside a frame (see ComputeOptions::setNbParallelNodes)
+    /// @{
+    struct ParallelNodes;
+
+    bool canProcessParallelNodes() const;
+    bool processGraphAtTimeByParallelNodes(InternalGraphAtTimeImpl& renderGraphAtTime,
+                                           visitor::Process<InternalGraphAtTimeImpl>& processVisitor,
+                                           const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime);
+    void parallelNodesWorker(ParallelNodes& state, InternalGraphAtTimeImpl& renderGraphAtTime,
+                             visitor::Process<InternalGraphAtTimeImpl>& processVisitor);
+    void endNodeInFlight(ParallelNodes& state, const InternalGraphAtTimeImpl::vertex_descriptor vd);
+    /// @}
+
+    /// @brief Frame-parallel rendering (see ComputeOptions::setNbParallelFrames)
+    /// @{
+    struct FrameInFlight;
+    struct ParallelFrames;
+
+    bool canProcessParallelFrames() const;
+    bool processParallelFrames(memory::IMemoryCache& outCache, const std::list<TimeRange>& timeRanges);
+    void parallelFramesWorker(ParallelFrames& state, memory::IMemoryCache& outCache);
+    void processFrameInFlight(ParallelFrames& state, FrameInFlight& frame, memory::IMemoryCache& outCache);
+    void waitFrameDelivery(ParallelFrames& state, const std::size_t frameIndex);
+    void waitAllFramesInFlight(ParallelFrames& state);
+    void setFrameError(ParallelFrames& state, const std::size_t frameIndex);
+    void endFrameInFlight(ParallelFrames& state, FrameInFlight& frame);
+    /// @}
+
 public:
     void updateGraph(Graph& userGraph, const std::list<std::string>& outputNodes);
 
@@ -88,6 +151,23 @@ private:
     const ComputeOptions& _options;
     memory::IMemoryCache& _internMemoryCache;
     ProcessVertexData _procOptions;
+
+    /// @brief Informations on the last setup of _renderGraphAtTime, to reuse it for the next frame.
+    struct SetupAtTimeCache
+    {
+        SetupAtTimeCache()
+            : _isValid(false)
+            , _time(0)
+            , _nbVertices(0)
+            , _nbEdges(0)
+        {
+        }
+        bool _isValid;                   ///< the graph at time is not specific to its time
+        OfxTime _time;                   ///< time of the graph at time
+        std::vector<OfxTime> _topology;  ///< see buildRelativeTopology
+        std::size_t _nbVertices;
+        std::size_t _nbEdges;
+    } _setupAtTimeCache;
 };
 }
 }
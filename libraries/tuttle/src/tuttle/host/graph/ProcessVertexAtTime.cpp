@@ -32,6 +32,13 @@ ProcessVertexAtTime::ProcessVertexAtTime(const ProcessVertexAtTime& other)
 {
 }
 
+void ProcessVertexAtTime::shiftTime(const OfxTime offset)
+{
+    const OfxTime t = _data._time + offset;
+    _data = ProcessVertexAtTimeData(*_data._nodeData, t);
+    _name = _clipName + "_at_" + boost::lexical_cast<std::string>(t);
+}
+
 ProcessVertexAtTime::~ProcessVertexAtTime()
 {
 }
@@ -38,6 +38,12 @@ public:
 
     Key getKey() const { return Key(_clipName, _data._time); }
 
+    /**
+     * @brief Move the vertex to another time.
+     * The per-time datas are reset.
+     */
+    void shiftTime(const OfxTime offset);
+
     const ProcessVertexData& getProcessData() const { return *_data._nodeData; }
     ProcessVertexAtTimeData& getProcessDataAtTime() { return _data; }
     const ProcessVertexAtTimeData& getProcessDataAtTime() const { return _data; }
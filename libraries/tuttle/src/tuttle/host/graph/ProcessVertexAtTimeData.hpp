@@ -53,6 +53,8 @@ public:
         , _isFinalNode(false)
         , _outDegree(0)
         , _inDegree(0)
+        , _hasContentHash(false)
+        , _contentHash(0)
     {
         _localInfos._nodes = 1; // local infos can contain only 1 node by definition...
     }
@@ -63,6 +65,8 @@ public:
         , _isFinalNode(false)
         , _outDegree(0)
         , _inDegree(0)
+        , _hasContentHash(false)
+        , _contentHash(0)
     {
         _localInfos._nodes = 1; // local infos can contain only 1 node by definition...
     }
@@ -87,6 +91,11 @@ public:
         _globalInfos = v._globalInfos;
 
         _apiImageEffect = v._apiImageEffect;
+        _tile = v._tile;
+
+        _hasContentHash = v._hasContentHash;
+        _contentHash = v._contentHash;
+        _contentCacheData = v._contentCacheData;
 
         return *this;
     }
@@ -138,6 +147,36 @@ public:
 
     } _apiImageEffect;
     /// @}
+
+    /**
+     * @brief Tiled rendering (see ComputeOptions::setTileSize)
+     * A partial process only renders a part of the output image,
+     * which is allocated by the first process and declared to the next nodes by the last one.
+     */
+    struct Tile
+    {
+        Tile()
+            : _isPartial(false)
+            , _isFirst(true)
+            , _isLast(true)
+        {
+            _renderWindowRoI.x1 = _renderWindowRoI.y1 = _renderWindowRoI.x2 = _renderWindowRoI.y2 = 0;
+        }
+        bool _isPartial;
+        bool _isFirst;
+        bool _isLast;
+        OfxRectD _renderWindowRoI; ///< part of _apiImageEffect._renderRoI rendered by a partial process
+    } _tile;
+
+    /**
+     * @brief Content cache (see memory::ContentCache)
+     * If the output image is already in the cache, its buffer is reused instead of rendering it.
+     */
+    /// @{
+    bool _hasContentHash;                   ///< the output can be stored in the content cache
+    std::size_t _contentHash;               ///< global hash of the output image
+    memory::IPoolDataPtr _contentCacheData; ///< buffer of the output image found in the content cache
+    /// @}
 };
 }
 }
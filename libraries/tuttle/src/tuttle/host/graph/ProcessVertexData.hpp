@@ -2,6 +2,7 @@
 #define _TUTTLE_HOST_PROCESSVERTEXDATA_HPP_
 
 #include <tuttle/host/INode.hpp>
+#include <tuttle/host/ComputeOptions.hpp>
 #include <tuttle/host/memory/IMemoryCache.hpp>
 
 #include <tuttle/host/ofx/OfxhCore.hpp>
@@ -62,6 +63,8 @@ public:
     OfxTime _step;
     bool _interactive;
 
+    boost::shared_ptr<IOutputHandle> _outputHandle; ///< receives the images of the final nodes (or NULL)
+
     std::size_t _outDegree; ///< number of connected input clips
     std::size_t _inDegree;  ///< number of nodes using the output of this node
 
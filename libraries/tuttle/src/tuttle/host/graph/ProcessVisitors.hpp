@@ -4,6 +4,7 @@
 #include "ProcessVertexData.hpp"
 
 #include <tuttle/host/memory/MemoryCache.hpp>
+#include <tuttle/host/attribute/Image.hpp>
 
 #include <boost/graph/properties.hpp>
 #include <boost/graph/visitors.hpp>
@@ -12,6 +13,9 @@
 #include <boost/foreach.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <iostream>
 #include <fstream>
@@ -190,7 +194,8 @@ public:
         if(vertex.isFake())
             return;
 
-        const std::size_t localHash = vertex.getProcessNode().getLocalHashAtTime(_time);
+        // inputs may be used at another time (temporal clip access)
+        const std::size_t localHash = vertex.getProcessNode().getLocalHashAtTime(vertex.getProcessDataAtTime()._time);
 
         typedef std::map<VertexKey, std::size_t> InputsHash;
         InputsHash inputsGlobalHash;
@@ -719,6 +724,7 @@ public:
         : _graph(graph)
         , _cache(cache)
         , _result(NULL)
+        , _mutexTime(new boost::mutex())
     {
     }
 
@@ -726,6 +732,7 @@ public:
         : _graph(graph)
         , _cache(cache)
         , _result(&result)
+        , _mutexTime(new boost::mutex())
     {
     }
 
@@ -734,6 +741,12 @@ public:
      */
     void setOutputMemoryCache(memory::IMemoryCache& result) { _result = &result; }
 
+    /**
+     * Set a function called before the process of each final node.
+     * Used to deliver frames in order when multiple frames are processed concurrently.
+     */
+    void setFinalNodeGate(const boost::function<void()>& gate) { _finalNodeGate = gate; }
+
     template <class VertexDescriptor, class Graph>
     void finish_vertex(VertexDescriptor v, Graph& g)
     {
@@ -747,20 +760,33 @@ public:
 
         // check if abort ?
 
+        if(_finalNodeGate && vertex.getProcessDataAtTime()._isFinalNode)
+            _finalNodeGate();
+
         // launch the process
         boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
         vertex.getProcessNode().process(vertex.getProcessDataAtTime());
         boost::posix_time::ptime t2(boost::posix_time::microsec_clock::local_time());
-        _cumulativeTime += t2 - t1;
+        boost::posix_time::time_duration cumulativeTime;
+        {
+            // independent nodes may be processed concurrently (see ComputeOptions::setNbParallelNodes)
+            boost::mutex::scoped_lock lock(*_mutexTime);
+            _cumulativeTime += t2 - t1;
+            cumulativeTime = _cumulativeTime;
+        }
 
         TUTTLE_LOG_TRACE("[Process] " << quotes(vertex._name) << " " << vertex._data._time << " took: " << t2 - t1
-                                      << " (cumul: " << _cumulativeTime << ")" << vertex);
+                                      << " (cumul: " << cumulativeTime << ")" << vertex);
 
-        if(_result && vertex.getProcessDataAtTime()._isFinalNode)
+        if(vertex.getProcessDataAtTime()._isFinalNode)
         {
+            const boost::shared_ptr<IOutputHandle>& outputHandle =
+                vertex.getProcessDataAtTime()._nodeData->_outputHandle;
             memory::CACHE_ELEMENT img = _cache.get(vertex._clipName + "." kOfxOutputAttributeName, vertex._data._time);
             if(!img.get())
             {
+                if(!_result && !outputHandle)
+                    return;
                 BOOST_THROW_EXCEPTION(exception::Logic()
                                       << exception::user() +
                                              "Output buffer not found in memoryCache at the end of the node process."
@@ -768,7 +794,12 @@ public:
                                              vertex._data._time
                                       << exception::nodeName(vertex._name) << exception::time(vertex._data._time));
             }
-            _result->put(vertex._clipName, vertex._data._time, img);
+            if(_result)
+                _result->put(vertex._clipName, vertex._data._time, img);
+            if(outputHandle)
+                outputHandle->outputImage(vertex._clipName, vertex._data._time, img);
+            // release the reference kept by the node for the fake output node
+            img->releaseReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost);
         }
     }
 
@@ -776,7 +807,9 @@ private:
     TGraph& _graph;
     memory::IMemoryCache& _cache;
     memory::IMemoryCache* _result;
+    boost::function<void()> _finalNodeGate;
     boost::posix_time::time_duration _cumulativeTime;
+    boost::shared_ptr<boost::mutex> _mutexTime; ///< shared by the copies of the visitor
 };
 
 template <class TGraph>
@@ -50,7 +50,9 @@ std::vector<std::string> getIOPluginsForExtension(const std::string& extension,
     {
         try
         {
-            node.second->loadAndDescribeActions();
+            // the descriptor comes from the plugin cache, the binary is only loaded if the plugin is unknown
+            if(node.second->getContexts().empty())
+                node.second->loadAndDescribeActions();
             const ofx::imageEffect::OfxhImageEffectNodeDescriptor& desc = node.second->getDescriptor();
             if(node.second->supportsContext(context))
             {
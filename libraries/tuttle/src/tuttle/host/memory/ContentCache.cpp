@@ -0,0 +1,163 @@
+#include "ContentCache.hpp"
+
+#include <tuttle/common/utils/global.hpp>
+
+namespace tuttle
+{
+namespace host
+{
+namespace memory
+{
+
+namespace
+{
+
+/// Check if @p container covers the region @p roi.
+bool contains(const OfxRectD& container, const OfxRectD& roi)
+{
+    return container.x1 <= roi.x1 && container.y1 <= roi.y1 && container.x2 >= roi.x2 && container.y2 >= roi.y2;
+}
+}
+
+ContentCache::ContentCache(const std::size_t maxMemorySize)
+    : _maxMemorySize(maxMemorySize)
+    , _memorySize(0)
+{
+}
+
+void ContentCache::setMaxMemorySize(const std::size_t maxMemorySize)
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    _maxMemorySize = maxMemorySize;
+    if(_memorySize > _maxMemorySize)
+        releaseMemoryUnlocked(_memorySize - _maxMemorySize);
+}
+
+std::size_t ContentCache::getMaxMemorySize() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return _maxMemorySize;
+}
+
+std::size_t ContentCache::getMemorySize() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return _memorySize;
+}
+
+void ContentCache::put(const std::size_t hash, const IPoolDataPtr& data, const OfxRectD& roi)
+{
+    Entry entry;
+    entry._data = data;
+    entry._roi = roi;
+    const std::size_t newSize = entrySize(entry);
+
+    boost::mutex::scoped_lock locker(_mutex);
+    MAP::iterator itr = _map.find(hash);
+    if(itr != _map.end())
+    {
+        erase(itr->second);
+    }
+    if(newSize > _maxMemorySize)
+        return;
+
+    if(_memorySize + newSize > _maxMemorySize)
+        releaseMemoryUnlocked(_memorySize + newSize - _maxMemorySize);
+
+    _lru.push_front(LruItem(hash, entry));
+    _map[hash] = _lru.begin();
+    _memorySize += newSize;
+}
+
+bool ContentCache::get(const std::size_t hash, const OfxRectD& roi, Entry& entry)
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    MAP::iterator itr = _map.find(hash);
+    if(itr == _map.end() || !contains(itr->second->second._roi, roi))
+    {
+        ++_statistics._nbMisses;
+        return false;
+    }
+    // move to the front of the list, iterators stay valid
+    _lru.splice(_lru.begin(), _lru, itr->second);
+    entry = itr->second->second;
+    ++_statistics._nbHits;
+    return true;
+}
+
+std::size_t ContentCache::releaseMemory(const std::size_t size)
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return releaseMemoryUnlocked(size);
+}
+
+std::size_t ContentCache::releaseMemoryUnlocked(const std::size_t size)
+{
+    std::size_t released = 0;
+    while(released < size && !_lru.empty())
+    {
+        LruList::iterator last = _lru.end();
+        --last;
+        released += entrySize(last->second);
+        erase(last);
+        ++_statistics._nbEvictions;
+    }
+    return released;
+}
+
+void ContentCache::erase(const LruList::iterator& it)
+{
+    _memorySize -= entrySize(it->second);
+    _map.erase(it->first);
+    _lru.erase(it);
+}
+
+std::size_t ContentCache::size() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return _map.size();
+}
+
+bool ContentCache::empty() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return _map.empty();
+}
+
+void ContentCache::clearAll()
+{
+    TUTTLE_LOG_DEBUG(" - CONTENTCACHE::CLEARALL - ");
+    boost::mutex::scoped_lock locker(_mutex);
+    _map.clear();
+    _lru.clear();
+    _memorySize = 0;
+}
+
+ContentCache::Statistics ContentCache::getStatistics() const
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    return _statistics;
+}
+
+void ContentCache::resetStatistics()
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    _statistics = Statistics();
+}
+
+std::ostream& operator<<(std::ostream& os, const ContentCache::Statistics& v)
+{
+    os << "hits: " << v._nbHits << ", misses: " << v._nbMisses << ", evictions: " << v._nbEvictions;
+    return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const ContentCache& v)
+{
+    boost::mutex::scoped_lock locker(v._mutex);
+    os << "[ContentCache] size:" << v._map.size() << ", memory: " << v._memorySize << "/" << v._maxMemorySize
+       << " bytes, " << v._statistics << std::endl;
+    return os;
+}
+}
+}
+}
@@ -0,0 +1,119 @@
+#ifndef _TUTTLE_HOST_CORE_CONTENTCACHE_HPP_
+#define _TUTTLE_HOST_CORE_CONTENTCACHE_HPP_
+
+#include "IMemoryPool.hpp"
+
+#include <ofxCore.h>
+
+#include <boost/unordered_map.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/cstdint.hpp>
+
+#include <list>
+#include <cstddef>
+#include <ostream>
+
+namespace tuttle
+{
+namespace host
+{
+namespace memory
+{
+
+/**
+ * @brief Cache of rendered images addressed by their content.
+ *
+ * The key is the global hash of a node at a time (see graph::visitor::ComputeHashAtTime),
+ * so the same result is reused across frames (frame-invariant branches)
+ * and across successive computations of the graph.
+ * Least recently used entries are removed when the memory size exceeds the maximum memory size.
+ */
+class ContentCache
+{
+    typedef ContentCache This;
+
+public:
+    /// @brief Image buffer and the region it covers (canonical coordinates).
+    struct Entry
+    {
+        IPoolDataPtr _data;
+        OfxRectD _roi;
+    };
+
+    /// @brief Counters of the cache activity.
+    struct Statistics
+    {
+        Statistics()
+            : _nbHits(0)
+            , _nbMisses(0)
+            , _nbEvictions(0)
+        {
+        }
+        boost::uint64_t _nbHits;
+        boost::uint64_t _nbMisses;
+        boost::uint64_t _nbEvictions;
+
+        friend std::ostream& operator<<(std::ostream& os, const Statistics& v);
+    };
+
+public:
+    /**
+     * @param maxMemorySize memory budget in bytes, 0 disables the cache.
+     */
+    explicit ContentCache(const std::size_t maxMemorySize = 0);
+    ~ContentCache() {}
+
+    void setMaxMemorySize(const std::size_t maxMemorySize);
+    std::size_t getMaxMemorySize() const;
+    std::size_t getMemorySize() const;
+    bool isEnabled() const { return getMaxMemorySize() > 0; }
+
+    /**
+     * @brief Add or replace the image of a content hash.
+     * Entries bigger than the maximum memory size are not stored.
+     */
+    void put(const std::size_t hash, const IPoolDataPtr& data, const OfxRectD& roi);
+
+    /**
+     * @brief Get the image of a content hash covering @p roi, and mark it as recently used.
+     * @return false if there is no such image.
+     */
+    bool get(const std::size_t hash, const OfxRectD& roi, Entry& entry);
+
+    /**
+     * @brief Remove least recently used entries until @p size bytes are released (or the cache is empty).
+     * @return the size of the released entries
+     */
+    std::size_t releaseMemory(const std::size_t size);
+
+    std::size_t size() const;
+    bool empty() const;
+    void clearAll();
+
+    Statistics getStatistics() const;
+    void resetStatistics();
+
+    friend std::ostream& operator<<(std::ostream& os, const ContentCache& v);
+
+private:
+    typedef std::pair<std::size_t, Entry> LruItem;
+    typedef std::list<LruItem> LruList; ///< most recently used first
+    typedef boost::unordered_map<std::size_t, LruList::iterator> MAP;
+
+    std::size_t entrySize(const Entry& entry) const { return entry._data->reservedSize(); }
+    void erase(const LruList::iterator& it);
+    std::size_t releaseMemoryUnlocked(const std::size_t size);
+
+private:
+    LruList _lru;
+    MAP _map;
+    std::size_t _maxMemorySize;
+    std::size_t _memorySize;
+    Statistics _statistics;
+    mutable boost::mutex _mutex; ///< protects all members
+};
+}
+}
+}
+
+#endif
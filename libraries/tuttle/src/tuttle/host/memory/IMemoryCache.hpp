@@ -65,6 +65,15 @@ public:
     virtual bool remove(const CACHE_ELEMENT&) = 0;
     virtual void clearUnused() = 0;
     virtual void clearAll() = 0;
+    /**
+     * @brief Declare the time spent to compute an element, used to select the elements to evict.
+     */
+    virtual void setRecomputeCost(const std::string& identifier, const double time, const double cost) = 0;
+    /**
+     * @brief Evict elements until @p size bytes are released.
+     * @return the size released
+     */
+    virtual std::size_t releaseMemory(const std::size_t size) = 0;
     virtual std::ostream& outputStream(std::ostream& os) const = 0;
     friend std::ostream& operator<<(std::ostream& os, const This& v);
 };
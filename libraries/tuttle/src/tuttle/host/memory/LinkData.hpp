@@ -1,7 +1,12 @@
 #ifndef _TUTTLE_HOST_LINKDATA_HPP_
 #define _TUTTLE_HOST_LINKDATA_HPP_
 
-#include "MemoryPool.hpp"
+#include "IMemoryPool.hpp"
+
+#include <boost/detail/atomic_count.hpp>
+#include <boost/function.hpp>
+
+#include <cassert>
 
 namespace tuttle
 {
@@ -12,34 +17,52 @@ namespace memory
 
 /**
  * @brief A link to an external buffer which can't be managed by the MemoryPool.
+ *
+ * The reserved size is 0, so the memory cache never evicts nor spills it.
+ * The release function is called (and the LinkData is deleted) when the last reference is released.
  */
 class LinkData : public IPoolData
 {
+private:
     LinkData();
     LinkData(const LinkData&);
 
 public:
-    LinkData(char* dataLink)
+    LinkData(char* dataLink, const std::size_t size, const boost::function<void()>& release = boost::function<void()>())
         : _dataLink(dataLink)
+        , _size(size)
+        , _release(release)
+        , _refCount(0)
     {
     }
 
     ~LinkData()
     {
         // we don't own _dataLink
+        if(_release)
+            _release();
     }
 
     char* data() { return _dataLink; }
     const char* data() const { return _dataLink; }
 
-    const size_t size() const { return 0; }
-    const size_t reservedSize() const { return 0; }
+    const std::size_t size() const { return _size; }
+    const std::size_t reservedSize() const { return 0; }
 
-    void addRef() {}
-    void release() {}
+    void setSize(const std::size_t newSize) { assert(newSize <= _size); }
+
+    void addRef() { ++_refCount; }
+    void release()
+    {
+        if(--_refCount == 0)
+            delete this;
+    }
 
 private:
     char* const _dataLink;
+    const std::size_t _size;
+    const boost::function<void()> _release;
+    boost::detail::atomic_count _refCount;
 };
 }
 }
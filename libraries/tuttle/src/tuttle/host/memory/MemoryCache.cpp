@@ -1,9 +1,14 @@
 #include "MemoryCache.hpp"
 #include <tuttle/host/attribute/Image.hpp> // to know the function getReference()
+#include <tuttle/host/Core.hpp>            // for core().getMemoryPool()
 #include <tuttle/common/utils/global.hpp>
 #include <boost/foreach.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/functional/hash.hpp>
 
 #include <functional>
+#include <algorithm>
+#include <fstream>
 
 namespace tuttle
 {
@@ -21,8 +26,26 @@ bool isUnused(const CACHE_ELEMENT& cacheElement)
     return cacheElement->getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerHost) < 1;
 }
 
+/// Check if the cache element waits for its next usage, so its buffer can be moved to disk.
+/// The host references declare the future usages, the plugin references are the images fetched by a running
+/// process (the plugin only keeps a raw pointer), and any other shared pointer is a pending access.
+bool isSpillable(const CACHE_ELEMENT& cacheElement)
+{
+    return cacheElement.use_count() == 1 &&
+           cacheElement->getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerPlugin) == 0;
+}
+
+/// Memory used by the cache element in RAM
+std::size_t imageMemorySize(const CACHE_ELEMENT& cacheElement)
+{
+    if(cacheElement.get() == NULL || !cacheElement->getPoolData())
+        return 0;
+    return cacheElement->getPoolData()->reservedSize();
+}
+
 /// Functor to get the smallest unused element in cache
-struct UnusedDataFitSize : public std::unary_function<CACHE_ELEMENT*, void>
+template <class Entry>
+struct UnusedDataFitSize : public std::unary_function<std::pair<Key, Entry>, void>
 {
     UnusedDataFitSize(std::size_t size)
         : _sizeNeeded(size)
@@ -31,15 +54,15 @@ struct UnusedDataFitSize : public std::unary_function<CACHE_ELEMENT*, void>
     {
     }
 
-    void operator()(const std::pair<Key, CACHE_ELEMENT>& pData)
+    void operator()(const std::pair<const Key, Entry>& pData)
     {
         // used data
-        if(!isUnused(pData.second))
+        if(!isUnused(pData.second._image))
             return;
 
-        const std::size_t bufferSize = pData.second->getPoolData()->reservedSize();
+        const std::size_t bufferSize = imageMemorySize(pData.second._image);
 
-        // Check minimum amount of memory
+        // Check minimum amount of memory (spilled images have no buffer)
         if(_sizeNeeded > bufferSize)
             return;
 
@@ -47,7 +70,7 @@ struct UnusedDataFitSize : public std::unary_function<CACHE_ELEMENT*, void>
         if(diff >= _bestMatchDiff)
             return;
         _bestMatchDiff = diff;
-        _pBestMatch = pData.second;
+        _pBestMatch = pData.second._image;
     }
 
     CACHE_ELEMENT bestMatch() { return _pBestMatch; }
@@ -57,6 +80,54 @@ private:
     std::size_t _bestMatchDiff;
     CACHE_ELEMENT _pBestMatch;
 };
+
+/// An element which can be evicted from the cache
+struct EvictionCandidate
+{
+    EvictionCandidate(const Key& key, const double cost, const std::size_t size, const std::size_t lastAccess)
+        : _key(key)
+        , _costDensity(cost / std::max(size, std::size_t(1)))
+        , _lastAccess(lastAccess)
+    {
+    }
+
+    /// Cheap to recompute relatively to the size first, then the least recently used
+    bool operator<(const EvictionCandidate& other) const
+    {
+        if(_costDensity != other._costDensity)
+            return _costDensity < other._costDensity;
+        return _lastAccess < other._lastAccess;
+    }
+
+    Key _key;
+    double _costDensity;
+    std::size_t _lastAccess;
+};
+
+/// An image removed from the RAM, to write on disk
+struct SpilledImage
+{
+    CACHE_ELEMENT _image;
+    IPoolDataPtr _data;
+    boost::filesystem::path _path;
+};
+}
+
+MemoryCache::MemoryCache()
+    : _accessCounter(0)
+    , _maxMemorySize(0)
+    , _spillEnabled(false)
+    , _nbSpillWrites(0)
+    , _nbReloads(0)
+{
+}
+
+MemoryCache::~MemoryCache()
+{
+    BOOST_FOREACH(const MAP::value_type& i, _map)
+    {
+        removeSpillFile(i.second);
+    }
 }
 
 MemoryCache& MemoryCache::operator=(const MemoryCache& cache)
@@ -65,24 +136,108 @@ MemoryCache& MemoryCache::operator=(const MemoryCache& cache)
         return *this;
     boost::mutex::scoped_lock lockerMap1(cache._mutexMap);
     boost::mutex::scoped_lock lockerMap2(_mutexMap);
-    _map = cache._map;
+    _map.clear();
+    // the spilled files are owned by the original cache
+    BOOST_FOREACH(const MAP::value_type& i, cache._map)
+    {
+        if(i.second._spillPath.empty())
+            _map.insert(i);
+        else
+            TUTTLE_LOG_WARNING("[MemoryCache] Spilled image " << i.first << " is not copied.");
+    }
+    _accessCounter = cache._accessCounter;
+    _maxMemorySize = cache._maxMemorySize;
     return *this;
 }
 
 void MemoryCache::put(const std::string& identifier, const double time, CACHE_ELEMENT pData)
 {
-    boost::mutex::scoped_lock lockerMap(_mutexMap);
-    _map[Key(identifier, time)] = pData;
+    std::size_t exceededSize = 0;
+    {
+        boost::mutex::scoped_lock lockerMap(_mutexMap);
+        Entry& entry = _map[Key(identifier, time)];
+        removeSpillFile(entry);
+        entry = Entry();
+        entry._image = pData;
+        entry._lastAccess = ++_accessCounter;
+
+        if(_maxMemorySize == 0)
+            return;
+        const std::size_t memorySize = getMemorySizeUnlocked();
+        if(memorySize <= _maxMemorySize)
+            return;
+        exceededSize = memorySize - _maxMemorySize;
+    }
+    releaseMemory(exceededSize);
 }
 
 CACHE_ELEMENT MemoryCache::get(const std::string& identifier, const double time) const
 {
+    const Key key(identifier, time);
+    CACHE_ELEMENT image;
+    bool isSpilled = false;
+    {
+        boost::mutex::scoped_lock lockerMap(_mutexMap);
+        MAP::const_iterator itr = _map.find(key);
+
+        if(itr == _map.end())
+            return CACHE_ELEMENT();
+        itr->second._lastAccess = ++_accessCounter;
+        image = itr->second._image;
+        isSpilled = !itr->second._spillPath.empty();
+    }
+    if(isSpilled)
+        reload(key, image);
+    return image;
+}
+
+void MemoryCache::reload(const Key& key, const CACHE_ELEMENT& image) const
+{
+    boost::recursive_mutex::scoped_lock lockerSpill(_mutexSpill);
+    boost::filesystem::path spillPath;
+    {
+        boost::mutex::scoped_lock lockerMap(_mutexMap);
+        MAP::const_iterator itr = _map.find(key);
+        if(itr == _map.end() || itr->second._image != image || itr->second._spillPath.empty())
+            return; // already reloaded
+        spillPath = itr->second._spillPath;
+    }
+
+    // the allocation may evict other images, so the map is not locked
+    boost::system::error_code error;
+    const std::size_t dataSize = boost::filesystem::file_size(spillPath, error);
+    IPoolDataPtr data;
+    bool loaded = false;
+    if(!error)
+    {
+        data = core().getMemoryPool().allocate(dataSize);
+        std::ifstream file(spillPath.string().c_str(), std::ios::in | std::ios::binary);
+        loaded = file.read(data->data(), dataSize).good();
+    }
+
     boost::mutex::scoped_lock lockerMap(_mutexMap);
-    MAP::const_iterator itr = _map.find(Key(identifier, time));
+    MAP::const_iterator itr = _map.find(key);
+    if(itr == _map.end() || itr->second._image != image || itr->second._spillPath != spillPath)
+        return; // the image was replaced or removed from the cache during the reload
+    if(!loaded)
+    {
+        BOOST_THROW_EXCEPTION(exception::File() << exception::user() + "Can't reload the image " +
+                                                       quotes(image->getFullName()) + " from the spill directory."
+                                                << exception::filename(spillPath.string()));
+    }
+    image->setPoolData(data);
+    removeSpillFile(itr->second);
+    ++_nbReloads;
+    TUTTLE_LOG_TRACE("[MemoryCache] Reload " << key << " from " << spillPath);
+}
 
-    if(itr == _map.end())
-        return CACHE_ELEMENT();
-    return itr->second;
+void MemoryCache::removeSpillFile(const Entry& entry) const
+{
+    if(entry._spillPath.empty())
+        return;
+    boost::system::error_code error;
+    boost::filesystem::remove(entry._spillPath, error);
+    entry._spillPath.clear();
 }
 
 CACHE_ELEMENT MemoryCache::get(const std::size_t& i) const
@@ -94,13 +249,13 @@ CACHE_ELEMENT MemoryCache::get(const std::size_t& i) const
 
     if(itr == _map.end())
         return CACHE_ELEMENT();
-    return itr->second;
+    return itr->second._image;
 }
 
 CACHE_ELEMENT MemoryCache::getUnusedWithSize(const std::size_t requestedSize) const
 {
     boost::mutex::scoped_lock lockerMap(_mutexMap);
-    return std::for_each(_map.begin(), _map.end(), UnusedDataFitSize(requestedSize)).bestMatch();
+    return std::for_each(_map.begin(), _map.end(), UnusedDataFitSize<Entry>(requestedSize)).bestMatch();
 }
 
 std::size_t MemoryCache::size() const
@@ -129,13 +284,13 @@ const std::string EMPTY_STRING = "";
 template <typename T>
 struct FindValuePredicate : public std::unary_function<typename T::value_type, bool>
 {
-    const typename T::mapped_type& _value;
-    FindValuePredicate(const typename T::mapped_type& value)
+    const CACHE_ELEMENT& _value;
+    FindValuePredicate(const CACHE_ELEMENT& value)
         : _value(value)
     {
     }
 
-    bool operator()(const typename T::value_type& pair) { return pair.second == _value; }
+    bool operator()(const typename T::value_type& pair) { return pair.second._image == _value; }
 };
 }
 
@@ -176,6 +331,7 @@ bool MemoryCache::remove(const CACHE_ELEMENT& pData)
 
     if(itr == _map.end())
         return false;
+    removeSpillFile(itr->second);
     _map.erase(itr);
     return true;
 }
@@ -185,8 +341,9 @@ void MemoryCache::clearUnused()
     boost::mutex::scoped_lock lockerMap(_mutexMap);
     for(MAP::iterator it = _map.begin(); it != _map.end();)
     {
-        if(isUnused(it->second))
+        if(isUnused(it->second._image))
         {
+            removeSpillFile(it->second);
             _map.erase(
                 it++); // post-increment here, increments 'it' and returns a copy of the original 'it' to be used by erase()
         }
@@ -201,18 +358,186 @@ void MemoryCache::clearAll()
 {
     TUTTLE_LOG_DEBUG(" - MEMORYCACHE::CLEARALL - ");
     boost::mutex::scoped_lock lockerMap(_mutexMap);
+    BOOST_FOREACH(const MAP::value_type& i, _map)
+    {
+        removeSpillFile(i.second);
+    }
     _map.clear();
 }
 
+void MemoryCache::setRecomputeCost(const std::string& identifier, const double time, const double cost)
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    MAP::iterator itr = _map.find(Key(identifier, time));
+    if(itr != _map.end())
+        itr->second._cost = cost;
+}
+
+std::size_t MemoryCache::releaseMemory(const std::size_t size)
+{
+    boost::recursive_mutex::scoped_lock lockerSpill(_mutexSpill);
+    std::vector<SpilledImage> spilledImages;
+    std::size_t released = 0;
+    {
+        boost::mutex::scoped_lock lockerMap(_mutexMap);
+        std::vector<EvictionCandidate> unusedCandidates;
+        std::vector<EvictionCandidate> spillCandidates;
+        BOOST_FOREACH(const MAP::value_type& i, _map)
+        {
+            const std::size_t memorySize = imageMemorySize(i.second._image);
+            if(memorySize == 0)
+                continue;
+            const EvictionCandidate candidate(i.first, i.second._cost, memorySize, i.second._lastAccess);
+            if(isUnused(i.second._image))
+                unusedCandidates.push_back(candidate);
+            // only the images waiting for their next usage (not used by a process)
+            else if(_spillEnabled && isSpillable(i.second._image))
+                spillCandidates.push_back(candidate);
+        }
+
+        // the unused images are simply removed
+        std::sort(unusedCandidates.begin(), unusedCandidates.end());
+        BOOST_FOREACH(const EvictionCandidate& candidate, unusedCandidates)
+        {
+            if(released >= size)
+                break;
+            MAP::iterator itr = _map.find(candidate._key);
+            released += imageMemorySize(itr->second._image);
+            _map.erase(itr);
+        }
+
+        // the other images are moved to the spill directory
+        std::sort(spillCandidates.begin(), spillCandidates.end());
+        BOOST_FOREACH(const EvictionCandidate& candidate, spillCandidates)
+        {
+            if(released >= size)
+                break;
+            Entry& entry = _map.find(candidate._key)->second;
+            std::size_t key = candidate._key.getHash();
+            boost::hash_combine(key, this);
+
+            SpilledImage spilledImage;
+            spilledImage._image = entry._image;
+            spilledImage._data = entry._image->getPoolData();
+            spilledImage._path = _spillTranslator.create(key);
+            released += spilledImage._data->reservedSize();
+
+            entry._image->getPoolData() = IPoolDataPtr();
+            entry._spillPath = spilledImage._path;
+            spilledImages.push_back(spilledImage);
+        }
+    }
+
+    // write the spilled images without locking the map (put, remove and clear don't wait for the disk),
+    // only the reload waits for the spill mutex
+    BOOST_FOREACH(SpilledImage& spilledImage, spilledImages)
+    {
+        std::ofstream file(spilledImage._path.string().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(spilledImage._data->data(), spilledImage._data->size());
+        file.close();
+
+        boost::mutex::scoped_lock lockerMap(_mutexMap);
+        MAP::iterator itr = getIteratorForValue(spilledImage._image);
+        if(itr == _map.end() || itr->second._spillPath != spilledImage._path)
+        {
+            // the image was replaced or removed from the cache during the write
+            boost::system::error_code error;
+            boost::filesystem::remove(spilledImage._path, error);
+            continue;
+        }
+        if(file)
+        {
+            ++_nbSpillWrites;
+            TUTTLE_LOG_TRACE("[MemoryCache] Spill " << spilledImage._image->getFullName() << " to "
+                                                    << spilledImage._path);
+            continue;
+        }
+        // keep the image in memory
+        TUTTLE_LOG_WARNING("[MemoryCache] Can't spill " << spilledImage._image->getFullName() << " to "
+                                                        << spilledImage._path);
+        released -= spilledImage._data->reservedSize();
+        spilledImage._image->setPoolData(spilledImage._data);
+        removeSpillFile(itr->second);
+    }
+    return released;
+}
+
+void MemoryCache::setMaxMemorySize(const std::size_t maxMemorySize)
+{
+    std::size_t exceededSize = 0;
+    {
+        boost::mutex::scoped_lock lockerMap(_mutexMap);
+        _maxMemorySize = maxMemorySize;
+        const std::size_t memorySize = getMemorySizeUnlocked();
+        if(_maxMemorySize == 0 || memorySize <= _maxMemorySize)
+            return;
+        exceededSize = memorySize - _maxMemorySize;
+    }
+    releaseMemory(exceededSize);
+}
+
+std::size_t MemoryCache::getMaxMemorySize() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return _maxMemorySize;
+}
+
+std::size_t MemoryCache::getMemorySize() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return getMemorySizeUnlocked();
+}
+
+std::size_t MemoryCache::getMemorySizeUnlocked() const
+{
+    std::size_t memorySize = 0;
+    BOOST_FOREACH(const MAP::value_type& i, _map)
+    {
+        memorySize += imageMemorySize(i.second._image);
+    }
+    return memorySize;
+}
+
+void MemoryCache::setSpillDirectory(const boost::filesystem::path& spillDir)
+{
+    boost::recursive_mutex::scoped_lock lockerSpill(_mutexSpill);
+    _spillTranslator.setRootDir(spillDir);
+    _spillEnabled = !spillDir.empty();
+}
+
+std::size_t MemoryCache::getNbSpilled() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    std::size_t nbSpilled = 0;
+    BOOST_FOREACH(const MAP::value_type& i, _map)
+    {
+        if(!i.second._spillPath.empty())
+            ++nbSpilled;
+    }
+    return nbSpilled;
+}
+
+std::size_t MemoryCache::getNbSpillWrites() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return _nbSpillWrites;
+}
+
+std::size_t MemoryCache::getNbReloads() const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    return _nbReloads;
+}
+
 std::ostream& operator<<(std::ostream& os, const MemoryCache& v)
 {
     os << "[MemoryCache] size:" << v.size() << std::endl;
     BOOST_FOREACH(const MemoryCache::MAP::value_type& i, v._map)
     {
-        os << "[MemoryCache] " << i.first << " id:" << i.second->getId()
-           << " ref host:" << i.second->getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerHost)
-           << " ref plugins:" << i.second->getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerPlugin)
-           << std::endl;
+        os << "[MemoryCache] " << i.first << " id:" << i.second._image->getId()
+           << " ref host:" << i.second._image->getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerHost)
+           << " ref plugins:" << i.second._image->getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerPlugin)
+           << (i.second._spillPath.empty() ? "" : " spilled") << std::endl;
     }
     return os;
 }
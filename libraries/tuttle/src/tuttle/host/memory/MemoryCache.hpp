@@ -4,8 +4,12 @@
 #include "IMemoryCache.hpp"
 #include "IMemoryPool.hpp"
 
+#include <tuttle/host/diskCache/DiskCacheTranslator.hpp>
+
 #include <boost/unordered_map.hpp>
 #include <boost/thread.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/filesystem/path.hpp>
 
 namespace tuttle
 {
@@ -14,26 +18,68 @@ namespace host
 namespace memory
 {
 
+/**
+ * @brief Cache of the images computed by the nodes.
+ *
+ * With a memory budget (see setMaxMemorySize), the images are evicted when the budget is exceeded
+ * or when the MemoryPool needs memory:
+ *  - the unused images are removed from the cache,
+ *  - the images waiting for their next usage are spilled to a scratch directory (see setSpillDirectory)
+ *    and reloaded on the next access.
+ * Images cheap to recompute relatively to their size are evicted first, then the least recently used.
+ */
 class MemoryCache : public IMemoryCache
 {
     typedef MemoryCache This;
 
 public:
-    MemoryCache(const MemoryCache& other) { *this = other; }
-    MemoryCache() {}
-    ~MemoryCache() {}
+    MemoryCache(const MemoryCache& other)
+        : _accessCounter(0)
+        , _maxMemorySize(0)
+        , _spillEnabled(false)
+        , _nbSpillWrites(0)
+        , _nbReloads(0)
+    {
+        *this = other;
+    }
+    MemoryCache();
+    ~MemoryCache();
 
     MemoryCache& operator=(const MemoryCache& cache);
 
 private:
-    typedef boost::unordered_map<Key, CACHE_ELEMENT, KeyHash> MAP;
+    struct Entry
+    {
+        Entry()
+            : _lastAccess(0)
+            , _cost(0)
+        {
+        }
+        CACHE_ELEMENT _image;
+        mutable std::size_t _lastAccess;             ///< value of the access counter at the last access
+        double _cost;                                ///< time spent to compute the image
+        mutable boost::filesystem::path _spillPath; ///< file containing the image data if spilled
+    };
+    typedef boost::unordered_map<Key, Entry, KeyHash> MAP;
     //	typedef std::map<Key, CACHE_ELEMENT> MAP;
     MAP _map;
     mutable boost::mutex _mutexMap; ///< Mutex for cache data map.
+    mutable std::size_t _accessCounter;
+
+    std::size_t _maxMemorySize;
+    DiskCacheTranslator _spillTranslator;
+    bool _spillEnabled;
+    mutable boost::recursive_mutex _mutexSpill; ///< Serialize the spill writes and the reload of images.
+    std::size_t _nbSpillWrites;
+    mutable std::size_t _nbReloads;
 
     MAP::const_iterator getIteratorForValue(const CACHE_ELEMENT&) const;
     MAP::iterator getIteratorForValue(const CACHE_ELEMENT&);
 
+    std::size_t getMemorySizeUnlocked() const;
+    void reload(const Key& key, const CACHE_ELEMENT& image) const;
+    void removeSpillFile(const Entry& entry) const;
+
 public:
     void put(const std::string& identifier, const double time, CACHE_ELEMENT pData);
     CACHE_ELEMENT get(const std::string& identifier, const double time) const;
@@ -47,6 +93,39 @@ public:
     bool remove(const CACHE_ELEMENT&);
     void clearUnused();
     void clearAll();
+
+    void setRecomputeCost(const std::string& identifier, const double time, const double cost);
+    std::size_t releaseMemory(const std::size_t size);
+
+    /**
+     * @brief Memory budget of the images kept in RAM, 0 means no budget.
+     */
+    void setMaxMemorySize(const std::size_t maxMemorySize);
+    std::size_t getMaxMemorySize() const;
+    /**
+     * @brief Memory used by the images kept in RAM (spilled images excluded).
+     */
+    std::size_t getMemorySize() const;
+
+    /**
+     * @brief Set the scratch directory where the evicted images are spilled.
+     * An empty path disables the spill.
+     */
+    void setSpillDirectory(const boost::filesystem::path& spillDir);
+    void setSpillDirectory(const std::string& spillDir) { setSpillDirectory(boost::filesystem::path(spillDir)); }
+    /**
+     * @brief Number of images currently spilled to disk.
+     */
+    std::size_t getNbSpilled() const;
+    /**
+     * @brief Number of images written to the spill directory since the creation of the cache.
+     */
+    std::size_t getNbSpillWrites() const;
+    /**
+     * @brief Number of images reloaded from the spill directory since the creation of the cache.
+     */
+    std::size_t getNbReloads() const;
+
     std::ostream& outputStream(std::ostream& os) const
     {
         os << *this;
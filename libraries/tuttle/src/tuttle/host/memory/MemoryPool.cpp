@@ -6,7 +6,15 @@
 
 #include <boost/throw_exception.hpp>
 
-#include <algorithm>
+#include <limits>
+#include <cstdlib>
+
+#ifdef __LINUX__
+#include <sys/mman.h>
+#endif
+#ifdef __WINDOWS__
+#include <malloc.h>
+#endif
 
 namespace tuttle
 {
@@ -19,6 +27,63 @@ IPool::~IPool()
 {
 }
 
+namespace
+{
+
+const std::size_t cacheLineSize = 64;
+const std::size_t pageSize = 4096;
+const std::size_t hugePageSize = 2 * 1024 * 1024;
+
+/// Max number of unused datas kept by each thread
+const std::size_t threadCacheCapacity = 4;
+
+/// Max ratio between the reserved size and the requested size of a reused buffer
+const std::size_t maxBufferRatio = 2;
+
+/**
+ * @brief Allocate an aligned buffer: on cache lines for small buffers, on pages for big ones.
+ */
+char* alignedAllocate(const std::size_t size, const bool useHugePages)
+{
+    std::size_t alignment = cacheLineSize;
+    if(useHugePages && size >= hugePageSize)
+        alignment = hugePageSize;
+    else if(size >= pageSize)
+        alignment = pageSize;
+
+    void* p = NULL;
+#ifdef __WINDOWS__
+    p = _aligned_malloc(size, alignment);
+#else
+    if(posix_memalign(&p, alignment, size) != 0)
+        p = NULL;
+#endif
+    if(p == NULL)
+        throw std::bad_alloc();
+
+#if defined(__LINUX__) && defined(MADV_HUGEPAGE)
+    if(alignment == hugePageSize)
+        madvise(p, size, MADV_HUGEPAGE); // only an advice, ignore errors
+#endif
+    return static_cast<char*>(p);
+}
+
+void alignedFree(char* p)
+{
+#ifdef __WINDOWS__
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+/// No cleanup at the end of a thread, the thread caches are owned by the pool
+template <class T>
+void noCleanup(T*)
+{
+}
+}
+
 class PoolData : public IPoolData
 {
 private:
@@ -27,17 +92,18 @@ private:
     friend class MemoryPool;
 
 public:
-    PoolData(IPool& pool, const std::size_t size)
+    PoolData(IPool& pool, const std::size_t size, const bool useHugePages)
         : _pool(pool)
-        , _id(_count++)
+        , _id(_count.fetch_add(1))
         , _reservedSize(size)
         , _size(size)
-        , _pData(new char[size])
+        , _wastedSize(0)
+        , _pData(alignedAllocate(size, useHugePages))
         , _refCount(0)
     {
     }
 
-    ~PoolData() { delete[] _pData; }
+    ~PoolData() { alignedFree(_pData); }
 
 public:
     bool operator==(const PoolData& other) const { return _id == other._id; }
@@ -57,13 +123,14 @@ public:
     }
 
 private:
-    static std::size_t _count;       ///< unique id generator
-    IPool& _pool;                    ///< ref to the owner pool
-    const std::size_t _id;           ///< unique id to identify one memory data
-    const std::size_t _reservedSize; ///< memory allocated
-    std::size_t _size;               ///< memory requested
-    char* const _pData;              ///< own the data
-    int _refCount;                   ///< counter on clients currently using this data
+    static boost::atomic<std::size_t> _count; ///< unique id generator
+    IPool& _pool;                             ///< ref to the owner pool
+    const std::size_t _id;                    ///< unique id to identify one memory data
+    const std::size_t _reservedSize;          ///< memory allocated
+    std::size_t _size;                        ///< memory requested
+    std::size_t _wastedSize;                  ///< wasted memory declared to the pool when the data was referenced
+    char* const _pData;                       ///< own the data
+    boost::atomic<int> _refCount;             ///< counter on clients currently using this data, shared between threads
 };
 
 void intrusive_ptr_add_ref(IPoolData* pData)
@@ -76,99 +143,102 @@ void intrusive_ptr_release(IPoolData* pData)
     pData->release();
 }
 
-std::size_t PoolData::_count = 0;
+boost::atomic<std::size_t> PoolData::_count(0);
 
 void PoolData::addRef()
 {
-    if(++_refCount == 1)
+    if(_refCount.fetch_add(1) == 0)
         _pool.referenced(this);
 }
 
 void PoolData::release()
 {
-    if(--_refCount == 0)
+    if(_refCount.fetch_sub(1) == 1)
         _pool.released(this);
 }
 
 MemoryPool::MemoryPool(const std::size_t maxSize)
-    : _memoryAuthorized(maxSize)
+    : _threadCache(&noCleanup<ThreadCache>)
+    , _nbDataUsed(0)
+    , _nbDataUnused(0)
+    , _memoryUsed(0)
+    , _memoryUnused(0)
+    , _memoryWasted(0)
+    , _memoryAuthorized(maxSize)
+    , _useHugePages(false)
 {
 }
 
 MemoryPool::~MemoryPool()
 {
-    if(!_dataUsed.empty())
+    if(getDataUsedSize() != 0)
     {
         TUTTLE_LOG_DEBUG(
             "[Memory Pool] Error inside memory pool. Some data always mark used at the destruction (nb elements:"
-            << _dataUsed.size() << ")");
+            << getDataUsedSize() << ")");
     }
+    clear();
 }
 
-void MemoryPool::referenced(PoolData* pData)
+MemoryPool::ThreadCache& MemoryPool::getThreadCache()
 {
-    boost::mutex::scoped_lock locker(_mutex);
-    DataList::iterator it = _dataUnused.find(pData);
-
-    if(it != _dataUnused.end())
+    ThreadCache* threadCache = _threadCache.get();
+    if(threadCache == NULL)
     {
-        _dataUnused.erase(it);
-    }
-    else // a really new data
-    {
-        _allDatas.push_back(pData);
-        _dataMap[pData->data()] = pData;
+        threadCache = new ThreadCache();
+        {
+            boost::mutex::scoped_lock locker(_mutex);
+            _threadCaches.push_back(threadCache);
+        }
+        _threadCache.reset(threadCache);
     }
-    _dataUsed.insert(pData);
+    return *threadCache;
 }
 
-void MemoryPool::released(PoolData* pData)
+void MemoryPool::referenced(PoolData* pData)
 {
-    boost::mutex::scoped_lock locker(_mutex);
-    _dataUsed.erase(pData);
-    _dataUnused.insert(pData);
+    // the data was removed from the unused datas by getOneAvailableData, or is a really new data
+    pData->_wastedSize = pData->reservedSize() - pData->size();
+    _nbDataUsed.fetch_add(1);
+    _memoryUsed.fetch_add(pData->reservedSize());
+    _memoryWasted.fetch_add(pData->_wastedSize);
 }
 
-namespace
-{
-
-/// Functor to get the smallest element in pool
-struct DataFitSize : public std::unary_function<PoolData*, void>
+void MemoryPool::released(PoolData* pData)
 {
-    DataFitSize(std::size_t size)
-        : _sizeNeeded(size)
-        , _bestMatchDiff(ULONG_MAX)
-        , _pBestMatch(NULL)
-    {
-    }
+    _nbDataUsed.fetch_sub(1);
+    _memoryUsed.fetch_sub(pData->reservedSize());
+    _memoryWasted.fetch_sub(pData->_wastedSize);
+    _nbDataUnused.fetch_add(1);
+    _memoryUnused.fetch_add(pData->reservedSize());
 
-    void operator()(PoolData* pData)
+    // keep it in the cache of the current thread, the oldest one goes to the shared datas
+    PoolData* pOldest = NULL;
     {
-        const std::size_t dataSize = pData->reservedSize();
-
-        // Check minimum amount of memory
-        if(_sizeNeeded > dataSize)
-            return;
-        // Do not reuse too big buffers
-        if(dataSize > _maxBufferRatio * _sizeNeeded)
-            return;
-        const std::size_t diff = dataSize - _sizeNeeded;
-        if(diff >= _bestMatchDiff)
-            return;
-        _bestMatchDiff = diff;
-        _pBestMatch = pData;
+        ThreadCache& threadCache = getThreadCache();
+        boost::mutex::scoped_lock locker(threadCache._mutex);
+        threadCache._datas.push_back(pData);
+        if(threadCache._datas.size() > threadCacheCapacity)
+        {
+            pOldest = threadCache._datas.front();
+            threadCache._datas.erase(threadCache._datas.begin());
+        }
     }
+    if(pOldest != NULL)
+        addUnusedData(pOldest);
+}
 
-    PoolData* bestMatch() { return _pBestMatch; }
-
-private:
-    static const double _maxBufferRatio; //< max ratio between used and unused part of the buffer
-    const std::size_t _sizeNeeded;
-    std::size_t _bestMatchDiff;
-    PoolData* _pBestMatch;
-};
+void MemoryPool::addUnusedData(PoolData* pData)
+{
+    boost::mutex::scoped_lock locker(_mutex);
+    _dataUnused.insert(DataBySize::value_type(pData->reservedSize(), pData));
+}
 
-const double DataFitSize::_maxBufferRatio = 2.0;
+void MemoryPool::deleteUnusedData(PoolData* pData)
+{
+    _nbDataUnused.fetch_sub(1);
+    _memoryUnused.fetch_sub(pData->reservedSize());
+    delete pData;
 }
 
 IPoolDataPtr MemoryPool::allocate(const std::size_t size)
@@ -210,6 +280,20 @@ IPoolDataPtr MemoryPool::allocate(const std::size_t size)
 
         availableSize = getAvailableMemorySize();
         if(size > availableSize)
+        {
+            // Release the least recently used images of the ContentCache
+            TUTTLE_LOG_TRACE("[Memory Pool] Release elements from the ContentCache");
+            core().getContentCache().releaseMemory(size - availableSize);
+            availableSize = getAvailableMemorySize();
+        }
+        if(size > availableSize)
+        {
+            // Evict the images waiting for their next usage from the MemoryCache (spill them to disk)
+            TUTTLE_LOG_TRACE("[Memory Pool] Evict elements from the MemoryCache");
+            memoryCache.releaseMemory(size - availableSize);
+            availableSize = getAvailableMemorySize();
+        }
+        if(size > availableSize)
         {
             // Release elements from the MemoryPool (make them available to the OS)
             TUTTLE_LOG_TRACE("[Memory Pool] Release elements from the MemoryPool");
@@ -228,7 +312,7 @@ IPoolDataPtr MemoryPool::allocate(const std::size_t size)
 
     // Allocate a new buffer in MemoryPool
     TUTTLE_LOG_TRACE("[Memory Pool] allocate " << size << " bytes");
-    return new PoolData(*this, size);
+    return new PoolData(*this, size, _useHugePages);
 }
 
 std::size_t MemoryPool::updateMemoryAuthorizedWithRAM()
@@ -238,30 +322,14 @@ std::size_t MemoryPool::updateMemoryAuthorizedWithRAM()
     return _memoryAuthorized;
 }
 
-namespace
-{
-
-std::size_t accumulateReservedSize(const std::size_t& sum, const IPoolData* pData)
-{
-    return sum + pData->reservedSize();
-}
-
-std::size_t accumulateWastedSize(const std::size_t& sum, const IPoolData* pData)
-{
-    return sum + (pData->reservedSize() - pData->size());
-}
-}
-
 std::size_t MemoryPool::getUsedMemorySize() const
 {
-    boost::mutex::scoped_lock locker(_mutex);
-    return std::accumulate(_dataUsed.begin(), _dataUsed.end(), 0, &accumulateReservedSize);
+    return _memoryUsed.load(boost::memory_order_relaxed);
 }
 
 std::size_t MemoryPool::getAllocatedAndUnusedMemorySize() const
 {
-    boost::mutex::scoped_lock locker(_mutex);
-    return std::accumulate(_dataUnused.begin(), _dataUnused.end(), 0, &accumulateReservedSize);
+    return _memoryUnused.load(boost::memory_order_relaxed);
 }
 
 std::size_t MemoryPool::getAllocatedMemorySize() const
@@ -281,41 +349,110 @@ std::size_t MemoryPool::getAvailableMemorySize() const
 
 std::size_t MemoryPool::getWastedMemorySize() const
 {
-    boost::mutex::scoped_lock locker(_mutex);
-    return std::accumulate(_dataUsed.begin(), _dataUsed.end(), 0, std::ptr_fun(&accumulateWastedSize));
+    return _memoryWasted.load(boost::memory_order_relaxed);
 }
 
 std::size_t MemoryPool::getDataUsedSize() const
 {
-    return _dataUsed.size();
+    return _nbDataUsed.load(boost::memory_order_relaxed);
 }
 
 std::size_t MemoryPool::getDataUnusedSize() const
 {
-    return _dataUnused.size();
+    return _nbDataUnused.load(boost::memory_order_relaxed);
 }
 
 PoolData* MemoryPool::getOneAvailableData(const size_t size)
+{
+    PoolData* pBestMatch = NULL;
+    ThreadCache& threadCache = getThreadCache();
+    {
+        // best fit in the few datas released by the current thread
+        boost::mutex::scoped_lock locker(threadCache._mutex);
+        std::vector<PoolData*>::iterator bestMatchIt = threadCache._datas.end();
+        for(std::vector<PoolData*>::iterator it = threadCache._datas.begin(); it != threadCache._datas.end(); ++it)
+        {
+            const std::size_t dataSize = (*it)->reservedSize();
+            // Check minimum amount of memory and do not reuse too big buffers
+            if(dataSize < size || dataSize > maxBufferRatio * size)
+                continue;
+            if(pBestMatch == NULL || dataSize < pBestMatch->reservedSize())
+            {
+                pBestMatch = *it;
+                bestMatchIt = it;
+            }
+        }
+        if(pBestMatch != NULL)
+            threadCache._datas.erase(bestMatchIt);
+    }
+    if(pBestMatch == NULL)
+    {
+        // the smallest shared data big enough
+        boost::mutex::scoped_lock locker(_mutex);
+        DataBySize::iterator it = _dataUnused.lower_bound(size);
+        if(it == _dataUnused.end() || it->first > maxBufferRatio * size)
+        {
+            // the datas released by the other threads are also available
+            if(!flushThreadCaches(&threadCache))
+                return NULL;
+            it = _dataUnused.lower_bound(size);
+            if(it == _dataUnused.end() || it->first > maxBufferRatio * size)
+                return NULL;
+        }
+        pBestMatch = it->second;
+        _dataUnused.erase(it);
+    }
+    _nbDataUnused.fetch_sub(1);
+    _memoryUnused.fetch_sub(pBestMatch->reservedSize());
+    return pBestMatch;
+}
+
+bool MemoryPool::flushThreadCaches(const ThreadCache* except)
+{
+    bool moved = false;
+    for(boost::ptr_vector<ThreadCache>::iterator it = _threadCaches.begin(); it != _threadCaches.end(); ++it)
+    {
+        if(&*it == except)
+            continue;
+        boost::mutex::scoped_lock cacheLocker(it->_mutex);
+        for(std::vector<PoolData*>::const_iterator itData = it->_datas.begin(); itData != it->_datas.end(); ++itData)
+            _dataUnused.insert(DataBySize::value_type((*itData)->reservedSize(), *itData));
+        moved = moved || !it->_datas.empty();
+        it->_datas.clear();
+    }
+    return moved;
+}
+
+std::size_t MemoryPool::clearUnusedDatas(const std::size_t size)
 {
     boost::mutex::scoped_lock locker(_mutex);
-    return std::for_each(_dataUnused.begin(), _dataUnused.end(), DataFitSize(size)).bestMatch();
+    flushThreadCaches(NULL);
+    // release the biggest buffers first
+    std::size_t released = 0;
+    while(released < size && !_dataUnused.empty())
+    {
+        DataBySize::iterator it = _dataUnused.end();
+        --it;
+        released += it->first;
+        deleteUnusedData(it->second);
+        _dataUnused.erase(it);
+    }
+    return released;
 }
 
 void MemoryPool::clear(std::size_t size)
 {
-    /// @todo tuttle
+    clearUnusedDatas(size);
 }
 
 void MemoryPool::clear()
 {
-    boost::mutex::scoped_lock locker(_mutex);
-    _dataUnused.clear();
+    clearUnusedDatas(std::numeric_limits<std::size_t>::max());
 }
 
 void MemoryPool::clearOne()
 {
-    boost::mutex::scoped_lock locker(_mutex);
-    _dataUnused.erase(_dataUnused.begin());
+    clearUnusedDatas(1);
 }
 
 std::ostream& operator<<(std::ostream& os, const MemoryPool& memoryPool)
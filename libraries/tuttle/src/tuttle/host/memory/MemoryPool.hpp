@@ -3,12 +3,14 @@
 
 #include "IMemoryPool.hpp"
 
-#include <boost/ptr_container/ptr_list.hpp>
-#include <boost/unordered_set.hpp>
+#include <tuttle/common/atomic.hpp>
+
+#include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/thread.hpp>
+#include <boost/thread/tss.hpp>
 
 #include <map>
-#include <list>
+#include <vector>
 #include <sstream>
 #include <numeric>
 #include <functional>
@@ -31,6 +33,13 @@ public:
 };
 
 /**
+ * @brief Pool of image buffers.
+ *
+ * Unused buffers are kept to be reused by the next allocations:
+ * first in a small cache of the thread which released them (no contention between threads),
+ * then in a map ordered by size (best fit lookup in O(log n)).
+ * Buffers are aligned on cache lines (64 bytes), big buffers on memory pages.
+ *
  * @todo tuttle: virtual destructor or nothing in virtual
  */
 class MemoryPool : public IMemoryPool, public IPool
@@ -45,6 +54,13 @@ public:
     IPoolDataPtr allocate(const std::size_t size);
     std::size_t updateMemoryAuthorizedWithRAM();
 
+    /**
+     * @brief Ask the system to back the big buffers with huge pages (transparent huge pages on Linux).
+     * Only used by the next allocations. Disabled by default.
+     */
+    void setUseHugePages(const bool useHugePages) { _useHugePages = useHugePages; }
+    bool getUseHugePages() const { return _useHugePages; }
+
     void referenced(PoolData*);
     void released(PoolData*);
 
@@ -58,6 +74,11 @@ public:
     std::size_t getDataUsedSize() const;
     std::size_t getDataUnusedSize() const;
 
+    /**
+     * @brief Get the smallest unused data of at least @p size bytes (and not too big).
+     * The data is no more in the unused datas, so it needs to be referenced by the caller.
+     * @return NULL if there is no such data
+     */
     PoolData* getOneAvailableData(const size_t size);
 
     void clear(std::size_t size);
@@ -67,13 +88,35 @@ public:
     friend std::ostream& operator<<(std::ostream& os, const This& v);
 
 private:
-    typedef boost::unordered_set<PoolData*> DataList;
-    boost::ptr_list<PoolData> _allDatas; // the owner
-    std::map<char*, PoolData*> _dataMap;
-    DataList _dataUsed;
-    DataList _dataUnused;
+    /// @brief Unused datas kept by a thread, to be reused by the same thread without locking the pool.
+    struct ThreadCache
+    {
+        boost::mutex _mutex;
+        std::vector<PoolData*> _datas; ///< the most recently released data last
+    };
+    typedef std::multimap<std::size_t, PoolData*> DataBySize;
+
+    ThreadCache& getThreadCache();
+    void addUnusedData(PoolData* pData);
+    void deleteUnusedData(PoolData* pData);
+    /// @brief Move the datas of the thread caches (but @p except) to the shared datas (_mutex locked by the caller).
+    bool flushThreadCaches(const ThreadCache* except);
+    std::size_t clearUnusedDatas(const std::size_t size);
+
+private:
+    DataBySize _dataUnused; ///< the owner of the unused datas which are not in a thread cache
+    boost::ptr_vector<ThreadCache> _threadCaches;
+    boost::thread_specific_ptr<ThreadCache> _threadCache;
+
+    boost::atomic<std::size_t> _nbDataUsed;
+    boost::atomic<std::size_t> _nbDataUnused;
+    boost::atomic<std::size_t> _memoryUsed;
+    boost::atomic<std::size_t> _memoryUnused;
+    boost::atomic<std::size_t> _memoryWasted;
+
     std::size_t _memoryAuthorized;
-    mutable boost::mutex _mutex;
+    bool _useHugePages;
+    mutable boost::mutex _mutex; ///< protects _dataUnused and _threadCaches
 };
 
 #ifndef SWIG
@@ -74,6 +74,7 @@ OfxhImage::OfxhImage()
     , _clipName("No clip !")
     , _time(0)
 {
+    initReferenceCount();
     TUTTLE_LOG_TRACE("[Ofxh Image] create clip:"
                      << getClipName() << ", time:" << getTime() << ", id:" << getId()
                      << ", ref host:" << getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerHost)
@@ -89,6 +90,7 @@ OfxhImage::OfxhImage(attribute::OfxhClip& instance, const OfxTime time)
     , _clipName(instance.getFullName())
     , _time(time)
 {
+    initReferenceCount();
     TUTTLE_LOG_TRACE("[Ofxh Image] create clip:"
                      << getClipName() << ", time:" << getTime() << ", id:" << getId()
                      << ", ref host:" << getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerHost)
@@ -245,8 +247,17 @@ int OfxhImage::getRowBytes() const
     return getIntProperty(kOfxImagePropRowBytes);
 }
 
+void OfxhImage::initReferenceCount()
+{
+    // Declare all owners at creation, so the map structure is never modified
+    // when an image is shared between frames processed concurrently.
+    _referenceCount[eReferenceOwnerHost] = 0;
+    _referenceCount[eReferenceOwnerPlugin] = 0;
+}
+
 int OfxhImage::getReferenceCount(const EReferenceOwner from) const
 {
+    boost::mutex::scoped_lock lock(_referenceMutex);
     RefMap::const_iterator it = _referenceCount.find(from);
     if(it == _referenceCount.end())
         return 0;
@@ -255,14 +266,22 @@ int OfxhImage::getReferenceCount(const EReferenceOwner from) const
 
 void OfxhImage::addReference(const EReferenceOwner from, const std::size_t n)
 {
-    const std::ptrdiff_t refC = _referenceCount[from] = getReferenceCount(from) + n;
+    std::ptrdiff_t refC = 0;
+    {
+        boost::mutex::scoped_lock lock(_referenceMutex);
+        refC = _referenceCount[from] += n;
+    }
     TUTTLE_LOG_INFO("[Ofxh Image] add reference with degree " << n << ", clipName:" << getClipName() << ", time:"
                                                               << getTime() << ", id:" << getId() << ", ref:" << refC);
 }
 
 bool OfxhImage::releaseReference(const EReferenceOwner from)
 {
-    const std::ptrdiff_t refC = _referenceCount[from] = getReferenceCount(from) - 1;
+    std::ptrdiff_t refC = 0;
+    {
+        boost::mutex::scoped_lock lock(_referenceMutex);
+        refC = --_referenceCount[from];
+    }
     TUTTLE_LOG_INFO("[Ofxh Image] release reference, clipName:" << getClipName() << ", time:" << getTime()
                                                                 << ", id:" << getId() << ", ref:" << refC);
     if(refC < 0)
@@ -38,6 +38,8 @@
 
 #include <ofxImageEffect.h>
 
+#include <boost/thread/mutex.hpp>
+
 namespace tuttle
 {
 namespace host
@@ -68,10 +70,12 @@ public:
 protected:
     /// called during ctors to get bits from the clip props into ours
     void initClipBits(attribute::OfxhClip& instance);
+    void initReferenceCount();
     static std::ptrdiff_t _count; ///< temp.... for check
     std::ptrdiff_t _id;           ///< temp.... for check
     typedef std::map<EReferenceOwner, std::ptrdiff_t> RefMap;
     RefMap _referenceCount; ///< reference count on this image
+    mutable boost::mutex _referenceMutex; ///< an image may be released by nodes processed concurrently
     std::string _clipName;  ///< for debug
     OfxTime _time;          ///< for debug
 
@@ -1476,6 +1476,43 @@ bool OfxhImageEffectNode::getTimeDomainAction(OfxRangeD& range) const OFX_EXCEPT
     return false;
 }
 
+bool OfxhImageEffectNode::getOutputImageBufferAction(OfxTime time, OfxPointD renderScale,
+                                                     OfxhOutputImageBuffer& buffer) const OFX_EXCEPTION_SPEC
+{
+    property::OfxhPropSpec inStuff[] = {{kOfxPropTime, property::ePropTypeDouble, 1, true, "0"},
+                                        {kOfxImageEffectPropRenderScale, property::ePropTypeDouble, 2, true, "0"},
+                                        {0}};
+
+    property::OfxhPropSpec outStuff[] = {{kOfxImagePropData, property::ePropTypePointer, 1, false, NULL},
+                                         {kOfxImagePropRowBytes, property::ePropTypeInt, 1, false, "0"},
+                                         {kOfxImagePropBounds, property::ePropTypeInt, 4, false, "0"},
+                                         {kTuttleOfxImagePropBufferRelease, property::ePropTypePointer, 1, false, NULL},
+                                         {kTuttleOfxImagePropBufferReleaseCustomData, property::ePropTypePointer, 1, false,
+                                          NULL},
+                                         {0}};
+
+    property::OfxhSet inArgs(inStuff);
+    property::OfxhSet outArgs(outStuff);
+
+    inArgs.setDoubleProperty(kOfxPropTime, time);
+    inArgs.setDoublePropertyN(kOfxImageEffectPropRenderScale, &renderScale.x, 2);
+
+    OfxStatus status = mainEntry(kTuttleOfxImageEffectActionGetOutputImageBuffer, this->getHandle(), &inArgs, &outArgs);
+
+    if(status == kOfxStatReplyDefault)
+        return false;
+    if(status != kOfxStatOK)
+        BOOST_THROW_EXCEPTION(OfxhException(status, "getOutputImageBufferAction error."));
+
+    buffer._data = outArgs.getPointerProperty(kOfxImagePropData);
+    buffer._rowBytes = outArgs.getIntProperty(kOfxImagePropRowBytes);
+    outArgs.getIntPropertyN(kOfxImagePropBounds, &buffer._bounds.x1, 4);
+    buffer._release =
+        reinterpret_cast<TuttleOfxImageBufferReleaseFunc>(outArgs.getPointerProperty(kTuttleOfxImagePropBufferRelease));
+    buffer._releaseCustomData = outArgs.getPointerProperty(kTuttleOfxImagePropBufferReleaseCustomData);
+    return buffer._data != NULL;
+}
+
 /**
  * implemented for Param::SetInstance
  */
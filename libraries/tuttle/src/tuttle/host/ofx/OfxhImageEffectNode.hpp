@@ -58,6 +58,18 @@ namespace ofx
 namespace imageEffect
 {
 
+/**
+ * @brief Output image buffer given by a plugin (see kTuttleOfxImageEffectActionGetOutputImageBuffer).
+ */
+struct OfxhOutputImageBuffer
+{
+    void* _data;      ///< bottom left corner of the image
+    int _rowBytes;    ///< negative if the rows are from top to bottom in memory
+    OfxRectI _bounds; ///< bounds in pixels
+    TuttleOfxImageBufferReleaseFunc _release;
+    void* _releaseCustomData;
+};
+
 /**
  *  an image effect plugin instance.
  *
@@ -362,6 +374,10 @@ public:
     // time domain
     virtual bool getTimeDomainAction(OfxRangeD& range) const OFX_EXCEPTION_SPEC;
 
+    /// output image buffer given by the plugin (tuttle extension), return false if the host needs to render it
+    virtual bool getOutputImageBufferAction(OfxTime time, OfxPointD renderScale,
+                                            OfxhOutputImageBuffer& buffer) const OFX_EXCEPTION_SPEC;
+
     /**
      * Get the interact description, this will also call describe on the interact
      * This will return NULL if there is not main entry point or if the description failed
@@ -158,6 +158,12 @@ private:
         ar& BOOST_SERIALIZATION_NVP(_baseDescriptor);
         // ar & BOOST_SERIALIZATION_NVP(_pluginLoadGuard); // don't save this
         ar& BOOST_SERIALIZATION_NVP(_contexts);
+
+        if(typename Archive::is_loading())
+        {
+            // the supported contexts are known without loading the plugin binary
+            initContexts();
+        }
     }
 };
 }
@@ -136,6 +136,7 @@ public:
     /// set the version string to write to the cache,
     /// and also that we expect on cachess read in
     void setCacheVersion(const std::string& cacheVersion) { _cacheVersion = cacheVersion; }
+    const std::string& getCacheVersion() const { return _cacheVersion; }
 
     // populate the cache.  must call scanPluginFiles() after to check for changes.
     // void readCache( std::istream& is );
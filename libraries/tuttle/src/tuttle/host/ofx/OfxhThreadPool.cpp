@@ -0,0 +1,420 @@
+#include "OfxhThreadPool.hpp"
+
+#include <tuttle/common/utils/global.hpp>
+#include <tuttle/common/exceptions.hpp>
+
+#include <boost/thread/tss.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+namespace tuttle
+{
+namespace host
+{
+namespace ofx
+{
+
+namespace
+{
+
+/**
+ * @brief What the current thread is doing for the thread pool.
+ */
+struct ThreadContext
+{
+    ThreadContext()
+        : _pool(NULL)
+        , _workerIndex(-1)
+        , _inTask(false)
+        , _taskIndex(0)
+    {
+    }
+    const OfxhThreadPool* _pool; ///< pool owning this thread (NULL if not a worker)
+    int _workerIndex;
+    bool _inTask;
+    unsigned int _taskIndex;
+};
+
+boost::thread_specific_ptr<ThreadContext> threadContext;
+
+ThreadContext& getThreadContext()
+{
+    if(threadContext.get() == NULL)
+        threadContext.reset(new ThreadContext());
+    return *threadContext;
+}
+
+boost::uint64_t elapsedMicroseconds(const boost::posix_time::ptime& t)
+{
+    return (boost::posix_time::microsec_clock::universal_time() - t).total_microseconds();
+}
+}
+
+struct OfxhThreadPool::Job
+{
+    Job(OfxThreadFunctionV1 func, const unsigned int nThreads, void* customArg)
+        : _func(func)
+        , _nThreads(nThreads)
+        , _customArg(customArg)
+        , _nbRemainingTasks(nThreads)
+        , _failed(false)
+    {
+    }
+
+    OfxThreadFunctionV1* _func;
+    unsigned int _nThreads;
+    void* _customArg;
+
+    boost::mutex _mutex;
+    boost::condition_variable _cond;
+    unsigned int _nbRemainingTasks;
+    bool _failed;
+};
+
+OfxhThreadPool::Statistics& OfxhThreadPool::Statistics::operator+=(const Statistics& other)
+{
+    _nbJobs += other._nbJobs;
+    _nbTasks += other._nbTasks;
+    _nbStolenTasks += other._nbStolenTasks;
+    _idleTime += other._idleTime;
+    _stealTime += other._stealTime;
+    return *this;
+}
+
+std::ostream& operator<<(std::ostream& os, const OfxhThreadPool::Statistics& v)
+{
+    os << "jobs: " << v._nbJobs << ", tasks: " << v._nbTasks << ", stolen tasks: " << v._nbStolenTasks
+       << ", idle time: " << v._idleTime / 1000 << "ms, steal time: " << v._stealTime / 1000 << "ms";
+    return os;
+}
+
+OfxhThreadPool::OfxhThreadPool(const std::size_t nbThreads)
+    : _requestedNbThreads(nbThreads)
+    , _nbPendingTasks(0)
+    , _stop(false)
+    , _nextWorker(0)
+{
+}
+
+OfxhThreadPool::~OfxhThreadPool()
+{
+    boost::unique_lock<boost::shared_mutex> lock(_mutexThreads);
+    stop();
+}
+
+std::size_t OfxhThreadPool::nbThreadsFromCPUs(const std::size_t nbThreads)
+{
+    if(nbThreads)
+        return nbThreads;
+    return std::max(boost::thread::hardware_concurrency(), 1u);
+}
+
+void OfxhThreadPool::setNbThreads(const std::size_t nbThreads)
+{
+    {
+        boost::shared_lock<boost::shared_mutex> lock(_mutexThreads);
+        if(nbThreadsFromCPUs(nbThreads) == nbThreadsFromCPUs(_requestedNbThreads))
+            return;
+    }
+    boost::unique_lock<boost::shared_mutex> lock(_mutexThreads);
+    const bool started = !_workers.empty();
+    stop();
+    _requestedNbThreads = nbThreads;
+    if(started)
+        start();
+}
+
+std::size_t OfxhThreadPool::getNbThreads() const
+{
+    boost::shared_lock<boost::shared_mutex> lock(_mutexThreads);
+    return nbThreadsFromCPUs(_requestedNbThreads);
+}
+
+void OfxhThreadPool::start()
+{
+    const std::size_t nbThreads = nbThreadsFromCPUs(_requestedNbThreads);
+    TUTTLE_LOG_DEBUG("[Multi thread] Start thread pool with " << nbThreads << " threads.");
+    _stop = false;
+    for(std::size_t i = 0; i < nbThreads; ++i)
+        _workers.push_back(new Worker());
+    _threads.reset(new boost::thread_group());
+    for(std::size_t i = 0; i < nbThreads; ++i)
+        _threads->create_thread(boost::bind(&OfxhThreadPool::workerLoop, this, i));
+}
+
+void OfxhThreadPool::stop()
+{
+    if(_workers.empty())
+        return;
+    {
+        boost::mutex::scoped_lock lock(_mutexWakeUp);
+        _stop = true;
+    }
+    _condWakeUp.notify_all();
+    _threads->join_all();
+    _threads.reset();
+
+    // keep the statistics of the destroyed workers
+    boost::mutex::scoped_lock lock(_mutexWakeUp);
+    for(boost::ptr_vector<Worker>::iterator it = _workers.begin(); it != _workers.end(); ++it)
+        _externalStats += it->_stats;
+    _workers.clear();
+}
+
+OfxStatus OfxhThreadPool::run(OfxThreadFunctionV1 func, const unsigned int nThreads, void* customArg)
+{
+    ThreadContext& context = getThreadContext();
+    const bool isWorker = context._pool == this;
+
+    // A task calling run() is already protected by the lock of its caller.
+    boost::shared_lock<boost::shared_mutex> lock(_mutexThreads, boost::defer_lock);
+    if(!context._inTask)
+    {
+        lock.lock();
+        if(_workers.empty())
+        {
+            lock.unlock();
+            {
+                boost::unique_lock<boost::shared_mutex> uniqueLock(_mutexThreads);
+                if(_workers.empty())
+                    start();
+            }
+            lock.lock();
+        }
+    }
+
+    Job job(func, nThreads, customArg);
+    const std::size_t nbWorkers = _workers.size();
+    std::size_t firstWorker = 0;
+    {
+        boost::mutex::scoped_lock lockWakeUp(_mutexWakeUp);
+        ++_externalStats._nbJobs;
+        // counted before being queued, so the counter can't be decremented first
+        _nbPendingTasks += nThreads;
+        firstWorker = _nextWorker;
+        _nextWorker = (_nextWorker + nThreads) % nbWorkers;
+    }
+    if(isWorker)
+    {
+        // other workers will steal the tasks from the front of the queue
+        Worker& worker = _workers[context._workerIndex];
+        boost::mutex::scoped_lock lockWorker(worker._mutex);
+        for(unsigned int i = 0; i < nThreads; ++i)
+        {
+            const Task task = {&job, nThreads - 1 - i};
+            worker._tasks.push_back(task);
+        }
+    }
+    else
+    {
+        for(unsigned int i = 0; i < nThreads; ++i)
+        {
+            Worker& worker = _workers[(firstWorker + i) % nbWorkers];
+            const Task task = {&job, i};
+            boost::mutex::scoped_lock lockWorker(worker._mutex);
+            worker._tasks.push_back(task);
+        }
+    }
+    _condWakeUp.notify_all();
+
+    // help the workers until the end of the job
+    for(;;)
+    {
+        {
+            boost::mutex::scoped_lock lockJob(job._mutex);
+            if(job._nbRemainingTasks == 0)
+                break;
+        }
+        Task task;
+        if(popTask(isWorker ? context._workerIndex : -1, task))
+        {
+            executeTask(task);
+            continue;
+        }
+        // all the tasks of this job are already running
+        boost::mutex::scoped_lock lockJob(job._mutex);
+        while(job._nbRemainingTasks)
+            job._cond.wait(lockJob);
+        break;
+    }
+
+    return job._failed ? kOfxStatFailed : kOfxStatOK;
+}
+
+void OfxhThreadPool::workerLoop(const std::size_t workerIndex)
+{
+    ThreadContext& context = getThreadContext();
+    context._pool = this;
+    context._workerIndex = static_cast<int>(workerIndex);
+
+    for(;;)
+    {
+        Task task;
+        if(popTask(context._workerIndex, task))
+        {
+            executeTask(task);
+            continue;
+        }
+
+        const boost::posix_time::ptime t(boost::posix_time::microsec_clock::universal_time());
+        {
+            boost::mutex::scoped_lock lock(_mutexWakeUp);
+            while(_nbPendingTasks == 0 && !_stop)
+                _condWakeUp.wait(lock);
+            if(_nbPendingTasks == 0 && _stop)
+                return;
+        }
+        Worker& worker = _workers[workerIndex];
+        boost::mutex::scoped_lock lockWorker(worker._mutex);
+        worker._stats._idleTime += elapsedMicroseconds(t);
+    }
+}
+
+/**
+ * @brief Get a task from the queue of the worker @p workerIndex, or steal a task from another worker.
+ * @param workerIndex -1 for a thread outside the pool
+ */
+bool OfxhThreadPool::popTask(const int workerIndex, Task& task)
+{
+    const std::size_t nbWorkers = _workers.size();
+    bool found = false;
+    if(workerIndex >= 0)
+    {
+        // LIFO on its own queue
+        Worker& worker = _workers[workerIndex];
+        boost::mutex::scoped_lock lock(worker._mutex);
+        if(!worker._tasks.empty())
+        {
+            task = worker._tasks.back();
+            worker._tasks.pop_back();
+            ++worker._stats._nbTasks;
+            found = true;
+        }
+    }
+
+    if(!found)
+    {
+        // FIFO on the queues of the other workers
+        const boost::posix_time::ptime t(boost::posix_time::microsec_clock::universal_time());
+        const std::size_t first = workerIndex >= 0 ? workerIndex + 1 : 0;
+        for(std::size_t i = 0; !found && i < nbWorkers; ++i)
+        {
+            Worker& victim = _workers[(first + i) % nbWorkers];
+            if(static_cast<int>((first + i) % nbWorkers) == workerIndex)
+                continue;
+            boost::mutex::scoped_lock lock(victim._mutex);
+            if(!victim._tasks.empty())
+            {
+                task = victim._tasks.front();
+                victim._tasks.pop_front();
+                found = true;
+            }
+        }
+        const boost::uint64_t stealTime = elapsedMicroseconds(t);
+        if(workerIndex >= 0)
+        {
+            Worker& worker = _workers[workerIndex];
+            boost::mutex::scoped_lock lock(worker._mutex);
+            worker._stats._stealTime += stealTime;
+            if(found)
+            {
+                ++worker._stats._nbTasks;
+                ++worker._stats._nbStolenTasks;
+            }
+        }
+        else
+        {
+            boost::mutex::scoped_lock lock(_mutexWakeUp);
+            _externalStats._stealTime += stealTime;
+            if(found)
+            {
+                ++_externalStats._nbTasks;
+                ++_externalStats._nbStolenTasks;
+            }
+        }
+    }
+
+    if(found)
+    {
+        boost::mutex::scoped_lock lock(_mutexWakeUp);
+        --_nbPendingTasks;
+    }
+    return found;
+}
+
+void OfxhThreadPool::executeTask(const Task& task)
+{
+    Job& job = *task._job;
+    ThreadContext& context = getThreadContext();
+    // tasks could be nested, if a task calls multiThread
+    const bool previousInTask = context._inTask;
+    const unsigned int previousTaskIndex = context._taskIndex;
+    context._inTask = true;
+    context._taskIndex = task._index;
+
+    bool failed = false;
+    try
+    {
+        job._func(task._index, job._nThreads, job._customArg);
+    }
+    catch(...)
+    {
+        TUTTLE_LOG_ERROR("[Multi thread] Exception in thread " << task._index << "/" << job._nThreads << "."
+                                                               << std::endl
+                                                               << tuttle::exception::format_current_exception());
+        failed = true;
+    }
+
+    context._inTask = previousInTask;
+    context._taskIndex = previousTaskIndex;
+
+    boost::mutex::scoped_lock lock(job._mutex);
+    job._failed = job._failed || failed;
+    if(--job._nbRemainingTasks == 0)
+        job._cond.notify_all();
+}
+
+OfxhThreadPool::Statistics OfxhThreadPool::getStatistics() const
+{
+    boost::shared_lock<boost::shared_mutex> lock(_mutexThreads);
+    Statistics stats;
+    {
+        boost::mutex::scoped_lock lockWakeUp(_mutexWakeUp);
+        stats = _externalStats;
+    }
+    for(boost::ptr_vector<Worker>::const_iterator it = _workers.begin(); it != _workers.end(); ++it)
+    {
+        boost::mutex::scoped_lock lockWorker(const_cast<Worker&>(*it)._mutex);
+        stats += it->_stats;
+    }
+    return stats;
+}
+
+void OfxhThreadPool::resetStatistics()
+{
+    boost::shared_lock<boost::shared_mutex> lock(_mutexThreads);
+    {
+        boost::mutex::scoped_lock lockWakeUp(_mutexWakeUp);
+        _externalStats = Statistics();
+    }
+    for(boost::ptr_vector<Worker>::iterator it = _workers.begin(); it != _workers.end(); ++it)
+    {
+        boost::mutex::scoped_lock lockWorker(it->_mutex);
+        it->_stats = Statistics();
+    }
+}
+
+bool OfxhThreadPool::getCurrentThreadIndex(unsigned int& threadIndex)
+{
+    if(threadContext.get() == NULL || !threadContext->_inTask)
+    {
+        threadIndex = 0;
+        return false;
+    }
+    threadIndex = threadContext->_taskIndex;
+    return true;
+}
+}
+}
+}
@@ -0,0 +1,129 @@
+#ifndef _TUTTLE_HOST_OFX_THREADPOOL_HPP_
+#define _TUTTLE_HOST_OFX_THREADPOOL_HPP_
+
+#include <ofxMultiThread.h>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/cstdint.hpp>
+
+#include <deque>
+#include <iostream>
+
+namespace tuttle
+{
+namespace host
+{
+namespace ofx
+{
+
+/**
+ * @brief Persistent pool of threads used by the OFX MultiThread suite.
+ *
+ * Threads are created once and reused by all multiThread calls, instead of creating
+ * new threads for each process of each node at each frame.
+ * Each worker has its own queue of tasks, and steals tasks from the other workers when its queue is empty.
+ * The thread calling run() also executes tasks while waiting, so nested calls can't deadlock.
+ */
+class OfxhThreadPool
+{
+public:
+    typedef OfxhThreadPool This;
+
+    /// @brief Counters of the thread pool activity (times in microseconds).
+    struct Statistics
+    {
+        Statistics()
+            : _nbJobs(0)
+            , _nbTasks(0)
+            , _nbStolenTasks(0)
+            , _idleTime(0)
+            , _stealTime(0)
+        {
+        }
+        boost::uint64_t _nbJobs;        ///< number of multiThread calls
+        boost::uint64_t _nbTasks;       ///< number of tasks executed (one per thread index)
+        boost::uint64_t _nbStolenTasks; ///< tasks executed by another thread than the one they were queued to
+        boost::uint64_t _idleTime;      ///< time spent by the workers waiting for tasks
+        boost::uint64_t _stealTime;     ///< time spent searching tasks in the queues of other threads
+
+        Statistics& operator+=(const Statistics& other);
+        friend std::ostream& operator<<(std::ostream& os, const Statistics& v);
+    };
+
+private:
+    struct Job;
+    struct Task
+    {
+        Job* _job;
+        unsigned int _index;
+    };
+    struct Worker
+    {
+        boost::mutex _mutex; ///< protects the tasks and the statistics of this worker
+        std::deque<Task> _tasks;
+        Statistics _stats;
+    };
+
+public:
+    /**
+     * @param nbThreads number of worker threads, 0 means one per CPU.
+     * Threads are only created on the first use.
+     */
+    explicit OfxhThreadPool(const std::size_t nbThreads = 0);
+    ~OfxhThreadPool();
+
+    /**
+     * @brief Change the number of worker threads, 0 means one per CPU.
+     * Waits for the end of the running jobs.
+     */
+    void setNbThreads(const std::size_t nbThreads);
+    std::size_t getNbThreads() const;
+
+    /**
+     * @brief Call @p func with each thread index in [0, nThreads) and wait for the end of all calls.
+     * @return kOfxStatFailed if an exception escaped from one of the calls.
+     */
+    OfxStatus run(OfxThreadFunctionV1 func, const unsigned int nThreads, void* customArg);
+
+    Statistics getStatistics() const;
+    void resetStatistics();
+
+    /**
+     * @brief Thread index of the task executed by the calling thread.
+     * @return false if the calling thread isn't executing a task of a thread pool.
+     */
+    static bool getCurrentThreadIndex(unsigned int& threadIndex);
+
+private:
+    static std::size_t nbThreadsFromCPUs(const std::size_t nbThreads);
+    void start();
+    void stop();
+    void workerLoop(const std::size_t workerIndex);
+    bool popTask(const int workerIndex, Task& task);
+    void executeTask(const Task& task);
+
+private:
+    std::size_t _requestedNbThreads;
+    boost::ptr_vector<Worker> _workers;
+    boost::scoped_ptr<boost::thread_group> _threads;
+
+    /// running jobs hold a shared lock, threads are only created or destroyed with a unique lock
+    mutable boost::shared_mutex _mutexThreads;
+
+    mutable boost::mutex _mutexWakeUp; ///< protects the members below
+    boost::condition_variable _condWakeUp;
+    std::size_t _nbPendingTasks;
+    bool _stop;
+    std::size_t _nextWorker; ///< round robin over the workers for the tasks queued from outside the pool
+    Statistics _externalStats; ///< tasks executed by threads outside the pool
+};
+}
+}
+}
+
+#endif
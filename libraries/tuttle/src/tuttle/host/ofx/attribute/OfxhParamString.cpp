@@ -3,6 +3,10 @@
 #include <boost/functional/hash.hpp>
 #include <boost/filesystem/operations.hpp>
 
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
 namespace tuttle
 {
 namespace host
@@ -12,6 +16,53 @@ namespace ofx
 namespace attribute
 {
 
+namespace
+{
+/**
+ * @brief Filename of the frame @p time of a sequence, like the readers get it from the pattern:
+ * "####" (padded with zeros to the number of '#'), "@" (no padding) or "%04d".
+ * @return false if the filename of @p pattern has no frame pattern.
+ */
+bool getFilenameAtTime(const std::string& pattern, const OfxTime time, std::string& filename)
+{
+    const std::size_t dirEnd = pattern.find_last_of("/\\");
+    const std::size_t nameBegin = (dirEnd == std::string::npos) ? 0 : dirEnd + 1;
+    std::size_t begin = pattern.find_first_of("#@%", nameBegin);
+    while(begin != std::string::npos)
+    {
+        std::size_t end = begin;
+        int padding = 0;
+        if(pattern[begin] == '%')
+        {
+            // printf style: %d or %0Nd
+            std::size_t digitsEnd = pattern.find_first_not_of("0123456789", begin + 1);
+            if(digitsEnd != std::string::npos && pattern[digitsEnd] == 'd')
+            {
+                padding = std::atoi(pattern.substr(begin + 1, digitsEnd - begin - 1).c_str());
+                end = digitsEnd + 1;
+            }
+        }
+        else
+        {
+            end = pattern.find_first_not_of(pattern[begin], begin);
+            if(end == std::string::npos)
+                end = pattern.size();
+            if(pattern[begin] == '#')
+                padding = int(end - begin);
+        }
+        if(end != begin)
+        {
+            char frame[32];
+            std::sprintf(frame, "%0*d", padding, int(std::floor(time)));
+            filename = pattern.substr(0, begin) + frame + pattern.substr(end);
+            return true;
+        }
+        begin = pattern.find_first_of("#@%", begin + 1);
+    }
+    return false;
+}
+}
+
 const std::string& OfxhParamString::getStringMode() const
 {
     return getProperties().getStringProperty(kOfxParamPropStringMode);
@@ -66,9 +117,20 @@ std::size_t OfxhParamString::getHashAtTime(const OfxTime time) const
     std::size_t seed = boost::hash_value(value);
     if(getStringMode() == kOfxParamStringIsFilePath)
     {
-        if(boost::filesystem::exists(value))
+        // The content of an input file at this time is part of the hash,
+        // so an image cached by hash is not reused after the file is modified.
+        std::string filename;
+        if(!boost::filesystem::exists(value) && getProperties().getIntProperty(kOfxParamPropStringFilePathExists))
+            getFilenameAtTime(value, time, filename);
+        else
+            filename = value;
+        boost::system::error_code error;
+        const std::time_t lastWriteTime = boost::filesystem::last_write_time(filename, error);
+        if(!error)
         {
-            boost::hash_combine(seed, boost::filesystem::last_write_time(value));
+            boost::hash_combine(seed, lastWriteTime);
+            // the modification time is in seconds, the size changes with most edits in the same second
+            boost::hash_combine(seed, boost::filesystem::file_size(filename, error));
         }
     }
     return seed;
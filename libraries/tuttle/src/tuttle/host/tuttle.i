@@ -1,5 +1,3 @@
-%module tuttle
-
 %module(directors="1", threads="1") tuttle
 
 %include <tuttle/host/version.hpp>
@@ -0,0 +1,165 @@
+#ifndef _TUTTLE_IOPLUGIN_CONTEXT_READAHEAD_HPP_
+#define _TUTTLE_IOPLUGIN_CONTEXT_READAHEAD_HPP_
+
+#include "ReaderPlugin.hpp"
+#include "ReadAheadQueue.hpp"
+
+#include <tuttle/plugin/ImageGilProcessor.hpp>
+
+#include <ofxsImageEffect.h>
+
+#include <boost/gil/algorithm.hpp>
+#include <boost/gil/image_view_factory.hpp>
+#include <boost/foreach.hpp>
+#include <boost/function.hpp>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace tuttle
+{
+namespace plugin
+{
+
+/**
+ * @brief Read the next frames of a sequence in background threads, with the read-ahead queue of the ReaderPlugin.
+ *
+ * Each render requests the next frames (with the same region of definition), decoded by ReaderProcess
+ * into buffers of the OFX memory suite. If the frame was read in advance, the render only copies it to the output
+ * image, otherwise the ReaderProcess reads it synchronously.
+ *
+ * @warning multiThreadProcessImages of the ReaderProcess must only use _params (from getProcessParams)
+ *          and write into _dstView.
+ *
+ * Usage: doGilRender<ReadAhead<MyReaderProcess>::Process>( *this, args );
+ */
+template <template <class> class ReaderProcess>
+struct ReadAhead
+{
+    template <class View>
+    class Process
+    {
+    private:
+        typedef typename View::value_type Pixel;
+
+        class Reader : public ReaderProcess<View>
+        {
+        public:
+            typedef ReaderProcess<View> Parent;
+
+        public:
+            template <class Plugin>
+            Reader(Plugin& plugin)
+                : Parent(plugin)
+            {
+            }
+
+            /// @brief Setup the reader to decode the frame at @p time into @p dst, without OFX image.
+            void setupReadAhead(const OfxTime time, const OfxRectI& pixelRod, const View& dst)
+            {
+                this->_renderArgs.time = time;
+                this->_renderArgs.renderWindow = pixelRod;
+                this->_dstPixelRod = pixelRod;
+                this->_dstPixelRodSize.x = pixelRod.x2 - pixelRod.x1;
+                this->_dstPixelRodSize.y = pixelRod.y2 - pixelRod.y1;
+                this->_dstView = dst;
+                this->_params = this->_plugin.getProcessParams(time);
+            }
+
+            void read() { this->multiThreadFunction(0, 1); }
+
+            /// @brief Only fetch the output image (no access to the file).
+            void setupOutput(const OFX::RenderArguments& args)
+            {
+                this->_renderArgs = args;
+                this->ImageGilProcessor<View>::setup(args);
+            }
+
+            const View& getDstView() const { return this->_dstView; }
+            const OfxRectI& getDstPixelRod() const { return this->_dstPixelRod; }
+        };
+
+        class Frame : public ReadAheadFrame
+        {
+        public:
+            template <class Plugin>
+            Frame(Plugin& plugin, const OfxTime time, const OfxRectI& pixelRod)
+                : _reader(plugin)
+                , _pixelRod(pixelRod)
+                , _memory((pixelRod.x2 - pixelRod.x1) * (pixelRod.y2 - pixelRod.y1) * sizeof(Pixel), &plugin)
+            {
+                const int width = pixelRod.x2 - pixelRod.x1;
+                const int height = pixelRod.y2 - pixelRod.y1;
+                _view = boost::gil::interleaved_view(width, height, static_cast<Pixel*>(_memory.lock()),
+                                                     width * sizeof(Pixel));
+                _reader.setupReadAhead(time, pixelRod, _view);
+            }
+            ~Frame() { _memory.unlock(); }
+
+            void read() { _reader.read(); }
+
+            const View& getView() const { return _view; }
+            const OfxRectI& getPixelRod() const { return _pixelRod; }
+
+        private:
+            Reader _reader;
+            OfxRectI _pixelRod;
+            OFX::ImageMemory _memory;
+            View _view;
+        };
+
+        template <class Plugin>
+        static boost::shared_ptr<ReadAheadFrame> newFrame(Plugin& plugin, const OfxTime time, const OfxRectI& pixelRod)
+        {
+            return boost::make_shared<Frame>(boost::ref(plugin), time, pixelRod);
+        }
+
+    public:
+        template <class Plugin>
+        Process(Plugin& plugin)
+            : _plugin(plugin)
+            , _reader(plugin)
+            , _newFrame(boost::bind(&Process::template newFrame<Plugin>, boost::ref(plugin), _1, _2))
+        {
+        }
+
+        void setupAndProcess(const OFX::RenderArguments& args)
+        {
+            ReadAheadQueue* queue = _plugin.getReadAheadQueue();
+            if(!queue)
+            {
+                _reader.setupAndProcess(args);
+                return;
+            }
+
+            const boost::shared_ptr<ReadAheadFrame> readFrame = queue->acquire(args.time);
+
+            // the readers always render the full region of definition
+            BOOST_FOREACH(const OfxTime time, queue->getFramesToRead(args.time))
+            {
+                queue->push(time, _newFrame(time, args.renderWindow));
+            }
+
+            const Frame* frame = dynamic_cast<const Frame*>(readFrame.get());
+            if(frame)
+            {
+                _reader.setupOutput(args);
+                if(frame->getPixelRod() == _reader.getDstPixelRod() && frame->getPixelRod() == args.renderWindow)
+                {
+                    boost::gil::copy_pixels(frame->getView(), _reader.getDstView());
+                    return;
+                }
+            }
+            _reader.setupAndProcess(args);
+        }
+
+    private:
+        ReaderPlugin& _plugin;
+        Reader _reader;
+        boost::function<boost::shared_ptr<ReadAheadFrame>(const OfxTime, const OfxRectI&)> _newFrame;
+    };
+};
+}
+}
+
+#endif
@@ -0,0 +1,206 @@
+#include "ReadAheadQueue.hpp"
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/common/exceptions.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <algorithm>
+#include <ostream>
+
+namespace tuttle
+{
+namespace plugin
+{
+
+ReadAheadQueue::ReadAheadQueue(const std::size_t nbThreads, const std::size_t nbFrames)
+    : _nbThreads(std::max(nbThreads, std::size_t(1)))
+    , _nbFrames(nbFrames)
+    , _first(0)
+    , _last(0)
+    , _step(1.0)
+    , _stop(false)
+{
+}
+
+ReadAheadQueue::~ReadAheadQueue()
+{
+    endSequence();
+}
+
+void ReadAheadQueue::beginSequence(const OfxTime first, const OfxTime last, const double step)
+{
+    endSequence();
+
+    boost::mutex::scoped_lock lock(_mutex);
+    _first = first;
+    _last = last;
+    _step = step > 0 ? step : 1.0;
+    _statistics = Statistics();
+}
+
+void ReadAheadQueue::endSequence()
+{
+    boost::scoped_ptr<boost::thread_group> threads;
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        _stop = true;
+        _pending.clear();
+        threads.swap(_threads);
+    }
+    _condPending.notify_all();
+    if(threads)
+        threads->join_all();
+
+    boost::mutex::scoped_lock lock(_mutex);
+    _frames.clear();
+    _stop = false;
+}
+
+std::vector<OfxTime> ReadAheadQueue::getFramesToRead(const OfxTime time) const
+{
+    std::vector<OfxTime> frames;
+    boost::mutex::scoped_lock lock(_mutex);
+    std::size_t nbFrames = _frames.size();
+    for(std::size_t i = 1; i <= _nbFrames && nbFrames < _nbFrames; ++i)
+    {
+        const OfxTime t = time + i * _step;
+        if(t < _first || t > _last)
+            break;
+        if(_frames.find(t) != _frames.end())
+            continue;
+        frames.push_back(t);
+        ++nbFrames;
+    }
+    return frames;
+}
+
+void ReadAheadQueue::push(const OfxTime time, const boost::shared_ptr<ReadAheadFrame>& frame)
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    Entry& entry = _frames[time];
+    entry._state = eFrameStatePending;
+    entry._frame = frame;
+    entry._error = boost::exception_ptr();
+    _pending.push_back(time);
+
+    if(!_threads)
+    {
+        _threads.reset(new boost::thread_group());
+        for(std::size_t i = 0; i < _nbThreads; ++i)
+            _threads->create_thread(boost::bind(&ReadAheadQueue::worker, this));
+    }
+    _condPending.notify_one();
+}
+
+boost::shared_ptr<ReadAheadFrame> ReadAheadQueue::acquire(const OfxTime time)
+{
+    boost::shared_ptr<ReadAheadFrame> frame;
+    boost::mutex::scoped_lock lock(_mutex);
+
+    // the frames too far behind will not be asked anymore
+    const OfxTime oldest = time - _nbFrames * _step;
+    for(FrameMap::iterator it = _frames.begin(); it != _frames.end() && it->first < oldest;)
+    {
+        if(it->second._state == eFrameStateReading)
+        {
+            ++it;
+            continue;
+        }
+        _pending.erase(std::remove(_pending.begin(), _pending.end(), it->first), _pending.end());
+        _frames.erase(it++);
+    }
+
+    FrameMap::iterator it = _frames.find(time);
+    if(it == _frames.end())
+    {
+        ++_statistics._nbMisses;
+        return frame;
+    }
+    if(it->second._state == eFrameStatePending)
+    {
+        // not started, the reader is faster in the render thread
+        _pending.erase(std::remove(_pending.begin(), _pending.end(), time), _pending.end());
+        _frames.erase(it);
+        ++_statistics._nbMisses;
+        return frame;
+    }
+    if(it->second._state == eFrameStateReading)
+    {
+        const boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+        while(it->second._state == eFrameStateReading)
+            _condDone.wait(lock);
+        const boost::posix_time::time_duration stall = boost::posix_time::microsec_clock::universal_time() - begin;
+        _statistics._stallTime += stall.total_microseconds() / 1000000.0;
+    }
+
+    if(it->second._error)
+    {
+        TUTTLE_LOG_DEBUG("[Read ahead] Error at time " << time << ", the frame will be read again:" << std::endl
+                                                       << boost::diagnostic_information(it->second._error));
+        ++_statistics._nbMisses;
+    }
+    else
+    {
+        frame = it->second._frame;
+        ++_statistics._nbHits;
+    }
+    _frames.erase(it);
+    return frame;
+}
+
+ReadAheadQueue::Statistics ReadAheadQueue::getStatistics() const
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    return _statistics;
+}
+
+void ReadAheadQueue::worker()
+{
+    for(;;)
+    {
+        OfxTime time;
+        boost::shared_ptr<ReadAheadFrame> frame;
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            while(_pending.empty() && !_stop)
+                _condPending.wait(lock);
+            if(_stop)
+                return;
+            time = _pending.front();
+            _pending.pop_front();
+            Entry& entry = _frames[time];
+            entry._state = eFrameStateReading;
+            frame = entry._frame;
+        }
+
+        boost::exception_ptr error;
+        try
+        {
+            frame->read();
+        }
+        catch(...)
+        {
+            error = boost::current_exception();
+        }
+
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            Entry& entry = _frames[time];
+            entry._state = eFrameStateDone;
+            entry._error = error;
+        }
+        _condDone.notify_all();
+    }
+}
+
+std::ostream& operator<<(std::ostream& os, const ReadAheadQueue::Statistics& statistics)
+{
+    os << "hits: " << statistics._nbHits << ", misses: " << statistics._nbMisses
+       << ", stall time: " << statistics._stallTime << "s";
+    return os;
+}
+}
+}
@@ -0,0 +1,126 @@
+#ifndef _TUTTLE_IOPLUGIN_CONTEXT_READAHEADQUEUE_HPP_
+#define _TUTTLE_IOPLUGIN_CONTEXT_READAHEADQUEUE_HPP_
+
+#include <ofxCore.h>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+namespace tuttle
+{
+namespace plugin
+{
+
+/**
+ * @brief A frame read in advance, it owns the decoded image.
+ */
+class ReadAheadFrame
+{
+public:
+    virtual ~ReadAheadFrame() {}
+
+    /// @brief Read and decode the image (called by a background thread).
+    virtual void read() = 0;
+};
+
+/**
+ * @brief Read the next frames of a sequence in background threads, before the host asks for them.
+ *
+ * The frames are requested in the render thread (see ReadAhead), and retrieved with acquire() when the host renders
+ * them. A frame which is not ready is read synchronously by the reader, so an error is always reported by the render of
+ * the frame itself.
+ */
+class ReadAheadQueue : boost::noncopyable
+{
+public:
+    struct Statistics
+    {
+        Statistics()
+            : _nbHits(0)
+            , _nbMisses(0)
+            , _stallTime(0.0)
+        {
+        }
+
+        std::size_t _nbHits;   ///< frames already read when rendered
+        std::size_t _nbMisses; ///< frames read synchronously
+        double _stallTime;     ///< time waiting for the frames being read, in seconds
+    };
+
+public:
+    /**
+     * @param nbThreads number of reading threads
+     * @param nbFrames maximum number of frames read in advance (so the number of images kept in memory)
+     */
+    ReadAheadQueue(const std::size_t nbThreads, const std::size_t nbFrames);
+    ~ReadAheadQueue();
+
+    /// @brief Frames to read in advance: from @p first to @p last with @p step.
+    void beginSequence(const OfxTime first, const OfxTime last, const double step);
+    /// @brief Cancel the frames not read and release all frames.
+    void endSequence();
+
+    /// @brief The next frames after @p time which are not already requested (no more than the read-ahead size).
+    std::vector<OfxTime> getFramesToRead(const OfxTime time) const;
+    /// @brief Read @p frame at @p time in background.
+    void push(const OfxTime time, const boost::shared_ptr<ReadAheadFrame>& frame);
+
+    /**
+     * @brief Get the frame read at @p time, wait for it if it's being read.
+     * @return NULL if the frame needs to be read synchronously (not requested, not started or read with an error)
+     */
+    boost::shared_ptr<ReadAheadFrame> acquire(const OfxTime time);
+
+    Statistics getStatistics() const;
+
+private:
+    enum EFrameState
+    {
+        eFrameStatePending,
+        eFrameStateReading,
+        eFrameStateDone
+    };
+    struct Entry
+    {
+        EFrameState _state;
+        boost::shared_ptr<ReadAheadFrame> _frame;
+        boost::exception_ptr _error;
+    };
+    typedef std::map<OfxTime, Entry> FrameMap;
+
+    void worker();
+
+private:
+    const std::size_t _nbThreads;
+    const std::size_t _nbFrames;
+
+    OfxTime _first;
+    OfxTime _last;
+    double _step;
+
+    mutable boost::mutex _mutex;
+    boost::condition_variable _condPending; ///< a frame is pending or the queue is stopped
+    boost::condition_variable _condDone;    ///< a frame is read
+    FrameMap _frames;
+    std::deque<OfxTime> _pending; ///< frames to read, in the order of the requests
+    bool _stop;
+    Statistics _statistics;
+    boost::scoped_ptr<boost::thread_group> _threads;
+};
+
+std::ostream& operator<<(std::ostream& os, const ReadAheadQueue::Statistics& statistics);
+}
+}
+
+#endif
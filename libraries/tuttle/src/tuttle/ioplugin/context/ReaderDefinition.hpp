@@ -8,6 +8,12 @@ namespace tuttle
 namespace plugin
 {
 
+/// @name read-ahead statistics of the last sequence render (output parameters)
+/// @{
+static const std::string kTuttlePluginReadAheadHits = "readAheadHits";
+static const std::string kTuttlePluginReadAheadMisses = "readAheadMisses";
+/// @}
+
 enum EParamReaderBitDepth
 {
     eParamReaderBitDepthAuto = 0,
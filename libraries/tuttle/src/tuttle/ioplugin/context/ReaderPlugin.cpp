@@ -2,6 +2,10 @@
 
 #include <filesystem.hpp>
 
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+
 namespace tuttle
 {
 namespace plugin
@@ -9,16 +13,29 @@ namespace plugin
 
 namespace bfs = boost::filesystem;
 
+namespace
+{
+/// Reading threads of the read-ahead, the host uses the other cores to compute the frames.
+std::size_t readAheadNbThreads()
+{
+    return std::min(std::max(boost::thread::hardware_concurrency() / 4, 1u), 4u);
+}
+}
+
 ReaderPlugin::ReaderPlugin(OfxImageEffectHandle handle)
     : OFX::ImageEffect(handle)
     , _isSequence(false)
     , _filePattern()
+    , _readAhead(false)
+    , _readAheadQueue(readAheadNbThreads(), 2 * readAheadNbThreads())
 {
     _clipDst = fetchClip(kOfxImageEffectOutputClipName);
     _paramFilepath = fetchStringParam(kTuttlePluginFilename);
     _isSequence = sequenceParser::browseSequence(_filePattern, _paramFilepath->getValue());
     _paramBitDepth = fetchChoiceParam(kTuttlePluginBitDepth);
     _paramChannel = fetchChoiceParam(kTuttlePluginChannel);
+    _paramReadAheadHits = fetchIntParam(kTuttlePluginReadAheadHits);
+    _paramReadAheadMisses = fetchIntParam(kTuttlePluginReadAheadMisses);
 }
 
 ReaderPlugin::~ReaderPlugin()
@@ -91,12 +108,35 @@ bool ReaderPlugin::getTimeDomain(OfxRangeD& range)
     return true;
 }
 
+void ReaderPlugin::beginSequenceRender(const OFX::BeginSequenceRenderArguments& args)
+{
+    // an interactive host doesn't render the frames in order
+    _readAhead = _isSequence && !args.isInteractive;
+    if(_readAhead)
+    {
+        _readAheadQueue.beginSequence(std::max(args.frameRange.min, getFirstTime()),
+                                      std::min(args.frameRange.max, getLastTime()), args.frameStep);
+    }
+}
+
 void ReaderPlugin::render(const OFX::RenderArguments& args)
 {
     std::string filename = getAbsoluteFilenameAt(args.time);
     TUTTLE_LOG_INFO("        >-- " << filename);
 }
 
+void ReaderPlugin::endSequenceRender(const OFX::EndSequenceRenderArguments& args)
+{
+    if(!_readAhead)
+        return;
+    _readAhead = false;
+    _readAheadQueue.endSequence();
+    const ReadAheadQueue::Statistics statistics = _readAheadQueue.getStatistics();
+    TUTTLE_LOG_DEBUG("[Reader plugin] Read ahead of " << getName() << ": " << statistics);
+    _paramReadAheadHits->setValue(static_cast<int>(statistics._nbHits));
+    _paramReadAheadMisses->setValue(static_cast<int>(statistics._nbMisses));
+}
+
 std::string ReaderPlugin::getAbsoluteFilenameAt(const OfxTime time) const
 {
     if(_isSequence)
@@ -4,6 +4,7 @@
 #include <boost/gil/channel_algorithm.hpp> // force to use the boostHack version first
 
 #include "ReaderDefinition.hpp"
+#include "ReadAheadQueue.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 #include <tuttle/plugin/exceptions.hpp>
@@ -32,7 +33,17 @@ public:
     virtual void getClipPreferences(OFX::ClipPreferencesSetter& clipPreferences);
     virtual bool getTimeDomain(OfxRangeD& range);
 
+    virtual void beginSequenceRender(const OFX::BeginSequenceRenderArguments& args);
     virtual void render(const OFX::RenderArguments& args);
+    virtual void endSequenceRender(const OFX::EndSequenceRenderArguments& args);
+
+    /**
+     * @brief Queue of the frames read in background threads (see ReadAhead).
+     * @return NULL outside of a non-interactive sequence render
+     */
+    ReadAheadQueue* getReadAheadQueue() { return _readAhead ? &_readAheadQueue : NULL; }
+    /// @brief Hits, misses and stall time of the read-ahead, since the beginning of the last sequence render.
+    ReadAheadQueue::Statistics getReadAheadStatistics() const { return _readAheadQueue.getStatistics(); }
 
 public:
     std::string getAbsoluteFilenameAt(const OfxTime time) const;
@@ -58,10 +69,15 @@ public:
     OFX::ChoiceParam* _paramBitDepth; ///< Explicit bit depth conversion
     OFX::ChoiceParam* _paramChannel;  ///< Explicit component conversion
                                       /// @}
+    OFX::IntParam* _paramReadAheadHits;   ///< Read-ahead hits of the last sequence render
+    OFX::IntParam* _paramReadAheadMisses; ///< Read-ahead misses of the last sequence render
 
 private:
     bool _isSequence;
     sequenceParser::Sequence _filePattern; ///< Filename pattern manager
+
+    bool _readAhead;
+    ReadAheadQueue _readAheadQueue;
 };
 }
 }
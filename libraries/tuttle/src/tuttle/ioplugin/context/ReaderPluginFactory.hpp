@@ -50,6 +50,25 @@ void describeReaderParamsInContext(OFX::ImageEffectDescriptor& desc, OFX::EConte
         explicitConversion->setIsSecret(true);
         explicitConversion->setDefault(static_cast<int>(OFX::getImageEffectHostDescription()->getDefaultPixelDepth()));
     }
+
+    // Set by the plugin at the end of a sequence render, not used to compute the images.
+    OFX::IntParamDescriptor* readAheadHits = desc.defineIntParam(kTuttlePluginReadAheadHits);
+    readAheadHits->setLabel("Read-ahead hits");
+    readAheadHits->setHint("Number of frames already read in advance when rendered, during the last sequence render.");
+    readAheadHits->setIsSecret(true);
+    readAheadHits->setIsPersistant(false);
+    readAheadHits->setEvaluateOnChange(false);
+    readAheadHits->setAnimates(false);
+    readAheadHits->setDefault(0);
+
+    OFX::IntParamDescriptor* readAheadMisses = desc.defineIntParam(kTuttlePluginReadAheadMisses);
+    readAheadMisses->setLabel("Read-ahead misses");
+    readAheadMisses->setHint("Number of frames read when rendered, during the last sequence render.");
+    readAheadMisses->setIsSecret(true);
+    readAheadMisses->setIsPersistant(false);
+    readAheadMisses->setEvaluateOnChange(false);
+    readAheadMisses->setAnimates(false);
+    readAheadMisses->setDefault(0);
 }
 }
 }
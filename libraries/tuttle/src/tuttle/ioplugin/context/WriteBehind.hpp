@@ -0,0 +1,97 @@
+#ifndef _TUTTLE_IOPLUGIN_CONTEXT_WRITEBEHIND_HPP_
+#define _TUTTLE_IOPLUGIN_CONTEXT_WRITEBEHIND_HPP_
+
+#include "WriterPlugin.hpp"
+#include "WriteBehindQueue.hpp"
+
+#include <boost/gil/algorithm.hpp>
+#include <boost/gil/image.hpp>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace tuttle
+{
+namespace plugin
+{
+
+/**
+ * @brief Write the images in background threads, with the write-behind queue of the WriterPlugin.
+ *
+ * The WriterProcess is setup in the render thread, the source image is copied (the host is free to reuse
+ * its buffer as soon as the render action returns) and the writing (multiThreadProcessImages) is done
+ * by the queue. Outside of a non-interactive sequence render, the image is written synchronously.
+ *
+ * @warning multiThreadProcessImages of the WriterProcess must only use values retrieved during setup.
+ *
+ * Usage: doGilRender<WriteBehind<MyWriterProcess>::Process>( *this, args );
+ */
+template <template <class> class WriterProcess>
+struct WriteBehind
+{
+    template <class View>
+    class Process
+    {
+    private:
+        class Writer : public WriterProcess<View>
+        {
+        public:
+            typedef WriterProcess<View> Parent;
+            typedef typename Parent::Image Image;
+
+        public:
+            template <class Plugin>
+            Writer(Plugin& plugin)
+                : Parent(plugin)
+            {
+            }
+
+            /// @brief Setup the writer and copy the source image, no OFX image is kept.
+            void setupWriteBehind(const OFX::RenderArguments& args)
+            {
+                this->_renderArgs = args;
+                this->_renderWindowSize.x = args.renderWindow.x2 - args.renderWindow.x1;
+                this->_renderWindowSize.y = args.renderWindow.y2 - args.renderWindow.y1;
+                this->setup(args);
+
+                _srcCopy.recreate(this->_srcView.dimensions());
+                boost::gil::copy_pixels(this->_srcView, boost::gil::view(_srcCopy));
+                this->_srcView = boost::gil::view(_srcCopy);
+                this->_src.reset();
+                this->_dst.reset();
+            }
+
+            void write() { this->multiThreadFunction(0, 1); }
+
+        private:
+            Image _srcCopy;
+        };
+
+    public:
+        template <class Plugin>
+        Process(Plugin& plugin)
+            : _plugin(plugin)
+            , _writer(new Writer(plugin))
+        {
+        }
+
+        void setupAndProcess(const OFX::RenderArguments& args)
+        {
+            WriteBehindQueue* queue = _plugin.getWriteBehindQueue();
+            if(!queue)
+            {
+                _writer->setupAndProcess(args);
+                return;
+            }
+            _writer->setupWriteBehind(args);
+            queue->push(boost::bind(&Writer::write, _writer));
+        }
+
+    private:
+        WriterPlugin& _plugin;
+        boost::shared_ptr<Writer> _writer;
+    };
+};
+}
+}
+
+#endif
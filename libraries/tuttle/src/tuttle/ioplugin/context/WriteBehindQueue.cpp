@@ -0,0 +1,125 @@
+#include "WriteBehindQueue.hpp"
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/common/exceptions.hpp>
+
+#include <boost/bind.hpp>
+
+#include <algorithm>
+
+namespace tuttle
+{
+namespace plugin
+{
+
+WriteBehindQueue::WriteBehindQueue(const std::size_t nbThreads, const std::size_t maxPendingJobs)
+    : _nbThreads(std::max(nbThreads, std::size_t(1)))
+    , _maxPendingJobs(std::max(maxPendingJobs, std::size_t(1)))
+    , _nbRunningJobs(0)
+    , _stop(false)
+{
+}
+
+WriteBehindQueue::~WriteBehindQueue()
+{
+    try
+    {
+        wait();
+    }
+    catch(...)
+    {
+        TUTTLE_LOG_ERROR("[Write behind] Error ignored at destruction:" << std::endl
+                                                                        << tuttle::exception::format_current_exception());
+    }
+}
+
+void WriteBehindQueue::push(const Job& job)
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    // backpressure: limit the number of images kept in memory
+    while(!_error && _jobs.size() + _nbRunningJobs >= _maxPendingJobs)
+        _condSlot.wait(lock);
+    rethrowError(lock);
+
+    if(!_threads)
+    {
+        _threads.reset(new boost::thread_group());
+        for(std::size_t i = 0; i < _nbThreads; ++i)
+            _threads->create_thread(boost::bind(&WriteBehindQueue::worker, this));
+    }
+    _jobs.push_back(job);
+    _condJob.notify_one();
+}
+
+void WriteBehindQueue::wait()
+{
+    boost::scoped_ptr<boost::thread_group> threads;
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        _stop = true;
+        threads.swap(_threads);
+    }
+    _condJob.notify_all();
+    if(threads)
+        threads->join_all();
+
+    boost::mutex::scoped_lock lock(_mutex);
+    _stop = false;
+    rethrowError(lock);
+}
+
+std::size_t WriteBehindQueue::getNbPendingJobs() const
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    return _jobs.size() + _nbRunningJobs;
+}
+
+void WriteBehindQueue::worker()
+{
+    for(;;)
+    {
+        Job job;
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            while(_jobs.empty() && !_stop)
+                _condJob.wait(lock);
+            // stopped and nothing more to write
+            if(_jobs.empty())
+                return;
+            job.swap(_jobs.front());
+            _jobs.pop_front();
+            ++_nbRunningJobs;
+        }
+
+        try
+        {
+            job();
+        }
+        catch(...)
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            if(!_error)
+                _error = boost::current_exception();
+        }
+        // release the image before giving the slot back
+        job.clear();
+
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            --_nbRunningJobs;
+        }
+        _condSlot.notify_all();
+    }
+}
+
+void WriteBehindQueue::rethrowError(boost::mutex::scoped_lock& lock)
+{
+    if(!_error)
+        return;
+    boost::exception_ptr error;
+    std::swap(error, _error);
+    lock.unlock();
+    boost::rethrow_exception(error);
+}
+}
+}
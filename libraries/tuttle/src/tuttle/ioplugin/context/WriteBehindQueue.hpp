@@ -0,0 +1,73 @@
+#ifndef _TUTTLE_IOPLUGIN_CONTEXT_WRITEBEHINDQUEUE_HPP_
+#define _TUTTLE_IOPLUGIN_CONTEXT_WRITEBEHINDQUEUE_HPP_
+
+#include <boost/exception_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <cstddef>
+#include <deque>
+
+namespace tuttle
+{
+namespace plugin
+{
+
+/**
+ * @brief Bounded queue of write jobs, executed by a small pool of background threads.
+ *
+ * Used by the writers to encode the images while the host computes the next frames.
+ * The threads are only created with the first job.
+ */
+class WriteBehindQueue : boost::noncopyable
+{
+public:
+    typedef boost::function<void()> Job;
+
+public:
+    /**
+     * @param nbThreads number of encoding threads
+     * @param maxPendingJobs maximum number of jobs waiting or running (so the number of images kept in memory)
+     */
+    WriteBehindQueue(const std::size_t nbThreads, const std::size_t maxPendingJobs);
+    ~WriteBehindQueue();
+
+    /**
+     * @brief Add a job, wait for a free slot if there are already too many pending jobs.
+     * @exception rethrow the error of a previous job, if any (it is not rethrown by wait()).
+     */
+    void push(const Job& job);
+
+    /**
+     * @brief Wait for the end of all jobs and stop the threads.
+     * @exception rethrow the first error of the jobs.
+     */
+    void wait();
+
+    std::size_t getNbPendingJobs() const;
+
+private:
+    void worker();
+    void rethrowError(boost::mutex::scoped_lock& lock);
+
+private:
+    const std::size_t _nbThreads;
+    const std::size_t _maxPendingJobs;
+
+    mutable boost::mutex _mutex;
+    boost::condition_variable _condJob;  ///< a job is available or the queue is stopped
+    boost::condition_variable _condSlot; ///< a pending job is done
+    std::deque<Job> _jobs;
+    std::size_t _nbRunningJobs;
+    bool _stop;
+    boost::exception_ptr _error; ///< first error of the jobs
+    boost::scoped_ptr<boost::thread_group> _threads;
+};
+}
+}
+
+#endif
@@ -6,7 +6,9 @@
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/thread/thread.hpp>
 
+#include <algorithm>
 #include <cstdio>
 
 namespace tuttle
@@ -16,12 +18,23 @@ namespace plugin
 
 namespace bfs = boost::filesystem;
 
+namespace
+{
+/// Encoding threads of the write-behind queue, the host uses the other cores to compute the next frames.
+std::size_t writeBehindNbThreads()
+{
+    return std::min(std::max(boost::thread::hardware_concurrency() / 4, 1u), 4u);
+}
+}
+
 WriterPlugin::WriterPlugin(OfxImageEffectHandle handle)
     : ImageEffectGilPlugin(handle)
     , _oneRender(false)
     , _oneRenderAtTime(0)
     , _isSequence(false)
     , _filePattern()
+    , _writeBehind(false)
+    , _writeBehindQueue(writeBehindNbThreads(), writeBehindNbThreads() + 1)
 {
     _clipSrc = fetchClip(kOfxImageEffectSimpleSourceClipName);
     _clipDst = fetchClip(kOfxImageEffectOutputClipName);
@@ -129,6 +142,14 @@ void WriterPlugin::beginSequenceRender(const OFX::BeginSequenceRenderArguments&
     {
         bfs::create_directories(dir);
     }
+    // an interactive host expects the file to be written at the end of the render action
+    _writeBehind = !args.isInteractive;
+}
+
+void WriterPlugin::endSequenceRender(const OFX::EndSequenceRenderArguments& args)
+{
+    _writeBehind = false;
+    _writeBehindQueue.wait();
 }
 
 void WriterPlugin::render(const OFX::RenderArguments& args)
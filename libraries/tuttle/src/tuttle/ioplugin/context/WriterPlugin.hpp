@@ -4,6 +4,7 @@
 #include <boost/gil/channel_algorithm.hpp> // force to use the boostHack version first
 
 #include "WriterDefinition.hpp"
+#include "WriteBehindQueue.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
@@ -29,6 +30,14 @@ public:
 
     virtual void beginSequenceRender(const OFX::BeginSequenceRenderArguments& args);
     virtual void render(const OFX::RenderArguments& args);
+    /// @brief Wait for the images written in background and report their errors.
+    virtual void endSequenceRender(const OFX::EndSequenceRenderArguments& args);
+
+    /**
+     * @brief Queue of the images to write in background threads (see WriteBehind).
+     * @return NULL outside of a non-interactive sequence render
+     */
+    WriteBehindQueue* getWriteBehindQueue() { return _writeBehind ? &_writeBehindQueue : NULL; }
 
 protected:
     inline bool varyOnTime() const { return _isSequence; }
@@ -40,6 +49,9 @@ private:
     bool _oneRender;
     OfxTime _oneRenderAtTime;
 
+    bool _writeBehind;
+    WriteBehindQueue _writeBehindQueue;
+
 public:
     std::string getAbsoluteFilenameAt(const OfxTime time) const;
     std::string getAbsoluteFirstFilename() const;
@@ -7,6 +7,7 @@
 #include <tuttle/plugin/image.hpp>
 #include <tuttle/plugin/exceptions.hpp>
 #include <tuttle/common/math/rectOp.hpp>
+#include <tuttle/common/atomic.hpp>
 
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
@@ -18,6 +19,7 @@
 #include <boost/throw_exception.hpp>
 
 #include <cstdlib>
+#include <algorithm>
 #include <vector>
 
 namespace tuttle
@@ -30,6 +32,16 @@ namespace plugin
  */
 class ImageProcessor : public OFX::MultiThread::Processor, public tuttle::plugin::OfxProgress
 {
+public:
+    /**
+     * @brief How the render window is split between the threads.
+     */
+    enum EScheduling
+    {
+        eSchedulingStatic, ///< one band of rows per thread
+        eSchedulingDynamic ///< small chunks of rows pulled by each thread as soon as it is available
+    };
+
 protected:
     OFX::ImageEffect& _effect;        ///< effect to render with
     OFX::RenderArguments _renderArgs; ///< render arguments
@@ -42,6 +54,9 @@ protected:
 
 private:
     unsigned int _nbThreads;
+    EScheduling _scheduling;
+    unsigned int _chunkSize;     ///< number of rows of a chunk with dynamic scheduling, 0 means auto
+    boost::atomic<int> _nextRow; ///< first row of the next chunk to process with dynamic scheduling
 
 public:
     /** @brief ctor */
@@ -50,6 +65,9 @@ public:
         , _effect(effect)
         , _imageOrientation(imageOrientation)
         , _nbThreads(0) // auto, maximum allowable number of CPUs will be used
+        , _scheduling(eSchedulingDynamic)
+        , _chunkSize(0)
+        , _nextRow(0)
     {
         _dstPixelRod.x1 = _dstPixelRod.y1 = _dstPixelRod.x2 = _dstPixelRod.y2 = 0;
         _dstPixelRodSize.x = _dstPixelRodSize.y = 0;
@@ -69,6 +87,18 @@ public:
     void setNbThreads(const unsigned int nbThreads) { _nbThreads = nbThreads; }
     void setNbThreadsAuto() { _nbThreads = 0; }
 
+    /**
+     * @brief Dynamic scheduling balances the load of plugins with spatially uneven costs.
+     * Use static scheduling if multiThreadProcessImages needs to be called once per thread.
+     */
+    void setScheduling(const EScheduling scheduling) { _scheduling = scheduling; }
+    EScheduling getScheduling() const { return _scheduling; }
+
+    /**
+     * @brief Number of rows of each chunk with dynamic scheduling, 0 means auto (about 8 chunks per thread).
+     */
+    void setChunkSize(const unsigned int chunkSize) { _chunkSize = chunkSize; }
+
     /** @brief called before any MP is done */
     virtual void preProcess() { progressBegin(_renderWindowSize.y * _renderWindowSize.x); }
 
@@ -144,8 +174,23 @@ public:
      */
     void multiThreadFunction(const unsigned int threadId, const unsigned int nThreads)
     {
-        // slice the y range into the number of threads it has
         const int dy = std::abs(_renderArgs.renderWindow.y2 - _renderArgs.renderWindow.y1);
+        if(_scheduling == eSchedulingDynamic && nThreads > 1)
+        {
+            // pull chunks of rows until the end of the render window
+            const int chunkSize = _chunkSize ? _chunkSize : std::max(1, dy / int(nThreads * 8));
+            const int yEnd = std::min(_renderArgs.renderWindow.y1, _renderArgs.renderWindow.y2) + dy;
+            OfxRectI winRoW = _renderArgs.renderWindow;
+            for(int y = _nextRow.fetch_add(chunkSize); y < yEnd; y = _nextRow.fetch_add(chunkSize))
+            {
+                winRoW.y1 = y;
+                winRoW.y2 = std::min(y + chunkSize, yEnd);
+                multiThreadProcessImages(winRoW);
+            }
+            return;
+        }
+
+        // slice the y range into the number of threads it has
         const int y1 = _renderArgs.renderWindow.y1 + threadId * dy / nThreads;
         const int step = (threadId + 1) * dy / nThreads;
         const int y2 = _renderArgs.renderWindow.y1 + (step < dy ? step : dy);
@@ -180,6 +225,7 @@ public:
         preProcess();
 
         // call the base multi threading code, should put a pre & post thread calls in too
+        _nextRow.store(std::min(_renderArgs.renderWindow.y1, _renderArgs.renderWindow.y2), boost::memory_order_relaxed);
         multiThread(_nbThreads);
 
         // call the post MP pass
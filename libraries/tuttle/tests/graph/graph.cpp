@@ -3,8 +3,17 @@
 
 #include <tuttle/host/Graph.hpp>
 #include <tuttle/host/Node.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/foreach.hpp>
 
 #include <iostream>
+#include <cstring>
+#include <map>
+#include <vector>
 
 using namespace boost::unit_test;
 using namespace tuttle::host;
@@ -212,4 +221,203 @@ BOOST_AUTO_TEST_CASE(graph_compute)
     TUTTLE_LOG_INFO("----------------- DONE -----------------");
 }
 
+namespace
+{
+
+/// Renders the final node in buffers of the test and counts their releases.
+class BufferOutputHandle : public IOutputHandle
+{
+public:
+    void* allocateBuffer(const std::string& nodeName, const OfxTime time, const attribute::Image& image)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        boost::shared_ptr<std::vector<char> > buffer(new std::vector<char>(image.getMemorySize()));
+        _buffers[time] = buffer;
+        _nbReleases[&buffer->front()] = 0;
+        return &buffer->front();
+    }
+
+    void releaseBuffer(void* buffer)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        ++_nbReleases[buffer];
+    }
+
+    void outputImage(const std::string& nodeName, const OfxTime time, const boost::shared_ptr<attribute::Image>& image)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        _images[time] = image;
+    }
+
+    boost::mutex _mutex;
+    std::map<OfxTime, boost::shared_ptr<std::vector<char> > > _buffers;
+    std::map<void*, int> _nbReleases;
+    std::map<OfxTime, boost::shared_ptr<attribute::Image> > _images;
+};
+
+std::string computeCheckerboardInvert(memory::MemoryCache& outputCache, const ComputeOptions& options)
+{
+    Graph g;
+    Graph::Node& checkerboard = g.createNode("tuttle.checkerboard");
+    Graph::Node& invert = g.createNode("tuttle.invert");
+    checkerboard.getParam("format").setValue("PAL");
+    checkerboard.getParam("explicitConversion").setValue("32f");
+    g.connect(checkerboard, invert);
+    g.compute(outputCache, invert, options);
+    return invert.getName();
+}
+}
+
+BOOST_AUTO_TEST_CASE(graph_outputHandleBuffers)
+{
+    TUTTLE_LOG_INFO("--> OUTPUT HANDLE BUFFERS");
+    // the content cache doesn't keep the buffers of the application
+    core().getContentCache().setMaxMemorySize(64 * 1024 * 1024);
+
+    memory::MemoryCache reference;
+    const std::string invertName = computeCheckerboardInvert(reference, ComputeOptions(0, 2));
+
+    // the second compute reuses the checkerboard from the content cache,
+    // but renders again the final node in new buffers
+    for(int i = 0; i < 2; ++i)
+    {
+        boost::shared_ptr<BufferOutputHandle> handle(new BufferOutputHandle());
+        ComputeOptions options(0, 2);
+        options.setReturnBuffers(false);
+        options.setOutputHandle(handle);
+        memory::MemoryCache outputCache;
+        BOOST_CHECK_EQUAL(invertName, computeCheckerboardInvert(outputCache, options));
+        BOOST_CHECK_EQUAL(0U, outputCache.size());
+
+        BOOST_REQUIRE_EQUAL(3U, handle->_buffers.size());
+        BOOST_REQUIRE_EQUAL(3U, handle->_images.size());
+        for(int t = 0; t < 3; ++t)
+        {
+            const std::vector<char>& buffer = *handle->_buffers[t];
+            attribute::Image& image = *handle->_images[t];
+            memory::CACHE_ELEMENT expected = reference.get(invertName, t);
+            BOOST_REQUIRE(expected.get() != NULL);
+            // the image is rendered in the buffer of the application
+            BOOST_CHECK_EQUAL(static_cast<void*>(image.getPixelData()), static_cast<const void*>(&buffer.front()));
+            BOOST_REQUIRE_EQUAL(expected->getMemorySize(), buffer.size());
+            BOOST_CHECK_EQUAL(0, std::memcmp(expected->getPixelData(), &buffer.front(), buffer.size()));
+            // still used by the application
+            BOOST_CHECK_EQUAL(0, handle->_nbReleases[image.getPixelData()]);
+        }
+
+        // the buffers are released once, with the last reference to their images
+        handle->_images.clear();
+        BOOST_CHECK_EQUAL(3U, handle->_nbReleases.size());
+        typedef std::map<void*, int>::value_type NbReleases;
+        BOOST_FOREACH(const NbReleases& nbReleases, handle->_nbReleases)
+        {
+            BOOST_CHECK_EQUAL(1, nbReleases.second);
+        }
+    }
+
+    core().getContentCache().clearAll();
+    core().getContentCache().setMaxMemorySize(0);
+    TUTTLE_LOG_INFO("----------------- DONE -----------------");
+}
+
+namespace
+{
+
+/// Renders the frame 0 of @p node and returns its image.
+memory::CACHE_ELEMENT computeFrame(Graph& g, Graph::Node& node)
+{
+    memory::MemoryCache outputCache;
+    g.compute(outputCache, node, ComputeOptions(0));
+    return outputCache.get(node.getName(), 0);
+}
+
+bool sameImages(const memory::CACHE_ELEMENT& a, const memory::CACHE_ELEMENT& b)
+{
+    return a->getMemorySize() == b->getMemorySize() &&
+           std::memcmp(a->getPixelData(), b->getPixelData(), a->getMemorySize()) == 0;
+}
+}
+
+BOOST_AUTO_TEST_CASE(graph_contentCache)
+{
+    TUTTLE_LOG_INFO("--> CONTENT CACHE");
+    memory::ContentCache& contentCache = core().getContentCache();
+    contentCache.clearAll();
+    contentCache.setMaxMemorySize(64 * 1024 * 1024);
+    contentCache.resetStatistics();
+
+    {
+        Graph g;
+        Graph::Node& checkerboard = g.createNode("tuttle.checkerboard");
+        Graph::Node& blur = g.createNode("tuttle.blur");
+        Graph::Node& invert = g.createNode("tuttle.invert");
+        checkerboard.getParam("format").setValue("PAL");
+        checkerboard.getParam("explicitConversion").setValue("32f");
+        blur.getParam("size").setValue(2.0, 2.0);
+        g.connect(checkerboard, blur);
+        g.connect(blur, invert);
+
+        const memory::CACHE_ELEMENT first = computeFrame(g, invert);
+        BOOST_REQUIRE(first.get() != NULL);
+        const memory::ContentCache::Statistics firstStats = contentCache.getStatistics();
+        BOOST_CHECK_EQUAL(0U, firstStats._nbHits);
+        BOOST_CHECK_GT(firstStats._nbMisses, 0U);
+
+        // unchanged graph: the input of the final node is reused
+        const memory::CACHE_ELEMENT second = computeFrame(g, invert);
+        BOOST_REQUIRE(second.get() != NULL);
+        const memory::ContentCache::Statistics secondStats = contentCache.getStatistics();
+        BOOST_CHECK_GT(secondStats._nbHits, firstStats._nbHits);
+        BOOST_CHECK_EQUAL(secondStats._nbMisses, firstStats._nbMisses);
+        BOOST_CHECK(sameImages(first, second));
+
+        // a modified parameter changes the hash of the node
+        blur.getParam("size").setValue(6.0, 6.0);
+        const memory::CACHE_ELEMENT third = computeFrame(g, invert);
+        BOOST_REQUIRE(third.get() != NULL);
+        const memory::ContentCache::Statistics thirdStats = contentCache.getStatistics();
+        BOOST_CHECK_GT(thirdStats._nbMisses, secondStats._nbMisses);
+        BOOST_CHECK(!sameImages(second, third));
+    }
+
+    {
+        const std::string filename = ".tests/graph/contentCache.png";
+        BOOST_REQUIRE(compute(list_of(NodeInit("tuttle.checkerboard").setParam("format", "PAL"))(
+            NodeInit("tuttle.pngwriter").setParam("filename", filename))));
+
+        Graph g;
+        Graph::Node& read = g.createNode("tuttle.pngreader");
+        Graph::Node& invert = g.createNode("tuttle.invert");
+        read.getParam("filename").setValue(filename);
+        g.connect(read, invert);
+
+        const memory::CACHE_ELEMENT first = computeFrame(g, invert);
+        BOOST_REQUIRE(first.get() != NULL);
+        const memory::ContentCache::Statistics firstStats = contentCache.getStatistics();
+        const memory::CACHE_ELEMENT second = computeFrame(g, invert);
+        BOOST_REQUIRE(second.get() != NULL);
+        const memory::ContentCache::Statistics secondStats = contentCache.getStatistics();
+        BOOST_CHECK_GT(secondStats._nbHits, firstStats._nbHits);
+        BOOST_CHECK_EQUAL(secondStats._nbMisses, firstStats._nbMisses);
+
+        // the file is replaced, without any change in the graph
+        const std::time_t lastWriteTime = boost::filesystem::last_write_time(filename);
+        BOOST_REQUIRE(compute(list_of(NodeInit("tuttle.constant").setParam("format", "PAL"))(
+            NodeInit("tuttle.pngwriter").setParam("filename", filename))));
+        // the modification time has a precision of one second
+        boost::filesystem::last_write_time(filename, lastWriteTime + 10);
+
+        const memory::ContentCache::Statistics beforeStats = contentCache.getStatistics();
+        const memory::CACHE_ELEMENT third = computeFrame(g, invert);
+        BOOST_REQUIRE(third.get() != NULL);
+        const memory::ContentCache::Statistics thirdStats = contentCache.getStatistics();
+        BOOST_CHECK_GT(thirdStats._nbMisses, beforeStats._nbMisses);
+        BOOST_CHECK(!sameImages(second, third));
+    }
+
+    contentCache.clearAll();
+    contentCache.setMaxMemorySize(0);
+    TUTTLE_LOG_INFO("----------------- DONE -----------------");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
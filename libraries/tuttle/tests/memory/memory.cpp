@@ -4,6 +4,10 @@
 // custom host
 #include <tuttle/host/memory/MemoryPool.hpp>
 #include <tuttle/host/memory/MemoryCache.hpp>
+#include <tuttle/host/memory/ContentCache.hpp>
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
 
 #include <iostream>
 
@@ -107,6 +111,70 @@ BOOST_AUTO_TEST_CASE(memoryPool)
     }
 }
 
+BOOST_AUTO_TEST_CASE(memoryPoolThreads)
+{
+    memory::MemoryPool pool(1000000);
+    {
+        // buffers are aligned on cache lines
+        const memory::IPoolDataPtr small = pool.allocate(10);
+        const memory::IPoolDataPtr big = pool.allocate(10000);
+        BOOST_CHECK_EQUAL(0U, reinterpret_cast<std::size_t>(small->data()) % 64);
+        BOOST_CHECK_EQUAL(0U, reinterpret_cast<std::size_t>(big->data()) % 64);
+    }
+    BOOST_CHECK_EQUAL(2U, pool.getDataUnusedSize());
+
+    // buffers released by other threads
+    boost::thread_group threads;
+    for(int i = 0; i < 4; ++i)
+        threads.create_thread(boost::bind(&memory::MemoryPool::allocate, &pool, 1000 * (i + 1)));
+    threads.join_all();
+    BOOST_CHECK_EQUAL(0U, pool.getUsedMemorySize());
+    BOOST_CHECK_EQUAL(6U, pool.getDataUnusedSize());
+
+    {
+        // best fit between all unused buffers
+        const memory::IPoolDataPtr pData = pool.allocate(2500);
+        BOOST_CHECK_EQUAL(3000U, pData->reservedSize());
+        BOOST_CHECK_EQUAL(5U, pool.getDataUnusedSize());
+    }
+
+    // release the biggest buffers first
+    pool.clear(12000);
+    BOOST_CHECK_EQUAL(4U, pool.getDataUnusedSize());
+    BOOST_CHECK_EQUAL(6010U, pool.getAllocatedMemorySize());
+    pool.clear();
+    BOOST_CHECK_EQUAL(0U, pool.getDataUnusedSize());
+    BOOST_CHECK_EQUAL(0U, pool.getAllocatedMemorySize());
+}
+
+namespace
+{
+void copyPoolData(const memory::IPoolDataPtr& pData)
+{
+    for(int i = 0; i < 100000; ++i)
+    {
+        memory::IPoolDataPtr copy = pData;
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(memoryPoolSharedData)
+{
+    memory::MemoryPool pool(1000);
+    {
+        // the same data referenced and released by several threads
+        const memory::IPoolDataPtr pData = pool.allocate(100);
+        boost::thread_group threads;
+        for(int i = 0; i < 4; ++i)
+            threads.create_thread(boost::bind(&copyPoolData, boost::cref(pData)));
+        threads.join_all();
+        BOOST_CHECK_EQUAL(100U, pool.getUsedMemorySize());
+        BOOST_CHECK_EQUAL(0U, pool.getDataUnusedSize());
+    }
+    BOOST_CHECK_EQUAL(0U, pool.getUsedMemorySize());
+    BOOST_CHECK_EQUAL(1U, pool.getDataUnusedSize());
+}
+
 BOOST_AUTO_TEST_CASE(memoryCache)
 {
     memory::MemoryCache cache;
@@ -151,4 +219,43 @@ BOOST_AUTO_TEST_CASE(memoryCache)
     BOOST_CHECK_EQUAL(true, cache.inCache(pData));
 }
 
+BOOST_AUTO_TEST_CASE(contentCache)
+{
+    memory::MemoryPool pool(100);
+    memory::ContentCache cache(25);
+    const OfxRectD roi = {0, 0, 10, 10};
+    const OfxRectD smallRoi = {2, 2, 8, 8};
+    const OfxRectD bigRoi = {-1, 0, 10, 10};
+
+    cache.put(1, pool.allocate(10), roi);
+    cache.put(2, pool.allocate(10), roi);
+    BOOST_CHECK_EQUAL(2U, cache.size());
+    BOOST_CHECK_EQUAL(20U, cache.getMemorySize());
+
+    // the cached image covers the smaller region but not the bigger one
+    memory::ContentCache::Entry entry;
+    BOOST_CHECK(cache.get(1, smallRoi, entry));
+    BOOST_CHECK_EQUAL(10U, entry._data->size());
+    BOOST_CHECK(!cache.get(1, bigRoi, entry));
+    BOOST_CHECK(!cache.get(3, roi, entry));
+
+    // the least recently used entry is removed to respect the memory budget
+    cache.put(3, pool.allocate(10), roi);
+    BOOST_CHECK_EQUAL(2U, cache.size());
+    BOOST_CHECK(cache.get(1, roi, entry));
+    BOOST_CHECK(!cache.get(2, roi, entry));
+    BOOST_CHECK(cache.get(3, roi, entry));
+
+    // entries bigger than the memory budget are not stored
+    cache.put(4, pool.allocate(30), roi);
+    BOOST_CHECK(!cache.get(4, roi, entry));
+
+    BOOST_CHECK_EQUAL(10U, cache.releaseMemory(5));
+    BOOST_CHECK_EQUAL(1U, cache.size());
+
+    cache.clearAll();
+    BOOST_CHECK(cache.empty());
+    BOOST_CHECK_EQUAL(0U, cache.getMemorySize());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
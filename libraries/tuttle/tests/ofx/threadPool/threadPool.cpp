@@ -0,0 +1,75 @@
+#define BOOST_TEST_MODULE ofx_threadPool_tests
+#include <tuttle/test/main.hpp>
+
+#include <tuttle/host/ofx/OfxhThreadPool.hpp>
+
+#include <boost/thread/mutex.hpp>
+
+#include <vector>
+
+using namespace boost::unit_test;
+
+namespace
+{
+tuttle::host::ofx::OfxhThreadPool* pool = NULL;
+boost::mutex mutex;
+std::vector<unsigned int> nbCalls;
+unsigned int nbNestedCalls = 0;
+
+void nestedFunction(unsigned int threadIndex, unsigned int threadMax, void* customArg)
+{
+    boost::mutex::scoped_lock lock(mutex);
+    ++nbNestedCalls;
+}
+
+void threadFunction(unsigned int threadIndex, unsigned int threadMax, void* customArg)
+{
+    pool->run(nestedFunction, 4, NULL);
+
+    unsigned int currentIndex = 0;
+    BOOST_CHECK(tuttle::host::ofx::OfxhThreadPool::getCurrentThreadIndex(currentIndex));
+    BOOST_CHECK_EQUAL(threadIndex, currentIndex);
+
+    boost::mutex::scoped_lock lock(mutex);
+    ++nbCalls[threadIndex];
+}
+}
+
+BOOST_AUTO_TEST_SUITE(ofx_threadPool_tests_suite01)
+
+BOOST_AUTO_TEST_CASE(threadPool_run)
+{
+    tuttle::host::ofx::OfxhThreadPool threadPool(3);
+    pool = &threadPool;
+
+    const unsigned int nbJobs = 100;
+    const unsigned int nThreads = 8;
+    nbCalls.assign(nThreads, 0);
+    for(unsigned int i = 0; i < nbJobs; ++i)
+    {
+        BOOST_CHECK_EQUAL(kOfxStatOK, threadPool.run(threadFunction, nThreads, NULL));
+    }
+    // each thread index is called once per job
+    for(unsigned int i = 0; i < nThreads; ++i)
+    {
+        BOOST_CHECK_EQUAL(nbJobs, nbCalls[i]);
+    }
+    BOOST_CHECK_EQUAL(nbJobs * nThreads * 4, nbNestedCalls);
+
+    // outside of a task
+    unsigned int currentIndex = 0;
+    BOOST_CHECK(!tuttle::host::ofx::OfxhThreadPool::getCurrentThreadIndex(currentIndex));
+
+    const tuttle::host::ofx::OfxhThreadPool::Statistics stats = threadPool.getStatistics();
+    BOOST_CHECK_EQUAL(nbJobs + nbJobs * nThreads, stats._nbJobs);
+    BOOST_CHECK_EQUAL(nbJobs * nThreads * 5, stats._nbTasks);
+
+    // resize the pool between jobs
+    threadPool.setNbThreads(2);
+    BOOST_CHECK_EQUAL(2U, threadPool.getNbThreads());
+    BOOST_CHECK_EQUAL(kOfxStatOK, threadPool.run(threadFunction, nThreads, NULL));
+
+    pool = NULL;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+#define BOOST_TEST_MODULE tuttle_startup_benchmark
+#include <tuttle/test/unit_test.hpp>
+
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/PluginCacheFile.hpp>
+#include <tuttle/host/io.hpp>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/foreach.hpp>
+
+#include <iostream>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+BOOST_AUTO_TEST_SUITE(startup_benchmark)
+
+namespace
+{
+
+double seconds(const boost::posix_time::ptime& begin)
+{
+    return (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() / 1000000.0;
+}
+
+std::size_t nbLoadedBinaries()
+{
+    std::size_t nbLoaded = 0;
+    BOOST_FOREACH(const ofx::OfxhPluginBinary& binary, core().getPluginCache().getBinaries())
+    {
+        if(binary.isLoaded())
+            ++nbLoaded;
+    }
+    return nbLoaded;
+}
+}
+
+BOOST_AUTO_TEST_CASE(preload_with_cache)
+{
+    boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    core().preload(true);
+    const double preloadTime = seconds(begin);
+
+    std::cout << "[startup] preload of " << core().getPlugins().size() << " plugins: " << preloadTime * 1000.0 << " ms"
+              << std::endl;
+    if(!core().getPlugins().empty())
+        BOOST_CHECK(boost::filesystem::exists(core().getPreferences().getTuttleHomePath() / "tuttlePluginCache.bin"));
+}
+
+BOOST_AUTO_TEST_CASE(read_plugin_cache_file)
+{
+    const std::string cacheFile = (core().getPreferences().buildTuttleTestPath() / "tuttlePluginCache.bin").string();
+    pluginCacheFile::write(cacheFile, core().getPluginCache());
+
+    ofx::OfxhPluginCache pluginCache;
+    pluginCache.setCacheVersion(core().getPluginCache().getCacheVersion());
+    pluginCache.registerAPICache(core().getImageEffectPluginCache());
+
+    const boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    BOOST_REQUIRE(pluginCacheFile::read(cacheFile, pluginCache));
+    const double readTime = seconds(begin);
+
+    std::cout << "[startup] read of the plugin cache file (" << boost::filesystem::file_size(cacheFile)
+              << " bytes): " << readTime * 1000.0 << " ms" << std::endl;
+    BOOST_CHECK_EQUAL(pluginCache.getBinaries().size(), core().getPluginCache().getBinaries().size());
+
+    // another cache version needs to rescan the plugins
+    ofx::OfxhPluginCache otherVersion;
+    otherVersion.setCacheVersion("tuttleV0");
+    BOOST_CHECK(!pluginCacheFile::read(cacheFile, otherVersion));
+}
+
+BOOST_AUTO_TEST_CASE(lazy_plugin_loading)
+{
+    // looking for the readers of a file format only needs the plugin descriptors
+    const boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    io::getReaders("image.exr");
+    const double getReadersTime = seconds(begin);
+
+    std::cout << "[startup] search of the readers: " << getReadersTime * 1000.0 << " ms" << std::endl;
+    BOOST_CHECK_EQUAL(nbLoadedBinaries(), std::size_t(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,33 @@
+#include "EXRThreading.hpp"
+
+#include <ofxsMultiThread.h>
+
+#include <ImfThreading.h>
+
+#include <boost/thread/once.hpp>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace exr
+{
+
+namespace
+{
+boost::once_flag exrThreadPoolOnce = BOOST_ONCE_INIT;
+
+void setExrThreadCount()
+{
+    if(Imf::globalThreadCount() == 0)
+        Imf::setGlobalThreadCount(OFX::MultiThread::getNumCPUs());
+}
+}
+
+void initExrThreadPool()
+{
+    boost::call_once(exrThreadPoolOnce, setExrThreadCount);
+}
+}
+}
+}
@@ -0,0 +1,21 @@
+#ifndef EXR_THREADING_HPP
+#define EXR_THREADING_HPP
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace exr
+{
+
+/**
+ * @brief Size the global thread pool of OpenEXR from the number of CPUs given by the host (only once).
+ *
+ * OpenEXR uses it to compress and decompress the line blocks or tiles in parallel.
+ */
+void initExrThreadPool();
+}
+}
+}
+
+#endif
@@ -2,6 +2,8 @@
 #include "EXRReaderPlugin.hpp"
 #include "EXRReaderProcess.hpp"
 
+#include <EXRThreading.hpp>
+
 #include <tuttle/ioplugin/context/ReaderPlugin.hpp>
 
 #include <ImfInputFile.h>
@@ -44,6 +46,8 @@ EXRReaderPlugin::EXRReaderPlugin(OfxImageEffectHandle handle)
 
     _paramFileCompression = fetchChoiceParam(kParamCompression);
     _paramFileBitDepth = fetchChoiceParam(kParamFileBitDepth);
+
+    initExrThreadPool();
 }
 
 EXRReaderProcessParams EXRReaderPlugin::getProcessParams(const OfxTime time)
@@ -13,7 +13,7 @@ namespace exr
 namespace reader
 {
 
-static const bool kSupportTiles = false;
+static const bool kSupportTiles = true;
 
 /**
  * @brief Function called to describe the plugin main features.
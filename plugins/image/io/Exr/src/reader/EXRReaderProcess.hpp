@@ -12,6 +12,9 @@
 
 #include <boost/scoped_ptr.hpp>
 
+#include <string>
+#include <vector>
+
 namespace tuttle
 {
 namespace plugin
@@ -34,17 +37,24 @@ protected:
     EXRReaderPlugin& _plugin; ///< Rendering plugin
     EXRReaderProcessParams _params;
     boost::scoped_ptr<Imf::InputFile> _exrImage; ///< Pointer to an exr image
+    std::vector<std::string> _channelNames;      ///< Name of the file channel read for each output channel
 
     template <typename PixelType>
     void initExrChannel(DataVector& data, Imf::Slice& slice, Imf::FrameBuffer& frameBuffer, Imf::PixelType pixelType,
-                        std::string channelID, const Imath::Box2i& dw);
+                        const std::string& channelID, const Imath::Box2i& box);
+
+    bool initExrChannelInView(Imf::FrameBuffer& frameBuffer, const Imf::PixelType pixelType,
+                              const std::string& channelID, const View& dst, const Imath::Box2i& box,
+                              const std::size_t channelIndex);
 
-    void channelCopy(Imf::InputFile& input, const EXRReaderProcessParams& params, View& dst, const std::size_t nbChannels);
+    void channelCopy(Imf::InputFile& input, const Imath::Box2i& readBox, View& dst, const std::size_t nbChannels);
 
     template <typename workingView>
-    void sliceCopy(Imf::InputFile& input, const Imf::Slice* slice, View& dst, const EXRReaderProcessParams& params,
+    void sliceCopy(const DataVector& data, const Imath::Box2i& box, const Imath::Box2i& readBox, View& dst,
                    const std::size_t channelIndex);
 
+    Imath::Box2i getFileWindow(const OfxRectI& windowRoW) const;
+
     std::string getChannelName(size_t index);
 
 public:
@@ -54,7 +64,7 @@ public:
 
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
 
-    void readImage(const std::string& filepath);
+    void readImage(const OfxRectI& windowRoW);
 };
 }
 }
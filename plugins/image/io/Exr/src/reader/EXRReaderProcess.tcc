@@ -28,11 +28,14 @@
 #include <boost/integer.hpp> // for boost::uint_t
 #include <boost/cstdint.hpp>
 #include <boost/mpl/vector.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/assert.hpp>
 #include <boost/filesystem/fstream.hpp>
 
 #include <algorithm>
+#include <cstddef>
 
 namespace tuttle
 {
@@ -45,6 +48,19 @@ namespace reader
 
 namespace bfs = boost::filesystem;
 
+inline Imath::Box2i boxIntersection(const Imath::Box2i& a, const Imath::Box2i& b)
+{
+    Imath::Box2i res;
+
+    res.min.x = std::max(a.min.x, b.min.x);
+    res.min.y = std::max(a.min.y, b.min.y);
+
+    res.max.x = std::min(a.max.x, b.max.x);
+    res.max.y = std::min(a.max.y, b.max.y);
+
+    return res;
+}
+
 template <class View>
 EXRReaderProcess<View>::EXRReaderProcess(EXRReaderPlugin& instance)
     : ImageGilProcessor<View>(instance, eImageOrientationFromTopToBottom)
@@ -60,6 +76,12 @@ void EXRReaderProcess<View>::setup(const OFX::RenderArguments& args)
 
     _params = _plugin.getProcessParams(args.time);
 
+    int nbChannels = std::min(_params._fileNbChannels, int(boost::gil::num_channels<View>::type::value));
+    nbChannels = std::min(nbChannels, _params._userNbComponents);
+    _channelNames.clear();
+    for(int channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
+        _channelNames.push_back(getChannelName(channelIndex));
+
     try
     {
         _exrImage.reset(new Imf::InputFile(_params._filepath.c_str()));
@@ -79,14 +101,17 @@ template <class View>
 void EXRReaderProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 {
     using namespace terry;
-    BOOST_ASSERT(procWindowRoW == this->_dstPixelRod);
 
+    // the view is from top to bottom
+    View procWindowView = subimage_view(this->_dstView, procWindowRoW.x1 - this->_dstPixelRod.x1,
+                                        this->_dstPixelRod.y2 - procWindowRoW.y2, procWindowRoW.x2 - procWindowRoW.x1,
+                                        procWindowRoW.y2 - procWindowRoW.y1);
     // TODO: Exr can contain a background color
-    terry::draw::fill_pixels(this->_dstView, terry::numeric::pixel_zeros<Pixel>());
+    terry::draw::fill_pixels(procWindowView, terry::numeric::pixel_zeros<Pixel>());
 
     try
     {
-        readImage(_params._filepath);
+        readImage(procWindowRoW);
     }
     catch(boost::exception& e)
     {
@@ -102,35 +127,57 @@ void EXRReaderProcess<View>::multiThreadProcessImages(const OfxRectI& procWindow
     }
 }
 
+/**
+ * @brief Read the scanlines of the file needed by @p windowRoW (using the file opened in setup).
+ */
 template <class View>
-void EXRReaderProcess<View>::readImage(const std::string& filepath)
+void EXRReaderProcess<View>::readImage(const OfxRectI& windowRoW)
 {
-    using namespace boost;
-    using namespace mpl;
     using namespace boost::gil;
-    using namespace Imf;
-
-    EXRReaderProcessParams params = _plugin.getProcessParams(this->_renderArgs.time);
-    Imf::InputFile in(filepath.c_str());
 
-    int nbChannels = std::min(_params._fileNbChannels, int(num_channels<View>::type::value));
-    nbChannels = std::min(nbChannels, _params._userNbComponents);
-
-    if(nbChannels == 0)
+    if(_channelNames.empty())
     {
         BOOST_THROW_EXCEPTION(exception::FileNotExist()
                               << exception::user() + "EXR: doesn't support " + _params._fileNbChannels + " channels.");
     }
 
-    channelCopy(in, params, this->_dstView, nbChannels);
+    const Imf::Header& header = _exrImage->header();
+    const Imath::Box2i& outputWindow = _params._displayWindow ? header.displayWindow() : header.dataWindow();
+    const Imath::Box2i readBox = boxIntersection(getFileWindow(windowRoW), header.dataWindow());
+    if(readBox.isEmpty())
+        return;
+
+    View dst = subimage_view(this->_dstView, readBox.min.x - outputWindow.min.x, readBox.min.y - outputWindow.min.y,
+                             readBox.max.x - readBox.min.x + 1, readBox.max.y - readBox.min.y + 1);
+    channelCopy(*_exrImage, readBox, dst, _channelNames.size());
+}
+
+/**
+ * @brief The window of the file (display or data window) corresponding to @p windowRoW.
+ * @return an inclusive box in file coordinates (from top to bottom)
+ */
+template <class View>
+Imath::Box2i EXRReaderProcess<View>::getFileWindow(const OfxRectI& windowRoW) const
+{
+    const Imf::Header& header = _exrImage->header();
+    const Imath::Box2i& outputWindow = _params._displayWindow ? header.displayWindow() : header.dataWindow();
+    const OfxRectI& rod = this->_dstPixelRod;
+
+    Imath::Box2i fileWindow;
+    fileWindow.min.x = outputWindow.min.x + windowRoW.x1 - rod.x1;
+    fileWindow.max.x = outputWindow.min.x + windowRoW.x2 - rod.x1 - 1;
+    fileWindow.min.y = outputWindow.min.y + rod.y2 - windowRoW.y2;
+    fileWindow.max.y = outputWindow.min.y + rod.y2 - windowRoW.y1 - 1;
+    return fileWindow;
 }
 
 template <class View>
 template <typename PixelType>
 void EXRReaderProcess<View>::initExrChannel(DataVector& data, Imf::Slice& slice, Imf::FrameBuffer& frameBuffer,
-                                            Imf::PixelType pixelType, std::string channelID, const Imath::Box2i& dw)
+                                            Imf::PixelType pixelType, const std::string& channelID,
+                                            const Imath::Box2i& box)
 {
-    Imath::V2i s = dw.size();
+    Imath::V2i s = box.size();
     s.x += 1;
     s.y += 1;
 
@@ -138,7 +185,7 @@ void EXRReaderProcess<View>::initExrChannel(DataVector& data, Imf::Slice& slice,
     data.resize(allocSize);
 
     slice.type = pixelType;
-    slice.base = (char*)(&data[0] - sizeof(PixelType) * (dw.min.x + dw.min.y * s.x));
+    slice.base = (char*)(&data[0] - sizeof(PixelType) * (box.min.x + box.min.y * s.x));
     slice.xStride = sizeof(PixelType);
     slice.yStride = sizeof(PixelType) * s.x;
     slice.xSampling = 1;
@@ -148,8 +195,37 @@ void EXRReaderProcess<View>::initExrChannel(DataVector& data, Imf::Slice& slice,
     frameBuffer.insert(channelID.c_str(), slice);
 }
 
+/**
+ * @brief Decode the channel directly into the output view, if it doesn't need any conversion.
+ * @param[in] dst  output view of @p box
+ * @return false if the channel needs to be decoded into a temporary buffer
+ */
+template <class View>
+bool EXRReaderProcess<View>::initExrChannelInView(Imf::FrameBuffer& frameBuffer, const Imf::PixelType pixelType,
+                                                  const std::string& channelID, const View& dst,
+                                                  const Imath::Box2i& box, const std::size_t channelIndex)
+{
+    typedef typename boost::gil::channel_type<View>::type Channel;
+
+    if(pixelType != Imf::FLOAT || !boost::is_same<Channel, boost::gil::bits32f>::value ||
+       !boost::is_pointer<typename View::x_iterator>::value)
+        return false;
+
+    char* origin = reinterpret_cast<char*>(&boost::gil::nth_channel_view(dst, channelIndex)(0, 0));
+    const std::ptrdiff_t xStride = sizeof(Pixel);
+    // negative for a view from top to bottom on an OFX image
+    const std::ptrdiff_t yStride = dst.pixels().row_size();
+
+    // OpenEXR addresses the pixel (x, y) at base + x * xStride + y * yStride,
+    // the unsigned strides wrap around so a negative yStride is valid.
+    Imf::Slice slice(pixelType, origin - box.min.x * xStride - box.min.y * yStride, static_cast<std::size_t>(xStride),
+                     static_cast<std::size_t>(yStride));
+    frameBuffer.insert(channelID.c_str(), slice);
+    return true;
+}
+
 template <class View>
-void EXRReaderProcess<View>::channelCopy(Imf::InputFile& input, const EXRReaderProcessParams& params, View& dst,
+void EXRReaderProcess<View>::channelCopy(Imf::InputFile& input, const Imath::Box2i& readBox, View& dst,
                                          const std::size_t nbChannels)
 {
     using namespace boost::gil;
@@ -157,32 +233,44 @@ void EXRReaderProcess<View>::channelCopy(Imf::InputFile& input, const EXRReaderP
     const Imf::Header& header = input.header();
     const Imath::Box2i& dataWindow = header.dataWindow();
 
+    // OpenEXR decodes full scanlines of the data window
+    const Imath::Box2i lines(Imath::V2i(dataWindow.min.x, readBox.min.y), Imath::V2i(dataWindow.max.x, readBox.max.y));
+    const bool fullLines = (readBox.min.x == dataWindow.min.x && readBox.max.x == dataWindow.max.x);
+
     Imf::FrameBuffer frameBuffer;
     std::vector<DataVector> data(nbChannels);
     std::vector<Imf::Slice> slices(nbChannels);
+    std::vector<bool> inView(nbChannels, false);
 
     for(size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
     {
         const Imf::ChannelList& cl(header.channels());
-        const Imf::Channel& ch = cl[getChannelName(channelIndex).c_str()];
+        const std::string& channelName = _channelNames[channelIndex];
+        const Imf::Channel& ch = cl[channelName.c_str()];
+
+        if(fullLines && initExrChannelInView(frameBuffer, ch.type, channelName, dst, readBox, channelIndex))
+        {
+            inView[channelIndex] = true;
+            continue;
+        }
+
         switch(ch.type)
         {
             case Imf::HALF:
             {
-                initExrChannel<half>(data[channelIndex], slices[channelIndex], frameBuffer, ch.type,
-                                     getChannelName(channelIndex), dataWindow);
+                initExrChannel<half>(data[channelIndex], slices[channelIndex], frameBuffer, ch.type, channelName, lines);
                 break;
             }
             case Imf::FLOAT:
             {
-                initExrChannel<float>(data[channelIndex], slices[channelIndex], frameBuffer, ch.type,
-                                      getChannelName(channelIndex), dataWindow);
+                initExrChannel<float>(data[channelIndex], slices[channelIndex], frameBuffer, ch.type, channelName,
+                                      lines);
                 break;
             }
             case Imf::UINT:
             {
                 initExrChannel<boost::uint32_t>(data[channelIndex], slices[channelIndex], frameBuffer, ch.type,
-                                                getChannelName(channelIndex), dataWindow);
+                                                channelName, lines);
                 break;
             }
             case Imf::NUM_PIXELTYPES:
@@ -193,26 +281,30 @@ void EXRReaderProcess<View>::channelCopy(Imf::InputFile& input, const EXRReaderP
         }
     }
 
+    // only the needed line blocks are decompressed, in parallel by the global thread pool of OpenEXR
     input.setFrameBuffer(frameBuffer);
-    input.readPixels(dataWindow.min.y, dataWindow.max.y);
+    input.readPixels(readBox.min.y, readBox.max.y);
 
     for(size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
     {
+        if(inView[channelIndex])
+            continue;
+
         switch(slices[channelIndex].type)
         {
             case Imf::HALF:
             {
-                sliceCopy<gray16h_view_t>(input, &slices[channelIndex], dst, params, channelIndex);
+                sliceCopy<gray16h_view_t>(data[channelIndex], lines, readBox, dst, channelIndex);
                 break;
             }
             case Imf::FLOAT:
             {
-                sliceCopy<gray32f_view_t>(input, &slices[channelIndex], dst, params, channelIndex);
+                sliceCopy<gray32f_view_t>(data[channelIndex], lines, readBox, dst, channelIndex);
                 break;
             }
             case Imf::UINT:
             {
-                sliceCopy<gray32_view_t>(input, &slices[channelIndex], dst, params, channelIndex);
+                sliceCopy<gray32_view_t>(data[channelIndex], lines, readBox, dst, channelIndex);
                 break;
             }
             case Imf::NUM_PIXELTYPES:
@@ -224,62 +316,28 @@ void EXRReaderProcess<View>::channelCopy(Imf::InputFile& input, const EXRReaderP
     }
 }
 
-Imath::Box2i boxIntersection(const Imath::Box2i& a, const Imath::Box2i& b)
-{
-    Imath::Box2i res;
-
-    res.min.x = std::max(a.min.x, b.min.x);
-    res.min.y = std::max(a.min.y, b.min.y);
-
-    res.max.x = std::min(a.max.x, b.max.x);
-    res.max.y = std::min(a.max.y, b.max.y);
-
-    return res;
-}
-
+/**
+ * @brief Copy the part @p readBox of the decoded lines @p box to the output view of @p readBox.
+ */
 template <class View>
 template <typename workingView>
-void EXRReaderProcess<View>::sliceCopy(Imf::InputFile& input, const Imf::Slice* slice, View& dst,
-                                       const EXRReaderProcessParams& params, const std::size_t channelIndex)
+void EXRReaderProcess<View>::sliceCopy(const DataVector& data, const Imath::Box2i& box, const Imath::Box2i& readBox,
+                                       View& dst, const std::size_t channelIndex)
 {
     using namespace terry;
-    const Imath::Box2i dataWindow = input.header().dataWindow();
-    Imath::V2i dataWindowSize = dataWindow.size();
-    dataWindowSize.x += 1;
-    dataWindowSize.y += 1;
-
-    if(dataWindowSize.x <= 0 || dataWindowSize.y <= 0)
-        return;
-
-    workingView dataView(interleaved_view(dataWindowSize.x, dataWindowSize.y, (typename workingView::value_type*)slice->base,
-                                          dataWindowSize.x * sizeof(typename workingView::value_type)));
-
-    if(params._displayWindow)
-    {
-        const Imath::Box2i displayWindow = input.header().displayWindow();
-        const Imath::Box2i croppedDisplayWindow = boxIntersection(displayWindow, dataWindow);
-        Imath::V2i croppedDisplayWindowSize = croppedDisplayWindow.size();
-        croppedDisplayWindowSize.x += 1;
-        croppedDisplayWindowSize.y += 1;
+    typedef typename workingView::value_type WorkingPixel;
+    typedef typename workingView::const_t ConstWorkingView;
 
-        if(croppedDisplayWindowSize.x <= 0 || croppedDisplayWindowSize.y <= 0)
-            return;
+    Imath::V2i boxSize = box.size();
+    boxSize.x += 1;
+    boxSize.y += 1;
 
-        workingView dataSubView = subimage_view(dataView, croppedDisplayWindow.min.x, croppedDisplayWindow.min.y,
-                                                croppedDisplayWindowSize.x, croppedDisplayWindowSize.y);
+    ConstWorkingView dataView(interleaved_view(boxSize.x, boxSize.y, reinterpret_cast<const WorkingPixel*>(&data[0]),
+                                               boxSize.x * sizeof(WorkingPixel)));
+    ConstWorkingView dataSubView = subimage_view(dataView, readBox.min.x - box.min.x, readBox.min.y - box.min.y,
+                                                 dst.width(), dst.height());
 
-        View dstSubView = subimage_view(dst, croppedDisplayWindow.min.x - displayWindow.min.x,
-                                        croppedDisplayWindow.min.y - displayWindow.min.y, croppedDisplayWindowSize.x,
-                                        croppedDisplayWindowSize.y);
-
-        copy_and_convert_pixels(dataSubView, nth_channel_view(dstSubView, channelIndex));
-    }
-    else
-    {
-        workingView dataSubView =
-            subimage_view(dataView, dataWindow.min.x, dataWindow.min.y, dataWindowSize.x, dataWindowSize.y);
-        copy_and_convert_pixels(dataSubView, nth_channel_view(dst, channelIndex));
-    }
+    copy_and_convert_pixels(dataSubView, nth_channel_view(dst, channelIndex));
 }
 
 template <class View>
@@ -24,6 +24,20 @@ enum EParamStorage
     eParamStorageScanLine = 0,
     eParamStorageTiles
 };
+
+static const std::string kParamTileSize = "tileSize";
+
+static const std::string kParamTileLevels = "tileLevels";
+static const std::string kParamTileLevelsOne = "oneLevel";
+static const std::string kParamTileLevelsMipmap = "mipmap";
+static const std::string kParamTileLevelsRipmap = "ripmap";
+
+enum EParamTileLevels
+{
+    eParamTileLevelsOne = 0,
+    eParamTileLevelsMipmap,
+    eParamTileLevelsRipmap
+};
 }
 }
 }
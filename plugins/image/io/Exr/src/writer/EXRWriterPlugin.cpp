@@ -2,6 +2,10 @@
 #include "EXRWriterPlugin.hpp"
 #include "EXRWriterProcess.hpp"
 
+#include <EXRThreading.hpp>
+
+#include <tuttle/ioplugin/context/WriteBehind.hpp>
+
 #include <boost/gil/gil_all.hpp>
 
 namespace tuttle
@@ -20,9 +24,13 @@ EXRWriterPlugin::EXRWriterPlugin(OfxImageEffectHandle handle)
 {
     _paramComponentsType = fetchChoiceParam(kTuttlePluginChannel);
     _paramStorageType = fetchChoiceParam(kParamStorageType);
+    _paramTileSize = fetchInt2DParam(kParamTileSize);
+    _paramTileLevels = fetchChoiceParam(kParamTileLevels);
 
     _paramFileBitDepth = fetchChoiceParam(kParamFileBitDepth);
     _paramCompression = fetchChoiceParam(kParamCompression);
+
+    initExrThreadPool();
 }
 
 EXRWriterProcessParams EXRWriterPlugin::getProcessParams(const OfxTime time)
@@ -33,6 +41,8 @@ EXRWriterProcessParams EXRWriterPlugin::getProcessParams(const OfxTime time)
     params._fileBitDepth = (ETuttlePluginFileBitDepth) this->_paramFileBitDepth->getValue();
     params._componentsType = (ETuttlePluginComponents)_paramComponentsType->getValue();
     params._storageType = (EParamStorage)_paramStorageType->getValue();
+    params._tileSize = _paramTileSize->getValue();
+    params._tileLevels = (EParamTileLevels)_paramTileLevels->getValue();
     params._compression = (EParamCompression)_paramCompression->getValue();
 
     return params;
@@ -46,7 +56,7 @@ void EXRWriterPlugin::render(const OFX::RenderArguments& args)
 {
     WriterPlugin::render(args);
 
-    doGilRender<EXRWriterProcess>(*this, args);
+    doGilRender<WriteBehind<EXRWriterProcess>::Process>(*this, args);
 }
 }
 }
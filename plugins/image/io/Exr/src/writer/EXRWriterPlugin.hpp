@@ -19,6 +19,8 @@ struct EXRWriterProcessParams
     ETuttlePluginFileBitDepth _fileBitDepth;
     ETuttlePluginComponents _componentsType;
     EParamStorage _storageType;
+    OfxPointI _tileSize;
+    EParamTileLevels _tileLevels;
     EParamCompression _compression;
 };
 
@@ -38,6 +40,8 @@ public:
 protected:
     OFX::ChoiceParam* _paramComponentsType;
     OFX::ChoiceParam* _paramStorageType;
+    OFX::Int2DParam* _paramTileSize;
+    OFX::ChoiceParam* _paramTileLevels;
     OFX::ChoiceParam* _paramFileBitDepth;
     OFX::ChoiceParam* _paramCompression;
 };
@@ -4,6 +4,8 @@
 
 #include <tuttle/ioplugin/context/WriterPluginFactory.hpp>
 
+#include <limits>
+
 namespace tuttle
 {
 namespace plugin
@@ -70,12 +72,26 @@ void EXRWriterPluginFactory::describeInContext(OFX::ImageEffectDescriptor& desc,
     OFX::ChoiceParamDescriptor* storageType = desc.defineChoiceParam(kParamStorageType);
     storageType->setLabel("Storage type");
     storageType->appendOption(kParamStorageScanLine);
-#if(TUTTLE_EXPERIMENTAL)
     storageType->appendOption(kParamStorageTiles);
-#endif
     storageType->setCacheInvalidation(OFX::eCacheInvalidateValueAll);
     storageType->setDefault(eParamStorageScanLine);
 
+    OFX::Int2DParamDescriptor* tileSize = desc.defineInt2DParam(kParamTileSize);
+    tileSize->setLabel("Tile size");
+    tileSize->setDefault(64, 64);
+    tileSize->setRange(1, 1, std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
+    tileSize->setDisplayRange(16, 16, 512, 512);
+    tileSize->setHint("Size of the tiles, with the tiles storage type.");
+
+    OFX::ChoiceParamDescriptor* tileLevels = desc.defineChoiceParam(kParamTileLevels);
+    tileLevels->setLabel("Tile levels");
+    tileLevels->appendOption(kParamTileLevelsOne, "Only the full resolution image.");
+    tileLevels->appendOption(kParamTileLevelsMipmap, "Full resolution and reduced images, halved in both directions.");
+    tileLevels->appendOption(kParamTileLevelsRipmap,
+                             "Full resolution and reduced images, halved in each direction independently.");
+    tileLevels->setDefault(eParamTileLevelsOne);
+    tileLevels->setHint("Resolution levels written in the file, with the tiles storage type.");
+
     OFX::ChoiceParamDescriptor* bitDepth =
         static_cast<OFX::ChoiceParamDescriptor*>(desc.getParamDescriptor(kTuttlePluginBitDepth));
     bitDepth->resetOptions();
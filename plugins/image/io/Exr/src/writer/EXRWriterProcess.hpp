@@ -8,6 +8,7 @@
 #include <terry/globals.hpp>
 
 #include <ImfOutputFile.h>
+#include <ImfTiledOutputFile.h>
 #include <ImfRgba.h>
 #include <ImfChannelList.h>
 #include <ImfArray.h>
@@ -42,12 +43,20 @@ public:
 protected:
     EXRWriterPlugin& _plugin; ///< Rendering plugin
     EXRWriterProcessParams _params;
-
-    template <class WPixel>
-    void writeGrayImage(View& src, std::string& filepath, Imf::PixelType pixType);
+    /// @name Retrieved at setup, the image may be written in another thread
+    /// @{
+    OFX::EPixelComponent _srcComponents;
+    double _srcPixelAspectRatio;
+    /// @}
 
     template <class WPixel>
     void writeImage(View& src, std::string& filepath, Imf::PixelType pixType);
+
+    template <class WView>
+    void writeFile(const std::string& filepath, Imf::Header& header, const WView& image, const Imf::PixelType pixType);
+
+    template <class WView>
+    void writeTileLevels(Imf::TiledOutputFile& file, const WView& image, const Imf::PixelType pixType);
 };
 }
 }
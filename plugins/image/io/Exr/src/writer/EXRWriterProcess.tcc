@@ -12,6 +12,10 @@
 #include <boost/mpl/if.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <algorithm>
+#include <cstddef>
 
 namespace tuttle
 {
@@ -38,6 +42,8 @@ void EXRWriterProcess<View>::setup(const OFX::RenderArguments& args)
     using namespace boost::gil;
     ImageGilFilterProcessor<View>::setup(args);
     _params = _plugin.getProcessParams(args.time);
+    _srcComponents = _plugin._clipSrc->getPixelComponents();
+    _srcPixelAspectRatio = _plugin._clipSrc->getPixelAspectRatio();
 }
 
 /**
@@ -47,7 +53,7 @@ void EXRWriterProcess<View>::setup(const OFX::RenderArguments& args)
 template <class View>
 void EXRWriterProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 {
-    // no tiles and no multithreading supported
+    // the whole image is written at once (the compression uses the OpenEXR threads)
     BOOST_ASSERT((procWindowRoW == this->_dstPixelRod));
     BOOST_ASSERT((this->_srcPixelRod == this->_dstPixelRod));
 
@@ -63,7 +69,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages(const OfxRectI& procWindow
                 {
                     case eTuttlePluginComponentsAuto:
                     {
-                        switch(_plugin._clipSrc->getPixelComponents())
+                        switch(_srcComponents)
                         {
                             case OFX::ePixelComponentAlpha:
                                 writeImage<gray16h_pixel_t>(src, _params._filepath, Imf::HALF);
@@ -108,7 +114,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages(const OfxRectI& procWindow
                 {
                     case eTuttlePluginComponentsAuto:
                     {
-                        switch(_plugin._clipSrc->getPixelComponents())
+                        switch(_srcComponents)
                         {
                             case OFX::ePixelComponentAlpha:
                                 writeImage<gray32f_pixel_t>(src, _params._filepath, Imf::FLOAT);
@@ -153,7 +159,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages(const OfxRectI& procWindow
                 {
                     case eTuttlePluginComponentsAuto:
                     {
-                        switch(_plugin._clipSrc->getPixelComponents())
+                        switch(_srcComponents)
                         {
                             case OFX::ePixelComponentAlpha:
                                 writeImage<gray32_pixel_t>(src, _params._filepath, Imf::UINT);
@@ -211,62 +217,81 @@ void EXRWriterProcess<View>::multiThreadProcessImages(const OfxRectI& procWindow
     }
 }
 
-template <int my_nb_channels>
-struct FillFrameSwitch
+/**
+ * @brief Name of the channel @p index of an image with @p nbChannels channels.
+ */
+inline const char* getExrChannelName(const std::size_t nbChannels, const std::size_t index)
 {
-    template <typename View>
-    static void fillFrameBuffer(Imf::FrameBuffer& frameBuffer, const View& dvw, const Imf::PixelType pixType,
-                                const std::size_t bitsTypeSize, const std::size_t rowBytes);
-};
+    static const char* const grayNames[] = {"Y"};
+    static const char* const colorNames[] = {"R", "G", "B", "A"};
+    return nbChannels == 1 ? grayNames[index] : colorNames[index];
+}
 
-template <>
-struct FillFrameSwitch<1>
+/**
+ * @brief Insert a slice for each channel of @p view (planar or interleaved) into @p frameBuffer.
+ */
+template <class WView>
+void fillFrameBuffer(Imf::FrameBuffer& frameBuffer, const WView& view, const Imf::PixelType pixType)
 {
-    template <typename View>
-    static void fillFrameBuffer(Imf::FrameBuffer& frameBuffer, const View& dvw, const Imf::PixelType pixType,
-                                const std::size_t bitsTypeSize, const std::size_t rowBytes)
-    {
-        // Gray
-        char* pixelsY = (char*)boost::gil::interleaved_view_get_raw_data(dvw);
-        frameBuffer.insert("Y", Imf::Slice(pixType, pixelsY, bitsTypeSize, rowBytes));
-    }
-};
+    static const std::size_t nbChannels = boost::gil::num_channels<WView>::value;
 
-template <>
-struct FillFrameSwitch<3>
-{
-    template <typename View>
-    static void fillFrameBuffer(Imf::FrameBuffer& frameBuffer, const View& dvw, Imf::PixelType pixType,
-                                const std::size_t bitsTypeSize, const std::size_t rowBytes)
+    for(std::size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
     {
-        // RGB
-        char* pixelsR = (char*)boost::gil::planar_view_get_raw_data(dvw, 0);
-        char* pixelsG = (char*)boost::gil::planar_view_get_raw_data(dvw, 1);
-        char* pixelsB = (char*)boost::gil::planar_view_get_raw_data(dvw, 2);
-        frameBuffer.insert("R", Imf::Slice(pixType, pixelsR, bitsTypeSize, rowBytes));
-        frameBuffer.insert("G", Imf::Slice(pixType, pixelsG, bitsTypeSize, rowBytes));
-        frameBuffer.insert("B", Imf::Slice(pixType, pixelsB, bitsTypeSize, rowBytes));
+        typedef typename boost::gil::nth_channel_view_type<WView>::type ChannelView;
+        const ChannelView channelView = boost::gil::nth_channel_view(view, channelIndex);
+
+        char* base = (char*)(&channelView(0, 0));
+        const std::ptrdiff_t xStride = boost::gil::memunit_step(channelView.x_at(0, 0));
+        // negative for a view from top to bottom on an OFX image
+        const std::ptrdiff_t yStride = channelView.pixels().row_size();
+
+        // OpenEXR addresses the pixel (x, y) at base + x * xStride + y * yStride,
+        // the unsigned strides wrap around so a negative yStride is valid.
+        frameBuffer.insert(getExrChannelName(nbChannels, channelIndex),
+                           Imf::Slice(pixType, base, static_cast<std::size_t>(xStride),
+                                      static_cast<std::size_t>(yStride)));
     }
-};
+}
 
-template <>
-struct FillFrameSwitch<4>
+/**
+ * @brief Box filter of @p src into the smaller image @p dst.
+ */
+template <class SView, class DView>
+void downscaleLevel(const SView& src, const DView& dst)
 {
-    template <typename View>
-    static void fillFrameBuffer(Imf::FrameBuffer& frameBuffer, const View& dvw, const Imf::PixelType pixType,
-                                const std::size_t bitsTypeSize, const std::size_t rowBytes)
+    typedef typename boost::gil::channel_type<DView>::type DChannel;
+    static const std::size_t nbChannels = boost::gil::num_channels<DView>::value;
+
+    const int srcWidth = src.width();
+    const int srcHeight = src.height();
+    const int dstWidth = dst.width();
+    const int dstHeight = dst.height();
+
+    for(int y = 0; y < dstHeight; ++y)
     {
-        // RGBA
-        char* pixelsR = (char*)boost::gil::planar_view_get_raw_data(dvw, 0);
-        char* pixelsG = (char*)boost::gil::planar_view_get_raw_data(dvw, 1);
-        char* pixelsB = (char*)boost::gil::planar_view_get_raw_data(dvw, 2);
-        char* pixelsA = (char*)boost::gil::planar_view_get_raw_data(dvw, 3);
-        frameBuffer.insert("R", Imf::Slice(pixType, pixelsR, bitsTypeSize, rowBytes));
-        frameBuffer.insert("G", Imf::Slice(pixType, pixelsG, bitsTypeSize, rowBytes));
-        frameBuffer.insert("B", Imf::Slice(pixType, pixelsB, bitsTypeSize, rowBytes));
-        frameBuffer.insert("A", Imf::Slice(pixType, pixelsA, bitsTypeSize, rowBytes));
+        const int srcY1 = y * srcHeight / dstHeight;
+        const int srcY2 = std::max((y + 1) * srcHeight / dstHeight, srcY1 + 1);
+        for(int x = 0; x < dstWidth; ++x)
+        {
+            const int srcX1 = x * srcWidth / dstWidth;
+            const int srcX2 = std::max((x + 1) * srcWidth / dstWidth, srcX1 + 1);
+
+            double sum[nbChannels] = {};
+            for(int sy = srcY1; sy < srcY2; ++sy)
+            {
+                typename SView::x_iterator it = src.x_at(srcX1, sy);
+                for(int sx = srcX1; sx < srcX2; ++sx, ++it)
+                {
+                    for(std::size_t c = 0; c < nbChannels; ++c)
+                        sum[c] += static_cast<double>((*it)[c]);
+                }
+            }
+            const double nbPixels = (srcY2 - srcY1) * (srcX2 - srcX1);
+            for(std::size_t c = 0; c < nbChannels; ++c)
+                dst(x, y)[c] = static_cast<DChannel>(static_cast<float>(sum[c] / nbPixels));
+        }
     }
-};
+}
 
 template <class View>
 template <class WPixel>
@@ -278,10 +303,7 @@ void EXRWriterProcess<View>::writeImage(View& src, std::string& filepath, Imf::P
     typedef boost::gil::image<WPixel, is_planar_t::value> image_t;
     typedef typename image_t::view_t view_t;
 
-    image_t img(src.width(), src.height());
-    view_t dvw(view(img));
-    boost::gil::copy_and_convert_pixels(src, dvw);
-    Imf::Header header(src.width(), src.height(), (float)_plugin._clipSrc->getPixelAspectRatio());
+    Imf::Header header(src.width(), src.height(), (float)_srcPixelAspectRatio);
 
     switch(_params._compression)
     {
@@ -315,6 +337,24 @@ void EXRWriterProcess<View>::writeImage(View& src, std::string& filepath, Imf::P
             break;
     }
 
+    if(_params._storageType == eParamStorageTiles)
+    {
+        Imf::LevelMode levelMode = Imf::ONE_LEVEL;
+        switch(_params._tileLevels)
+        {
+            case eParamTileLevelsOne:
+                levelMode = Imf::ONE_LEVEL;
+                break;
+            case eParamTileLevelsMipmap:
+                levelMode = Imf::MIPMAP_LEVELS;
+                break;
+            case eParamTileLevelsRipmap:
+                levelMode = Imf::RIPMAP_LEVELS;
+                break;
+        }
+        header.setTileDescription(Imf::TileDescription(_params._tileSize.x, _params._tileSize.y, levelMode));
+    }
+
     // TODO
     // RoI
     //	header.dataWindow()
@@ -322,57 +362,132 @@ void EXRWriterProcess<View>::writeImage(View& src, std::string& filepath, Imf::P
     //	header.displayWindow()
     //	header.lineOrder() = Imf::INCREASING_Y;
 
-    std::size_t bitsTypeSize = 0;
-    switch(pixType)
+    static const std::size_t nbChannels = boost::gil::num_channels<WPixel>::value;
+    if(nbChannels != 1 && nbChannels != 3 && nbChannels != 4)
+        BOOST_THROW_EXCEPTION(exception::ImageFormat() << exception::user("ExrWriter: incompatible image type"));
+
+    for(std::size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex)
+        header.channels().insert(getExrChannelName(nbChannels, channelIndex), Imf::Channel(pixType));
+
+    // the source already has the pixel type of the file: no intermediate image
+    const bool sameChannels =
+        boost::is_same<typename boost::gil::channel_type<WPixel>::type,
+                       typename boost::gil::channel_type<View>::type>::value &&
+        (nbChannels == boost::gil::num_channels<View>::value);
+    if(sameChannels)
     {
-        case Imf::HALF:
-            bitsTypeSize = sizeof(half);
-            break;
-        case Imf::FLOAT:
-            bitsTypeSize = sizeof(float);
-            break;
-        case Imf::UINT:
-            bitsTypeSize = sizeof(boost::uint32_t);
-            break;
-        default:
-            break;
+        writeFile(filepath, header, src, pixType);
+        return;
     }
 
-    switch(dvw.num_channels())
+    image_t img(src.width(), src.height());
+    view_t dvw(view(img));
+    boost::gil::copy_and_convert_pixels(src, dvw);
+    writeFile(filepath, header, dvw, pixType);
+}
+
+/**
+ * @brief Write the file, the compression is done by the global thread pool of OpenEXR.
+ */
+template <class View>
+template <class WView>
+void EXRWriterProcess<View>::writeFile(const std::string& filepath, Imf::Header& header, const WView& image,
+                                       const Imf::PixelType pixType)
+{
+    Imf::FrameBuffer frameBuffer;
+    fillFrameBuffer(frameBuffer, image, pixType);
+
+    if(!header.hasTileDescription())
     {
-        case 1: // Gray
-            header.channels().insert("Y", Imf::Channel(pixType));
-            break;
-        case 3:
+        Imf::OutputFile file(filepath.c_str(), header);
+        file.setFrameBuffer(frameBuffer);
+        // Finalize output
+        file.writePixels(image.height());
+        return;
+    }
+
+    Imf::TiledOutputFile file(filepath.c_str(), header);
+    file.setFrameBuffer(frameBuffer);
+    file.writeTiles(0, file.numXTiles(0) - 1, 0, file.numYTiles(0) - 1, 0, 0);
+    writeTileLevels(file, image, pixType);
+}
+
+/**
+ * @brief Write the reduced resolution levels (mipmap or ripmap), each one from the previous bigger level.
+ */
+template <class View>
+template <class WView>
+void EXRWriterProcess<View>::writeTileLevels(Imf::TiledOutputFile& file, const WView& image,
+                                             const Imf::PixelType pixType)
+{
+    typedef boost::gil::image<typename WView::value_type, boost::gil::is_planar<WView>::value> level_image_t;
+
+    switch(file.levelMode())
+    {
+        case Imf::ONE_LEVEL:
+        case Imf::NUM_LEVELMODES:
+            return;
+        case Imf::MIPMAP_LEVELS:
         {
-            header.channels().insert("R", Imf::Channel(pixType));
-            header.channels().insert("G", Imf::Channel(pixType));
-            header.channels().insert("B", Imf::Channel(pixType));
-            break;
+            level_image_t previous;
+            for(int level = 1; level < file.numLevels(); ++level)
+            {
+                level_image_t current(file.levelWidth(level), file.levelHeight(level));
+                if(level == 1)
+                    downscaleLevel(image, view(current));
+                else
+                    downscaleLevel(const_view(previous), view(current));
+
+                Imf::FrameBuffer frameBuffer;
+                fillFrameBuffer(frameBuffer, const_view(current), pixType);
+                file.setFrameBuffer(frameBuffer);
+                file.writeTiles(0, file.numXTiles(level) - 1, 0, file.numYTiles(level) - 1, level, level);
+                previous.swap(current);
+            }
+            return;
         }
-        case 4:
+        case Imf::RIPMAP_LEVELS:
         {
-            header.channels().insert("R", Imf::Channel(pixType));
-            header.channels().insert("G", Imf::Channel(pixType));
-            header.channels().insert("B", Imf::Channel(pixType));
-            header.channels().insert("A", Imf::Channel(pixType));
-            break;
-        }
-        default:
-            BOOST_THROW_EXCEPTION(exception::ImageFormat() << exception::user("ExrWriter: incompatible image type"));
-    }
-
-    Imf::OutputFile file(filepath.c_str(), header);
-    Imf::FrameBuffer frameBuffer;
+            // (0, ly) from (0, ly - 1), then (lx, ly) from (lx - 1, ly)
+            level_image_t firstColumn;
+            for(int ly = 0; ly < file.numYLevels(); ++ly)
+            {
+                if(ly > 0)
+                {
+                    level_image_t current(file.levelWidth(0), file.levelHeight(ly));
+                    if(ly == 1)
+                        downscaleLevel(image, view(current));
+                    else
+                        downscaleLevel(const_view(firstColumn), view(current));
+                    firstColumn.swap(current);
 
-    const std::size_t rowBytes = bitsTypeSize * src.width();
+                    Imf::FrameBuffer frameBuffer;
+                    fillFrameBuffer(frameBuffer, const_view(firstColumn), pixType);
+                    file.setFrameBuffer(frameBuffer);
+                    file.writeTiles(0, file.numXTiles(0) - 1, 0, file.numYTiles(ly) - 1, 0, ly);
+                }
 
-    static const std::size_t view_nb_channels = boost::gil::num_channels<view_t>::value;
-    FillFrameSwitch<view_nb_channels>::template fillFrameBuffer<view_t>(frameBuffer, dvw, pixType, bitsTypeSize, rowBytes);
+                level_image_t previous;
+                for(int lx = 1; lx < file.numXLevels(); ++lx)
+                {
+                    level_image_t current(file.levelWidth(lx), file.levelHeight(ly));
+                    if(lx > 1)
+                        downscaleLevel(const_view(previous), view(current));
+                    else if(ly > 0)
+                        downscaleLevel(const_view(firstColumn), view(current));
+                    else
+                        downscaleLevel(image, view(current));
 
-    file.setFrameBuffer(frameBuffer);
-    // Finalize output
-    file.writePixels(src.height());
+                    Imf::FrameBuffer frameBuffer;
+                    fillFrameBuffer(frameBuffer, const_view(current), pixType);
+                    file.setFrameBuffer(frameBuffer);
+                    file.writeTiles(0, file.numXTiles(lx) - 1, 0, file.numYTiles(ly) - 1, lx, ly);
+                    previous.swap(current);
+                }
+            }
+            return;
+        }
+    }
 }
 }
 }
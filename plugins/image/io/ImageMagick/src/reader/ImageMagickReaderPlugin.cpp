@@ -2,6 +2,8 @@
 #include "ImageMagickReaderProcess.hpp"
 #include "ImageMagickReaderDefinitions.hpp"
 
+#include <tuttle/ioplugin/context/ReadAhead.hpp>
+
 #include <boost/gil/gil_all.hpp>
 #include <boost/filesystem.hpp>
 
@@ -50,17 +52,20 @@ void ImageMagickReaderPlugin::render(const OFX::RenderArguments& args)
     {
         case OFX::ePixelComponentRGBA:
         {
-            doGilRender<ImageMagickReaderProcess, false, boost::gil::rgba_layout_t>(*this, args, bitDepth);
+            doGilRender<ReadAhead<ImageMagickReaderProcess>::Process, false, boost::gil::rgba_layout_t>(*this, args,
+                                                                                                        bitDepth);
             return;
         }
         case OFX::ePixelComponentRGB:
         {
-            doGilRender<ImageMagickReaderProcess, false, boost::gil::rgb_layout_t>(*this, args, bitDepth);
+            doGilRender<ReadAhead<ImageMagickReaderProcess>::Process, false, boost::gil::rgb_layout_t>(*this, args,
+                                                                                                       bitDepth);
             return;
         }
         case OFX::ePixelComponentAlpha:
         {
-            doGilRender<ImageMagickReaderProcess, false, boost::gil::gray_layout_t>(*this, args, bitDepth);
+            doGilRender<ReadAhead<ImageMagickReaderProcess>::Process, false, boost::gil::gray_layout_t>(*this, args,
+                                                                                                        bitDepth);
             return;
         }
         case OFX::ePixelComponentCustom:
@@ -111,7 +111,7 @@ void ImageMagickReaderProcess<View>::multiThreadProcessImages(const OfxRectI& pr
 {
     // no tiles and no multithreading supported
     BOOST_ASSERT(procWindowRoW == this->_dstPixelRod);
-    readGilImage(this->_dstView, _plugin.getProcessParams(this->_renderArgs.time)._filepath);
+    readGilImage(this->_dstView, _params._filepath);
 }
 
 template <class SView, class DView>
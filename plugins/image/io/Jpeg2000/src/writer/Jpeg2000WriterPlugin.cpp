@@ -5,6 +5,7 @@
 #include <openjpeg/J2KWriter.hpp>
 
 #include <tuttle/plugin/global.hpp>
+#include <tuttle/ioplugin/context/WriteBehind.hpp>
 
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
@@ -72,7 +73,7 @@ void Jpeg2000WriterPlugin::render(const OFX::RenderArguments& args)
 {
     WriterPlugin::render(args);
 
-    doGilRender<Jpeg2000WriterProcess>(*this, args);
+    doGilRender<WriteBehind<Jpeg2000WriterProcess>::Process>(*this, args);
 }
 }
 }
@@ -48,6 +48,7 @@ private:
 protected:
     Jpeg2000WriterPlugin& _plugin; ///< Rendering plugin
     Jpeg2000ProcessParams _params;
+    OFX::EBitDepth _srcBitDepth; ///< retrieved at setup, the image may be written in another thread
     tuttle::io::J2KWriter _writer; ///< Writer engine
 };
 }
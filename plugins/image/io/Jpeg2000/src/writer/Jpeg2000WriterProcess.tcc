@@ -31,6 +31,7 @@ void Jpeg2000WriterProcess<View>::setup(const OFX::RenderArguments& args)
     ImageGilFilterProcessor<View>::setup(args);
 
     _params = _plugin.getProcessParams(args.time);
+    _srcBitDepth = _plugin._clipSrc->getPixelDepth();
 }
 
 /**
@@ -56,7 +57,7 @@ void Jpeg2000WriterProcess<View>::multiThreadProcessImages(const OfxRectI& procW
     {
         case eTuttlePluginBitDepthAuto:
         {
-            switch(_plugin._clipSrc->getPixelDepth())
+            switch(_srcBitDepth)
             {
                 case OFX::eBitDepthUByte:
                 {
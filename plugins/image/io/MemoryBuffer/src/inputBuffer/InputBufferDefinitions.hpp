@@ -26,12 +26,16 @@ static const std::string kParamInputBufferPointer = "bufferPointer";
 static const std::string kParamInputCallbackPointer = "callbackPointer";
 static const std::string kParamInputCustomData = "customData";
 static const std::string kParamInputCallbackDestroyCustomData = "callbackDestroyCustomData";
+static const std::string kParamInputCallbackRetainImage = "callbackRetainImage";
 
 extern "C" {
 typedef void* CustomDataPtr;
 typedef void (*CallbackInputImagePtr)(OfxTime time, CustomDataPtr customData, void** outRawdata, int* outWidth,
                                       int* outHeight, int* outRowSizeBytes);
 typedef void (*CallbackDestroyCustomDataPtr)(CustomDataPtr customData);
+typedef void (*CallbackReleaseImagePtr)(void* image);
+/// Keep the image returned by the last call of the input callback, until the returned image is given to @p outRelease.
+typedef void* (*CallbackRetainImagePtr)(CustomDataPtr customData, CallbackReleaseImagePtr* outRelease);
 }
 
 static const std::string kParamSize = "size";
@@ -92,6 +96,8 @@ enum EParamOrientation
 };
 
 static const std::string kParamTimeDomain = "timeDomain";
+
+static const std::string kParamZeroCopy = "zeroCopy";
 }
 }
 }
@@ -71,6 +71,7 @@ InputBufferPlugin::InputBufferPlugin(OfxImageEffectHandle handle)
     _paramInputCallbackPointer = fetchStringParam(kParamInputCallbackPointer);
     _paramInputCallbackCustomData = fetchStringParam(kParamInputCustomData);
     _paramInputCallbackDestroyCustomData = fetchStringParam(kParamInputCallbackDestroyCustomData);
+    _paramInputCallbackRetainImage = fetchStringParam(kParamInputCallbackRetainImage);
 
     _paramSize = fetchInt2DParam(kParamSize);
     _paramRowByteSize = fetchIntParam(kParamRowBytesSize);
@@ -82,6 +83,7 @@ InputBufferPlugin::InputBufferPlugin(OfxImageEffectHandle handle)
     _paramOrientation = fetchChoiceParam(kParamOrientation);
 
     _paramTimeDomain = fetchDouble2DParam(kParamTimeDomain);
+    _paramZeroCopy = fetchBooleanParam(kParamZeroCopy);
 
     // init temporary values
     _callbackMode_time = 0;
@@ -89,12 +91,23 @@ InputBufferPlugin::InputBufferPlugin(OfxImageEffectHandle handle)
     _callbackMode_imgSize.y = 0;
     _callbackMode_rowSizeBytes = 0;
     _callbackMode_imgPointer = NULL;
+    _tempStoreCustomDataPtr = NULL;
 
     changedParam(OFX::InstanceChangedArgs(), kParamInputMode);
 }
 
 InputBufferPlugin::~InputBufferPlugin()
 {
+    destroyCustomData();
+}
+
+void InputBufferPlugin::destroyCustomData()
+{
+    const CallbackDestroyCustomDataPtr callbackDestroyPtr =
+        reinterpret_cast<CallbackDestroyCustomDataPtr>(stringToPointer(_paramInputCallbackDestroyCustomData->getValue()));
+    if(callbackDestroyPtr != NULL && _tempStoreCustomDataPtr != NULL)
+        callbackDestroyPtr(_tempStoreCustomDataPtr);
+    _tempStoreCustomDataPtr = NULL;
 }
 
 InputBufferProcessParams InputBufferPlugin::getProcessParams(const OfxTime time) const
@@ -107,6 +120,8 @@ InputBufferProcessParams InputBufferPlugin::getProcessParams(const OfxTime time)
     params._customDataPtr = static_cast<CustomDataPtr>(stringToPointer(_paramInputCallbackCustomData->getValue()));
     params._callbackDestroyPtr =
         reinterpret_cast<CallbackDestroyCustomDataPtr>(stringToPointer(_paramInputCallbackDestroyCustomData->getValue()));
+    params._callbackRetainImagePtr =
+        reinterpret_cast<CallbackRetainImagePtr>(stringToPointer(_paramInputCallbackRetainImage->getValue()));
 
     const OfxPointI imgSize = _paramSize->getValueAtTime(time);
     params._width = imgSize.x;
@@ -156,6 +171,7 @@ InputBufferProcessParams InputBufferPlugin::getProcessParams(const OfxTime time)
             break;
     }
     params._orientation = static_cast<EParamOrientation>(_paramOrientation->getValue());
+    params._zeroCopy = _paramZeroCopy->getValue();
 
     return params;
 }
@@ -174,16 +190,17 @@ void InputBufferPlugin::changedParam(const OFX::InstanceChangedArgs& args, const
     {
         _paramInputMode->setValue(eParamInputModeBufferPointer);
     }
-    else if((paramName == kParamInputCallbackPointer) || (paramName == kParamInputCustomData))
+    else if(paramName == kParamInputCallbackPointer)
     {
         _paramInputMode->setValue(eParamInputModeCallbackPointer);
     }
     else if(paramName == kParamInputCustomData)
     {
-        InputBufferProcessParams params = getProcessParams(args.time);
-        if(params._callbackDestroyPtr != NULL && _tempStoreCustomDataPtr != NULL)
-            params._callbackDestroyPtr(_tempStoreCustomDataPtr);
+        _paramInputMode->setValue(eParamInputModeCallbackPointer);
+        // the previous custom data is not used anymore
+        destroyCustomData();
         _tempStoreCustomDataPtr = static_cast<CustomDataPtr>(stringToPointer(_paramInputCallbackCustomData->getValue()));
+        _callbackMode_imgPointer = NULL;
     }
 }
 
@@ -247,25 +264,88 @@ void InputBufferPlugin::callbackMode_updateImage(const OfxTime time, const Input
                         &_callbackMode_imgSize.y, &_callbackMode_rowSizeBytes);
 }
 
+bool InputBufferPlugin::getOutputImageBuffer(const OFX::OutputImageBufferArguments& args, OFX::OutputImageBuffer& buffer)
+{
+    InputBufferProcessParams params = getProcessParams(args.time);
+    if(!params._zeroCopy)
+        return false;
+
+    unsigned char* inputImageBufferPtr = NULL;
+    OfxPointI imgSize = {0, 0};
+    int rowBytesDistanceSize = 0;
+    switch(params._mode)
+    {
+        case eParamInputModeBufferPointer:
+        {
+            inputImageBufferPtr = params._inputBuffer;
+            imgSize.x = params._width;
+            imgSize.y = params._height;
+            rowBytesDistanceSize = params._rowByteSize;
+            break;
+        }
+        case eParamInputModeCallbackPointer:
+        {
+            // the image of the callback needs to stay alive with the output image
+            if(params._callbackRetainImagePtr == NULL)
+                return false;
+            callbackMode_updateImage(args.time, params);
+            inputImageBufferPtr = _callbackMode_imgPointer;
+            imgSize = _callbackMode_imgSize;
+            rowBytesDistanceSize = _callbackMode_rowSizeBytes;
+            break;
+        }
+    }
+    if(inputImageBufferPtr == NULL || imgSize.x <= 0 || imgSize.y <= 0)
+        return false;
+
+    if(rowBytesDistanceSize == 0)
+        rowBytesDistanceSize =
+            imgSize.x * numberOfComponents(params._pixelComponents) * bitDepthMemorySize(params._bitDepth);
+
+    buffer.bounds.x1 = 0;
+    buffer.bounds.y1 = 0;
+    buffer.bounds.x2 = imgSize.x;
+    buffer.bounds.y2 = imgSize.y;
+    // OpenFX images point to the bottom left corner
+    switch(params._orientation)
+    {
+        case eParamOrientationFromBottomToTop:
+        {
+            buffer.data = inputImageBufferPtr;
+            buffer.rowBytes = rowBytesDistanceSize;
+            break;
+        }
+        case eParamOrientationFromTopToBottom:
+        {
+            buffer.data = inputImageBufferPtr + (imgSize.y - 1) * rowBytesDistanceSize;
+            buffer.rowBytes = -rowBytesDistanceSize;
+            break;
+        }
+    }
+
+    if(params._mode == eParamInputModeCallbackPointer)
+    {
+        // The output image keeps the image of the callback, released with the output image.
+        CallbackReleaseImagePtr releaseImage = NULL;
+        buffer.releaseCustomData = params._callbackRetainImagePtr(params._customDataPtr, &releaseImage);
+        buffer.release = releaseImage;
+        _callbackMode_imgPointer = NULL;
+    }
+    return true;
+}
+
 /**
  * @brief The overridden render function
  * @param[in]   args     Rendering parameters
  */
 void InputBufferPlugin::render(const OFX::RenderArguments& args)
 {
-    // @todo: add an OpenFX extension to setup the image buffer pointer
-    //        from the plugin.
-    // If the host supports this extension, we only need to set the pointer,
-    // else we need to do a buffer copy.
+    // In zero copy mode, the host only calls render if it can't use the image buffer
+    // given by getOutputImageBuffer, so we need to do a buffer copy.
 
     // User parameters
     InputBufferProcessParams params = getProcessParams(args.time);
 
-    //	if()
-    //	{
-    //		// Set the buffer pointer
-    //	}
-    //	else
     {
         // Buffer Copy
 
@@ -341,8 +421,8 @@ void InputBufferPlugin::render(const OFX::RenderArguments& args)
             {
                 for(int y = 0; y < dstPixelRodSize.y; ++y)
                 {
-                    memcpy(dst->getPixelAddress(0, y), inputImageBufferPtr + (dstPixelRodSize.y - y) * rowBytesDistanceSize,
-                           widthBytesSize);
+                    memcpy(dst->getPixelAddress(0, y),
+                           inputImageBufferPtr + (dstPixelRodSize.y - 1 - y) * rowBytesDistanceSize, widthBytesSize);
                 }
                 break;
             }
@@ -352,10 +432,9 @@ void InputBufferPlugin::render(const OFX::RenderArguments& args)
         {
             case eParamInputModeCallbackPointer:
             {
-                // We duplicated the image buffer to a buffer allocated by the host.
-                // Now we can destroy the customData.
-                if(params._callbackDestroyPtr != NULL)
-                    params._callbackDestroyPtr(params._customDataPtr);
+                // We duplicated the image buffer to a buffer allocated by the host,
+                // the callback is called again for the next render.
+                // The customData is used by the next frames, it's destroyed with the instance.
                 _callbackMode_imgPointer = NULL;
                 break;
             }
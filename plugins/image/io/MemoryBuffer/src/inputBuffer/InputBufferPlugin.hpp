@@ -20,6 +20,7 @@ struct InputBufferProcessParams
     CallbackInputImagePtr _callbackPtr;
     CustomDataPtr _customDataPtr;
     CallbackDestroyCustomDataPtr _callbackDestroyPtr;
+    CallbackRetainImagePtr _callbackRetainImagePtr;
 
     int _width;
     int _height;
@@ -30,6 +31,7 @@ struct InputBufferProcessParams
     OFX::EBitDepth _bitDepth;
     OFX::EField _field;
     EParamOrientation _orientation;
+    bool _zeroCopy;
 };
 
 /**
@@ -53,6 +55,8 @@ public:
     void getClipPreferences(OFX::ClipPreferencesSetter& clipPreferences);
     bool getRegionOfDefinition(const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod);
 
+    bool getOutputImageBuffer(const OFX::OutputImageBufferArguments& args, OFX::OutputImageBuffer& buffer);
+
     void render(const OFX::RenderArguments& args);
 
 public:
@@ -63,6 +67,7 @@ public:
     OFX::StringParam* _paramInputCallbackPointer;
     OFX::StringParam* _paramInputCallbackCustomData;
     OFX::StringParam* _paramInputCallbackDestroyCustomData;
+    OFX::StringParam* _paramInputCallbackRetainImage;
 
     OFX::Int2DParam* _paramSize;
     OFX::IntParam* _paramRowByteSize;
@@ -74,9 +79,10 @@ public:
     OFX::ChoiceParam* _paramOrientation;
 
     OFX::Double2DParam* _paramTimeDomain;
+    OFX::BooleanParam* _paramZeroCopy;
 
 private:
-    CustomDataPtr _tempStoreCustomDataPtr; //< keep track of the previous value
+    CustomDataPtr _tempStoreCustomDataPtr; //< keep track of the previous value, destroyed with the instance
 
     /// @brief Store temporary values (between actions).
     ///        We ensure that we call the get image callback only once,
@@ -94,6 +100,9 @@ private:
      *        and is responsible to call the callback only once for a given input time.
      */
     void callbackMode_updateImage(const OfxTime time, const InputBufferProcessParams& params);
+
+    /// @brief Destroy the custom data of the callback, when it's replaced or with the instance.
+    void destroyCustomData();
 };
 }
 }
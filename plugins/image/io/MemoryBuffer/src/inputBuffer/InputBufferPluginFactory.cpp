@@ -173,13 +173,38 @@ void InputBufferPluginFactory::describeInContext(OFX::ImageEffectDescriptor& des
 
     OFX::StringParamDescriptor* callbackDestroyCustomData = desc.defineStringParam(kParamInputCallbackDestroyCustomData);
     callbackDestroyCustomData->setLabel("Callback Destroy Custom Data");
-    callbackDestroyCustomData->setHint("This parameter represents a pointer to a function.\n"
+    callbackDestroyCustomData->setHint("This parameter represents a pointer to a function of type "
+                                       "\"void(*)(void* inputCustomData)\", called when the custom data is replaced "
+                                       "or when the node is destroyed.\n"
                                        "WARNING:\n"
                                        " - Your application could crash if you set an invalid value here.\n");
     callbackDestroyCustomData->setCacheInvalidation(OFX::eCacheInvalidateValueAll);
     callbackDestroyCustomData->setIsPersistant(false);
     callbackDestroyCustomData->setAnimates(false);
     callbackDestroyCustomData->setDefault("");
+
+    OFX::StringParamDescriptor* callbackRetainImage = desc.defineStringParam(kParamInputCallbackRetainImage);
+    callbackRetainImage->setLabel("Callback Retain Image");
+    callbackRetainImage->setHint("This parameter represents a pointer to a function of type "
+                                 "\"void*(*)(void* inputCustomData, void(**outRelease)(void* image))\".\n"
+                                 "It keeps the image returned by the last call of the callback, "
+                                 "until the returned image is given to outRelease. It's needed for the zero copy.\n"
+                                 "WARNING:\n"
+                                 " - Your application could crash if you set an invalid value here.\n");
+    callbackRetainImage->setCacheInvalidation(OFX::eCacheInvalidateValueAll);
+    callbackRetainImage->setIsPersistant(false);
+    callbackRetainImage->setAnimates(false);
+    callbackRetainImage->setDefault("");
+
+    OFX::BooleanParamDescriptor* zeroCopy = desc.defineBooleanParam(kParamZeroCopy);
+    zeroCopy->setLabel("Zero Copy");
+    zeroCopy->setHint("Use the image buffer as the output image, without copy (if the host supports it).\n"
+                      "In buffer pointer mode, the buffer needs to stay valid as long as the output image is used.\n"
+                      "In callback mode, the image of the callback is retained with the output image "
+                      "(it needs the retain image callback).");
+    zeroCopy->setCacheInvalidation(OFX::eCacheInvalidateValueAll);
+    zeroCopy->setAnimates(false);
+    zeroCopy->setDefault(false);
 }
 
 /**
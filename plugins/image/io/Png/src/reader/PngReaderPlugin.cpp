@@ -5,6 +5,7 @@
 #include "PngEngine/png_adds.hpp"
 
 #include <tuttle/ioplugin/context/ReaderPlugin.hpp>
+#include <tuttle/ioplugin/context/ReadAhead.hpp>
 
 #include <boost/gil/gil_all.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -127,7 +128,7 @@ void PngReaderPlugin::getClipPreferences(OFX::ClipPreferencesSetter& clipPrefere
 void PngReaderPlugin::render(const OFX::RenderArguments& args)
 {
     ReaderPlugin::render(args);
-    doGilRender<PngReaderProcess>(*this, args);
+    doGilRender<ReadAhead<PngReaderProcess>::Process>(*this, args);
 }
 }
 }
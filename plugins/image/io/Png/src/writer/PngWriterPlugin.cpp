@@ -1,6 +1,8 @@
 #include "PngWriterPlugin.hpp"
 #include "PngWriterProcess.hpp"
 
+#include <tuttle/ioplugin/context/WriteBehind.hpp>
+
 #include <boost/gil/gil_all.hpp>
 
 namespace tuttle
@@ -39,7 +41,7 @@ void PngWriterPlugin::render(const OFX::RenderArguments& args)
 {
     WriterPlugin::render(args);
 
-    doGilRender<PngWriterProcess>(*this, args);
+    doGilRender<WriteBehind<PngWriterProcess>::Process>(*this, args);
 }
 }
 }
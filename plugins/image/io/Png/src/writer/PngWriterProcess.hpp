@@ -30,6 +30,7 @@ protected:
     PngWriterPlugin& _plugin; ///< Rendering plugin
 
     PngWriterProcessParams _params;
+    OFX::EPixelComponent _srcComponents; ///< retrieved at setup, the image may be written in another thread
 
 public:
     PngWriterProcess(PngWriterPlugin& instance);
@@ -33,6 +33,7 @@ void PngWriterProcess<View>::setup(const OFX::RenderArguments& args)
     ImageGilFilterProcessor<View>::setup(args);
 
     _params = _plugin.getProcessParams(args.time);
+    _srcComponents = _plugin._clipSrc->getPixelComponents();
 }
 
 /**
@@ -87,7 +88,7 @@ void PngWriterProcess<View>::writeImage(View& src)
     {
         case eTuttlePluginComponentsAuto:
         {
-            switch(_plugin._clipSrc->getPixelComponents())
+            switch(_srcComponents)
             {
                 case OFX::ePixelComponentAlpha:
                 {
@@ -1,14 +1,136 @@
 #ifndef _TUTTLE_PLUGIN_CTL_ALGORITHM_HPP_
 #define _TUTTLE_PLUGIN_CTL_ALGORITHM_HPP_
 
+#include "CTLDefinitions.hpp"
+
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
 #include <terry/channel.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace tuttle
 {
 namespace plugin
 {
 namespace ctl
 {
+
+/**
+ * @brief Maps the input range of the LUT to [0, 1], linearly or in log2 to keep the precision of the low values of HDR
+ * images. The values outside of the range are clamped.
+ */
+class LutShaper
+{
+public:
+    LutShaper(const EParamLutShaper type, const float min, const float max)
+        : _type(type)
+        , _min(min)
+        , _max(max)
+        , _offset(type == eParamLutShaperLog2 ? std::log(min) : min)
+        , _scale(1.0f / ((type == eParamLutShaperLog2 ? std::log(max) : max) - _offset))
+    {
+    }
+
+    float operator()(const float v) const
+    {
+        const float c = std::min(std::max(v, _min), _max);
+        const float t = ((_type == eParamLutShaperLog2 ? std::log(c) : c) - _offset) * _scale;
+        return std::min(std::max(t, 0.0f), 1.0f);
+    }
+
+    float inverse(const float t) const
+    {
+        const float v = t / _scale + _offset;
+        return _type == eParamLutShaperLog2 ? std::exp(v) : v;
+    }
+
+private:
+    EParamLutShaper _type;
+    float _min;
+    float _max;
+    float _offset; ///< shaped value of min
+    float _scale;  ///< 1 / (shaped value of max - shaped value of min)
+};
+
+/**
+ * @brief 3D LUT of the rgb values of a CTL transform, sampled on a regular grid of the shaper space.
+ */
+class Lut3D
+{
+public:
+    typedef std::vector<float, OfxAllocator<float> > Data;
+
+public:
+    Lut3D(const int size, const LutShaper& shaper, const std::size_t hash)
+        : _size(size)
+        , _shaper(shaper)
+        , _hash(hash)
+        , _data(3 * size * size * size)
+    {
+    }
+
+    int getSize() const { return _size; }
+    const LutShaper& getShaper() const { return _shaper; }
+
+    /// @brief Identifier of the transform and of the sampling
+    std::size_t getHash() const { return _hash; }
+
+    /// @brief rgb values of the nodes, the node (r, g, b) at ((b * size + g) * size + r) * 3
+    float* data() { return &_data[0]; }
+
+    /// @brief Input value of the node @p i, on each axis
+    float nodeValue(const int i) const { return _shaper.inverse(float(i) / (_size - 1)); }
+
+    /// @brief Trilinear interpolation of the transform of (r, g, b)
+    void apply(float& r, float& g, float& b) const
+    {
+        const int last = _size - 1;
+        const float sr = _shaper(r) * last;
+        const float sg = _shaper(g) * last;
+        const float sb = _shaper(b) * last;
+        const int ir = std::min(int(sr), last - 1);
+        const int ig = std::min(int(sg), last - 1);
+        const int ib = std::min(int(sb), last - 1);
+        const float fr = sr - ir;
+        const float fg = sg - ig;
+        const float fb = sb - ib;
+
+        const std::size_t dr = 3;
+        const std::size_t dg = 3 * _size;
+        const std::size_t db = 3 * _size * _size;
+        const float* n000 = &_data[ib * db + ig * dg + ir * dr];
+        const float* n100 = n000 + dr;
+        const float* n010 = n000 + dg;
+        const float* n110 = n010 + dr;
+        const float* n001 = n000 + db;
+        const float* n101 = n001 + dr;
+        const float* n011 = n001 + dg;
+        const float* n111 = n011 + dr;
+
+        float out[3];
+        for(int c = 0; c < 3; ++c)
+        {
+            const float v00 = n000[c] + (n100[c] - n000[c]) * fr;
+            const float v10 = n010[c] + (n110[c] - n010[c]) * fr;
+            const float v01 = n001[c] + (n101[c] - n001[c]) * fr;
+            const float v11 = n011[c] + (n111[c] - n011[c]) * fr;
+            const float v0 = v00 + (v10 - v00) * fg;
+            const float v1 = v01 + (v11 - v01) * fg;
+            out[c] = v0 + (v1 - v0) * fb;
+        }
+        r = out[0];
+        g = out[1];
+        b = out[2];
+    }
+
+private:
+    int _size; ///< number of nodes on each axis
+    LutShaper _shaper;
+    std::size_t _hash;
+    Data _data;
+};
 }
 }
 }
@@ -24,6 +24,35 @@ enum EParamChooseInput
 };
 
 static const std::string kParamCTLCode("code");
+
+static const std::string kParamMode("mode");
+static const std::string kParamModeInterpreter("interpreter");
+static const std::string kParamModeLut("lut");
+
+enum EParamMode
+{
+    eParamModeInterpreter = 0,
+    eParamModeLut,
+};
+
+static const std::string kParamLutSize("lutSize");
+
+static const std::string kParamLutShaper("lutShaper");
+static const std::string kParamLutShaperLinear("linear");
+static const std::string kParamLutShaperLog2("log2");
+
+enum EParamLutShaper
+{
+    eParamLutShaperLinear = 0,
+    eParamLutShaperLog2,
+};
+
+static const std::string kParamLutRangeMin("lutRangeMin");
+static const std::string kParamLutRangeMax("lutRangeMax");
+
+/// Default LUT range: 6.5 stops below and above the middle gray (0.18)
+static const double kLutMiddleGray = 0.18;
+static const double kLutDefaultStops = 6.5;
 }
 }
 }
@@ -5,8 +5,11 @@
 #include <boost/gil/gil_all.hpp>
 #include <boost/algorithm/string/split.hpp>
 
+#include <CtlSimdInterpreter.h>
+
 #include <fstream>
 #include <boost/filesystem/path.hpp>
+#include <boost/filesystem/operations.hpp>
 
 namespace tuttle
 {
@@ -22,8 +25,14 @@ CTLPlugin::CTLPlugin(OfxImageEffectHandle handle)
     _paramCode = fetchStringParam(kParamCTLCode);
     _paramFile = fetchStringParam(kTuttlePluginFilename);
     _paramUpdateRender = fetchPushButtonParam(kParamChooseInputCodeUpdate);
+    _paramMode = fetchChoiceParam(kParamMode);
+    _paramLutSize = fetchIntParam(kParamLutSize);
+    _paramLutShaper = fetchChoiceParam(kParamLutShaper);
+    _paramLutRangeMin = fetchDoubleParam(kParamLutRangeMin);
+    _paramLutRangeMax = fetchDoubleParam(kParamLutRangeMax);
 
     changedParam(_instanceChangedArgs, kParamChooseInput);
+    changedParam(_instanceChangedArgs, kParamMode);
 }
 
 CTLProcessParams<CTLPlugin::Scalar> CTLPlugin::getProcessParams(const OfxPointD& renderScale) const
@@ -31,6 +40,7 @@ CTLProcessParams<CTLPlugin::Scalar> CTLPlugin::getProcessParams(const OfxPointD&
     using namespace boost::filesystem;
     CTLProcessParams<Scalar> params;
     params._inputType = static_cast<EParamChooseInput>(_paramInput->getValue());
+    params._fileTime = 0;
     switch(params._inputType)
     {
         case eParamChooseInputCode:
@@ -48,9 +58,17 @@ CTLProcessParams<CTLPlugin::Scalar> CTLPlugin::getProcessParams(const OfxPointD&
             params._filename = _paramFile->getValue();
             params._module = filename.stem().string();
             params._paths.push_back(filename.parent_path().string());
+            if(exists(filename))
+                params._fileTime = last_write_time(filename);
             break;
         }
     }
+
+    params._mode = static_cast<EParamMode>(_paramMode->getValue());
+    params._lutSize = _paramLutSize->getValue();
+    params._lutShaper = static_cast<EParamLutShaper>(_paramLutShaper->getValue());
+    params._lutRangeMin = _paramLutRangeMin->getValue();
+    params._lutRangeMax = _paramLutRangeMax->getValue();
     return params;
 }
 
@@ -77,6 +95,14 @@ void CTLPlugin::changedParam(const OFX::InstanceChangedArgs& args, const std::st
             }
         }
     }
+    else if(paramName == kParamMode)
+    {
+        const bool lut = _paramMode->getValue() == eParamModeLut;
+        _paramLutSize->setIsSecretAndDisabled(!lut);
+        _paramLutShaper->setIsSecretAndDisabled(!lut);
+        _paramLutRangeMin->setIsSecretAndDisabled(!lut);
+        _paramLutRangeMax->setIsSecretAndDisabled(!lut);
+    }
     else if(paramName == kParamCTLCode)
     {
         _paramInput->setValue(eParamChooseInputCode);
@@ -140,6 +166,78 @@ void CTLPlugin::render(const OFX::RenderArguments& args)
     }
     BOOST_THROW_EXCEPTION(exception::Unknown());
 }
+
+boost::shared_ptr<Ctl::SimdInterpreter> CTLPlugin::getInterpreter(const CTLProcessParams<Scalar>& params)
+{
+    // the interpreters of the code and of the file, when switching between them
+    static const std::size_t kMaxNbInterpreters = 2;
+
+    const std::size_t hash = interpreterHash(params);
+    boost::mutex::scoped_lock lock(_interpretersMutex);
+    for(std::list<HashedInterpreter>::iterator it = _interpreters.begin(), itEnd = _interpreters.end(); it != itEnd; ++it)
+    {
+        if(it->first == hash)
+        {
+            _interpreters.splice(_interpreters.begin(), _interpreters, it);
+            return _interpreters.front().second;
+        }
+    }
+
+    // the module is loaded while locked, so concurrent renders don't load it twice
+    boost::shared_ptr<Ctl::SimdInterpreter> interpreter(new Ctl::SimdInterpreter());
+    switch(params._inputType)
+    {
+        case eParamChooseInputCode:
+        {
+            TUTTLE_LOG_TRACE("CTL -- Load code: " << params._code);
+            interpreter->loadModule("", "", params._code);
+            break;
+        }
+        case eParamChooseInputFile:
+        {
+            interpreter->setModulePaths(params._paths);
+            TUTTLE_LOG_TRACE("CTL -- Load module: " << params._filename << " " << params._module);
+            interpreter->loadFile(params._filename, params._module);
+            break;
+        }
+    }
+    _interpreters.push_front(HashedInterpreter(hash, interpreter));
+    if(_interpreters.size() > kMaxNbInterpreters)
+        _interpreters.pop_back();
+    return interpreter;
+}
+
+boost::shared_ptr<const Lut3D> CTLPlugin::findLut(const std::size_t hash)
+{
+    boost::mutex::scoped_lock lock(_lutsMutex);
+    for(std::list<boost::shared_ptr<const Lut3D> >::iterator it = _luts.begin(), itEnd = _luts.end(); it != itEnd; ++it)
+    {
+        if((*it)->getHash() == hash)
+        {
+            _luts.splice(_luts.begin(), _luts, it);
+            return _luts.front();
+        }
+    }
+    return boost::shared_ptr<const Lut3D>();
+}
+
+void CTLPlugin::addLut(const boost::shared_ptr<const Lut3D>& lut)
+{
+    // a 65^3 LUT takes 3.3MB
+    static const std::size_t kMaxNbLuts = 2;
+
+    boost::mutex::scoped_lock lock(_lutsMutex);
+    for(std::list<boost::shared_ptr<const Lut3D> >::iterator it = _luts.begin(); it != _luts.end();)
+    {
+        if((*it)->getHash() == lut->getHash())
+            it = _luts.erase(it); // also baked by a concurrent render
+        else
+            ++it;
+    }
+    _luts.push_front(lut);
+    if(_luts.size() > kMaxNbLuts)
+        _luts.pop_back();
+}
 }
 }
 }
@@ -2,9 +2,22 @@
 #define _TUTTLE_PLUGIN_CTL_PLUGIN_HPP_
 
 #include "CTLDefinitions.hpp"
+#include "CTLAlgorithm.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
+#include <boost/functional/hash.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <ctime>
+#include <list>
+
+namespace Ctl
+{
+class SimdInterpreter;
+}
+
 namespace tuttle
 {
 namespace plugin
@@ -20,8 +33,45 @@ struct CTLProcessParams
     std::string _filename;
     std::string _module;
     std::string _code;
+    std::time_t _fileTime; ///< last modification of the file
+
+    EParamMode _mode;
+    int _lutSize;
+    EParamLutShaper _lutShaper;
+    Scalar _lutRangeMin;
+    Scalar _lutRangeMax;
 };
 
+/**
+ * @brief Hash of the CTL module, to identify its loaded interpreter.
+ */
+template <typename Scalar>
+std::size_t interpreterHash(const CTLProcessParams<Scalar>& p)
+{
+    std::size_t seed = 0;
+    boost::hash_combine(seed, static_cast<int>(p._inputType));
+    boost::hash_combine(seed, p._paths);
+    boost::hash_combine(seed, p._filename);
+    boost::hash_combine(seed, p._module);
+    boost::hash_combine(seed, p._code);
+    boost::hash_combine(seed, static_cast<long>(p._fileTime));
+    return seed;
+}
+
+/**
+ * @brief Hash of the CTL module and of the sampling, to identify its baked LUT.
+ */
+template <typename Scalar>
+std::size_t lutHash(const CTLProcessParams<Scalar>& p)
+{
+    std::size_t seed = interpreterHash(p);
+    boost::hash_combine(seed, p._lutSize);
+    boost::hash_combine(seed, static_cast<int>(p._lutShaper));
+    boost::hash_combine(seed, p._lutRangeMin);
+    boost::hash_combine(seed, p._lutRangeMax);
+    return seed;
+}
+
 /**
  * @brief CTL plugin
  */
@@ -43,14 +93,36 @@ public:
 
     void render(const OFX::RenderArguments& args);
 
+    /**
+     * @brief Interpreter with the module of @p params loaded, shared by the renders while the module doesn't change.
+     * @warning the interpreter is used by several threads, it is only used to create function calls
+     */
+    boost::shared_ptr<Ctl::SimdInterpreter> getInterpreter(const CTLProcessParams<Scalar>& params);
+
+    /// @brief LUT baked by a previous render (or a null pointer)
+    boost::shared_ptr<const Lut3D> findLut(const std::size_t hash);
+    void addLut(const boost::shared_ptr<const Lut3D>& lut);
+
 public:
     OFX::ChoiceParam* _paramInput;
     OFX::StringParam* _paramCode;
     OFX::StringParam* _paramFile;
     OFX::PushButtonParam* _paramUpdateRender;
+    OFX::ChoiceParam* _paramMode;
+    OFX::IntParam* _paramLutSize;
+    OFX::ChoiceParam* _paramLutShaper;
+    OFX::DoubleParam* _paramLutRangeMin;
+    OFX::DoubleParam* _paramLutRangeMax;
 
 private:
     OFX::InstanceChangedArgs _instanceChangedArgs;
+
+    typedef std::pair<std::size_t, boost::shared_ptr<Ctl::SimdInterpreter> > HashedInterpreter;
+    boost::mutex _interpretersMutex;
+    std::list<HashedInterpreter> _interpreters; ///< most recently used first
+
+    boost::mutex _lutsMutex;
+    std::list<boost::shared_ptr<const Lut3D> > _luts; ///< most recently used first
 };
 }
 }
@@ -4,6 +4,7 @@
 
 #include "ofxsImageEffect.h"
 
+#include <cmath>
 #include <limits>
 
 namespace tuttle
@@ -112,6 +113,43 @@ void CTLPluginFactory::describeInContext(OFX::ImageEffectDescriptor& desc, OFX::
     file->setLabel(kTuttlePluginFilenameLabel);
     file->setHint("CTL source code file.");
     file->setStringType(OFX::eStringTypeFilePath);
+
+    OFX::ChoiceParamDescriptor* mode = desc.defineChoiceParam(kParamMode);
+    mode->setLabel("Mode");
+    mode->appendOption(kParamModeInterpreter);
+    mode->appendOption(kParamModeLut);
+    mode->setDefault(eParamModeInterpreter);
+    mode->setHint("interpreter: the CTL program is run on each pixel.\n"
+                  "lut: the CTL program is sampled once into a 3D LUT, which is applied on the pixels. It's a lot faster "
+                  "with long transforms, but the values are clamped to the LUT range and the alpha is not transformed.");
+
+    OFX::IntParamDescriptor* lutSize = desc.defineIntParam(kParamLutSize);
+    lutSize->setLabel("LUT size");
+    lutSize->setHint("Number of nodes of the LUT on each axis.");
+    lutSize->setRange(2, 257);
+    lutSize->setDisplayRange(17, 129);
+    lutSize->setDefault(65);
+
+    OFX::ChoiceParamDescriptor* lutShaper = desc.defineChoiceParam(kParamLutShaper);
+    lutShaper->setLabel("LUT shaper");
+    lutShaper->appendOption(kParamLutShaperLinear);
+    lutShaper->appendOption(kParamLutShaperLog2);
+    lutShaper->setDefault(eParamLutShaperLog2);
+    lutShaper->setHint("Distribution of the LUT nodes in the LUT range.\n"
+                       "linear: for display referred values.\n"
+                       "log2: for scene referred (HDR) values, the same number of nodes in each stop.");
+
+    OFX::DoubleParamDescriptor* lutRangeMin = desc.defineDoubleParam(kParamLutRangeMin);
+    lutRangeMin->setLabel("LUT range min");
+    lutRangeMin->setHint("Lowest input value of the LUT (it needs to be positive with a log2 shaper).");
+    lutRangeMin->setDisplayRange(0.0, 1.0);
+    lutRangeMin->setDefault(kLutMiddleGray * std::pow(2.0, -kLutDefaultStops));
+
+    OFX::DoubleParamDescriptor* lutRangeMax = desc.defineDoubleParam(kParamLutRangeMax);
+    lutRangeMax->setLabel("LUT range max");
+    lutRangeMax->setHint("Highest input value of the LUT.");
+    lutRangeMax->setDisplayRange(0.0, 64.0);
+    lutRangeMax->setDefault(kLutMiddleGray * std::pow(2.0, kLutDefaultStops));
 }
 
 /**
@@ -1,10 +1,14 @@
 #ifndef _TUTTLE_PLUGIN_CTL_PROCESS_HPP_
 #define _TUTTLE_PLUGIN_CTL_PROCESS_HPP_
 
+#include "CTLAlgorithm.hpp"
+
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 
 #include <CtlSimdInterpreter.h>
 
+#include <boost/shared_ptr.hpp>
+
 namespace tuttle
 {
 namespace plugin
@@ -28,7 +32,8 @@ protected:
     CTLPlugin& _plugin;               ///< Rendering plugin
     CTLProcessParams<Scalar> _params; ///< parameters
 
-    Ctl::SimdInterpreter _interpreter;
+    boost::shared_ptr<Ctl::SimdInterpreter> _interpreter; ///< in interpreter mode, shared with the other renders
+    boost::shared_ptr<const Lut3D> _lut;                  ///< in LUT mode, shared with the other renders
 
 public:
     CTLProcess(CTLPlugin& effect);
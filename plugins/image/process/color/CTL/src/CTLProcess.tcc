@@ -2,10 +2,15 @@
 #include "CTLProcess.hpp"
 #include "CTLPlugin.hpp"
 
+#include <ofxsMultiThread.h>
+
 #include <half.h>
 #include <Iex.h>
 #include <CtlMessage.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace tuttle
 {
 namespace plugin
@@ -106,6 +111,56 @@ void callCtl(Ctl::Interpreter& interp, Ctl::FunctionCallPtr call, const std::siz
         a += m;
     }
 }
+
+/**
+ * @brief Samples the CTL transform on the nodes of a LUT, each thread computes some blue planes.
+ */
+class LutBaker : public OFX::MultiThread::Processor
+{
+public:
+    LutBaker(Ctl::Interpreter& interpreter, Lut3D& lut)
+        : _interpreter(interpreter)
+        , _lut(lut)
+    {
+    }
+
+    void multiThreadFunction(const unsigned int threadId, const unsigned int nThreads)
+    {
+        const int size = _lut.getSize();
+        const std::size_t planeSize = size * size;
+        Ctl::FunctionCallPtr call = _interpreter.newFunctionCall("main");
+
+        std::vector<float> r(planeSize), g(planeSize), b(planeSize), a(planeSize, 1.0f);
+        std::vector<float> rOut(planeSize), gOut(planeSize), bOut(planeSize), aOut(planeSize);
+        for(int ig = 0; ig < size; ++ig)
+        {
+            for(int ir = 0; ir < size; ++ir)
+            {
+                r[ig * size + ir] = _lut.nodeValue(ir);
+                g[ig * size + ir] = _lut.nodeValue(ig);
+            }
+        }
+
+        for(int ib = threadId; ib < size; ib += nThreads)
+        {
+            std::fill(b.begin(), b.end(), _lut.nodeValue(ib));
+            callCtl<float>(_interpreter, call, planeSize, &rOut[0], &gOut[0], &bOut[0], &aOut[0], &r[0], &g[0], &b[0],
+                           &a[0]);
+
+            float* node = _lut.data() + 3 * planeSize * ib;
+            for(std::size_t i = 0; i < planeSize; ++i, node += 3)
+            {
+                node[0] = rOut[i];
+                node[1] = gOut[i];
+                node[2] = bOut[i];
+            }
+        }
+    }
+
+private:
+    Ctl::Interpreter& _interpreter;
+    Lut3D& _lut;
+};
 }
 
 template <class View>
@@ -122,24 +177,39 @@ void CTLProcess<View>::setup(const OFX::RenderArguments& args)
     ctlPlugin = &_plugin;
     ImageGilFilterProcessor<View>::setup(args);
     _params = _plugin.getProcessParams(args.renderScale);
+    Ctl::setMessageOutputFunction(ctlMessageOutput);
 
-    switch(_params._inputType)
+    switch(_params._mode)
     {
-        case eParamChooseInputCode:
+        case eParamModeInterpreter:
         {
-            TUTTLE_LOG_TRACE("CTL -- Load code: " << _params._code);
-            _interpreter.loadModule("", "", _params._code);
+            _interpreter = _plugin.getInterpreter(_params);
             break;
         }
-        case eParamChooseInputFile:
+        case eParamModeLut:
         {
-            _interpreter.setModulePaths(_params._paths);
-            TUTTLE_LOG_TRACE("CTL -- Load module: " << _params._filename << " " << _params._module);
-            _interpreter.loadFile(_params._filename, _params._module);
+            const std::size_t hash = lutHash(_params);
+            _lut = _plugin.findLut(hash);
+            if(_lut)
+                break;
+
+            if(_params._lutRangeMin >= _params._lutRangeMax ||
+               (_params._lutShaper == eParamLutShaperLog2 && _params._lutRangeMin <= 0))
+            {
+                BOOST_THROW_EXCEPTION(exception::Value()
+                                      << exception::user() + "Invalid LUT range [" + _params._lutRangeMin + ", " +
+                                             _params._lutRangeMax + "] (it needs to be positive with a log2 shaper).");
+            }
+            TUTTLE_LOG_TRACE("CTL -- Bake a LUT of size " << _params._lutSize);
+            boost::shared_ptr<Lut3D> lut(
+                new Lut3D(_params._lutSize, LutShaper(_params._lutShaper, _params._lutRangeMin, _params._lutRangeMax), hash));
+            LutBaker baker(*_plugin.getInterpreter(_params), *lut);
+            baker.multiThread();
+            _plugin.addLut(lut);
+            _lut = lut;
             break;
         }
     }
-    Ctl::setMessageOutputFunction(ctlMessageOutput);
 }
 
 /**
@@ -151,7 +221,9 @@ void CTLProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 {
     using namespace boost::gil;
 
-    Ctl::FunctionCallPtr call = _interpreter.newFunctionCall("main");
+    Ctl::FunctionCallPtr call;
+    if(_interpreter)
+        call = _interpreter->newFunctionCall("main");
 
     const OfxPointI procWindowSize = {procWindowRoW.x2 - procWindowRoW.x1, procWindowRoW.y2 - procWindowRoW.y1};
 
@@ -177,7 +249,22 @@ void CTLProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
         const float* b = reinterpret_cast<float*>(&srcWorkLineV(0, 0)[2]);
         const float* a = reinterpret_cast<float*>(&srcWorkLineV(0, 0)[3]);
 
-        callCtl<float>(_interpreter, call, procWindowSize.x, rOut, gOut, bOut, aOut, r, g, b, a);
+        if(_lut)
+        {
+            // the alpha is not transformed
+            for(int x = 0; x < procWindowSize.x; ++x)
+            {
+                rOut[x] = r[x];
+                gOut[x] = g[x];
+                bOut[x] = b[x];
+                _lut->apply(rOut[x], gOut[x], bOut[x]);
+                aOut[x] = a[x];
+            }
+        }
+        else
+        {
+            callCtl<float>(*_interpreter, call, procWindowSize.x, rOut, gOut, bOut, aOut, r, g, b, a);
+        }
 
         copy_pixels(dstWorkLineV, dstLineV);
 
@@ -41,7 +41,7 @@ void LutPlugin::render(const OFX::RenderArguments& args)
         {
             BOOST_THROW_EXCEPTION(exception::File() << exception::user("Unable to read lut file."));
         }
-        _lut3D.reset(new TetraInterpolator(), _lutReader);
+        resetLut();
     }
     if(!_lutReader.readOk())
     {
@@ -50,6 +50,12 @@ void LutPlugin::render(const OFX::RenderArguments& args)
     doGilRender<LutProcess>(*this, args);
 }
 
+void LutPlugin::resetLut()
+{
+    _lut3D.reset(new TetraInterpolator(), _lutReader);
+    _bakedLut3D.bake(_lut3D, BakedLut3D::eInterpolationTetrahedral);
+}
+
 void LutPlugin::changedParam(const OFX::InstanceChangedArgs& args, const std::string& paramName)
 {
     if(paramName == kTuttlePluginFilename)
@@ -62,7 +68,7 @@ void LutPlugin::changedParam(const OFX::InstanceChangedArgs& args, const std::st
             {
                 BOOST_THROW_EXCEPTION(exception::File() << exception::user("Unable to read lut file..."));
             }
-            _lut3D.reset(new TetraInterpolator(), _lutReader);
+            resetLut();
         }
     }
 }
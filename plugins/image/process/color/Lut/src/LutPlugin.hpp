@@ -3,6 +3,7 @@
 
 #include "lutEngine/LutReader.hpp"
 #include "lutEngine/Lut.hpp"
+#include "lutEngine/BakedLut3D.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
@@ -26,11 +27,16 @@ public:
     void render(const OFX::RenderArguments& args);
     void changedParam(const OFX::InstanceChangedArgs& args, const std::string& paramName);
 
+private:
+    /// @brief Reset the interpolated LUT from the LUT file read and bake it for the render.
+    void resetLut();
+
 public:
     OFX::StringParam* _sFilename; ///< Filename
 
     LutReader _lutReader; ///< Reader
     Lut3D _lut3D;
+    BakedLut3D _bakedLut3D; ///< lattice of _lut3D used to process rows of interleaved pixels
 };
 }
 }
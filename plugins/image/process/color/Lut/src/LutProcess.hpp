@@ -13,6 +13,8 @@
 #include <ofxsMultiThread.h>
 
 #include <boost/gil/gil_all.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/cstdint.hpp>
 
 namespace tuttle
 {
@@ -21,6 +23,28 @@ namespace plugin
 namespace lut
 {
 
+/// @brief Channel type of the BakedLut3D rows (void if the channel is not supported).
+template <typename Channel>
+struct BakedLutChannel
+{
+    typedef void type;
+};
+template <>
+struct BakedLutChannel<boost::gil::bits8>
+{
+    typedef boost::uint8_t type;
+};
+template <>
+struct BakedLutChannel<boost::gil::bits16>
+{
+    typedef boost::uint16_t type;
+};
+template <>
+struct BakedLutChannel<boost::gil::bits32f>
+{
+    typedef float type;
+};
+
 /**
  * @brief Lut process
  */
@@ -28,8 +52,9 @@ template <class View>
 class LutProcess : public ImageGilFilterProcessor<View>
 {
 private:
-    Lut3D* _lut3D;      ///< Lut3D
-    LutPlugin& _plugin; ///< Rendering plugin
+    Lut3D* _lut3D;                  ///< Lut3D
+    const BakedLut3D* _bakedLut3D; ///< Lut3D baked lattice
+    LutPlugin& _plugin;             ///< Rendering plugin
 
 public:
     LutProcess<View>(LutPlugin& instance);
@@ -38,6 +63,14 @@ public:
 
     // Lut3D Transform
     void applyLut(View& dst, View& src, const OfxRectI& procWindow);
+
+private:
+    /// @brief Apply the baked lattice on each row (interleaved RGB/RGBA views of 8, 16 bits or float channels).
+    template <typename Channel>
+    void applyLut(View& dst, View& src, const OfxRectI& procWindow, const boost::mpl::true_, const Channel*);
+    /// @brief Interpolate each pixel with the Lut3D.
+    template <typename Channel>
+    void applyLut(View& dst, View& src, const OfxRectI& procWindow, const boost::mpl::false_, const Channel*);
 };
 }
 }
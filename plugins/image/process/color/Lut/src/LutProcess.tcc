@@ -18,6 +18,7 @@
 
 #include <boost/gil/gil_all.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 namespace tuttle
 {
@@ -34,6 +35,7 @@ LutProcess<View>::LutProcess(LutPlugin& instance)
     , _plugin(instance)
 {
     _lut3D = &_plugin._lut3D;
+    _bakedLut3D = &_plugin._bakedLut3D;
 }
 
 /**
@@ -50,6 +52,52 @@ void LutProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 
 template <class View>
 void LutProcess<View>::applyLut(View& dst, View& src, const OfxRectI& procWindow)
+{
+    using namespace boost::gil;
+    typedef typename channel_type<View>::type Channel;
+    typedef typename color_space_type<View>::type ColorSpace;
+    typedef typename BakedLutChannel<Channel>::type BakedChannel;
+    typedef boost::mpl::bool_<!boost::is_same<BakedChannel, void>::value && !is_planar<View>::value &&
+                              (boost::is_same<ColorSpace, rgba_t>::value || boost::is_same<ColorSpace, rgb_t>::value)>
+        Baked;
+
+    if(Baked::value && _bakedLut3D->empty())
+    {
+        applyLut(dst, src, procWindow, boost::mpl::false_(), static_cast<const BakedChannel*>(NULL));
+        return;
+    }
+    applyLut(dst, src, procWindow, Baked(), static_cast<const BakedChannel*>(NULL));
+}
+
+template <class View>
+template <typename Channel>
+void LutProcess<View>::applyLut(View& dst, View& src, const OfxRectI& procWindow, const boost::mpl::true_,
+                                const Channel*)
+{
+    using namespace terry;
+    typedef typename channel_type<View>::type ChannelValue;
+    const std::size_t nbChannels = num_channels<View>::value;
+    const OfxPointI procWindowSize = {procWindow.x2 - procWindow.x1, procWindow.y2 - procWindow.y1};
+
+    for(int y = procWindow.y1; y < procWindow.y2; ++y)
+    {
+        const Channel* srcRow = reinterpret_cast<const Channel*>(&(*(src.row_begin(y) + procWindow.x1)));
+        Channel* dstRow = reinterpret_cast<Channel*>(&(*(dst.row_begin(y) + procWindow.x1)));
+        _bakedLut3D->applyRow(srcRow, dstRow, procWindowSize.x, nbChannels, nbChannels);
+        if(nbChannels > 3)
+        {
+            for(int x = 0; x < procWindowSize.x; ++x)
+                dstRow[x * nbChannels + 3] = channel_traits<ChannelValue>::max_value();
+        }
+        if(this->progressForward(procWindowSize.x))
+            return;
+    }
+}
+
+template <class View>
+template <typename Channel>
+void LutProcess<View>::applyLut(View& dst, View& src, const OfxRectI& procWindow, const boost::mpl::false_,
+                                const Channel*)
 {
     using namespace terry;
     typedef typename View::x_iterator vIterator;
@@ -58,14 +106,17 @@ void LutProcess<View>::applyLut(View& dst, View& src, const OfxRectI& procWindow
 
     for(int y = procWindow.y1; y < procWindow.y2; ++y)
     {
-        vIterator sit = src.row_begin(y);
-        vIterator dit = dst.row_begin(y);
+        vIterator sit = src.row_begin(y) + procWindow.x1;
+        vIterator dit = dst.row_begin(y) + procWindow.x1;
         for(int x = procWindow.x1; x < procWindow.x2; ++x)
         {
-            tuttle::Color col = _lut3D->getColor((*sit)[0], (*sit)[1], (*sit)[2]);
-            (*dit)[0] = static_cast<Pixel>(col.x);
-            (*dit)[1] = static_cast<Pixel>(col.y);
-            (*dit)[2] = static_cast<Pixel>(col.z);
+            // the Lut3D works on normalized values
+            const tuttle::Color col =
+                _lut3D->getColor(channel_convert<bits32f>((*sit)[0]), channel_convert<bits32f>((*sit)[1]),
+                                 channel_convert<bits32f>((*sit)[2]));
+            (*dit)[0] = channel_convert<Pixel>(bits32f(col.x));
+            (*dit)[1] = channel_convert<Pixel>(bits32f(col.y));
+            (*dit)[2] = channel_convert<Pixel>(bits32f(col.z));
             if(dst.num_channels() > 3)
                 (*dit)[3] = channel_traits<typename channel_type<View>::type>::max_value();
             ++sit;
@@ -0,0 +1,341 @@
+#include "BakedLut3D.hpp"
+#include "Color.hpp"
+
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define TUTTLE_LUTENGINE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace tuttle
+{
+
+namespace
+{
+
+/// @brief Position of an input value on an axis of the lattice.
+struct AxisCoord
+{
+    std::size_t _offset; ///< offset of the lower node, in floats
+    float _fraction;     ///< position between the lower and the upper node
+};
+
+inline AxisCoord floatCoord(const float value, const std::size_t maxIndex, const std::size_t stride)
+{
+    // clamp to [0, 1], NaN goes to 0
+    const float v = value > 0.f ? (value < 1.f ? value : 1.f) : 0.f;
+    const float t = v * maxIndex;
+    std::size_t index = static_cast<std::size_t>(t);
+    if(index >= maxIndex)
+        index = maxIndex - 1;
+
+    AxisCoord coord;
+    coord._offset = index * stride;
+    coord._fraction = t - index;
+    return coord;
+}
+
+/// @brief Precomputed coordinates of the 256 values.
+struct Coords8
+{
+    const boost::uint32_t* _index;
+    const float* _fraction;
+
+    AxisCoord operator()(const boost::uint8_t value, const std::size_t stride) const
+    {
+        AxisCoord coord;
+        coord._offset = _index[value] * stride;
+        coord._fraction = _fraction[value];
+        return coord;
+    }
+};
+
+/// @brief Coordinates of the 16 bits values in integer arithmetic.
+struct Coords16
+{
+    boost::uint32_t _maxIndex;
+
+    AxisCoord operator()(const boost::uint16_t value, const std::size_t stride) const
+    {
+        static const boost::uint32_t maxValue = 65535;
+        const boost::uint32_t t = value * _maxIndex;
+        boost::uint32_t index = t / maxValue;
+        if(index >= _maxIndex)
+            index = _maxIndex - 1;
+
+        AxisCoord coord;
+        coord._offset = index * stride;
+        coord._fraction = (t - index * maxValue) * (1.f / maxValue);
+        return coord;
+    }
+};
+
+#ifdef TUTTLE_LUTENGINE_SSE
+typedef __m128 Node;
+
+inline Node loadNode(const float* p) { return _mm_loadu_ps(p); }
+inline void storeNode(const Node node, float* out) { _mm_storeu_ps(out, node); }
+inline Node scaleNode(const Node a, const float w) { return _mm_mul_ps(a, _mm_set1_ps(w)); }
+inline Node maddNode(const Node acc, const Node a, const float w) { return _mm_add_ps(acc, _mm_mul_ps(a, _mm_set1_ps(w))); }
+inline Node lerpNode(const Node a, const Node b, const float t)
+{
+    return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_set1_ps(t)));
+}
+#else
+struct Node
+{
+    float _v[4];
+};
+
+inline Node loadNode(const float* p)
+{
+    Node node = {{p[0], p[1], p[2], p[3]}};
+    return node;
+}
+inline void storeNode(const Node& node, float* out)
+{
+    for(std::size_t c = 0; c < 4; ++c)
+        out[c] = node._v[c];
+}
+inline Node scaleNode(const Node& a, const float w)
+{
+    Node node = {{a._v[0] * w, a._v[1] * w, a._v[2] * w, a._v[3] * w}};
+    return node;
+}
+inline Node maddNode(const Node& acc, const Node& a, const float w)
+{
+    Node node = {{acc._v[0] + a._v[0] * w, acc._v[1] + a._v[1] * w, acc._v[2] + a._v[2] * w, acc._v[3] + a._v[3] * w}};
+    return node;
+}
+inline Node lerpNode(const Node& a, const Node& b, const float t)
+{
+    Node node = {{a._v[0] + (b._v[0] - a._v[0]) * t, a._v[1] + (b._v[1] - a._v[1]) * t,
+                  a._v[2] + (b._v[2] - a._v[2]) * t, a._v[3] + (b._v[3] - a._v[3]) * t}};
+    return node;
+}
+#endif
+
+/// @brief Interpolation between the 8 nodes of the cube (like TrilinInterpolator).
+struct Trilinear
+{
+    static void interpolate(const float* lattice, const AxisCoord& x, const AxisCoord& y, const AxisCoord& z,
+                            const std::size_t strideX, const std::size_t strideY, float* out)
+    {
+        const float* p000 = lattice + x._offset + y._offset + z._offset;
+        const float* p100 = p000 + strideX;
+
+        const Node c00 = lerpNode(loadNode(p000), loadNode(p000 + 4), z._fraction);
+        const Node c01 = lerpNode(loadNode(p000 + strideY), loadNode(p000 + strideY + 4), z._fraction);
+        const Node c10 = lerpNode(loadNode(p100), loadNode(p100 + 4), z._fraction);
+        const Node c11 = lerpNode(loadNode(p100 + strideY), loadNode(p100 + strideY + 4), z._fraction);
+
+        storeNode(lerpNode(lerpNode(c00, c01, y._fraction), lerpNode(c10, c11, y._fraction), x._fraction), out);
+    }
+};
+
+/// @brief Interpolation between the 4 nodes of the tetrahedron containing the point (like TetraInterpolator).
+struct Tetrahedral
+{
+    static void interpolate(const float* lattice, const AxisCoord& x, const AxisCoord& y, const AxisCoord& z,
+                            const std::size_t strideX, const std::size_t strideY, float* out)
+    {
+        static const std::size_t strideZ = 4;
+        const float fx = x._fraction;
+        const float fy = y._fraction;
+        const float fz = z._fraction;
+
+        // axes sorted by decreasing fraction
+        float f1, f2, f3;
+        std::size_t s1, s2;
+        if(fx >= fy)
+        {
+            if(fy >= fz)
+            {
+                f1 = fx;
+                f2 = fy;
+                f3 = fz;
+                s1 = strideX;
+                s2 = strideY;
+            }
+            else if(fx >= fz)
+            {
+                f1 = fx;
+                f2 = fz;
+                f3 = fy;
+                s1 = strideX;
+                s2 = strideZ;
+            }
+            else
+            {
+                f1 = fz;
+                f2 = fx;
+                f3 = fy;
+                s1 = strideZ;
+                s2 = strideX;
+            }
+        }
+        else
+        {
+            if(fz >= fy)
+            {
+                f1 = fz;
+                f2 = fy;
+                f3 = fx;
+                s1 = strideZ;
+                s2 = strideY;
+            }
+            else if(fz >= fx)
+            {
+                f1 = fy;
+                f2 = fz;
+                f3 = fx;
+                s1 = strideY;
+                s2 = strideZ;
+            }
+            else
+            {
+                f1 = fy;
+                f2 = fx;
+                f3 = fz;
+                s1 = strideY;
+                s2 = strideX;
+            }
+        }
+
+        const float* p000 = lattice + x._offset + y._offset + z._offset;
+        const float* p1 = p000 + s1;
+        const float* p2 = p1 + s2;
+        const float* p111 = p000 + strideX + strideY + strideZ;
+
+        Node res = scaleNode(loadNode(p000), 1.f - f1);
+        res = maddNode(res, loadNode(p1), f1 - f2);
+        res = maddNode(res, loadNode(p2), f2 - f3);
+        res = maddNode(res, loadNode(p111), f3);
+        storeNode(res, out);
+    }
+};
+
+template <typename Integer>
+inline Integer toInteger(const float value)
+{
+    static const float maxValue = std::numeric_limits<Integer>::max();
+    const float v = value * maxValue + 0.5f;
+    return static_cast<Integer>(v > 0.f ? (v < maxValue ? v : maxValue) : 0.f);
+}
+}
+
+BakedLut3D::BakedLut3D()
+    : _dimSize(0)
+    , _interpolation(eInterpolationTetrahedral)
+{
+}
+
+void BakedLut3D::bake(const AbstractLut& lut, const EInterpolation interpolation)
+{
+    _dimSize = lut.dimSize();
+    _interpolation = interpolation;
+    _lattice.assign(_dimSize * _dimSize * _dimSize * 4, 0.f);
+    _index8.clear();
+    _fraction8.clear();
+    if(empty())
+        return;
+
+    std::vector<float>::iterator node = _lattice.begin();
+    for(std::size_t x = 0; x < _dimSize; ++x)
+    {
+        for(std::size_t y = 0; y < _dimSize; ++y)
+        {
+            for(std::size_t z = 0; z < _dimSize; ++z, node += 4)
+            {
+                const Color color = lut.getIndexedColor(x, y, z);
+                node[0] = static_cast<float>(color.x);
+                node[1] = static_cast<float>(color.y);
+                node[2] = static_cast<float>(color.z);
+            }
+        }
+    }
+
+    const std::size_t maxIndex = _dimSize - 1;
+    _index8.resize(256);
+    _fraction8.resize(256);
+    for(std::size_t value = 0; value < 256; ++value)
+    {
+        const AxisCoord coord = floatCoord(value / 255.f, maxIndex, 1);
+        _index8[value] = static_cast<boost::uint32_t>(coord._offset);
+        _fraction8[value] = coord._fraction;
+    }
+}
+
+void BakedLut3D::applyRow(const float* src, float* dst, const std::size_t nbPixels, const std::size_t srcStep,
+                          const std::size_t dstStep) const
+{
+    if(_interpolation == eInterpolationTrilinear)
+        applyRowFloat<Trilinear>(src, dst, nbPixels, srcStep, dstStep);
+    else
+        applyRowFloat<Tetrahedral>(src, dst, nbPixels, srcStep, dstStep);
+}
+
+void BakedLut3D::applyRow(const boost::uint8_t* src, boost::uint8_t* dst, const std::size_t nbPixels,
+                          const std::size_t srcStep, const std::size_t dstStep) const
+{
+    const Coords8 coords = {&_index8[0], &_fraction8[0]};
+    if(_interpolation == eInterpolationTrilinear)
+        applyRowInteger<Trilinear>(src, dst, nbPixels, srcStep, dstStep, coords);
+    else
+        applyRowInteger<Tetrahedral>(src, dst, nbPixels, srcStep, dstStep, coords);
+}
+
+void BakedLut3D::applyRow(const boost::uint16_t* src, boost::uint16_t* dst, const std::size_t nbPixels,
+                          const std::size_t srcStep, const std::size_t dstStep) const
+{
+    const Coords16 coords = {static_cast<boost::uint32_t>(_dimSize - 1)};
+    if(_interpolation == eInterpolationTrilinear)
+        applyRowInteger<Trilinear>(src, dst, nbPixels, srcStep, dstStep, coords);
+    else
+        applyRowInteger<Tetrahedral>(src, dst, nbPixels, srcStep, dstStep, coords);
+}
+
+template <class Interpolation>
+void BakedLut3D::applyRowFloat(const float* src, float* dst, const std::size_t nbPixels, const std::size_t srcStep,
+                               const std::size_t dstStep) const
+{
+    const std::size_t maxIndex = _dimSize - 1;
+    const std::size_t strideY = 4 * _dimSize;
+    const std::size_t strideX = strideY * _dimSize;
+    const float* lattice = &_lattice[0];
+    float out[4];
+
+    for(std::size_t i = 0; i < nbPixels; ++i, src += srcStep, dst += dstStep)
+    {
+        const AxisCoord x = floatCoord(src[0], maxIndex, strideX);
+        const AxisCoord y = floatCoord(src[1], maxIndex, strideY);
+        const AxisCoord z = floatCoord(src[2], maxIndex, 4);
+        Interpolation::interpolate(lattice, x, y, z, strideX, strideY, out);
+        dst[0] = out[0];
+        dst[1] = out[1];
+        dst[2] = out[2];
+    }
+}
+
+template <class Interpolation, typename Integer, class Coords>
+void BakedLut3D::applyRowInteger(const Integer* src, Integer* dst, const std::size_t nbPixels,
+                                 const std::size_t srcStep, const std::size_t dstStep, const Coords& coords) const
+{
+    const std::size_t strideY = 4 * _dimSize;
+    const std::size_t strideX = strideY * _dimSize;
+    const float* lattice = &_lattice[0];
+    float out[4];
+
+    for(std::size_t i = 0; i < nbPixels; ++i, src += srcStep, dst += dstStep)
+    {
+        const AxisCoord x = coords(src[0], strideX);
+        const AxisCoord y = coords(src[1], strideY);
+        const AxisCoord z = coords(src[2], 4);
+        Interpolation::interpolate(lattice, x, y, z, strideX, strideY, out);
+        dst[0] = toInteger<Integer>(out[0]);
+        dst[1] = toInteger<Integer>(out[1]);
+        dst[2] = toInteger<Integer>(out[2]);
+    }
+}
+}
@@ -0,0 +1,72 @@
+#ifndef _LUTENGINE_BAKEDLUT3D_HPP_
+#define _LUTENGINE_BAKEDLUT3D_HPP_
+
+#include "AbstractLut.hpp"
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace tuttle
+{
+
+/**
+ * @brief 3D LUT baked into a contiguous float lattice, applied on rows of interleaved pixels.
+ *
+ * Each node is stored as 4 floats (RGB and a padding value) so that a node is loaded in one SSE register.
+ * The lattice keeps the order of Lut3D: the first input channel is the slowest axis.
+ * The inputs are clamped to [0, 1] (integer inputs are normalized by the maximum channel value).
+ */
+class BakedLut3D
+{
+public:
+    enum EInterpolation
+    {
+        eInterpolationTrilinear,
+        eInterpolationTetrahedral
+    };
+
+public:
+    BakedLut3D();
+
+    /// @brief Copy the lattice of @p lut, the interpolation is chosen at bake time.
+    void bake(const AbstractLut& lut, const EInterpolation interpolation);
+
+    bool empty() const { return _dimSize < 2; }
+    std::size_t dimSize() const { return _dimSize; }
+    EInterpolation interpolation() const { return _interpolation; }
+
+    /**
+     * @brief Apply the LUT on the 3 first channels of @p nbPixels pixels, the other channels are not modified.
+     * @param srcStep, dstStep number of channels between two pixels (3 or 4 for interleaved RGB/RGBA)
+     */
+    void applyRow(const float* src, float* dst, const std::size_t nbPixels, const std::size_t srcStep,
+                  const std::size_t dstStep) const;
+    void applyRow(const boost::uint8_t* src, boost::uint8_t* dst, const std::size_t nbPixels,
+                  const std::size_t srcStep, const std::size_t dstStep) const;
+    void applyRow(const boost::uint16_t* src, boost::uint16_t* dst, const std::size_t nbPixels,
+                  const std::size_t srcStep, const std::size_t dstStep) const;
+
+private:
+    template <class Interpolation>
+    void applyRowFloat(const float* src, float* dst, const std::size_t nbPixels, const std::size_t srcStep,
+                       const std::size_t dstStep) const;
+    template <class Interpolation, typename Integer, class Coords>
+    void applyRowInteger(const Integer* src, Integer* dst, const std::size_t nbPixels, const std::size_t srcStep,
+                         const std::size_t dstStep, const Coords& coords) const;
+
+private:
+    std::vector<float> _lattice;
+    std::size_t _dimSize;
+    EInterpolation _interpolation;
+
+    /// @name Lattice index and fraction of each 8 bits value
+    /// @{
+    std::vector<boost::uint32_t> _index8;
+    std::vector<float> _fraction8;
+    /// @}
+};
+}
+
+#endif
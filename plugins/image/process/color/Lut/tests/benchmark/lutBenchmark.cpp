@@ -0,0 +1,113 @@
+#include <lutEngine/Lut.hpp>
+#include <lutEngine/BakedLut3D.hpp>
+#include <lutEngine/TetraInterpolator.hpp>
+#include <lutEngine/TrilinInterpolator.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define BOOST_TEST_MODULE plugin_lut_benchmark
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(plugin_lut_benchmark)
+
+using namespace boost::unit_test;
+using namespace tuttle;
+
+namespace
+{
+
+static const std::size_t kLutSize = 33;
+static const std::size_t kNbPixels = 4000000;
+
+/// @brief A smooth and non separable LUT.
+void fillLut(Lut3D& lut)
+{
+    const double maxIndex = lut.dimSize() - 1.0;
+    for(std::size_t x = 0; x < lut.dimSize(); ++x)
+    {
+        for(std::size_t y = 0; y < lut.dimSize(); ++y)
+        {
+            for(std::size_t z = 0; z < lut.dimSize(); ++z)
+            {
+                const double r = x / maxIndex;
+                const double g = y / maxIndex;
+                const double b = z / maxIndex;
+                lut.setIndexedValues(x, y, z, std::sqrt(r), 0.5 * (g + r * b), b * b * (1.0 - 0.3 * g));
+            }
+        }
+    }
+}
+
+/// @brief Random RGB pixels in [0, 1[ (the Interpolators don't support the value 1).
+std::vector<float> randomPixels(const std::size_t nbPixels)
+{
+    std::vector<float> pixels(nbPixels * 3);
+    std::srand(42);
+    for(std::size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = (std::rand() % 10000) / 10000.f;
+    return pixels;
+}
+
+double seconds(const boost::posix_time::ptime& begin)
+{
+    return (boost::posix_time::microsec_clock::universal_time() - begin).total_microseconds() / 1000000.0;
+}
+
+void benchmarkBakedLut(Interpolator* interpolator, const BakedLut3D::EInterpolation interpolation, const char* name)
+{
+    Lut3D lut(interpolator, kLutSize);
+    fillLut(lut);
+    BakedLut3D bakedLut;
+    bakedLut.bake(lut, interpolation);
+
+    const std::vector<float> src = randomPixels(kNbPixels);
+
+    std::vector<float> reference(src.size());
+    boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+    for(std::size_t i = 0; i < src.size(); i += 3)
+    {
+        const Color color = lut.getColor(src[i], src[i + 1], src[i + 2]);
+        reference[i] = static_cast<float>(color.x);
+        reference[i + 1] = static_cast<float>(color.y);
+        reference[i + 2] = static_cast<float>(color.z);
+    }
+    const double referenceTime = seconds(begin);
+
+    std::vector<float> baked(src.size());
+    begin = boost::posix_time::microsec_clock::universal_time();
+    bakedLut.applyRow(&src[0], &baked[0], kNbPixels, 3, 3);
+    const double bakedTime = seconds(begin);
+
+    std::vector<boost::uint8_t> src8(src.size()), dst8(src.size());
+    for(std::size_t i = 0; i < src.size(); ++i)
+        src8[i] = static_cast<boost::uint8_t>(src[i] * 255.f);
+    begin = boost::posix_time::microsec_clock::universal_time();
+    bakedLut.applyRow(&src8[0], &dst8[0], kNbPixels, 3, 3);
+    const double baked8Time = seconds(begin);
+
+    std::cout << "[lut] " << name << ": " << kNbPixels / referenceTime / 1e6 << " Mpixels/s with the interpolator, "
+              << kNbPixels / bakedTime / 1e6 << " Mpixels/s baked (32f), " << kNbPixels / baked8Time / 1e6
+              << " Mpixels/s baked (8ui)" << std::endl;
+
+    // the timed results are used
+    BOOST_CHECK_SMALL(baked[src.size() / 2] - reference[src.size() / 2], 1e-5f);
+}
+}
+
+BOOST_AUTO_TEST_CASE(plugin_lut_benchmark_trilinear)
+{
+    benchmarkBakedLut(new TrilinInterpolator(), BakedLut3D::eInterpolationTrilinear, "trilinear");
+}
+
+BOOST_AUTO_TEST_CASE(plugin_lut_benchmark_tetrahedral)
+{
+    benchmarkBakedLut(new TetraInterpolator(), BakedLut3D::eInterpolationTetrahedral, "tetrahedral");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,13 @@
-#include <iostream>
+#include <lutEngine/Lut.hpp>
+#include <lutEngine/BakedLut3D.hpp>
+#include <lutEngine/TetraInterpolator.hpp>
+#include <lutEngine/TrilinInterpolator.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
 
 #define BOOST_TEST_MODULE test_plugin_lut
 #include <boost/test/unit_test.hpp>
@@ -6,10 +15,117 @@
 BOOST_AUTO_TEST_SUITE(plugin_lut)
 
 using namespace boost::unit_test;
+using namespace tuttle;
+
+namespace
+{
+
+static const std::size_t kLutSize = 33;
+
+/// @brief A smooth and non separable LUT.
+void fillLut(Lut3D& lut)
+{
+    const double maxIndex = lut.dimSize() - 1.0;
+    for(std::size_t x = 0; x < lut.dimSize(); ++x)
+    {
+        for(std::size_t y = 0; y < lut.dimSize(); ++y)
+        {
+            for(std::size_t z = 0; z < lut.dimSize(); ++z)
+            {
+                const double r = x / maxIndex;
+                const double g = y / maxIndex;
+                const double b = z / maxIndex;
+                lut.setIndexedValues(x, y, z, std::sqrt(r), 0.5 * (g + r * b), b * b * (1.0 - 0.3 * g));
+            }
+        }
+    }
+}
+
+/// @brief Random RGB pixels in [0, 1[ (the Interpolators don't support the value 1).
+std::vector<float> randomPixels(const std::size_t nbPixels)
+{
+    std::vector<float> pixels(nbPixels * 3);
+    std::srand(42);
+    for(std::size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = (std::rand() % 10000) / 10000.f;
+    return pixels;
+}
 
-BOOST_AUTO_TEST_CASE(plugin_lut_test_01)
+void checkBakedLut(Interpolator* interpolator, const BakedLut3D::EInterpolation interpolation)
 {
-    BOOST_CHECK_EQUAL(1.0, 1.0);
+    Lut3D lut(interpolator, kLutSize);
+    fillLut(lut);
+    BakedLut3D bakedLut;
+    bakedLut.bake(lut, interpolation);
+
+    const std::size_t nbPixels = 1000000;
+    const std::vector<float> src = randomPixels(nbPixels);
+
+    std::vector<float> reference(src.size());
+    for(std::size_t i = 0; i < src.size(); i += 3)
+    {
+        const Color color = lut.getColor(src[i], src[i + 1], src[i + 2]);
+        reference[i] = static_cast<float>(color.x);
+        reference[i + 1] = static_cast<float>(color.y);
+        reference[i + 2] = static_cast<float>(color.z);
+    }
+
+    std::vector<float> baked(src.size());
+    bakedLut.applyRow(&src[0], &baked[0], nbPixels, 3, 3);
+    for(std::size_t i = 0; i < src.size(); ++i)
+        BOOST_REQUIRE_SMALL(baked[i] - reference[i], 1e-5f);
+
+    // 8 and 16 bits inputs
+    std::vector<boost::uint8_t> src8(src.size()), dst8(src.size());
+    std::vector<boost::uint16_t> src16(src.size()), dst16(src.size());
+    for(std::size_t i = 0; i < src.size(); ++i)
+    {
+        src8[i] = static_cast<boost::uint8_t>(src[i] * 255.f);
+        src16[i] = static_cast<boost::uint16_t>(src[i] * 65535.f);
+    }
+    bakedLut.applyRow(&src8[0], &dst8[0], nbPixels, 3, 3);
+    bakedLut.applyRow(&src16[0], &dst16[0], nbPixels, 3, 3);
+    for(std::size_t i = 0; i < src.size(); i += 3)
+    {
+        const Color color8 = lut.getColor(src8[i] / 255.0, src8[i + 1] / 255.0, src8[i + 2] / 255.0);
+        BOOST_REQUIRE_SMALL(dst8[i] - color8.x * 255.0, 0.51);
+        BOOST_REQUIRE_SMALL(dst8[i + 2] - color8.z * 255.0, 0.51);
+        const Color color16 = lut.getColor(src16[i] / 65535.0, src16[i + 1] / 65535.0, src16[i + 2] / 65535.0);
+        BOOST_REQUIRE_SMALL(dst16[i + 1] - color16.y * 65535.0, 0.6);
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(plugin_lut_baked_trilinear)
+{
+    checkBakedLut(new TrilinInterpolator(), BakedLut3D::eInterpolationTrilinear);
+}
+
+BOOST_AUTO_TEST_CASE(plugin_lut_baked_tetrahedral)
+{
+    checkBakedLut(new TetraInterpolator(), BakedLut3D::eInterpolationTetrahedral);
+}
+
+BOOST_AUTO_TEST_CASE(plugin_lut_baked_clamp)
+{
+    Lut3D lut(new TetraInterpolator(), kLutSize);
+    fillLut(lut);
+    BakedLut3D bakedLut;
+    bakedLut.bake(lut, BakedLut3D::eInterpolationTetrahedral);
+
+    // RGBA pixels, out of range values are clamped and alpha is not modified
+    const float src[] = {1.f, 1.f, 1.f, 0.5f, -1.f, 2.f, 0.f, 0.25f};
+    float dst[8] = {0.f, 0.f, 0.f, 0.5f, 0.f, 0.f, 0.f, 0.25f};
+    bakedLut.applyRow(src, dst, 2, 4, 4);
+
+    const Color white = lut.getIndexedColor(kLutSize - 1, kLutSize - 1, kLutSize - 1);
+    BOOST_CHECK_CLOSE(dst[0], white.x, 1e-4);
+    BOOST_CHECK_CLOSE(dst[2], white.z, 1e-4);
+    BOOST_CHECK_EQUAL(dst[3], 0.5f);
+    const Color clamped = lut.getIndexedColor(0, kLutSize - 1, 0);
+    BOOST_CHECK_SMALL(dst[4] - clamped.x, 1e-5);
+    BOOST_CHECK_SMALL(dst[5] - clamped.y, 1e-5);
+    BOOST_CHECK_EQUAL(dst[7], 0.25f);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,8 @@
 #include "OCIOColorSpacePlugin.hpp"
 #include "OCIOColorSpaceProcess.hpp"
 
+#include <OCIOProcessorCache.hpp>
+
 #include <tuttle/common/utils/color.hpp>
 
 #include <boost/filesystem/operations.hpp>
@@ -120,8 +122,9 @@ OCIOColorSpaceProcessParams OCIOColorSpacePlugin::getProcessParams(const OfxPoin
         BOOST_THROW_EXCEPTION(exception::FileNotExist() << exception::filename(str));
     }
 
-    // Get the OCIO configuration processor.
-    params._config = OCIO::Config::CreateFromFile(str.c_str());
+    // Get the OCIO configuration (loaded once for all the renders).
+    params._configFilename = str;
+    params._config = getProcessorCache().getConfig(str);
 
     int index;
     _paramInputSpace->getValue(index);
@@ -16,6 +16,7 @@ namespace colorspace
 
 struct OCIOColorSpaceProcessParams
 {
+    std::string _configFilename;
     OCIO_NAMESPACE::ConstConfigRcPtr _config;
     std::string _inputSpace;
     std::string _outputSpace;
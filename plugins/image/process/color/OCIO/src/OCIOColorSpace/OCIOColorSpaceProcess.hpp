@@ -35,7 +35,7 @@ private:
     OCIOColorSpacePlugin& _plugin;       ///< Rendering plugin
     OCIOColorSpaceProcessParams _params; ///< parameters
 
-    OCIO::ConstConfigRcPtr _config;
+    OCIO::ConstProcessorRcPtr _processor; ///< shared by all the renders of the same conversion
 
 public:
     OCIOColorSpaceProcess<View>(OCIOColorSpacePlugin& instance);
@@ -1,5 +1,7 @@
 #include "OCIOColorSpaceDefinitions.hpp"
 
+#include <OCIOProcessorCache.hpp>
+
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
 #include <tuttle/plugin/exceptions.hpp>
@@ -12,6 +14,8 @@
 
 #include <boost/gil/gil_all.hpp>
 
+#include <algorithm>
+
 namespace tuttle
 {
 namespace plugin
@@ -36,11 +40,8 @@ void OCIOColorSpaceProcess<View>::setup(const OFX::RenderArguments& args)
 
     try
     {
-        // Load the current config.
-        _config = _params._config;
-
-        // Try to load the processor
-        _config->getProcessor(_params._inputSpace.c_str(), _params._outputSpace.c_str());
+        _processor =
+            getProcessorCache().getColorSpaceProcessor(_params._configFilename, _params._inputSpace, _params._outputSpace);
     }
     catch(OCIO::Exception& exception)
     {
@@ -69,33 +70,28 @@ template <class View>
 void OCIOColorSpaceProcess<View>::applyLut(View& dst, View& src)
 {
     using namespace boost::gil;
-    typedef typename View::x_iterator vIterator;
-    typedef typename channel_type<View>::type Pixel;
 
-    copy_pixels(src, dst);
+    if(is_planar<View>::value)
+    {
+        BOOST_THROW_EXCEPTION(exception::NotImplemented());
+    }
 
     try
     {
-        OCIO::ConstProcessorRcPtr processor =
-            _config->getProcessor(_params._inputSpace.c_str(), _params._outputSpace.c_str());
-
-        if(is_planar<View>::value)
-        {
-            BOOST_THROW_EXCEPTION(exception::NotImplemented());
-        }
-        else
+        for(std::size_t y = 0; y < (unsigned int)dst.height(); ++y)
         {
-            for(std::size_t y = 0; y < (unsigned int)dst.height(); ++y)
-            {
-                // Wrap the image in a light-weight ImageDescription
-                OCIO::PackedImageDesc imageDesc((float*)&(dst(0, y)[0]), dst.width(), 1, num_channels<View>::type::value,
-                                                OCIO::AutoStride, dst.pixels().pixel_size(), dst.pixels().row_size());
-                // Apply the color transformation (in place)
-                // Need normalized values
-                processor->apply(imageDesc);
-                if(this->progressForward(dst.width()))
-                    return;
-            }
+            // Copy the row just before its transformation (still in cache), nothing to do if rendered in place
+            if(src.row_begin(y) != dst.row_begin(y))
+                std::copy(src.row_begin(y), src.row_end(y), dst.row_begin(y));
+
+            // Wrap the row in a light-weight ImageDescription
+            OCIO::PackedImageDesc imageDesc((float*)&(dst(0, y)[0]), dst.width(), 1, num_channels<View>::type::value,
+                                            OCIO::AutoStride, dst.pixels().pixel_size(), dst.pixels().row_size());
+            // Apply the color transformation (in place)
+            // Need normalized values
+            _processor->apply(imageDesc);
+            if(this->progressForward(dst.width()))
+                return;
         }
     }
     catch(OCIO::Exception& exception)
@@ -35,9 +35,7 @@ private:
     OCIOLutPlugin& _plugin;       ///< Rendering plugin
     OCIOLutProcessParams _params; ///< parameters
 
-    OCIO::FileTransformRcPtr fileTransform;
-    OCIO::GroupTransformRcPtr groupTransform;
-    OCIO::ConfigRcPtr config;
+    OCIO::ConstProcessorRcPtr _processor; ///< shared by all the renders of the same LUT file
 
 public:
     OCIOLutProcess<View>(OCIOLutPlugin& instance);
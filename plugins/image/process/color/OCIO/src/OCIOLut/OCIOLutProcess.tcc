@@ -1,5 +1,7 @@
 #include "OCIOLutDefinitions.hpp"
 
+#include <OCIOProcessorCache.hpp>
+
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
 #include <tuttle/plugin/exceptions.hpp>
@@ -12,6 +14,8 @@
 
 #include <boost/gil/gil_all.hpp>
 
+#include <algorithm>
+
 namespace tuttle
 {
 namespace plugin
@@ -36,33 +40,8 @@ void OCIOLutProcess<View>::setup(const OFX::RenderArguments& args)
 
     try
     {
-        fileTransform = OCIO::FileTransform::Create();
-        fileTransform->setSrc(_params._filename.c_str());
-        fileTransform->setInterpolation(_params._interpolationType);
-
-        // Add the file transform to the group, required by the transform process
-        groupTransform = OCIO::GroupTransform::Create();
-        groupTransform->push_back(fileTransform);
-
-        // Create the OCIO processor for the specified transform.
-        config = OCIO::Config::Create();
-
-        OCIO::ColorSpaceRcPtr inputColorSpace = OCIO::ColorSpace::Create();
-        inputColorSpace->setName(kOCIOInputspace.c_str());
-
-        config->addColorSpace(inputColorSpace);
-
-        OCIO::ColorSpaceRcPtr outputColorSpace = OCIO::ColorSpace::Create();
-        outputColorSpace->setName(kOCIOOutputspace.c_str());
-
-        outputColorSpace->setTransform(groupTransform, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
-
-        TUTTLE_LOG_WARNING("Specified Transform:" << *(groupTransform));
-
-        config->addColorSpace(outputColorSpace);
-
-        // Try to load the processor
-        config->getProcessor(kOCIOInputspace.c_str(), kOCIOOutputspace.c_str());
+        _processor = getProcessorCache().getFileProcessor(_params._filename, _params._interpolationType,
+                                                          OCIO::TRANSFORM_DIR_FORWARD);
     }
     catch(OCIO::Exception& exception)
     {
@@ -91,32 +70,28 @@ template <class View>
 void OCIOLutProcess<View>::applyLut(View& dst, View& src)
 {
     using namespace boost::gil;
-    typedef typename View::x_iterator vIterator;
-    typedef typename channel_type<View>::type Pixel;
 
-    copy_pixels(src, dst);
+    if(is_planar<View>::value)
+    {
+        BOOST_THROW_EXCEPTION(exception::NotImplemented());
+    }
 
     try
     {
-        OCIO::ConstProcessorRcPtr processor = config->getProcessor(kOCIOInputspace.c_str(), kOCIOOutputspace.c_str());
-
-        if(is_planar<View>::value)
-        {
-            BOOST_THROW_EXCEPTION(exception::NotImplemented());
-        }
-        else
+        for(std::size_t y = 0; y < (unsigned int)dst.height(); ++y)
         {
-            for(std::size_t y = 0; y < (unsigned int)dst.height(); ++y)
-            {
-                // Wrap the image in a light-weight ImageDescription
-                OCIO::PackedImageDesc imageDesc((float*)&(dst(0, y)[0]), dst.width(), 1, num_channels<View>::type::value,
-                                                OCIO::AutoStride, dst.pixels().pixel_size(), dst.pixels().row_size());
-                // Apply the color transformation (in place)
-                // Need normalized values
-                processor->apply(imageDesc);
-                if(this->progressForward(dst.width()))
-                    return;
-            }
+            // Copy the row just before its transformation (still in cache), nothing to do if rendered in place
+            if(src.row_begin(y) != dst.row_begin(y))
+                std::copy(src.row_begin(y), src.row_end(y), dst.row_begin(y));
+
+            // Wrap the row in a light-weight ImageDescription
+            OCIO::PackedImageDesc imageDesc((float*)&(dst(0, y)[0]), dst.width(), 1, num_channels<View>::type::value,
+                                            OCIO::AutoStride, dst.pixels().pixel_size(), dst.pixels().row_size());
+            // Apply the color transformation (in place)
+            // Need normalized values
+            _processor->apply(imageDesc);
+            if(this->progressForward(dst.width()))
+                return;
         }
     }
     catch(OCIO::Exception& exception)
@@ -0,0 +1,102 @@
+#include "OCIOProcessorCache.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/system/error_code.hpp>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace ocio
+{
+
+namespace OCIO = OCIO_NAMESPACE;
+
+namespace
+{
+ProcessorCache processorCache;
+
+std::time_t getLastWriteTime(const std::string& filename)
+{
+    boost::system::error_code error;
+    const std::time_t lastWriteTime = boost::filesystem::last_write_time(filename, error);
+    return error ? std::time_t(0) : lastWriteTime;
+}
+}
+
+ProcessorCache& getProcessorCache()
+{
+    return processorCache;
+}
+
+OCIO::ConstProcessorRcPtr ProcessorCache::getFileProcessor(const std::string& filename,
+                                                           const OCIO::Interpolation interpolation,
+                                                           const OCIO::TransformDirection direction)
+{
+    const std::time_t lastWriteTime = getLastWriteTime(filename);
+    const FileKey key(filename, interpolation, direction);
+
+    boost::mutex::scoped_lock lock(_mutex);
+    std::map<FileKey, Entry<OCIO::ConstProcessorRcPtr> >::iterator it = _fileProcessors.find(key);
+    if(it != _fileProcessors.end() && it->second._lastWriteTime == lastWriteTime)
+        return it->second._value;
+
+    OCIO::FileTransformRcPtr fileTransform = OCIO::FileTransform::Create();
+    fileTransform->setSrc(filename.c_str());
+    fileTransform->setInterpolation(interpolation);
+    fileTransform->setDirection(direction);
+    TUTTLE_LOG_DEBUG("[OCIO] New processor for the transform: " << *fileTransform);
+
+    Entry<OCIO::ConstProcessorRcPtr> entry;
+    entry._lastWriteTime = lastWriteTime;
+    entry._value = OCIO::Config::Create()->getProcessor(fileTransform);
+    _fileProcessors[key] = entry;
+    return entry._value;
+}
+
+OCIO::ConstConfigRcPtr ProcessorCache::getConfig(const std::string& configFilename)
+{
+    const std::time_t lastWriteTime = getLastWriteTime(configFilename);
+
+    boost::mutex::scoped_lock lock(_mutex);
+    return getConfig(configFilename, lastWriteTime);
+}
+
+OCIO::ConstProcessorRcPtr ProcessorCache::getColorSpaceProcessor(const std::string& configFilename,
+                                                                 const std::string& inputSpace,
+                                                                 const std::string& outputSpace)
+{
+    const std::time_t lastWriteTime = getLastWriteTime(configFilename);
+    const ColorSpaceKey key(configFilename, inputSpace, outputSpace);
+
+    boost::mutex::scoped_lock lock(_mutex);
+    std::map<ColorSpaceKey, Entry<OCIO::ConstProcessorRcPtr> >::iterator it = _colorSpaceProcessors.find(key);
+    if(it != _colorSpaceProcessors.end() && it->second._lastWriteTime == lastWriteTime)
+        return it->second._value;
+
+    TUTTLE_LOG_DEBUG("[OCIO] New processor from " << inputSpace << " to " << outputSpace << " (" << configFilename
+                                                   << ")");
+    Entry<OCIO::ConstProcessorRcPtr> entry;
+    entry._lastWriteTime = lastWriteTime;
+    entry._value = getConfig(configFilename, lastWriteTime)->getProcessor(inputSpace.c_str(), outputSpace.c_str());
+    _colorSpaceProcessors[key] = entry;
+    return entry._value;
+}
+
+OCIO::ConstConfigRcPtr ProcessorCache::getConfig(const std::string& configFilename, const std::time_t lastWriteTime)
+{
+    std::map<std::string, Entry<OCIO::ConstConfigRcPtr> >::iterator it = _configs.find(configFilename);
+    if(it != _configs.end() && it->second._lastWriteTime == lastWriteTime)
+        return it->second._value;
+
+    Entry<OCIO::ConstConfigRcPtr> entry;
+    entry._lastWriteTime = lastWriteTime;
+    entry._value = OCIO::Config::CreateFromFile(configFilename.c_str());
+    _configs[configFilename] = entry;
+    return entry._value;
+}
+}
+}
+}
@@ -0,0 +1,69 @@
+#ifndef _TUTTLE_PLUGIN_OCIOPROCESSORCACHE_HPP_
+#define _TUTTLE_PLUGIN_OCIOPROCESSORCACHE_HPP_
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+
+#include <ctime>
+#include <map>
+#include <string>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace ocio
+{
+
+/**
+ * @brief OCIO configs and processors shared by all the instances and render threads of the OCIO plugins.
+ *
+ * The entries are rebuilt when the modification time of their file changes.
+ */
+class ProcessorCache : boost::noncopyable
+{
+public:
+    /// @brief Processor applying the LUT file @p filename.
+    OCIO_NAMESPACE::ConstProcessorRcPtr getFileProcessor(const std::string& filename,
+                                                         const OCIO_NAMESPACE::Interpolation interpolation,
+                                                         const OCIO_NAMESPACE::TransformDirection direction);
+
+    /// @brief Config loaded from @p configFilename.
+    OCIO_NAMESPACE::ConstConfigRcPtr getConfig(const std::string& configFilename);
+
+    /// @brief Processor converting from @p inputSpace to @p outputSpace, with the config @p configFilename.
+    OCIO_NAMESPACE::ConstProcessorRcPtr getColorSpaceProcessor(const std::string& configFilename,
+                                                               const std::string& inputSpace,
+                                                               const std::string& outputSpace);
+
+private:
+    template <class Value>
+    struct Entry
+    {
+        std::time_t _lastWriteTime;
+        Value _value;
+    };
+
+    typedef boost::tuple<std::string, OCIO_NAMESPACE::Interpolation, OCIO_NAMESPACE::TransformDirection> FileKey;
+    typedef boost::tuple<std::string, std::string, std::string> ColorSpaceKey;
+
+    OCIO_NAMESPACE::ConstConfigRcPtr getConfig(const std::string& configFilename, const std::time_t lastWriteTime);
+
+private:
+    boost::mutex _mutex;
+    std::map<FileKey, Entry<OCIO_NAMESPACE::ConstProcessorRcPtr> > _fileProcessors;
+    std::map<std::string, Entry<OCIO_NAMESPACE::ConstConfigRcPtr> > _configs;
+    std::map<ColorSpaceKey, Entry<OCIO_NAMESPACE::ConstProcessorRcPtr> > _colorSpaceProcessors;
+};
+
+/// @brief The cache of the host process.
+ProcessorCache& getProcessorCache();
+}
+}
+}
+
+#endif
@@ -17,6 +17,8 @@ BlurProcess<View>::BlurProcess(BlurPlugin& effect)
     : ImageGilFilterProcessor<View>(effect, eImageOrientationIndependant)
     , _plugin(effect)
 {
+    // the separable convolution has a margin overhead for each processed window
+    this->setScheduling(ImageProcessor::eSchedulingStatic);
 }
 
 template <class View>
@@ -18,6 +18,8 @@ ConvolutionProcess<View>::ConvolutionProcess(ConvolutionPlugin& instance)
     : ImageGilFilterProcessor<View>(instance, eImageOrientationFromBottomToTop)
     , _plugin(instance)
 {
+    // the separable convolution has a margin overhead for each processed window
+    this->setScheduling(ImageProcessor::eSchedulingStatic);
 }
 
 template <class View>
@@ -32,6 +32,16 @@ const std::string kParamOptimizationLabel("Optimization activated");
 const std::string kParamOptimization("optimization");
 const std::string kParamPreBlurring("preBlurring");
 const std::string kParamPreBlurringLabel("Pre-blurring for patch research");
+const std::string kParamEngineLabel("Engine");
+const std::string kParamEngine("engine");
+const std::string kParamEngineClassic("classic");
+const std::string kParamEngineIntegral("integral");
+
+enum EParamEngine
+{
+    eParamEngineClassic = 0, ///< sliding patch distance per pixel and per offset
+    eParamEngineIntegral     ///< patch distances of an offset for the whole window from an integral image
+};
 
 const int kParamDefaultPatchSizeValue = 2;
 const int kParamDefaultBandwidthValueR = 3;
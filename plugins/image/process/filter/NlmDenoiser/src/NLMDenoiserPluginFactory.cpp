@@ -48,6 +48,7 @@ void NLMDenoiserPluginFactory::describe(OFX::ImageEffectDescriptor& desc)
         "radius.\n"
         "- If the animation is very fast, select a larger region radius.\n"
         "- A good patch radius is about 2 or 3.\n"
+        "- The 'integral' engine gives the same result faster, especially with a large patch radius.\n"
         "- The higher 'radius' parameters are, the slower the algorithm is.");
 
     // add the supported contexts
@@ -182,6 +183,17 @@ void NLMDenoiserPluginFactory::describeInContext(OFX::ImageEffectDescriptor& des
     depth->setRange(0, 20);
     depth->setDisplayRange(0, 4);
     depth->setHint("Searching depth (3D version) for the nl-means algorithm");
+
+    OFX::ChoiceParamDescriptor* engine = desc.defineChoiceParam(kParamEngine);
+    engine->setLabels(kParamEngineLabel, kParamEngineLabel, kParamEngineLabel);
+    engine->setParent(*groupParams);
+    engine->appendOption(kParamEngineClassic);
+    engine->appendOption(kParamEngineIntegral);
+    engine->setDefault(eParamEngineClassic);
+    engine->setHint("Computation of the patch distances (same result):\n"
+                    "- classic: sliding patch distance for each pixel and each offset of the region\n"
+                    "- integral: patch distances of each offset for the whole image from an integral image of the "
+                    "pixel distances, so the cost doesn't depend on the patch radius");
 }
 
 /**
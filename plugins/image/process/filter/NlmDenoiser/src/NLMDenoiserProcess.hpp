@@ -2,6 +2,7 @@
 #define _TUTTLE_PLUGIN_NLMDENOISERPROCESS_HPP_
 
 #include "NLMDenoiserPlugin.hpp"
+#include "NLMDenoiserDefinitions.hpp"
 
 #include <tuttle/common/utils/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
@@ -34,6 +35,7 @@ struct NlmParams
     int patchRadius;
     int regionRadius;
     double preBlurring;
+    EParamEngine engine;
 };
 
 /**
@@ -58,6 +60,7 @@ protected:
     OFX::DoubleParam* _paramRedGrainSize;   ///< Red color effect bandwidth
     OFX::DoubleParam* _paramGreenGrainSize; ///< Green color effect bandwidth
     OFX::DoubleParam* _paramBlueGrainSize;  ///< Blue color effect bandwidth
+    OFX::ChoiceParam* _paramEngine;         ///< Computation of the patch distances
 
     std::vector<View> _srcViews; ///< Array of source image view (3D-NLMeans)
     boost::ptr_vector<OFX::Image> _srcImgs;
@@ -81,8 +84,13 @@ public:
     double computeBandwidth();
     void nlMeans(View& dst, const OfxRectI& procWindow, const NlmParams& params);
 
+    void computeBandwidths(const View& src, const NlmParams& params, std::vector<double>& h1, std::vector<double>& h2);
+
     void computeWeights(const std::vector<View>& srcViews, const OfxRectI& procWindow, boost::gil::rgba32f_view_t& view_wc,
                         boost::gil::rgba32f_view_t& view_norm, const NlmParams& params);
+    void computeWeightsIntegral(const std::vector<View>& srcViews, const OfxRectI& procWindow,
+                                boost::gil::rgba32f_view_t& view_wc, boost::gil::rgba32f_view_t& view_norm,
+                                const NlmParams& params);
 };
 }
 }
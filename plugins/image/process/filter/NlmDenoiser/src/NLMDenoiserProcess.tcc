@@ -7,6 +7,7 @@
 #include <tuttle/plugin/ImageGilProcessor.hpp>
 #include <tuttle/plugin/IProgress.hpp>
 #include <tuttle/plugin/exceptions.hpp>
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
 #include <terry/globals.hpp>
 #include <terry/basic_colors.hpp>
 #include <terry/channel.hpp>
@@ -17,6 +18,7 @@
 #include <boost/gil/gil_all.hpp>
 #include <boost/scoped_ptr.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <vector>
@@ -31,6 +33,29 @@ namespace nlmDenoiser
 
 namespace bgil = boost::gil;
 
+/**
+ * @brief Rows [lbound, hbound) of the patches compared for the vertical offset @p yi, relative to the row @p yj.
+ * @param hi  height of the source views
+ */
+inline void patchRowBounds(const int yi, const int yj, const int hi, const int patchRadius, int& lbound, int& hbound)
+{
+    const int j = yj + yi;
+    if(yi >= 0)
+    {
+        lbound = -patchRadius + yj < 0 ? std::max(-yj, -patchRadius) : -patchRadius;
+        hbound = lbound + (patchRadius * 2 + 1);
+        if(hbound + j > hi)
+            hbound = std::min(hi - j, patchRadius);
+    }
+    else
+    {
+        hbound = patchRadius + yj > hi ? std::min(patchRadius, (hi - yj)) : patchRadius;
+        lbound = hbound - (patchRadius * 2 + 1);
+        if(lbound + j < 0)
+            lbound = 0;
+    }
+}
+
 template <class View>
 NLMDenoiserProcess<View>::NLMDenoiserProcess(NLMDenoiserPlugin& instance)
     : ImageGilProcessor<View>(instance, eImageOrientationIndependant)
@@ -50,6 +75,9 @@ NLMDenoiserProcess<View>::NLMDenoiserProcess(NLMDenoiserPlugin& instance)
     _paramPreBlurring = instance.fetchDoubleParam(kParamPreBlurring);
 
     _paramOptimized = instance.fetchBooleanParam(kParamOptimization);
+    _paramEngine = instance.fetchChoiceParam(kParamEngine);
+    // each window is extended by the patch and region radius, so the chunks can't be too small
+    this->setChunkSize(32);
 }
 
 template <class View>
@@ -175,6 +203,7 @@ void NLMDenoiserProcess<View>::multiThreadProcessImages(const OfxRectI& procWind
     params.patchRadius = _paramPatchRadius->getValue();
     params.regionRadius = _paramRegionRadius->getValue();
     params.preBlurring = (float)_paramPreBlurring->getValue();
+    params.engine = static_cast<EParamEngine>(_paramEngine->getValue());
 
     // Destination subview cropped by the procwindow
     View subDst = bgil::subimage_view(this->_dstView, procWindowRoW.x1 - this->_renderArgs.renderWindow.x1,
@@ -275,7 +304,10 @@ void NLMDenoiserProcess<View>::nlMeans(View& dst, const OfxRectI& procWindow, co
     nProcWindow.x2 = nProcWindow.x1 + w;
     nProcWindow.y2 = nProcWindow.y1 + h;
 
-    computeWeights(subSrcViews, nProcWindow, view_wc, view_norm, params);
+    if(params.engine == eParamEngineIntegral)
+        computeWeightsIntegral(subSrcViews, nProcWindow, view_wc, view_norm, params);
+    else
+        computeWeights(subSrcViews, nProcWindow, view_wc, view_norm, params);
 
     if(!_plugin.abort())
     {
@@ -307,6 +339,32 @@ void NLMDenoiserProcess<View>::nlMeans(View& dst, const OfxRectI& procWindow, co
     }
 }
 
+/**
+ * @brief Bandwidths of the weighting function for each channel, from the noise of @p src.
+ * @param[out] h1  maximal patch distance of each channel ([Kervrann] notations)
+ * @param[out] h2  1 / h1^2
+ */
+template <class View>
+void NLMDenoiserProcess<View>::computeBandwidths(const View& src, const NlmParams& params, std::vector<double>& h1,
+                                                 std::vector<double>& h2)
+{
+    // Noise variance estimation
+    const double nv = imageUtils::noise_variance(src);
+    const double sigma = std::sqrt(nv < 0 ? 0 : nv);
+
+    static const int nc = boost::mpl::min<boost::mpl::int_<3>, typename bgil::num_channels<Pixel>::type>::type::value;
+    h1.resize(nc);
+    h2.resize(nc);
+    for(int i = 0; i < nc; ++i)
+    {
+        double bw = params.bws[i];
+        if(bw < 0)
+            bw = (float)computeBandwidth();
+        h1[i] = bw * sigma;
+        h2[i] = 1.0 / (h1[i] * h1[i]);
+    }
+}
+
 template <class View>
 void NLMDenoiserProcess<View>::computeWeights(const std::vector<View>& srcViews, const OfxRectI& procWindow,
                                               bgil::rgba32f_view_t& view_wc, bgil::rgba32f_view_t& view_norm,
@@ -324,9 +382,6 @@ void NLMDenoiserProcess<View>::computeWeights(const std::vector<View>& srcViews,
     const int wi = srcViews[0].width();
     const int hi = srcViews[0].height();
 
-    // Noise variance estimation
-    const double nv = imageUtils::noise_variance(srcViews[0]);
-    const double sigma = std::sqrt(nv < 0 ? 0 : nv);
     Loc loc1, loc2;
     WLoc wcLoc, wnLoc;
 
@@ -336,23 +391,11 @@ void NLMDenoiserProcess<View>::computeWeights(const std::vector<View>& srcViews,
     const int min_ypi = std::min(params.regionRadius, hi / 2);
 
     static const int nc = boost::mpl::min<boost::mpl::int_<3>, typename bgil::num_channels<Pixel>::type>::type::value;
-    boost::array<float, nc> bws;
-    for(std::size_t i = 0; i < bws.size(); ++i)
-    {
-        bws[i] = params.bws[i];
-    }
     int lbound, hbound;
     // [Kervrann] notations
-    std::vector<double> h1(nc);
-    std::vector<double> h2(nc);
-
-    for(int i = 0; i < nc; ++i)
-    {
-        if(bws[i] < 0)
-            bws[i] = (float)computeBandwidth();
-        h1[i] = bws[i] * sigma;
-        h2[i] = 1.0 / (h1[i] * h1[i]);
-    }
+    std::vector<double> h1;
+    std::vector<double> h2;
+    computeBandwidths(srcViews[0], params, h1, h2);
 
     double abs_e, eucl_dist, weigth, e;
 
@@ -379,25 +422,12 @@ void NLMDenoiserProcess<View>::computeWeights(const std::vector<View>& srcViews,
                         // Initialize patch euclidian distance
                         eucl_dist = 0.0f;
                         int j = yj + yi;
-                        // Horizontal & vertical averaging bounds
-                        if(yi >= 0)
-                        {
-                            lbound = -patchRadius + yj < 0 ? std::max(-yj, -patchRadius) : -patchRadius;
-                            hbound = lbound + (patchRadius * 2 + 1);
-                            if(hbound + j > hi)
-                                hbound = std::min(hi - j, patchRadius);
-                        }
-                        else
-                        {
-                            hbound = patchRadius + yj > hi ? std::min(patchRadius, (hi - yj)) : patchRadius;
-                            lbound = hbound - (patchRadius * 2 + 1);
-                            if(lbound + j < 0)
-                                lbound = 0;
-                        }
+                        // Vertical averaging bounds
+                        patchRowBounds(yi, yj, hi, patchRadius, lbound, hbound);
 
-                        // Warmup: initial average accumulation
+                        // Warmup: initial average accumulation, the columns before the first one added by the sliding
                         int xl_bound = std::max(xl - patchRadius, 0);
-                        int xr_bound = std::min(wi, xl_bound + patchRadius * 2);
+                        int xr_bound = std::min(wi, xl + patchRadius);
                         loc1 = srcViews[zi].xy_at(xi, j);
                         loc2 = srcViews[0].xy_at(0, yj);
                         for(int xj = xl_bound; xj < xr_bound; ++xj)
@@ -498,6 +528,220 @@ void NLMDenoiserProcess<View>::computeWeights(const std::vector<View>& srcViews,
         }     // End for yi (displacment)
     }         // End for zi (displacment)
 }
+
+/**
+ * @brief Same weights as computeWeights, but computed one offset at a time for the whole window.
+ *
+ * For each offset, the squared differences between the pixels and their neighbours are summed into an integral image,
+ * so a patch distance costs 4 reads whatever the patch radius. The channels and the accumulators are stored plane by
+ * plane, so the loops along the rows can be vectorized.
+ */
+template <class View>
+void NLMDenoiserProcess<View>::computeWeightsIntegral(const std::vector<View>& srcViews, const OfxRectI& procWindow,
+                                                      bgil::rgba32f_view_t& view_wc, bgil::rgba32f_view_t& view_norm,
+                                                      const NlmParams& params)
+{
+    typedef typename View::x_iterator sIterator;
+    typedef typename bgil::rgba32f_view_t::x_iterator wIterator;
+    typedef std::vector<float, OfxAllocator<float> > FloatBuffer;
+    typedef std::vector<double, OfxAllocator<double> > DoubleBuffer;
+
+    const int patchRadius = params.patchRadius;
+    const int depth = srcViews.size();
+
+    const int wi = srcViews[0].width();
+    const int hi = srcViews[0].height();
+    const int wp = procWindow.x2 - procWindow.x1;
+    const int hp = procWindow.y2 - procWindow.y1;
+    const std::size_t srcSize = std::size_t(wi) * hi;
+    const std::size_t procSize = std::size_t(wp) * hp;
+
+    // Define the size of the neighborhood
+    const int min_xpi = std::min(params.regionRadius, wi / 2);
+    const int min_ypi = std::min(params.regionRadius, hi / 2);
+
+    static const int nc = boost::mpl::min<boost::mpl::int_<3>, typename bgil::num_channels<Pixel>::type>::type::value;
+    // [Kervrann] notations
+    std::vector<double> h1;
+    std::vector<double> h2;
+    computeBandwidths(srcViews[0], params, h1, h2);
+    boost::array<float, nc> h1f;
+    boost::array<float, nc> h2f;
+    for(int v = 0; v < nc; ++v)
+    {
+        h1f[v] = (float)h1[v];
+        h2f[v] = (float)h2[v];
+    }
+
+    // Source channels: planes[(zi * nc + v) * srcSize + y * wi + x]
+    FloatBuffer planes(depth * nc * srcSize);
+    for(int zi = 0; zi < depth; ++zi)
+    {
+        for(int y = 0; y < hi; ++y)
+        {
+            sIterator sIt = srcViews[zi].row_begin(y);
+            for(int x = 0; x < wi; ++x, ++sIt)
+            {
+                for(int v = 0; v < nc; ++v)
+                    planes[(zi * nc + v) * srcSize + y * wi + x] = (*sIt)[v];
+            }
+        }
+    }
+
+    // Accumulators of the processing window: wc[v * procSize + y * wp + x]
+    FloatBuffer wc(nc * procSize, 0.0f);
+    FloatBuffer wn(nc * procSize, 0.0f);
+
+    // Integral image of the squared differences, with a first row and a first column of zeros
+    const int wInt = wi + 1;
+    DoubleBuffer integral(std::size_t(wInt) * (hi + 1), 0.0);
+    DoubleBuffer sqDiff(wi);
+    FloatBuffer dist(wi);
+    FloatBuffer weights(nc * wi);
+
+    const float* const ref = &planes[0];
+
+    // For zi (displacment)
+    for(int zi = 0; zi < depth; ++zi)
+    {
+        const float* const cmp = &planes[zi * nc * srcSize];
+        // For yi (displacment)
+        for(int yi = -min_ypi; yi <= min_ypi; ++yi)
+        {
+            // For xi (displacment)
+            for(int xi = -min_xpi; xi <= min_xpi; ++xi)
+            {
+                // If not 0 displacment
+                if(xi != 0 || yi != 0)
+                {
+                    const int xl = xi < 0 ? std::abs(xi) : 0;
+                    const int xh = wi + xi > wi ? wi - xi : wi;
+                    const int yl = yi < 0 ? std::abs(yi) : 0;
+                    const int yh = hi + yi > hi ? hi - yi : hi;
+
+                    // Integral image on [xl, xh) x [yl, yh)
+                    std::fill(integral.begin() + yl * wInt + xl, integral.begin() + yl * wInt + xh + 1, 0.0);
+                    for(int y = yl; y < yh; ++y)
+                    {
+                        std::fill(sqDiff.begin() + xl, sqDiff.begin() + xh, 0.0);
+                        for(int v = 0; v < nc; ++v)
+                        {
+                            const float* const r = ref + v * srcSize + y * wi;
+                            const float* const c = cmp + v * srcSize + (y + yi) * wi + xi;
+                            for(int x = xl; x < xh; ++x)
+                            {
+                                const double e = c[x] - r[x];
+                                sqDiff[x] += e * e;
+                            }
+                        }
+                        const double* const prevRow = &integral[y * wInt + 1];
+                        double* const row = &integral[(y + 1) * wInt + 1];
+                        integral[(y + 1) * wInt + xl] = 0.0;
+                        double rowSum = 0.0;
+                        for(int x = xl; x < xh; ++x)
+                        {
+                            rowSum += sqDiff[x];
+                            row[x] = prevRow[x] + rowSum;
+                        }
+                    }
+
+                    // For yj
+                    for(int yj = yl; yj < yh; ++yj)
+                    {
+                        const int j = yj + yi;
+                        // Weigthening will be computed
+                        const bool w2Pass = (yj >= procWindow.y1 && yj < procWindow.y2);
+                        // Symetric weigthening will be computed
+                        const bool w1Pass = (zi == 0 && j >= procWindow.y1 && j < procWindow.y2);
+                        if(!w1Pass && !w2Pass)
+                            continue;
+
+                        // Columns of the pixels (w2Pass) and of the pixels with a neighbour (w1Pass) in the window
+                        const int x2Begin = std::max(xl, procWindow.x1);
+                        const int x2End = std::min(xh, procWindow.x2);
+                        const int x1Begin = std::max(xl, procWindow.x1 - xi);
+                        const int x1End = std::min(xh, procWindow.x2 - xi);
+                        const int xBegin = w2Pass ? (w1Pass ? std::min(x1Begin, x2Begin) : x2Begin) : x1Begin;
+                        const int xEnd = w2Pass ? (w1Pass ? std::max(x1End, x2End) : x2End) : x1End;
+
+                        // Patch distances from the integral image
+                        int lbound, hbound;
+                        patchRowBounds(yi, yj, hi, patchRadius, lbound, hbound);
+                        const int y1 = std::max(yj + lbound, yl);
+                        const int y2 = std::max(y1, std::min(yj + hbound, yh));
+                        const double* const top = &integral[y1 * wInt];
+                        const double* const bottom = &integral[y2 * wInt];
+                        for(int xj = xBegin; xj < xEnd; ++xj)
+                        {
+                            const int x1 = std::max(xj - patchRadius, xl);
+                            const int x2 = std::min(xj + patchRadius + 1, xh);
+                            dist[xj] = (float)std::abs(bottom[x2] - bottom[x1] - top[x2] + top[x1]);
+                        }
+
+                        for(int v = 0; v < nc; ++v)
+                        {
+                            // Weight computation (Modified Bisquare weightening function)
+                            float* const w = &weights[v * wi];
+                            for(int xj = xBegin; xj < xEnd; ++xj)
+                            {
+                                const float d = dist[xj];
+                                float weigth = 1.0f - d * d * h2f[v];
+                                // Powerize to 8
+                                weigth *= weigth;
+                                weigth *= weigth;
+                                weigth *= weigth;
+                                w[xj] = d <= h1f[v] ? weigth : 0.0f;
+                            }
+
+                            // Weight accumulation
+                            if(w1Pass)
+                            {
+                                const float* const pixels = ref + v * srcSize + yj * wi;
+                                float* const wcRow = &wc[v * procSize + (j - procWindow.y1) * wp];
+                                float* const wnRow = &wn[v * procSize + (j - procWindow.y1) * wp];
+                                const int offset = xi - procWindow.x1;
+                                for(int xj = x1Begin; xj < x1End; ++xj)
+                                {
+                                    wcRow[xj + offset] += w[xj] * pixels[xj];
+                                    wnRow[xj + offset] += w[xj];
+                                }
+                            }
+                            if(w2Pass)
+                            {
+                                // Symmetry
+                                const float* const neighbours = cmp + v * srcSize + j * wi + xi;
+                                float* const wcRow = &wc[v * procSize + (yj - procWindow.y1) * wp];
+                                float* const wnRow = &wn[v * procSize + (yj - procWindow.y1) * wp];
+                                const int offset = -procWindow.x1;
+                                for(int xj = x2Begin; xj < x2End; ++xj)
+                                {
+                                    wcRow[xj + offset] += w[xj] * neighbours[xj];
+                                    wnRow[xj + offset] += w[xj];
+                                }
+                            }
+                        }
+                    } // End for yj
+                }     // End if not 0 displacment
+                if(this->progressForward(1))
+                    return;
+            } // End for xi (displacment)
+        }     // End for yi (displacment)
+    }         // End for zi (displacment)
+
+    for(int y = 0; y < hp; ++y)
+    {
+        wIterator wcIt = view_wc.row_begin(y);
+        wIterator wnIt = view_norm.row_begin(y);
+        for(int x = 0; x < wp; ++x, ++wcIt, ++wnIt)
+        {
+            for(int v = 0; v < nc; ++v)
+            {
+                (*wcIt)[v] = wc[v * procSize + y * wp + x];
+                (*wnIt)[v] = wn[v * procSize + y * wp + x];
+            }
+        }
+    }
+}
 }
 }
 }
@@ -33,6 +33,8 @@ SobelProcess<SView, DView>::SobelProcess(SobelPlugin& effect)
 {
     using namespace terry::numeric;
     pixel_zeros_t<DPixel>()(_pixelZero);
+    // the separable convolution has a margin overhead for each processed window
+    this->setScheduling(ImageProcessor::eSchedulingStatic);
 }
 
 template <class SView, class DView>
@@ -46,6 +46,8 @@ LensDistortPlugin::LensDistortPlugin(OfxImageEffectHandle handle)
     _postOffset = fetchDouble2DParam(kParamPostOffset);
     _resizeRod = fetchChoiceParam(kParamResizeRod);
     _resizeRodManualScale = fetchDoubleParam(kParamResizeRodManualScale);
+    _stmapMode = fetchChoiceParam(kParamSTMap);
+    _stmapFile = fetchStringParam(kParamSTMapFile);
     _groupDisplayParams = fetchGroupParam(kParamDisplayOptions);
     _gridOverlay = fetchBooleanParam(kParamGridOverlay);
     _gridCenter = fetchDouble2DParam(kParamGridCenter);
@@ -64,6 +66,7 @@ void LensDistortPlugin::initParamsProps()
     changedParam(args, kParamLensType);
     changedParam(args, kParamResizeRod);
     changedParam(args, kParamNormalization);
+    changedParam(args, kParamSTMap);
 }
 
 /**
@@ -140,6 +143,10 @@ void LensDistortPlugin::changedParam(const OFX::InstanceChangedArgs& args, const
             _resizeRodManualScale->setEnabled(false);
         }
     }
+    else if(paramName == kParamSTMap)
+    {
+        _stmapFile->setIsSecretAndDisabled(getSTMapMode() == eParamSTMapModel);
+    }
     else if(paramName == kParamGridOverlay || paramName == kParamGridCenter || paramName == kParamGridScale)
     {
         redrawOverlays();
@@ -154,7 +161,7 @@ bool LensDistortPlugin::isIdentity(const OFX::RenderArguments& args, OFX::Clip*&
     {
         isIdentity = true;
     }
-    else if(_coef1->getValue() == 0 && _preScale->getValue() == _preScale->getDefault() &&
+    else if(getSTMapMode() == eParamSTMapModel && _coef1->getValue() == 0 && _preScale->getValue() == _preScale->getDefault() &&
             _postScale->getValue() == _postScale->getDefault() && _preOffset->getValue() == _preOffset->getDefault() &&
             _postOffset->getValue() == _postOffset->getDefault() && (!_coef2->getIsEnable() || _coef2->getValue() == 0) &&
             (!_coef3->getIsEnable() || _coef3->getValue() == 0) &&
@@ -268,6 +275,13 @@ bool LensDistortPlugin::getRegionOfDefinition(const OFX::RegionOfDefinitionArgum
 
 void LensDistortPlugin::getRegionsOfInterest(const OFX::RegionsOfInterestArguments& args, OFX::RegionOfInterestSetter& rois)
 {
+    if(getSTMapMode() == eParamSTMapRead)
+    {
+        // the ST-map of the file may use any pixel of the source
+        rois.setRegionOfInterest(*_clipSrc, _clipSrc->getCanonicalRod(args.time));
+        return;
+    }
+
     OfxRectD srcRod = _clipSrc->getCanonicalRod(args.time);
     OfxRectD dstRod = _clipDst->getCanonicalRod(args.time);
 
@@ -477,9 +491,43 @@ LensDistortParams LensDistortPlugin::getProcessParams() const
 
     lensDistortParams._lensType = (tuttle::plugin::lens::EParamLensType)_lensType->getValue();
     lensDistortParams._centerType = (tuttle::plugin::lens::EParamCenterType)_centerType->getValue();
+    lensDistortParams._stmapMode = getSTMapMode();
+    lensDistortParams._stmapFilename = _stmapFile->getValue();
 
     return lensDistortParams;
 }
+
+boost::shared_ptr<const STMap> LensDistortPlugin::findSTMap(const std::size_t hash)
+{
+    boost::mutex::scoped_lock lock(_stmapsMutex);
+    for(std::list<boost::shared_ptr<const STMap> >::iterator it = _stmaps.begin(), itEnd = _stmaps.end(); it != itEnd; ++it)
+    {
+        if((*it)->getHash() == hash)
+        {
+            _stmaps.splice(_stmaps.begin(), _stmaps, it);
+            return _stmaps.front();
+        }
+    }
+    return boost::shared_ptr<const STMap>();
+}
+
+void LensDistortPlugin::addSTMap(const boost::shared_ptr<const STMap>& stmap)
+{
+    // the ST-maps of a distort and an undistort, or of 2 formats
+    static const std::size_t kMaxNbSTMaps = 2;
+
+    boost::mutex::scoped_lock lock(_stmapsMutex);
+    for(std::list<boost::shared_ptr<const STMap> >::iterator it = _stmaps.begin(); it != _stmaps.end();)
+    {
+        if((*it)->getHash() == stmap->getHash())
+            it = _stmaps.erase(it); // also built by a concurrent render
+        else
+            ++it;
+    }
+    _stmaps.push_front(stmap);
+    if(_stmaps.size() > kMaxNbSTMaps)
+        _stmaps.pop_back();
+}
 }
 }
 }
@@ -3,11 +3,16 @@
 
 #include "lensDistortDefinitions.hpp"
 #include "lensDistortProcessParams.hpp"
+#include "STMap.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 #include <tuttle/plugin/context/SamplerPlugin.hpp>
 
 #include <boost/gil/utilities.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <list>
 #include <string>
 
 namespace tuttle
@@ -22,6 +27,9 @@ struct LensDistortParams
     EParamLensType _lensType;
     EParamCenterType _centerType;
 
+    EParamSTMap _stmapMode;
+    std::string _stmapFilename;
+
     SamplerProcessParams _samplerProcessParams;
 };
 
@@ -62,6 +70,9 @@ public:
     OFX::ChoiceParam* _resizeRod;            ///< Choice how to resize the RoD (default 'no' resize)
     OFX::DoubleParam* _resizeRodManualScale; ///< scale the output RoD
 
+    OFX::ChoiceParam* _stmapMode; ///< compute the ST-map from the lens model, and write it, or read it from a file
+    OFX::StringParam* _stmapFile;
+
     OFX::GroupParam* _groupDisplayParams;  ///< group of all overlay options (don't modify the output image)
     OFX::BooleanParam* _gridOverlay;       ///< grid overlay
     OFX::Double2DParam* _gridCenter;       ///< grid center
@@ -109,9 +120,22 @@ public:
     const EParamLensType getLensType() const { return static_cast<EParamLensType>(_lensType->getValue()); }
     const EParamCenterType getCenterType() const { return static_cast<EParamCenterType>(_centerType->getValue()); }
     const EParamResizeRod getResizeRod() const { return static_cast<EParamResizeRod>(_resizeRod->getValue()); }
+    const EParamSTMap getSTMapMode() const { return static_cast<EParamSTMap>(_stmapMode->getValue()); }
+
+    /**
+     * @brief ST-maps of the last renders, so the lens model is only computed again
+     * when the parameters or the image sizes change (usually once per shot).
+     * @return the ST-map of @p hash or NULL
+     */
+    boost::shared_ptr<const STMap> findSTMap(const std::size_t hash);
+    void addSTMap(const boost::shared_ptr<const STMap>& stmap);
 
 private:
     void initParamsProps();
+
+private:
+    boost::mutex _stmapsMutex;
+    std::list<boost::shared_ptr<const STMap> > _stmaps; ///< most recently used first
 };
 }
 }
@@ -250,6 +250,22 @@ void LensDistortPluginFactory::describeInContext(OFX::ImageEffectDescriptor& des
     scaleRod->setDisplayRange(0, 2.5);
     scaleRod->setHint("Adjust the output RoD.");
 
+    OFX::ChoiceParamDescriptor* stmap = desc.defineChoiceParam(kParamSTMap);
+    stmap->setLabel("ST-map");
+    stmap->appendOption(kParamSTMapModel, "Model: compute the transformation from the lens parameters");
+    stmap->appendOption(kParamSTMapWrite, "Write: compute the transformation and write its ST-map into the file");
+    stmap->appendOption(kParamSTMapRead, "Read: use the ST-map of the file instead of the lens parameters");
+    stmap->setDefault(eParamSTMapModel);
+    stmap->setHint("The transformation is baked into an ST-map, computed once while the lens parameters and the image "
+                   "sizes don't change. The ST-map can be written into an EXR file to be reused (R and G channels "
+                   "contain the normalized position in the source image).");
+
+    OFX::StringParamDescriptor* stmapFile = desc.defineStringParam(kParamSTMapFile);
+    stmapFile->setLabel("ST-map file");
+    stmapFile->setStringType(OFX::eStringTypeFilePath);
+    stmapFile->setDefault("");
+    stmapFile->setHint("EXR file of the ST-map.");
+
     OFX::GroupParamDescriptor* displayOptions = desc.defineGroupParam(kParamDisplayOptions);
     displayOptions->setLabel("Display options");
     displayOptions->setHint("Display options (change nothing on the image)");
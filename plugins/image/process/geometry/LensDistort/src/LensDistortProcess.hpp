@@ -13,6 +13,7 @@
 #include <ofxsMultiThread.h>
 #include <boost/gil/gil_all.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace tuttle
 {
@@ -37,10 +38,14 @@ protected:
 
     LensDistortParams _params;
 
+    boost::shared_ptr<const STMap> _stmap; ///< transformation baked for each output pixel, shared between the renders
+    boost::shared_ptr<STMap> _stmapToBuild; ///< not in the cache, filled by this render
+
 public:
     LensDistortProcess(LensDistortPlugin& instance);
 
     void setup(const OFX::RenderArguments& args);
+    void postProcess();
 
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
 
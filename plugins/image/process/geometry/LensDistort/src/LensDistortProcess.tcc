@@ -6,6 +6,9 @@
 
 #include <terry/sampler/resample_progress.hpp>
 
+#include <boost/filesystem/operations.hpp>
+#include <boost/functional/hash.hpp>
+
 namespace tuttle
 {
 namespace plugin
@@ -18,6 +21,8 @@ LensDistortProcess<View>::LensDistortProcess(LensDistortPlugin& instance)
     : ImageGilFilterProcessor<View>(instance, eImageOrientationIndependant)
     , _plugin(instance)
 {
+    // the cost of a row depends on the distortion, use small chunks to balance the load
+    this->setChunkSize(8);
 }
 
 template <class View>
@@ -38,6 +43,67 @@ void LensDistortProcess<View>::setup(const OFX::RenderArguments& args)
     {
         _p = _plugin.getProcessParams(srcRod, dstRod, this->_clipDst->getPixelAspectRatio());
     }
+
+    const STMap::Point2 srcSize(this->_srcView.width(), this->_srcView.height());
+    if(_params._stmapMode == eParamSTMapRead)
+    {
+        if(!boost::filesystem::exists(_params._stmapFilename))
+        {
+            BOOST_THROW_EXCEPTION(exception::FileNotExist() << exception::user("The ST-map file doesn't exist.")
+                                                            << exception::filename(_params._stmapFilename));
+        }
+        std::size_t hash = boost::hash_value(_params._stmapFilename);
+        boost::hash_combine(hash, static_cast<long>(boost::filesystem::last_write_time(_params._stmapFilename)));
+        boost::hash_combine(hash, srcSize.x);
+        boost::hash_combine(hash, srcSize.y);
+        _stmap = _plugin.findSTMap(hash);
+        if(!_stmap)
+        {
+            _stmap = readSTMap(_params._stmapFilename, srcSize, hash);
+            _plugin.addSTMap(_stmap);
+        }
+        if(_stmap->getWidth() != std::size_t(this->_dstPixelRodSize.x) ||
+           _stmap->getHeight() != std::size_t(this->_dstPixelRodSize.y))
+        {
+            BOOST_THROW_EXCEPTION(exception::ImageFormat()
+                                  << exception::user() + "The ST-map size (" + _stmap->getWidth() + "x" +
+                                         _stmap->getHeight() + ") doesn't match the output size (" +
+                                         this->_dstPixelRodSize.x + "x" + this->_dstPixelRodSize.y + ")."
+                                  << exception::filename(_params._stmapFilename));
+        }
+        return;
+    }
+
+    std::size_t hash = hash_value(_p);
+    boost::hash_combine(hash, static_cast<int>(_params._lensType));
+    boost::hash_combine(hash, this->_dstPixelRodSize.x);
+    boost::hash_combine(hash, this->_dstPixelRodSize.y);
+    _stmap = _plugin.findSTMap(hash);
+
+    const OfxRectI& renderWindow = this->_renderArgs.renderWindow;
+    if(!_stmap && renderWindow.x1 == this->_dstPixelRod.x1 && renderWindow.y1 == this->_dstPixelRod.y1 &&
+       renderWindow.x2 == this->_dstPixelRod.x2 && renderWindow.y2 == this->_dstPixelRod.y2)
+    {
+        // each thread bakes the rows it renders
+        _stmapToBuild.reset(new STMap(this->_dstPixelRodSize.x, this->_dstPixelRodSize.y, hash));
+        _stmap = _stmapToBuild;
+    }
+}
+
+template <class View>
+void LensDistortProcess<View>::postProcess()
+{
+    ImageGilFilterProcessor<View>::postProcess();
+
+    if(!_stmap || _plugin.abort())
+        return;
+    if(_stmapToBuild)
+        _plugin.addSTMap(_stmapToBuild);
+    if(_params._stmapMode == eParamSTMapWrite &&
+       (_stmapToBuild || !boost::filesystem::exists(_params._stmapFilename)))
+    {
+        writeSTMap(_params._stmapFilename, *_stmap, STMap::Point2(this->_srcView.width(), this->_srcView.height()));
+    }
 }
 
 /**
@@ -51,6 +117,11 @@ void LensDistortProcess<View>::multiThreadProcessImages(const OfxRectI& procWind
     using namespace terry::sampler;
     OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates(procWindowRoW);
 
+    if(_stmapToBuild)
+    {
+        fillSTMap(_params._lensType, _p, *_stmapToBuild, procWindowOutput.y1, procWindowOutput.y2);
+    }
+
     switch(_params._samplerProcessParams._filter)
     {
         case eParamFilterNearest:
@@ -149,6 +220,11 @@ void LensDistortProcess<View>::lensDistort(View& srcView, View& dstView, const O
     using namespace terry::sampler;
     EParamFilterOutOfImage outOfImageProcess = _params._samplerProcessParams._outOfImageProcess;
     terry::Rect<std::ssize_t> procWin = ofxToGil(procWindow);
+    if(_stmap)
+    {
+        resample_pixels_progress(srcView, dstView, *_stmap, procWin, outOfImageProcess, this->getOfxProgress(), sampler);
+        return;
+    }
     switch(_params._lensType)
     {
         case eParamLensTypeBrown1:
@@ -0,0 +1,128 @@
+#include "STMap.hpp"
+
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <ImfChannelList.h>
+#include <ImfFrameBuffer.h>
+#include <ImfHeader.h>
+#include <ImfInputFile.h>
+#include <ImfOutputFile.h>
+#include <ImathBox.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <exception>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace lens
+{
+
+namespace
+{
+
+/// @brief Insert the R and G channels of an interleaved buffer (one row after the other, from the top) into the frame buffer.
+void insertSTChannels(Imf::FrameBuffer& frameBuffer, float* buffer, const std::size_t width)
+{
+    const std::size_t xStride = 2 * sizeof(float);
+    const std::size_t yStride = width * xStride;
+    frameBuffer.insert("R", Imf::Slice(Imf::FLOAT, reinterpret_cast<char*>(buffer), xStride, yStride));
+    frameBuffer.insert("G", Imf::Slice(Imf::FLOAT, reinterpret_cast<char*>(buffer + 1), xStride, yStride));
+}
+}
+
+void writeSTMap(const std::string& filename, const STMap& stmap, const STMap::Point2& srcSize)
+{
+    const std::size_t width = stmap.getWidth();
+    const std::size_t height = stmap.getHeight();
+
+    // EXR files are from top to bottom
+    std::vector<float> buffer(width * height * 2);
+    std::vector<float>::iterator it = buffer.begin();
+    for(std::size_t y = height; y-- > 0;)
+    {
+        const STMap::Point2f* pos = stmap.rowBegin(y);
+        for(std::size_t x = 0; x < width; ++x, ++pos)
+        {
+            *it++ = (pos->x + 0.5) / srcSize.x;
+            *it++ = (pos->y + 0.5) / srcSize.y;
+        }
+    }
+
+    try
+    {
+        const boost::filesystem::path dir = boost::filesystem::path(filename).parent_path();
+        if(!dir.empty())
+            boost::filesystem::create_directories(dir);
+
+        Imf::Header header(width, height);
+        header.channels().insert("R", Imf::Channel(Imf::FLOAT));
+        header.channels().insert("G", Imf::Channel(Imf::FLOAT));
+
+        Imf::FrameBuffer frameBuffer;
+        insertSTChannels(frameBuffer, &buffer.front(), width);
+
+        Imf::OutputFile file(filename.c_str(), header);
+        file.setFrameBuffer(frameBuffer);
+        file.writePixels(height);
+    }
+    catch(const std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(exception::File() << exception::user() + "Unable to write the ST-map: " + e.what()
+                                                << exception::filename(filename));
+    }
+}
+
+boost::shared_ptr<STMap> readSTMap(const std::string& filename, const STMap::Point2& srcSize, const std::size_t hash)
+{
+    std::vector<float> buffer;
+    std::size_t width = 0;
+    std::size_t height = 0;
+    try
+    {
+        Imf::InputFile file(filename.c_str());
+        const Imath::Box2i& dataWindow = file.header().dataWindow();
+        width = dataWindow.max.x - dataWindow.min.x + 1;
+        height = dataWindow.max.y - dataWindow.min.y + 1;
+        if(!file.header().channels().findChannel("R") || !file.header().channels().findChannel("G"))
+        {
+            BOOST_THROW_EXCEPTION(exception::File() << exception::user("The ST-map needs R and G channels.")
+                                                    << exception::filename(filename));
+        }
+
+        buffer.resize(width * height * 2);
+        Imf::FrameBuffer frameBuffer;
+        // the slices are addressed with the data window coordinates
+        insertSTChannels(frameBuffer, &buffer.front() - (dataWindow.min.y * width + dataWindow.min.x) * 2, width);
+        file.setFrameBuffer(frameBuffer);
+        file.readPixels(dataWindow.min.y, dataWindow.max.y);
+    }
+    catch(const exception::Common&)
+    {
+        throw;
+    }
+    catch(const std::exception& e)
+    {
+        BOOST_THROW_EXCEPTION(exception::File() << exception::user() + "Unable to read the ST-map: " + e.what()
+                                                << exception::filename(filename));
+    }
+
+    boost::shared_ptr<STMap> stmap(new STMap(width, height, hash));
+    std::vector<float>::const_iterator it = buffer.begin();
+    for(std::size_t y = height; y-- > 0;)
+    {
+        STMap::Point2f* pos = stmap->rowBegin(y);
+        for(std::size_t x = 0; x < width; ++x, ++pos)
+        {
+            pos->x = *it++ * srcSize.x - 0.5;
+            pos->y = *it++ * srcSize.y - 0.5;
+        }
+    }
+    return stmap;
+}
+}
+}
+}
@@ -0,0 +1,85 @@
+#ifndef _TUTTLE_PLUGIN_LENSDISTORT_STMAP_HPP_
+#define _TUTTLE_PLUGIN_LENSDISTORT_STMAP_HPP_
+
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
+
+#include <boost/gil/utilities.hpp>
+#include <boost/assert.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <vector>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace lens
+{
+
+/**
+ * @brief Lens transformation baked for each pixel of the output image: the position to sample in the source image.
+ *
+ * The positions are in pixels, relative to the source pixel RoD (as for the lens distortion functors).
+ */
+class STMap
+{
+public:
+    typedef boost::gil::point2<float> Point2f;
+    typedef boost::gil::point2<double> Point2;
+
+public:
+    STMap(const std::size_t width, const std::size_t height, const std::size_t hash)
+        : _width(width)
+        , _height(height)
+        , _hash(hash)
+        , _positions(width * height)
+    {
+    }
+
+    std::size_t getWidth() const { return _width; }
+    std::size_t getHeight() const { return _height; }
+
+    /// @brief Hash of everything the transformation depends on (lens parameters and image sizes, or file).
+    std::size_t getHash() const { return _hash; }
+
+    Point2f* rowBegin(const std::size_t y) { return &_positions[y * _width]; }
+    const Point2f* rowBegin(const std::size_t y) const { return &_positions[y * _width]; }
+
+    template <typename F2>
+    Point2 operator()(const boost::gil::point2<F2>& p) const
+    {
+        BOOST_ASSERT(p.x >= 0 && std::size_t(p.x) < _width && p.y >= 0 && std::size_t(p.y) < _height);
+        const Point2f& pos = _positions[std::size_t(p.y) * _width + std::size_t(p.x)];
+        return Point2(pos.x, pos.y);
+    }
+
+private:
+    const std::size_t _width;
+    const std::size_t _height;
+    const std::size_t _hash;
+    std::vector<Point2f, OfxAllocator<Point2f> > _positions; ///< row by row, from the bottom of the image
+};
+
+/**
+ * @brief Write the ST-map into an EXR file.
+ *
+ * The R and G channels contain the normalized position in the source image (0 on the left/bottom edge and 1 on the
+ * right/top edge, pixel centers at 0.5), as the ST-maps of the compositing applications.
+ *
+ * @param[in] srcSize size of the source image in pixels
+ */
+void writeSTMap(const std::string& filename, const STMap& stmap, const STMap::Point2& srcSize);
+
+/**
+ * @brief Read an ST-map written by writeSTMap (or by any application using the same convention).
+ *
+ * @param[in] srcSize size of the source image in pixels, to convert the normalized positions
+ * @param[in] hash hash of the new ST-map
+ */
+boost::shared_ptr<STMap> readSTMap(const std::string& filename, const STMap::Point2& srcSize, const std::size_t hash);
+}
+}
+}
+
+#endif
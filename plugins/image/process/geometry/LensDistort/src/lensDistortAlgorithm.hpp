@@ -2,6 +2,7 @@
 #define _LENSDISTORTALGORITHM_HPP_
 
 #include "lensDistortProcessParams.hpp"
+#include "STMap.hpp"
 
 #include <tuttle/plugin/numeric/rectOp.hpp>
 #include <tuttle/plugin/IProgress.hpp>
@@ -84,6 +85,12 @@ inline point2<F> transform(const ::tuttle::plugin::lens::LensUndistortFisheye4<F
 {
     return algo.apply(src);
 }
+
+template <typename F2>
+inline point2<double> transform(const ::tuttle::plugin::lens::STMap& stmap, const point2<F2>& src)
+{
+    return stmap(src);
+}
 }
 
 namespace tuttle
@@ -267,6 +274,73 @@ inline void transformValuesApply(const EParamLensType lensType, const LensDistor
         }
     }
 }
+
+/**
+ * @brief Bake the transformation of the rows [y1, y2[ of the output image into the ST-map.
+ */
+template <class DistortFunc>
+void fillSTMap(const DistortFunc& algo, STMap& stmap, const std::size_t y1, const std::size_t y2)
+{
+    typedef typename DistortFunc::Point2 Point2;
+    for(std::size_t y = y1; y < y2; ++y)
+    {
+        STMap::Point2f* pos = stmap.rowBegin(y);
+        for(std::size_t x = 0; x < stmap.getWidth(); ++x, ++pos)
+        {
+            const Point2 p = algo.apply(boost::gil::point2<std::ptrdiff_t>(x, y));
+            *pos = STMap::Point2f(p.x, p.y);
+        }
+    }
+}
+
+inline void fillSTMap(const EParamLensType lensType, const LensDistortProcessParams<double>& params, STMap& stmap,
+                      const std::size_t y1, const std::size_t y2)
+{
+    switch(lensType)
+    {
+        case eParamLensTypeBrown1:
+        {
+            if(params.distort)
+                fillSTMap(LensDistortBrown1<double>(params), stmap, y1, y2);
+            else
+                fillSTMap(LensUndistortBrown1<double>(params), stmap, y1, y2);
+            return;
+        }
+        case eParamLensTypeBrown3:
+        {
+            if(params.distort)
+                fillSTMap(LensDistortBrown3<double>(params), stmap, y1, y2);
+            else
+                fillSTMap(LensUndistortBrown3<double>(params), stmap, y1, y2);
+            return;
+        }
+        case eParamLensTypePTLens:
+        {
+            if(params.distort)
+                fillSTMap(LensDistortPTLens<double>(params), stmap, y1, y2);
+            else
+                fillSTMap(LensUndistortPTLens<double>(params), stmap, y1, y2);
+            return;
+        }
+        case eParamLensTypeFisheye:
+        {
+            if(params.distort)
+                fillSTMap(LensDistortFisheye<double>(params), stmap, y1, y2);
+            else
+                fillSTMap(LensUndistortFisheye<double>(params), stmap, y1, y2);
+            return;
+        }
+        case eParamLensTypeFisheye4:
+        {
+            if(params.distort)
+                fillSTMap(LensDistortFisheye4<double>(params), stmap, y1, y2);
+            else
+                fillSTMap(LensUndistortFisheye4<double>(params), stmap, y1, y2);
+            return;
+        }
+    }
+    BOOST_THROW_EXCEPTION(exception::Bug() << exception::user("Unrecognized lens type."));
+}
 }
 }
 }
@@ -90,6 +90,20 @@ enum EParamResizeRod
 };
 
 static const std::string kParamResizeRodManualScale("scaleRod");
+
+static const std::string kParamSTMap("stmap");
+static const std::string kParamSTMapModel("model");
+static const std::string kParamSTMapWrite("write");
+static const std::string kParamSTMapRead("read");
+enum EParamSTMap
+{
+    eParamSTMapModel = 0,
+    eParamSTMapWrite,
+    eParamSTMapRead
+};
+
+static const std::string kParamSTMapFile("stmapFile");
+
 static const std::string kParamDisplayOptions("displayOptions");
 static const std::string kParamGridOverlay("gridOverlay");
 static const std::string kParamGridCenter("gridCenter");
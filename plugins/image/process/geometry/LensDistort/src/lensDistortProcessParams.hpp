@@ -5,6 +5,7 @@
 #include <terry/globals.hpp>
 
 #include <boost/math/constants/constants.hpp>
+#include <boost/functional/hash.hpp>
 
 namespace tuttle
 {
@@ -103,6 +104,22 @@ struct LensDistortProcessParams
     /// @}
 };
 
+/**
+ * @brief Hash of all the values of the transformation, to identify its baked ST-map.
+ */
+template <typename F>
+std::size_t hash_value(const LensDistortProcessParams<F>& p)
+{
+    const F values[] = {p.imgSizeSrc.x,    p.imgSizeSrc.y,    p.imgCenterSrc.x,  p.imgCenterSrc.y,  p.imgCenterDst.x,
+                        p.imgCenterDst.y,  p.normalizeCoef,   p.pixelRatio,      p.lensCenterDst.x, p.lensCenterDst.y,
+                        p.lensCenterSrc.x, p.lensCenterSrc.y, p.postScale.x,     p.postScale.y,     p.preScale.x,
+                        p.preScale.y,      p.coef1,           p.coef2,           p.coef3,           p.coef4,
+                        p.squeeze,         p.asymmetric.x,    p.asymmetric.y};
+    std::size_t seed = boost::hash_range(values, values + sizeof(values) / sizeof(F));
+    boost::hash_combine(seed, p.distort);
+    return seed;
+}
+
 /**
  * @brief Contains functions to map coordinates between :
  *  * canonical coordinates system (ofx)
@@ -3,6 +3,10 @@
 
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 
+#include <terry/geometry/affine.hpp>
+#include <terry/math/Rect.hpp>
+#include <terry/sampler/sampler.hpp>
+
 namespace tuttle
 {
 namespace plugin
@@ -32,6 +36,12 @@ public:
     void setup(const OFX::RenderArguments& args);
 
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
+
+private:
+    /// @brief Resample with a windowed sampler, in two separable passes when possible.
+    template <class Sampler>
+    void resample(const terry::matrix3x2<double>& mat, const terry::Rect<std::ssize_t>& procWindow,
+                  const terry::sampler::EParamFilterOutOfImage outOfImageProcess, Sampler sampler = Sampler());
 };
 }
 }
@@ -1,5 +1,6 @@
 #include <tuttle/plugin/ofxToGil/rect.hpp>
 #include <terry/sampler/resample_progress.hpp>
+#include <terry/sampler/resample_separable.hpp>
 #include <terry/geometry/affine.hpp>
 
 namespace tuttle
@@ -79,72 +80,76 @@ void ResizeProcess<View>::multiThreadProcessImages(const OfxRectI& procWindow)
         case eParamFilterBC:
         {
             bc_sampler BCsampler(_params._samplerProcessParams._paramB, _params._samplerProcessParams._paramC);
-            resample_pixels_progress(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(),
-                                     BCsampler);
+            resample(mat, procWin, outOfImageProcess, BCsampler);
             break;
         }
         case eParamFilterBicubic:
-            resample_pixels_progress<bicubic_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                      this->getOfxProgress());
+            resample<bicubic_sampler>(mat, procWin, outOfImageProcess);
             break;
         case eParamFilterCatrom:
-            resample_pixels_progress<catrom_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                     this->getOfxProgress());
+            resample<catrom_sampler>(mat, procWin, outOfImageProcess);
             break;
         case eParamFilterKeys:
-            resample_pixels_progress<keys_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                   this->getOfxProgress());
+            resample<keys_sampler>(mat, procWin, outOfImageProcess);
             break;
         case eParamFilterSimon:
-            resample_pixels_progress<simon_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                    this->getOfxProgress());
+            resample<simon_sampler>(mat, procWin, outOfImageProcess);
             break;
         case eParamFilterRifman:
-            resample_pixels_progress<rifman_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                     this->getOfxProgress());
+            resample<rifman_sampler>(mat, procWin, outOfImageProcess);
             break;
         case eParamFilterMitchell:
-            resample_pixels_progress<mitchell_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                       this->getOfxProgress());
+            resample<mitchell_sampler>(mat, procWin, outOfImageProcess);
             break;
         case eParamFilterParzen:
-            resample_pixels_progress<parzen_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                     this->getOfxProgress());
+            resample<parzen_sampler>(mat, procWin, outOfImageProcess);
             break;
         case eParamFilterGaussian:
         {
             gaussian_sampler gaussianSampler(_params._samplerProcessParams._filterSize,
                                              _params._samplerProcessParams._filterSigma);
-            resample_pixels_progress(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(),
-                                     gaussianSampler);
+            resample(mat, procWin, outOfImageProcess, gaussianSampler);
             break;
         }
         case eParamFilterLanczos:
         {
             lanczos_sampler lanczosSampler(_params._samplerProcessParams._filterSize,
                                            _params._samplerProcessParams._filterSharpen);
-            resample_pixels_progress(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(),
-                                     lanczosSampler);
+            resample(mat, procWin, outOfImageProcess, lanczosSampler);
             break;
         }
         case eParamFilterLanczos3:
-            resample_pixels_progress<lanczos3_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                       this->getOfxProgress());
+            resample<lanczos3_sampler>(mat, procWin, outOfImageProcess);
             break;
         case eParamFilterLanczos4:
-            resample_pixels_progress<lanczos4_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                       this->getOfxProgress());
+            resample<lanczos4_sampler>(mat, procWin, outOfImageProcess);
             break;
         case eParamFilterLanczos6:
-            resample_pixels_progress<lanczos6_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                       this->getOfxProgress());
+            resample<lanczos6_sampler>(mat, procWin, outOfImageProcess);
             break;
         case eParamFilterLanczos12:
-            resample_pixels_progress<lanczos12_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                        this->getOfxProgress());
+            resample<lanczos12_sampler>(mat, procWin, outOfImageProcess);
             break;
     }
 }
+
+template <class View>
+template <class Sampler>
+void ResizeProcess<View>::resample(const terry::matrix3x2<double>& mat, const terry::Rect<std::ssize_t>& procWindow,
+                                   const terry::sampler::EParamFilterOutOfImage outOfImageProcess, Sampler sampler)
+{
+    using namespace terry::sampler;
+
+    if(is_separable(mat, outOfImageProcess))
+    {
+        // the weights are computed once by row and by column
+        resample_pixels_separable_progress(this->_srcView, this->_dstView, mat, procWindow, outOfImageProcess,
+                                           this->getOfxProgress(), sampler);
+        return;
+    }
+    resample_pixels_progress(this->_srcView, this->_dstView, mat, procWindow, outOfImageProcess, this->getOfxProgress(),
+                             sampler);
+}
 }
 }
 }
@@ -0,0 +1,168 @@
+#ifndef _TUTTLE_PLUGIN_TPS_DISPLACEMENTFIELD_HPP_
+#define _TUTTLE_PLUGIN_TPS_DISPLACEMENTFIELD_HPP_
+
+#include "tps.hpp"
+
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
+
+#include <boost/gil/gil_all.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace warp
+{
+
+/**
+ * @brief All the values a thin-plate spline depends on, to reuse its displacement field between frames.
+ */
+template <typename SCALAR>
+struct DisplacementFieldKey
+{
+    typedef SCALAR Scalar;
+    typedef boost::gil::point2<Scalar> Point2;
+
+    std::vector<Point2> _pIn;
+    std::vector<Point2> _pOut;
+    double _regularization;
+    bool _activateWarp;
+    std::size_t _width;
+    std::size_t _height;
+    double _transition;
+    std::size_t _gridStep; ///< distance in pixels between the nodes of the grid
+
+    bool operator==(const DisplacementFieldKey& other) const
+    {
+        return _pIn == other._pIn && _pOut == other._pOut && _regularization == other._regularization &&
+               _activateWarp == other._activateWarp && _width == other._width && _height == other._height &&
+               _transition == other._transition && _gridStep == other._gridStep;
+    }
+};
+
+/**
+ * @brief Thin-plate spline mapping sampled on a coarse grid.
+ *
+ * The spline is evaluated once on the nodes of the grid (every _gridStep pixels), the displacement of a pixel is
+ * interpolated with a Catmull-Rom bicubic between the 4x4 nodes around it. So a pixel costs a few multiplications
+ * instead of a loop over all the points of the curves.
+ * The pixels on the nodes get the exact spline (up to the float precision of the stored displacements), so a step of
+ * 1 gives the same mapping as TPS_Morpher. Between the nodes the error grows with the step and the curvature of the
+ * warp, the bicubic keeps it much lower than a bilinear interpolation on the same grid.
+ *
+ * The constructor only sets up the spline, the nodes are evaluated by computeNodeRows(), which can be called on
+ * separate ranges of rows from several threads.
+ */
+template <typename SCALAR, class Allocator = OfxAllocator<boost::gil::point2<float> > >
+class DisplacementField
+{
+public:
+    typedef SCALAR Scalar;
+    typedef boost::gil::point2<Scalar> Point2;
+    typedef boost::gil::point2<float> Displacement;
+    typedef DisplacementFieldKey<Scalar> Key;
+
+public:
+    explicit DisplacementField(const Key& key)
+        : _key(key)
+        , _invStep(1.0 / key._gridStep)
+        // one node before the first pixels and two after the last ones, so each pixel has 4x4 nodes around it
+        , _nbNodesX(key._width / key._gridStep + 4)
+        , _nbNodesY(key._height / key._gridStep + 4)
+        , _nodes(_nbNodesX * _nbNodesY)
+    {
+        _tps.setup(key._pIn, key._pOut, key._regularization, key._activateWarp, key._width, key._height,
+                   key._transition);
+    }
+
+    const Key& getKey() const { return _key; }
+
+    std::size_t getNbNodeRows() const { return _nbNodesY; }
+
+    /**
+     * @brief Evaluate the spline on the nodes of the rows [yBegin, yEnd[.
+     */
+    void computeNodeRows(const std::size_t yBegin, const std::size_t yEnd)
+    {
+        const Scalar step = _key._gridStep;
+        for(std::size_t y = yBegin; y < yEnd; ++y)
+        {
+            Displacement* d = &_nodes[y * _nbNodesX];
+            for(std::size_t x = 0; x < _nbNodesX; ++x, ++d)
+            {
+                const Point2 node((Scalar(x) - 1) * step, (Scalar(y) - 1) * step);
+                const Point2 pos = _tps(node);
+                *d = Displacement(pos.x - node.x, pos.y - node.y);
+            }
+        }
+    }
+
+    void computeNodes() { computeNodeRows(0, _nbNodesY); }
+
+    template <typename S2>
+    Point2 operator()(const boost::gil::point2<S2>& pt) const
+    {
+        Scalar wx[4];
+        Scalar wy[4];
+        const std::ptrdiff_t ix = cellWeights(pt.x * _invStep, _nbNodesX, wx);
+        const std::ptrdiff_t iy = cellWeights(pt.y * _invStep, _nbNodesY, wy);
+
+        Scalar dx = 0;
+        Scalar dy = 0;
+        const Displacement* row = &_nodes[iy * _nbNodesX + ix];
+        for(int j = 0; j < 4; ++j, row += _nbNodesX)
+        {
+            const Scalar rowX = wx[0] * row[0].x + wx[1] * row[1].x + wx[2] * row[2].x + wx[3] * row[3].x;
+            const Scalar rowY = wx[0] * row[0].y + wx[1] * row[1].y + wx[2] * row[2].y + wx[3] * row[3].y;
+            dx += wy[j] * rowX;
+            dy += wy[j] * rowY;
+        }
+        return Point2(pt.x + dx, pt.y + dy);
+    }
+
+private:
+    /**
+     * @brief Catmull-Rom weights of the 4 nodes around the position @p f (in nodes).
+     * Outside of the grid, the displacement of its border is used.
+     * @return index of the first of the 4 nodes
+     */
+    static std::ptrdiff_t cellWeights(const Scalar f, const std::size_t nbNodes, Scalar* w)
+    {
+        // the node of index i is at the position i - 1
+        const std::ptrdiff_t maxCell = std::ptrdiff_t(nbNodes) - 3;
+        std::ptrdiff_t i = std::ptrdiff_t(std::floor(f)) + 1;
+        Scalar t = f + 1 - i;
+        if(i < 1)
+        {
+            i = 1;
+            t = 0;
+        }
+        else if(i > maxCell)
+        {
+            i = maxCell;
+            t = 1;
+        }
+        w[0] = ((2 - t) * t - 1) * t * 0.5;
+        w[1] = ((3 * t - 5) * t * t + 2) * 0.5;
+        w[2] = ((4 - 3 * t) * t + 1) * t * 0.5;
+        w[3] = (t - 1) * t * t * 0.5;
+        return i - 1;
+    }
+
+private:
+    const Key _key;
+    const Scalar _invStep;
+    const std::size_t _nbNodesX;
+    const std::size_t _nbNodesY;
+    TPS_Morpher<Scalar> _tps;
+    std::vector<Displacement, Allocator> _nodes; ///< displacement at each node, row by row
+};
+}
+}
+}
+
+#endif
@@ -1,5 +1,3 @@
-#include "../WarpPlugin.hpp"
-#include "../WarpProcess.hpp"
 #include "../WarpDefinitions.hpp"
 #include "tps.hpp"
 
@@ -19,6 +17,7 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/math/special_functions/pow.hpp>
 #include <boost/foreach.hpp>
+#include <boost/format.hpp>
 
 #include <vector>
 #include <ostream>
@@ -2,6 +2,7 @@
 #define _TUTTLE_PLUGIN_WARP_ALGORITHM_HPP_
 
 #include "TPS/tps.hpp"
+#include "TPS/DisplacementField.hpp"
 
 #include <terry/channel.hpp>
 #include <terry/numeric/operations.hpp>
@@ -17,6 +18,13 @@ inline boost::gil::point2<F> transform(const tuttle::plugin::warp::TPS_Morpher<F
 {
     return op(src);
 }
+
+template <typename F, class A, typename F2>
+inline boost::gil::point2<F> transform(const tuttle::plugin::warp::DisplacementField<F, A>& op,
+                                       const boost::gil::point2<F2>& src)
+{
+    return op(src);
+}
 }
 }
 
@@ -46,6 +46,7 @@ static const std::string kParamSetKey = "setKey";
 static const std::string kParamGroupSettings = "settings";
 static const std::string kParamNbPointsBezier = "Points Bezier";
 static const std::string kParamRigiditeTPS = "Rigidite TPS";
+static const std::string kParamGridStep = "gridStep";
 
 static const std::string kParamGroupIn = "groupIn";
 static const std::string kParamPointIn = "pIn";
@@ -20,6 +20,7 @@
 
 #include <boost/assign/list_of.hpp>
 
+#include <algorithm>
 #include <cstddef>
 
 namespace tuttle
@@ -48,6 +49,7 @@ WarpPlugin::WarpPlugin(OfxImageEffectHandle handle)
 
     _paramRigiditeTPS = fetchDoubleParam(kParamRigiditeTPS);
     _paramNbPointsBezier = fetchIntParam(kParamNbPointsBezier);
+    _paramGridStep = fetchIntParam(kParamGridStep);
 
     // Multi curve
     for(std::size_t cptCBegin = 0; cptCBegin < kMaxNbPoints; ++cptCBegin)
@@ -113,8 +115,10 @@ WarpProcessParams<WarpPlugin::Scalar> WarpPlugin::getProcessParams(const OfxPoin
     const std::size_t nbPoints = _paramNbPoints->getValue();
     params._nbPoints = nbPoints;
 
+    params._activateWarp = true;
     params._rigiditeTPS = _paramRigiditeTPS->getValue();
     params._transition = _transition->getValue();
+    params._gridStep = std::max(_paramGridStep->getValue(), 1);
     params._method = static_cast<EParamMethod>(_paramMethod->getValue());
 
     if(nbPoints <= 1)
@@ -195,6 +199,78 @@ WarpProcessParams<WarpPlugin::Scalar> WarpPlugin::getProcessParams(const OfxPoin
     return params;
 }
 
+namespace
+{
+
+/**
+ * @brief Evaluate the nodes of a displacement field, each thread computes a band of rows of the grid.
+ */
+template <typename Scalar>
+class DisplacementFieldProcessor : public OFX::MultiThread::Processor
+{
+public:
+    explicit DisplacementFieldProcessor(DisplacementField<Scalar>& field)
+        : _field(field)
+    {
+    }
+
+    void multiThreadFunction(const unsigned int threadID, const unsigned int nThreads)
+    {
+        const std::size_t nbRows = _field.getNbNodeRows();
+        _field.computeNodeRows(nbRows * threadID / nThreads, nbRows * (threadID + 1) / nThreads);
+    }
+
+private:
+    DisplacementField<Scalar>& _field;
+};
+}
+
+boost::shared_ptr<const DisplacementField<WarpPlugin::Scalar> >
+WarpPlugin::findDisplacementField(const DisplacementFieldKey<Scalar>& key)
+{
+    typedef boost::shared_ptr<const DisplacementField<Scalar> > FieldPtr;
+    for(std::list<FieldPtr>::iterator it = _displacementFields.begin(), itEnd = _displacementFields.end(); it != itEnd;
+        ++it)
+    {
+        if((*it)->getKey() == key)
+        {
+            _displacementFields.splice(_displacementFields.begin(), _displacementFields, it);
+            return _displacementFields.front();
+        }
+    }
+    return FieldPtr();
+}
+
+boost::shared_ptr<const DisplacementField<WarpPlugin::Scalar> >
+WarpPlugin::getDisplacementField(const DisplacementFieldKey<Scalar>& key)
+{
+    // the fields of the A and B clips
+    static const std::size_t kMaxNbDisplacementFields = 2;
+    typedef boost::shared_ptr<const DisplacementField<Scalar> > FieldPtr;
+
+    {
+        boost::mutex::scoped_lock lock(_displacementFieldsMutex);
+        const FieldPtr field = findDisplacementField(key);
+        if(field)
+            return field;
+    }
+
+    // computed without the lock, so the renders of other frames are not blocked
+    const boost::shared_ptr<DisplacementField<Scalar> > field(new DisplacementField<Scalar>(key));
+    DisplacementFieldProcessor<Scalar> processor(*field);
+    processor.multiThread();
+
+    boost::mutex::scoped_lock lock(_displacementFieldsMutex);
+    // another render may have computed the same field meanwhile
+    const FieldPtr otherField = findDisplacementField(key);
+    if(otherField)
+        return otherField;
+    _displacementFields.push_front(field);
+    if(_displacementFields.size() > kMaxNbDisplacementFields)
+        _displacementFields.pop_back();
+    return field;
+}
+
 void WarpPlugin::changedParam(const OFX::InstanceChangedArgs& args, const std::string& paramName)
 {
     if(boost::starts_with(paramName, kParamPointIn) || boost::starts_with(paramName, kParamPointOut) ||
@@ -2,6 +2,7 @@
 #define _TUTTLE_PLUGIN_WARP_PLUGIN_HPP_
 
 #include "WarpDefinitions.hpp"
+#include "TPS/DisplacementField.hpp"
 
 #include <tuttle/plugin/global.hpp>
 
@@ -10,6 +11,10 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/gil/gil_all.hpp>
 #include <boost/array.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <list>
 
 namespace tuttle
 {
@@ -39,6 +44,7 @@ struct WarpProcessParams
     double _rigiditeTPS;
     std::size_t _nbPoints;
     double _transition;
+    std::size_t _gridStep;
 
     EParamMethod _method;
 };
@@ -59,6 +65,14 @@ public:
 public:
     WarpProcessParams<Scalar> getProcessParams(const OfxPointD& renderScale = OFX::kNoRenderScale) const;
 
+    /**
+     * @brief Get the displacement field of a thin-plate spline.
+     * The last fields are kept, so the spline is only evaluated again when the curves, the rigidity,
+     * the transition or the image size change (not for each frame).
+     * A new field is computed on all the threads, without locking the other renders.
+     */
+    boost::shared_ptr<const DisplacementField<Scalar> > getDisplacementField(const DisplacementFieldKey<Scalar>& key);
+
     void changedParam(const OFX::InstanceChangedArgs& args, const std::string& paramName);
 
     //	bool getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod );
@@ -85,6 +99,7 @@ public:
     OFX::GroupParam* _paramGroupSettings;
     OFX::DoubleParam* _paramRigiditeTPS;
     OFX::IntParam* _paramNbPointsBezier;
+    OFX::IntParam* _paramGridStep;
 
     // In
     OFX::GroupParam* _paramGroupIn;
@@ -117,8 +132,15 @@ public:
     OFX::GroupParam* _paramGroupCurveBegin;
     boost::array<OFX::BooleanParam*, kMaxNbPoints> _paramCurveBegin;
 
+private:
+    /// @brief The field of @p key if it is kept (and mark it as the most recently used), _displacementFieldsMutex must be locked.
+    boost::shared_ptr<const DisplacementField<Scalar> > findDisplacementField(const DisplacementFieldKey<Scalar>& key);
+
 private:
     OFX::InstanceChangedArgs _instanceChangedArgs;
+
+    boost::mutex _displacementFieldsMutex;
+    std::list<boost::shared_ptr<const DisplacementField<Scalar> > > _displacementFields; ///< most recently used first
 };
 }
 }
@@ -134,6 +134,17 @@ void WarpPluginFactory::describeInContext(OFX::ImageEffectDescriptor& desc, OFX:
         nbPointsBezier->setDisplayRange(1, 20);
         nbPointsBezier->setParent(groupSettings);
 
+        OFX::IntParamDescriptor* gridStep = desc.defineIntParam(kParamGridStep);
+        gridStep->setLabel("Grid Step");
+        gridStep->setHint("Distance in pixels between the points where the warp is computed, "
+                          "the other pixels are interpolated.\n"
+                          "1 computes the warp at each pixel. Bigger values are faster to compute, "
+                          "but less precise on strong or dense warps.");
+        gridStep->setDefault(4);
+        gridStep->setRange(1, std::numeric_limits<int>::max());
+        gridStep->setDisplayRange(1, 16);
+        gridStep->setParent(groupSettings);
+
         // Overlay Points et tangentes
         OFX::GroupParamDescriptor* groupOverlay = desc.defineGroupParam(kParamGroupOverlay);
         groupOverlay->setLabel("Overlay points et tangentes");
@@ -1,10 +1,13 @@
 #ifndef _TUTTLE_PLUGIN_WARP_PROCESS_HPP_
 #define _TUTTLE_PLUGIN_WARP_PROCESS_HPP_
 
-#include "TPS/tps.hpp"
+#include "TPS/DisplacementField.hpp"
 
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
+
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace tuttle
 {
@@ -26,7 +29,7 @@ public:
     typedef WarpPlugin::Scalar Scalar;
     typedef typename View::point_t Point;
     typedef typename View::coord_t Coord;
-    typedef typename terry::image_from_view<View>::type Image;
+    typedef typename terry::image_from_view<View, OfxAllocator<unsigned char> >::type Image; ///< in the host memory pool
 
 protected:
     WarpPlugin& _plugin; ///< Rendering plugin
@@ -37,8 +40,8 @@ protected:
     View _srcBView;
 
     WarpProcessParams<Scalar> _params; ///< parameters
-    TPS_Morpher<Scalar> _tpsA;
-    TPS_Morpher<Scalar> _tpsB;
+    boost::shared_ptr<const DisplacementField<Scalar> > _fieldA;
+    boost::shared_ptr<const DisplacementField<Scalar> > _fieldB;
 
 public:
     WarpProcess(WarpPlugin& effect);
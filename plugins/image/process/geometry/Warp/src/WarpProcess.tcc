@@ -20,6 +20,8 @@ WarpProcess<View>::WarpProcess(WarpPlugin& effect)
     , _plugin(effect)
 {
     _clipSrcB = effect.fetchClip(kClipSourceB);
+    // the cost of a row depends on the warped area, use small chunks to balance the load
+    this->setChunkSize(8);
 }
 
 template <class View>
@@ -48,14 +50,27 @@ void WarpProcess<View>::setup(const OFX::RenderArguments& args)
         // _srcBPixelRod = _srcB->getRegionOfDefinition(); // bug in nuke, returns bounds
         _srcBPixelRod = _clipSrcB->getPixelRod(args.time, args.renderScale);
         this->_srcBView = this->getView(this->_srcB.get(), _srcBPixelRod);
-        _tpsB.setup(_params._bezierOut, _params._bezierIn, _params._rigiditeTPS, _params._activateWarp,
-                    this->_srcBPixelRod.x2 - this->_srcBPixelRod.x1, this->_srcBPixelRod.y2 - this->_srcBPixelRod.y1,
-                    (1.0 - _params._transition));
+        DisplacementFieldKey<Scalar> keyB;
+        keyB._pIn = _params._bezierOut;
+        keyB._pOut = _params._bezierIn;
+        keyB._regularization = _params._rigiditeTPS;
+        keyB._activateWarp = _params._activateWarp;
+        keyB._width = this->_srcBPixelRod.x2 - this->_srcBPixelRod.x1;
+        keyB._height = this->_srcBPixelRod.y2 - this->_srcBPixelRod.y1;
+        keyB._transition = 1.0 - _params._transition;
+        keyB._gridStep = _params._gridStep;
+        _fieldB = _plugin.getDisplacementField(keyB);
     }
-    // TPS_Morpher<Scalar> tps( _params._inPoints, _params._outPoints , _params._rigiditeTPS);
-    _tpsA.setup(_params._bezierIn, _params._bezierOut, _params._rigiditeTPS, _params._activateWarp,
-                this->_srcPixelRod.x2 - this->_srcPixelRod.x1, this->_srcPixelRod.y2 - this->_srcPixelRod.y1,
-                _params._transition);
+    DisplacementFieldKey<Scalar> keyA;
+    keyA._pIn = _params._bezierIn;
+    keyA._pOut = _params._bezierOut;
+    keyA._regularization = _params._rigiditeTPS;
+    keyA._activateWarp = _params._activateWarp;
+    keyA._width = this->_srcPixelRod.x2 - this->_srcPixelRod.x1;
+    keyA._height = this->_srcPixelRod.y2 - this->_srcPixelRod.y1;
+    keyA._transition = _params._transition;
+    keyA._gridStep = _params._gridStep;
+    _fieldA = _plugin.getDisplacementField(keyA);
     // TUTTLE_TCOUT_VAR( _params._rigiditeTPS );
     // TUTTLE_TCOUT_VAR( _params._activateWarp );
 }
@@ -78,36 +93,32 @@ void WarpProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 
     const EParamFilterOutOfImage outOfImageProcess = eParamFilterOutBlack; /// @todo expose as parameter
 
+    // A is directly resampled into the output
+    {
+        View dst =
+            subimage_view(this->_dstView, this->_srcPixelRod.x1 - this->_dstPixelRod.x1,
+                          this->_srcPixelRod.y1 - this->_dstPixelRod.y1, this->_srcView.width(), this->_srcView.height());
+        resample_pixels_progress<terry::sampler::bilinear_sampler>(this->_srcView, dst, *_fieldA, procWindowSrcA,
+                                                                   outOfImageProcess, this->getOfxProgress());
+    }
+
     if(this->_clipSrcB->isConnected())
     {
-        Image imgA(procWindowSize.x, procWindowSize.y);
+        // only B needs a temporary image, allocated in the host memory pool
         Image imgB(procWindowSize.x, procWindowSize.y);
-        View viewA =
-            subimage_view(view(imgA), this->_srcPixelRod.x1 - procWindowRoW.x1, this->_srcPixelRod.y1 - procWindowRoW.y1,
-                          this->_srcView.width(), this->_srcView.height());
         View viewB =
             subimage_view(view(imgB), this->_srcBPixelRod.x1 - procWindowRoW.x1, this->_srcBPixelRod.y1 - procWindowRoW.y1,
                           this->_srcBView.width(), this->_srcBView.height());
 
-        resample_pixels_progress<terry::sampler::bilinear_sampler>(this->_srcView, viewA, _tpsA, procWindowSrcA,
-                                                                   outOfImageProcess, this->getOfxProgress());
-        resample_pixels_progress<terry::sampler::bilinear_sampler>(this->_srcBView, viewB, _tpsB, procWindowSrcB,
+        resample_pixels_progress<terry::sampler::bilinear_sampler>(this->_srcBView, viewB, *_fieldB, procWindowSrcB,
                                                                    outOfImageProcess, this->getOfxProgress());
 
-        // fondu entre imgA et imgB = this->_dstView FAITEALAMAIN
+        // fondu entre A et B
         View dst =
             subimage_view(this->_dstView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y);
-        transform_pixels_progress(view(imgA), view(imgB), dst, pixel_merge_t<Pixel>(_params._transition),
+        transform_pixels_progress(dst, view(imgB), dst, pixel_merge_t<Pixel>(_params._transition),
                                   this->getOfxProgress());
     }
-    else
-    {
-        View dst =
-            subimage_view(this->_dstView, this->_srcPixelRod.x1 - this->_dstPixelRod.x1,
-                          this->_srcPixelRod.y1 - this->_dstPixelRod.y1, this->_srcView.width(), this->_srcView.height());
-        resample_pixels_progress<terry::sampler::bilinear_sampler>(this->_srcView, dst, _tpsA, procWindowSrcA,
-                                                                   outOfImageProcess, this->getOfxProgress());
-    }
 }
 }
 }
@@ -0,0 +1,128 @@
+#include <TPS/DisplacementField.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_plugin_warp
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(plugin_warp)
+
+using namespace boost::unit_test;
+using namespace tuttle::plugin::warp;
+
+namespace
+{
+
+typedef double Scalar;
+typedef boost::gil::point2<Scalar> Point2;
+// without the OFX memory suite of a host
+typedef DisplacementField<Scalar, std::allocator<boost::gil::point2<float> > > Field;
+
+static const std::size_t kWidth = 320;
+static const std::size_t kHeight = 240;
+
+/// @brief Control points moved by up to 10 pixels in a random direction.
+DisplacementFieldKey<Scalar> randomKey(const std::size_t nbPoints, const std::size_t gridStep)
+{
+    DisplacementFieldKey<Scalar> key;
+    std::srand(42);
+    for(std::size_t i = 0; i < nbPoints; ++i)
+    {
+        const Point2 p(std::rand() % kWidth, std::rand() % kHeight);
+        key._pIn.push_back(p);
+        key._pOut.push_back(Point2(p.x + std::rand() % 21 - 10, p.y + std::rand() % 21 - 10));
+    }
+    key._regularization = 0.0;
+    key._activateWarp = true;
+    key._width = kWidth;
+    key._height = kHeight;
+    key._transition = 1.0;
+    key._gridStep = gridStep;
+    return key;
+}
+
+/// @brief Maximal distance (on x or y) between the field and the spline, on the pixels multiple of @p stride.
+double maxDifference(const Field& field, const std::size_t stride)
+{
+    const DisplacementFieldKey<Scalar>& key = field.getKey();
+    TPS_Morpher<Scalar> tps;
+    tps.setup(key._pIn, key._pOut, key._regularization, key._activateWarp, key._width, key._height, key._transition);
+
+    double maxDiff = 0.0;
+    for(std::ptrdiff_t y = 0; y < std::ptrdiff_t(kHeight); y += stride)
+    {
+        for(std::ptrdiff_t x = 0; x < std::ptrdiff_t(kWidth); x += stride)
+        {
+            const boost::gil::point2<std::ptrdiff_t> pt(x, y);
+            const Point2 expected = tps(pt);
+            const Point2 result = field(pt);
+            maxDiff = std::max(maxDiff, std::max(std::abs(result.x - expected.x), std::abs(result.y - expected.y)));
+        }
+    }
+    return maxDiff;
+}
+}
+
+// The displacements are stored as floats: 1e-3 pixel covers their rounding.
+
+BOOST_AUTO_TEST_CASE(displacement_field_exact_on_each_pixel)
+{
+    Field field(randomKey(60, 1));
+    field.computeNodes();
+    BOOST_CHECK_SMALL(maxDifference(field, 1), 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(displacement_field_exact_on_grid_nodes)
+{
+    Field field(randomKey(60, 8));
+    field.computeNodes();
+    BOOST_CHECK_SMALL(maxDifference(field, 8), 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(displacement_field_default_step)
+{
+    // with the default step of the plugin (4 pixels), the bicubic interpolation between the nodes stays below 0.1 pixel
+    // (on dense control points moved in random directions, the error is about 1 pixel)
+    Field field(randomKey(10, 4));
+    field.computeNodes();
+    BOOST_CHECK_SMALL(maxDifference(field, 1), 0.1);
+}
+
+BOOST_AUTO_TEST_CASE(displacement_field_rows_in_parallel)
+{
+    // the nodes computed by separate ranges of rows (as the threads of the plugin do) give the same field
+    Field field(randomKey(20, 4));
+    Field fieldByRanges(field.getKey());
+    field.computeNodes();
+    const std::size_t nbRows = fieldByRanges.getNbNodeRows();
+    const std::size_t nbRanges = 3;
+    for(std::size_t i = 0; i < nbRanges; ++i)
+        fieldByRanges.computeNodeRows(nbRows * i / nbRanges, nbRows * (i + 1) / nbRanges);
+
+    for(std::ptrdiff_t y = 0; y < std::ptrdiff_t(kHeight); ++y)
+    {
+        for(std::ptrdiff_t x = 0; x < std::ptrdiff_t(kWidth); ++x)
+        {
+            const boost::gil::point2<std::ptrdiff_t> pt(x, y);
+            BOOST_REQUIRE(field(pt) == fieldByRanges(pt));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(displacement_field_identity)
+{
+    DisplacementFieldKey<Scalar> key = randomKey(60, 4);
+    key._activateWarp = false;
+    Field field(key);
+    field.computeNodes();
+    BOOST_CHECK_SMALL(maxDifference(field, 1), 1e-3);
+    const Point2 pt = field(boost::gil::point2<std::ptrdiff_t>(13, 7));
+    BOOST_CHECK_SMALL(pt.x - 13.0, 1e-6);
+    BOOST_CHECK_SMALL(pt.y - 7.0, 1e-6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()